@@ -19,6 +19,13 @@ include(SanitizerInstrumentationOption)
 
 include(MCECompilerSettings)
 
+option(MCE_ALLOCATION_TRACKING "Replace the global allocation functions to count heap allocations per thread and per zone." OFF)
+option(MCE_LOCK_STATISTICS "Record acquisition counts and wait and hold times of the engine locks." OFF)
+option(MCE_PERF_COUNTERS "Record hardware performance counters per profiling zone using perf_event_open (Linux only)." OFF)
+option(MCE_COMPRESSION_LZ4 "Support the LZ4 codec for pack file entries (requires liblz4)." OFF)
+option(MCE_COMPRESSION_ZSTD "Support the Zstandard codec for pack file entries (requires libzstd)." OFF)
+option(MCE_BUILD_BENCHMARKS "Build the microbenchmark executable mce_benchmarks (requires Google Benchmark)." OFF)
+
 option(MCE_VKGLFORMAT_AS_SUBDIRECTORY "Use vkglformat as an embedded subdirectory (uses find_package otherwise)." ON)
 if(MCE_VKGLFORMAT_AS_SUBDIRECTORY)
 	add_subdirectory(${CMAKE_CURRENT_LIST_DIR}/../vkglformat vkglformat)
@@ -37,5 +44,14 @@ include(SetupVulkan)
 include(SetupGLM)
 include(SetupGTest)
 include(SetupBoost)
+if(MCE_COMPRESSION_LZ4)
+	include(SetupLZ4)
+endif()
+if(MCE_COMPRESSION_ZSTD)
+	include(SetupZstd)
+endif()
+if(MCE_BUILD_BENCHMARKS)
+	include(SetupGBenchmark)
+endif()
 
 find_package(TBB REQUIRED)
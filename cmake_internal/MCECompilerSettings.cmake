@@ -1,5 +1,7 @@
 include_guard()
 
+include(CheckCXXSourceCompiles)
+
 add_library(mce_compiler_settings INTERFACE)
 target_compile_definitions(mce_compiler_settings INTERFACE
 		$<$<CONFIG:Debug>:DEBUG>
@@ -26,6 +28,29 @@ target_link_libraries(mce_compiler_settings INTERFACE
 	)
 set_target_properties(mce_compiler_settings PROPERTIES EXPORT_NAME compiler_settings)
 
+# The containers use std::pmr from <memory_resource>, which libc++ only provides since LLVM 16.
+if(CMAKE_CXX_COMPILER_ID STREQUAL "Clang")
+	set(CMAKE_REQUIRED_FLAGS "-std=c++1z -stdlib=libc++")
+	set(CMAKE_REQUIRED_LIBRARIES "-stdlib=libc++")
+elseif(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+	set(CMAKE_REQUIRED_FLAGS "-std=c++1z")
+elseif(MSVC)
+	set(CMAKE_REQUIRED_FLAGS "/std:c++latest")
+endif()
+check_cxx_source_compiles("
+	#include <memory_resource>
+	int main() {
+		std::pmr::polymorphic_allocator<int> allocator(std::pmr::get_default_resource());
+		return allocator.resource() == nullptr;
+	}"
+	MCE_HAVE_STD_MEMORY_RESOURCE)
+unset(CMAKE_REQUIRED_FLAGS)
+unset(CMAKE_REQUIRED_LIBRARIES)
+if(NOT MCE_HAVE_STD_MEMORY_RESOURCE)
+	message(FATAL_ERROR "The standard library doesn't provide <memory_resource> (std::pmr). "
+			"GCC 9 / libstdc++ 9, MSVC 2017 15.6 or libc++ from LLVM 16 or newer are required.")
+endif()
+
 include(ProvideEmbeddedImport)
 provide_embedded_import(mce:: mce_compiler_settings)
 
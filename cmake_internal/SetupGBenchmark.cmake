@@ -0,0 +1,6 @@
+include_guard()
+
+if(NOT DEFINED benchmark_ROOT)
+	set(benchmark_ROOT ${LIBS_DIR}/benchmark)
+endif()
+find_package(benchmark REQUIRED)
@@ -0,0 +1,14 @@
+include_guard()
+
+find_path(LZ4_INCLUDE_DIR NAMES lz4.h HINTS ${LIBS_DIR}/lz4/include)
+find_library(LZ4_LIBRARY NAMES lz4 liblz4 HINTS ${LIBS_DIR}/lz4/lib)
+if(NOT LZ4_INCLUDE_DIR OR NOT LZ4_LIBRARY)
+	message(FATAL_ERROR "LZ4 not found, set LZ4_INCLUDE_DIR and LZ4_LIBRARY or disable MCE_COMPRESSION_LZ4.")
+endif()
+if(NOT TARGET LZ4::LZ4)
+	add_library(LZ4::LZ4 UNKNOWN IMPORTED)
+	set_target_properties(LZ4::LZ4 PROPERTIES
+		IMPORTED_LOCATION ${LZ4_LIBRARY}
+		INTERFACE_INCLUDE_DIRECTORIES ${LZ4_INCLUDE_DIR}
+		)
+endif()
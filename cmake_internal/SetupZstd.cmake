@@ -0,0 +1,14 @@
+include_guard()
+
+find_path(ZSTD_INCLUDE_DIR NAMES zstd.h HINTS ${LIBS_DIR}/zstd/include)
+find_library(ZSTD_LIBRARY NAMES zstd libzstd zstd_static HINTS ${LIBS_DIR}/zstd/lib)
+if(NOT ZSTD_INCLUDE_DIR OR NOT ZSTD_LIBRARY)
+	message(FATAL_ERROR "Zstandard not found, set ZSTD_INCLUDE_DIR and ZSTD_LIBRARY or disable MCE_COMPRESSION_ZSTD.")
+endif()
+if(NOT TARGET zstd::zstd)
+	add_library(zstd::zstd UNKNOWN IMPORTED)
+	set_target_properties(zstd::zstd PROPERTIES
+		IMPORTED_LOCATION ${ZSTD_LIBRARY}
+		INTERFACE_INCLUDE_DIRECTORIES ${ZSTD_INCLUDE_DIR}
+		)
+endif()
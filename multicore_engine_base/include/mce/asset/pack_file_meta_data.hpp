@@ -12,8 +12,10 @@
  * Defines the serializable structure of the meta data of a pack file.
  */
 
+#include <algorithm>
 #include <cstdint>
 #include <mce/util/composite_magic_number.hpp>
+#include <mce/util/compression.hpp>
 #include <string>
 #include <vector>
 
@@ -30,6 +32,33 @@ struct pack_file_element_meta_data {
 	uint64_t size;			  ///< The size of the element.
 	uint64_t compressed_size; ///< The compressed size of the element (0 means uncompressed).
 	std::string name;		  ///< The name of the element.
+	/// The codec used to compress the element, only meaningful if compressed_size is not 0.
+	util::compression_codec codec = util::compression_codec::zlib;
+	/// \brief The uncompressed size of the independently compressed blocks of the element or 0 if the element
+	/// is compressed as a single block.
+	/**
+	 * Every block except the last one has this size.
+	 */
+	uint64_t block_size = 0;
+	/// The end offsets of the compressed blocks relative to the offset of the element, empty if not blocked.
+	std::vector<uint64_t> block_ends = {};
+
+	/// Returns true if the element is compressed in independent blocks.
+	bool blocked() const noexcept {
+		return compressed_size != 0 && block_size != 0;
+	}
+	/// Returns the number of compressed blocks of a blocked element.
+	size_t block_count() const noexcept {
+		return block_ends.size();
+	}
+	/// Returns the begin offset of the given compressed block relative to the offset of the element.
+	uint64_t block_begin(size_t block) const noexcept {
+		return block ? block_ends[block - 1] : 0;
+	}
+	/// Returns the uncompressed size of the given block.
+	uint64_t block_uncompressed_size(size_t block) const noexcept {
+		return std::min(block_size, size - block * block_size);
+	}
 
 	/// Deserializes the pack file element meta data from the bstream.
 	friend bstream::ibstream& operator>>(bstream::ibstream& ibs, pack_file_element_meta_data& value);
@@ -40,7 +69,7 @@ struct pack_file_element_meta_data {
 /// Represents the meta data for a pack file.
 struct pack_file_meta_data {
 	/// The supported (current) version of the pack file meta data format.
-	constexpr static uint64_t version_ = util::composite_magic_number<uint64_t>(0u, 3u);
+	constexpr static uint64_t version_ = util::composite_magic_number<uint64_t>(0u, 5u);
 
 	/// Magic number for pack file meta data files.
 	static constexpr uint64_t magic_number_ =
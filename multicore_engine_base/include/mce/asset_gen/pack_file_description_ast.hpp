@@ -13,7 +13,10 @@
  */
 
 #include <algorithm>
+#include <boost/optional.hpp>
 #include <mce/asset_gen/base_ast.hpp>
+#include <mce/util/compression.hpp>
+#include <mce/util/string_tools.hpp>
 #include <string>
 #include <vector>
 
@@ -21,6 +24,19 @@ namespace mce {
 namespace asset_gen {
 namespace ast {
 
+/// AST node for a parsed compression modifier of a pack file description.
+struct compression_spec {
+	/// The codec to compress with, none disables compression.
+	util::compression_codec codec = util::compression_codec::none;
+	/// The compression level to use.
+	/**
+	 * Explicit levels are parsed from modifiers like zip(n), lz4(n) or zstd(n) and their range depends on the
+	 * codec, a modifier without a number selects the default level of the codec represented by -1.
+	 * The value is -2 if the codec is none.
+	 */
+	int level = -2;
+};
+
 /// AST node for a parsed entry of a pack file description.
 struct pack_file_entry {
 	/// Construct pack file entry node from values with lookup type.
@@ -37,24 +53,46 @@ struct pack_file_entry {
 	std::string external_path;			 ///< The external path of the file to add into the pack file.
 	lookup_type lookup = lookup_type::w; ///< Specifies how the external path is resolved when relative.
 	std::string internal_path;			 ///< The virtual name the file will have in the pack file.
+	/// Overrides the compression of the section for this entry if present.
+	boost::optional<compression_spec> compression;
+};
+
+/// AST node for a parsed compression rule of a pack file section.
+struct compression_rule {
+	/// \brief Wildcard pattern for the internal paths the rule applies to, where * matches any sequence of
+	/// characters (including /) and ? matches a single character.
+	std::string pattern;
+	compression_spec compression; ///< The compression to use for matching entries.
 };
 
 /// AST node for a parsed section of a pack file description.
 struct pack_file_section {
 	std::string name; ///< The name of the pack file section.
 
-	/// The compression level to use for this section.
+	/// The default compression for the entries of this section.
 	/**
-	 * The value has the following semantics:
-	 * Explicit levels range from 0 to 9 represent low to high compression levels accordingly and are
-	 * generated from zip(n) modifiers with n in the given range.
-	 * The default compression level of zlib is represented by the value of -1 which is parsed from a zip
-	 * modifier without a number.
-	 * A value of -2 disables compression for the section and is parsed if there is no zip modifier on the
-	 * section.
+	 * It is parsed from the zip, lz4, zstd or none modifier of the section with an optional level (e.g.
+	 * zstd(19)) and specifies no compression if there is no modifier.
 	 */
-	int zip_level;
+	compression_spec compression;
 	std::vector<pack_file_entry> entries; ///< The nodes for the entries in section.
+	/// The compression rules of the section in the order they are checked.
+	std::vector<compression_rule> compression_rules = {};
+
+	/// \brief Returns the compression to use for the given entry of this section, which will have the given
+	/// internal path in the pack file.
+	/**
+	 * The compression modifier of the entry takes precedence over the first compression rule whose pattern
+	 * matches the internal path, which in turn takes precedence over the default compression of the section.
+	 */
+	compression_spec entry_compression(const pack_file_entry& entry, const std::string& internal_path) const {
+		if(entry.compression) return *entry.compression;
+		auto rule = std::find_if(compression_rules.begin(), compression_rules.end(), [&](const auto& r) {
+			return util::matches_wildcard(internal_path, r.pattern);
+		});
+		if(rule != compression_rules.end()) return rule->compression;
+		return compression;
+	}
 };
 
 /// AST root node for a parsed pack file description.
@@ -21,10 +21,18 @@ namespace mce {
 namespace asset_gen {
 namespace ast {
 
+/// Enables comparison of compression specifications for equal.
+inline bool operator==(const compression_spec& o1, const compression_spec& o2) {
+	return o1.codec == o2.codec && o1.level == o2.level;
+}
+/// Enables comparison of compression specifications for not equal.
+inline bool operator!=(const compression_spec& o1, const compression_spec& o2) {
+	return !(o1 == o2);
+}
 /// Enables comparison of pack file entries for equal.
 inline bool operator==(const pack_file_entry& o1, const pack_file_entry& o2) {
 	return o1.external_path == o2.external_path && o1.lookup == o2.lookup &&
-		   o1.internal_path == o2.internal_path;
+		   o1.internal_path == o2.internal_path && o1.compression == o2.compression;
 }
 /// Enables comparison of pack file entries for not equal.
 inline bool operator!=(const pack_file_entry& o1, const pack_file_entry& o2) {
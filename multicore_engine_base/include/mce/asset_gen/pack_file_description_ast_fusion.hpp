@@ -14,19 +14,31 @@
 
 #include <boost/fusion/include/adapt_struct.hpp>
 #include <boost/mpl/sequence_tag.hpp>
+#include <boost/optional.hpp>
 #include <mce/asset_gen/base_ast.hpp>
 #include <mce/asset_gen/pack_file_description_ast.hpp>
 #include <string>
 #include <vector>
 
-BOOST_FUSION_ADAPT_STRUCT(mce::asset_gen::ast::pack_file_entry,		 //
-						  (std::string, external_path)				 //
-						  (mce::asset_gen::ast::lookup_type, lookup) //
-						  (std::string, internal_path))				 //
+BOOST_FUSION_ADAPT_STRUCT(mce::asset_gen::ast::compression_spec, //
+						  (mce::util::compression_codec, codec)	 //
+						  (int, level))							 //
 
-BOOST_FUSION_ADAPT_STRUCT(mce::asset_gen::ast::pack_file_section,						//
-						  (std::string, name)											//
-						  (int, zip_level)												//
-						  (std::vector<mce::asset_gen::ast::pack_file_entry>, entries)) //
+BOOST_FUSION_ADAPT_STRUCT(mce::asset_gen::ast::pack_file_entry,									 //
+						  (std::string, external_path)											 //
+						  (mce::asset_gen::ast::lookup_type, lookup)							 //
+						  (std::string, internal_path)											 //
+						  (boost::optional<mce::asset_gen::ast::compression_spec>, compression)) //
+
+BOOST_FUSION_ADAPT_STRUCT(mce::asset_gen::ast::compression_rule,				//
+						  (std::string, pattern)								//
+						  (mce::asset_gen::ast::compression_spec, compression))	//
+
+// The compression rules precede the entries in the grammar.
+BOOST_FUSION_ADAPT_STRUCT(mce::asset_gen::ast::pack_file_section,								  //
+						  (std::string, name)													  //
+						  (mce::asset_gen::ast::compression_spec, compression)					  //
+						  (std::vector<mce::asset_gen::ast::compression_rule>, compression_rules) //
+						  (std::vector<mce::asset_gen::ast::pack_file_entry>, entries))			  //
 
 #endif /* ASSET_GEN_PACK_FILE_DESCRIPTION_AST_FUSION_HPP_ */
@@ -16,6 +16,7 @@
 #include <cstdint>
 #include <iostream>
 #include <mce/asset/pack_file_meta_data.hpp>
+#include <mce/util/compression.hpp>
 #include <string>
 #include <utility>
 #include <vector>
@@ -34,26 +35,35 @@ class pack_file_gen {
 		std::string path;
 		asset::pack_file_element_meta_data meta_data;
 		asset::pack_file_element_meta_data orig_meta_data;
-		int compression_level; //-2 no compression, -1 default compression, 0-9 low-high compression
+		int compression_level; //-2 no compression, -1 default compression, >=0 codec-specific low-high
 		// cppcheck-suppress passedByValue
 		pack_file_entry(std::string path, const std::string& name, uint64_t offset, uint64_t size)
-				: path{std::move(path)}, meta_data{offset, size, 0ull, name},
-				  orig_meta_data{offset, size, 0ull, name}, compression_level{-2} {}
+				: path{std::move(path)}, meta_data{offset, size, 0ull, name, util::compression_codec::none},
+				  orig_meta_data{offset, size, 0ull, name, util::compression_codec::none},
+				  compression_level{-2} {}
 		// cppcheck-suppress passedByValue
 		pack_file_entry(std::string path, const std::string& name, uint64_t offset, uint64_t size,
-						uint64_t compressed_size, int compression_level)
-				: path{std::move(path)}, meta_data{offset, size, compressed_size, name},
-				  orig_meta_data{offset, size, compressed_size, name}, compression_level{compression_level} {}
+						uint64_t compressed_size, util::compression_codec codec, int compression_level,
+						uint64_t block_size, const std::vector<uint64_t>& block_ends)
+				: path{std::move(path)},
+				  meta_data{offset, size, compressed_size, name, codec, block_size, block_ends},
+				  orig_meta_data{offset, size, compressed_size, name, codec, block_size, block_ends},
+				  compression_level{compression_level} {}
 	};
 	std::vector<pack_file_entry> entries;
 	uint64_t next_pos = 0;
 	uint64_t content_offset = 0;
+	uint64_t block_size = default_block_size;
 	asset::pack_file_meta_data meta_data;
 	std::vector<char> input_buffer;
 	std::vector<char> compressed_buffer;
+	std::vector<char> block_buffer;
+	std::vector<uint64_t> block_ends;
 
 	static uint64_t read_file_size(const std::string& path);
-	std::pair<uint64_t, uint64_t> read_file_size_compressed(const std::string& path, int level = -1);
+	std::pair<uint64_t, uint64_t> read_file_size_compressed(const std::string& path,
+															util::compression_codec codec, int level);
+	void compress_input(util::compression_codec codec, int level, uint64_t input_block_size);
 	uint64_t calculate_meta_data_size() const;
 	void compile_meta_data();
 	void update_content_offset(uint64_t new_content_offset);
@@ -62,10 +72,30 @@ class pack_file_gen {
 	void write_pack_file(const std::string& output_file);
 
 public:
+	/// The default uncompressed size of the independently compressed blocks of large files.
+	static constexpr uint64_t default_block_size = 0x40000;
+
+	/// \brief Sets the uncompressed size of the blocks into which files that are added in compressed form
+	/// afterwards are split if they are larger than one block.
+	/**
+	 * The blocks are compressed independently, which allows readers to decompress them in parallel and to
+	 * decompress only the blocks that cover a requested range. A size of 0 compresses every file as a single
+	 * block.
+	 */
+	void set_block_size(uint64_t size) noexcept {
+		block_size = size;
+	}
 	/// Add a file to the prepared content of the pack file in uncompressed form.
 	void add_file(const std::string& path, const std::string& name);
-	/// Add a file to the prepared content of the pack file in compressed form with the given level.
+	/// Add a file to the prepared content of the pack file in zlib compressed form with the given level.
 	void add_file_compressed(const std::string& path, const std::string& name, int level = -1);
+	/// \brief Add a file to the prepared content of the pack file in compressed form using the given codec
+	/// with the given level.
+	/**
+	 * Throws a compression_exception if the codec is not supported by this build.
+	 */
+	void add_file_compressed(const std::string& path, const std::string& name, util::compression_codec codec,
+							 int level = -1);
 	/// Compile the prepared content into a pack file and write it to the given output file.
 	void compile_pack_file(const std::string& output_file);
 };
@@ -147,6 +147,11 @@ struct invalid_data_exception : std::runtime_error {
 	using std::runtime_error::runtime_error;
 };
 
+/// Exception used to signal that an operation was cancelled before it completed.
+struct operation_cancelled_exception : std::runtime_error {
+	using std::runtime_error::runtime_error;
+};
+
 } // namespace mce
 
 #endif /* CORE_EXCEPTIONS_HPP_ */
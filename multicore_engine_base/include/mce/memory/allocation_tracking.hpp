@@ -0,0 +1,149 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_base/include/mce/memory/allocation_tracking.hpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#ifndef MEMORY_ALLOCATION_TRACKING_HPP_
+#define MEMORY_ALLOCATION_TRACKING_HPP_
+
+/**
+ * \file
+ * Provides counters for heap allocations made through the global allocation functions.
+ *
+ * The counting is only active in executables that link the object library mce_allocation_tracking, which
+ * replaces the global operator new and operator delete with counting versions. Otherwise all counters stay
+ * zero. The test executables always link it, other executables only if the engine is built with the CMake
+ * option MCE_ALLOCATION_TRACKING, which also defines the macro of the same name to enable the zones defined
+ * using MCE_ALLOCATION_ZONE.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace mce {
+namespace memory {
+
+namespace detail {
+struct allocation_tracking_access;
+
+/// Marks the allocation functions as replaced, called by the counting versions during static initialization.
+void mark_allocation_functions_replaced() noexcept;
+/// Records an allocation of the given size for the calling thread, its active zone and the global counters.
+void record_allocation(uint64_t size) noexcept;
+/// Records a deallocation for the calling thread, its active zone and the global counters.
+void record_deallocation() noexcept;
+} // namespace detail
+
+/// Returns true if the global allocation functions are replaced by the counting versions in this executable.
+bool allocation_tracking_enabled() noexcept;
+
+/// Holds the counts of calls to the global allocation functions.
+struct allocation_counters {
+	uint64_t allocations = 0;	 ///< The number of calls to allocation functions.
+	uint64_t deallocations = 0;   ///< The number of calls to deallocation functions with a non-null pointer.
+	uint64_t allocated_bytes = 0; ///< The sum of the sizes requested by the allocations.
+
+	/// Returns the counter differences between *this and the given earlier state.
+	allocation_counters operator-(const allocation_counters& other) const noexcept {
+		return {allocations - other.allocations, deallocations - other.deallocations,
+				allocated_bytes - other.allocated_bytes};
+	}
+};
+
+/// Returns the counters for the allocations made by the calling thread.
+allocation_counters thread_allocation_counters() noexcept;
+/// Returns the counters for the allocations made by all threads.
+allocation_counters global_allocation_counters() noexcept;
+
+/// Represents a named zone to which the allocations made while it is active are attributed.
+/**
+ * Zones are activated for the calling thread using allocation_zone_scope and can be nested, in which case the
+ * allocations are only attributed to the innermost zone. Deallocations are attributed to the zone that is
+ * active when the memory is released.
+ *
+ * Zones must have static storage duration because they are registered globally and never unregistered. The
+ * macro MCE_ALLOCATION_ZONE defines such a zone together with a scope for it.
+ */
+class allocation_zone {
+	const char* name_;
+	std::atomic<uint64_t> allocations_{0};
+	std::atomic<uint64_t> deallocations_{0};
+	std::atomic<uint64_t> allocated_bytes_{0};
+	allocation_zone* next_ = nullptr;
+
+	friend struct detail::allocation_tracking_access;
+
+public:
+	/// Creates and registers a zone with the given name that must be a string with static storage duration.
+	explicit allocation_zone(const char* name) noexcept;
+	/// Forbids copying.
+	allocation_zone(const allocation_zone&) = delete;
+	/// Forbids copying.
+	allocation_zone& operator=(const allocation_zone&) = delete;
+
+	/// Returns the name of the zone.
+	const char* name() const noexcept {
+		return name_;
+	}
+	/// Returns the counters for the allocations attributed to the zone.
+	allocation_counters counters() const noexcept {
+		return {allocations_.load(std::memory_order_relaxed), deallocations_.load(std::memory_order_relaxed),
+				allocated_bytes_.load(std::memory_order_relaxed)};
+	}
+	/// Resets the counters of the zone to zero.
+	void reset() noexcept;
+};
+
+/// Makes the given zone the active allocation_zone of the calling thread for the lifetime of the scope.
+class allocation_zone_scope {
+	allocation_zone* previous_;
+
+public:
+	/// Activates the given zone.
+	explicit allocation_zone_scope(allocation_zone& zone) noexcept;
+	/// Restores the zone that was active before.
+	~allocation_zone_scope() noexcept;
+	/// Forbids copying.
+	allocation_zone_scope(const allocation_zone_scope&) = delete;
+	/// Forbids copying.
+	allocation_zone_scope& operator=(const allocation_zone_scope&) = delete;
+};
+
+/// Returns the names and counters of all registered zones.
+std::vector<std::pair<const char*, allocation_counters>> allocation_zone_counters();
+
+/// Counts the allocations made by the calling thread during the lifetime of the object.
+class allocation_counting_scope {
+	allocation_counters start_;
+
+public:
+	/// Starts counting.
+	allocation_counting_scope() noexcept : start_{thread_allocation_counters()} {}
+	/// Returns the counters for the allocations made by the calling thread since the construction.
+	allocation_counters counters() const noexcept {
+		return thread_allocation_counters() - start_;
+	}
+};
+
+} // namespace memory
+} // namespace mce
+
+#define MCE_ALLOCATION_ZONE_CONCAT_IMPL(A, B) A##B
+#define MCE_ALLOCATION_ZONE_CONCAT(A, B) MCE_ALLOCATION_ZONE_CONCAT_IMPL(A, B)
+
+/// \brief Attributes the allocations in the rest of the enclosing block to a zone with the given name, if
+/// allocation tracking is enabled.
+#ifdef MCE_ALLOCATION_TRACKING
+#define MCE_ALLOCATION_ZONE(NAME)                                                                            \
+	static ::mce::memory::allocation_zone MCE_ALLOCATION_ZONE_CONCAT(mce_allocation_zone_, __LINE__){NAME}; \
+	::mce::memory::allocation_zone_scope MCE_ALLOCATION_ZONE_CONCAT(mce_allocation_zone_scope_, __LINE__) { \
+		MCE_ALLOCATION_ZONE_CONCAT(mce_allocation_zone_, __LINE__)                                           \
+	}
+#else
+#define MCE_ALLOCATION_ZONE(NAME)
+#endif
+
+#endif /* MEMORY_ALLOCATION_TRACKING_HPP_ */
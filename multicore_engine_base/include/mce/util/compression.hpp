@@ -14,6 +14,7 @@
 
 #include <cerrno>
 #include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <mce/exceptions.hpp>
 #include <string>
@@ -28,10 +29,58 @@ namespace util {
 std::vector<char> compress(const std::vector<char>& input, int level = -1);
 /// Compresses the data in the given vector into the given target vector with the given level.
 void compress(const std::vector<char>& input, int level, std::vector<char>& out_buffer);
+/// Compresses the given data into the given target vector with the given level.
+void compress(const char* input, size_t input_size, int level, std::vector<char>& out_buffer);
 /// Decompresses the data in the given vector and returns the decompressed data.
 std::vector<char> decompress(const std::vector<char>& input);
 /// Decompresses the data in the given vector into the given target vector.
 void decompress(const std::vector<char>& input, std::vector<char>& out_buffer);
+/// \brief Decompresses the given data directly into the given output buffer, whose size must be the exact
+/// size of the decompressed data.
+/**
+ * Throws a compression_exception if the decompressed data is smaller or larger than the output buffer.
+ */
+void decompress(const char* input, size_t input_size, char* output, size_t output_size);
+
+/// Identifies the codec used to compress a block of data, e.g. an element of a pack file.
+/**
+ * The numeric values are used in serialized data and must therefore not be changed.
+ */
+enum class compression_codec : uint8_t {
+	none = 0, ///< The data is stored without compression.
+	zlib = 1, ///< Deflate using zlib, the functions above.
+	lz4 = 2,  ///< LZ4, fastest decompression with a moderate compression ratio.
+	zstd = 3  ///< Zstandard, fast decompression with a high compression ratio at high levels.
+};
+
+/// Interface for the implementations of the compression codecs.
+class codec {
+public:
+	/// Allows polymorphic destruction.
+	virtual ~codec() = default;
+	/// Returns the id of the codec.
+	virtual compression_codec id() const noexcept = 0;
+	/// Compresses the given data into the given target vector with the given level.
+	/**
+	 * A level of -1 selects the default level of the codec, levels above the maximum level of the codec are
+	 * clamped to the maximum.
+	 */
+	virtual void compress(const char* input, size_t input_size, int level,
+						  std::vector<char>& out_buffer) const = 0;
+	/// \brief Decompresses the given data directly into the given output buffer, whose size must be the exact
+	/// size of the decompressed data.
+	/**
+	 * Throws a compression_exception if the data is corrupt or its size differs from the output buffer.
+	 */
+	virtual void decompress(const char* input, size_t input_size, char* output, size_t output_size) const = 0;
+};
+
+/// Returns true if the given codec is supported by this build.
+bool codec_available(compression_codec id) noexcept;
+/// Returns the implementation of the given codec or throws a compression_exception if it is not available.
+const codec& get_codec(compression_codec id);
+/// Returns the name of the given codec as it is used in pack file descriptions.
+const char* codec_name(compression_codec id) noexcept;
 
 namespace detail {
 namespace zlib_wrappers {
@@ -118,6 +167,8 @@ public:
 		stream.opaque = Z_NULL;
 		stream.avail_in = 0;
 		stream.next_in = Z_NULL;
+		stream.avail_out = 0;
+		stream.next_out = Z_NULL;
 		return_code rc = static_cast<return_code>(inflateInit(&stream));
 		zlib_check_error(rc);
 	}
@@ -27,6 +27,9 @@ bool starts_with(boost::string_view str, boost::string_view prefix);
 bool starts_with_ignore_case(boost::string_view str, boost::string_view prefix);
 /// Checks if the given string views are equal when character case is ignored.
 bool equal_ignore_case(boost::string_view str_a, boost::string_view str_b);
+/// \brief Checks if the given string view matches the given wildcard pattern, where * matches any sequence of
+/// characters and ? matches any single character.
+bool matches_wildcard(boost::string_view str, boost::string_view pattern);
 
 /// Allows efficient processing of delimited strings in place using function objects.
 /**
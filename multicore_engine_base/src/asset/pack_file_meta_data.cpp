@@ -19,6 +19,22 @@ bstream::ibstream& operator>>(bstream::ibstream& ibs, pack_file_element_meta_dat
 	ibs >> value.size;
 	ibs >> value.compressed_size;
 	ibs >> value.name;
+	uint8_t codec = 0;
+	ibs >> codec;
+	value.codec = static_cast<util::compression_codec>(codec);
+	ibs >> value.block_size;
+	ibs >> value.block_ends;
+	if(value.block_size) {
+		// Reject inconsistent block tables here to allow the readers to rely on them.
+		auto expected_blocks = value.size / value.block_size + (value.size % value.block_size ? 1 : 0);
+		if(value.compressed_size == 0 || value.block_ends.size() != expected_blocks ||
+		   !std::is_sorted(value.block_ends.begin(), value.block_ends.end()) ||
+		   (!value.block_ends.empty() && value.block_ends.back() != value.compressed_size)) {
+			ibs.raise_read_invalid();
+		}
+	} else if(!value.block_ends.empty()) {
+		ibs.raise_read_invalid();
+	}
 	return ibs;
 }
 bstream::obstream& operator<<(bstream::obstream& obs, const pack_file_element_meta_data& value) {
@@ -26,6 +42,9 @@ bstream::obstream& operator<<(bstream::obstream& obs, const pack_file_element_me
 	obs << value.size;
 	obs << value.compressed_size;
 	obs << value.name;
+	obs << static_cast<uint8_t>(value.codec);
+	obs << value.block_size;
+	obs << value.block_ends;
 	return obs;
 }
 
@@ -35,10 +35,10 @@ namespace mce {
 namespace asset_gen {
 namespace parser {
 namespace pack_file_description_parser_impl {
+using x3::attr;
 using x3::char_;
 using x3::eoi;
 using x3::eol;
-using x3::eps;
 using x3::int_;
 using x3::lexeme;
 using x3::lit;
@@ -49,9 +49,12 @@ auto skipper = ascii::space | (lit("//") >> *((char_ - eol) - eoi));
 rule<class pack_file_ast_root, ast::pack_file_ast_root> start;
 rule<class pack_file_section, ast::pack_file_section> section;
 rule<class pack_file_entry, ast::pack_file_entry> entry;
+rule<class pack_file_compression_rule, ast::compression_rule> compression_rule;
 rule<class pack_file_string_literal, std::string> string_literal;
 rule<class pack_file_identifier, std::string> identifier;
-rule<class pack_file_zip_level, int> zip_level;
+rule<class pack_file_compression, ast::compression_spec> compression;
+rule<class pack_file_section_compression, ast::compression_spec> section_compression;
+rule<class pack_file_compression_level, int> compression_level;
 rule<class pack_file_lookup_spec, ast::lookup_type> lookup_spec;
 
 struct lookup_type_ : x3::symbols<ast::lookup_type> {
@@ -61,25 +64,38 @@ struct lookup_type_ : x3::symbols<ast::lookup_type> {
 	}
 } lookup_type;
 
+struct codec_type_ : x3::symbols<util::compression_codec> {
+	codec_type_() {
+		add("zip", util::compression_codec::zlib);
+		add("lz4", util::compression_codec::lz4);
+		add("zstd", util::compression_codec::zstd);
+	}
+} codec_type;
+
 auto identifier_def = lexeme[char_("a-zA-Z_") >> *char_("0-9a-zA-Z_")];
 auto string_literal_def = lexeme[lit('\"') > *((char_ - '\"')) > lit('\"')];
 auto lookup_spec_def = no_case[lookup_type];
-auto entry_def = string_literal > -(lookup_spec) > -(lit('-') > lit('>') > string_literal) > lit(';');
-auto set_default_zip_level = [](auto& ctx) { _val(ctx) = -1; };
-auto set_uncompressed_zip_level = [](auto& ctx) { _val(ctx) = -2; };
-auto zip_level_def = ((lit("zip(") > int_ > lit(')')))	 // Explicit level
-					 | (lit("zip")[set_default_zip_level]) // Default level
-					 | (eps[set_uncompressed_zip_level]);  // Uncompressed
-auto section_def = identifier > zip_level > lit('{') > *(entry) > lit('}');
+auto entry_def = string_literal > -(lookup_spec) > -(lit('-') > lit('>') > string_literal) > -(compression) >
+				 lit(';');
+auto compression_rule_def = lit("compress") > string_literal > compression > lit(';');
+auto compression_level_def = (lit('(') > int_ > lit(')')) // Explicit level
+							 | attr(-1);				   // Default level
+auto compression_def = (lit("none") >> attr(util::compression_codec::none) >> attr(-2)) // Uncompressed
+					   | (codec_type > compression_level);
+auto section_compression_def = compression | attr(ast::compression_spec{}); // Uncompressed if not given
+auto section_def = identifier > section_compression > lit('{') > *(compression_rule) > *(entry) > lit('}');
 auto start_def = *(section);
 
 BOOST_SPIRIT_DEFINE(start);
 BOOST_SPIRIT_DEFINE(section);
 BOOST_SPIRIT_DEFINE(entry);
+BOOST_SPIRIT_DEFINE(compression_rule);
 BOOST_SPIRIT_DEFINE(string_literal);
 BOOST_SPIRIT_DEFINE(identifier);
 BOOST_SPIRIT_DEFINE(lookup_spec);
-BOOST_SPIRIT_DEFINE(zip_level);
+BOOST_SPIRIT_DEFINE(compression);
+BOOST_SPIRIT_DEFINE(section_compression);
+BOOST_SPIRIT_DEFINE(compression_level);
 
 } // namespace pack_file_description_parser_impl
 
@@ -34,7 +34,8 @@ uint64_t pack_file_gen::read_file_size(const std::string& path) {
 	} else
 		throw path_not_found_exception("Couldn't open asset file '" + path + "'.");
 }
-std::pair<uint64_t, uint64_t> pack_file_gen::read_file_size_compressed(const std::string& path, int level) {
+std::pair<uint64_t, uint64_t>
+pack_file_gen::read_file_size_compressed(const std::string& path, util::compression_codec codec, int level) {
 	std::string sanitized_path = path;
 	util::sanitize_path_inplace(sanitized_path);
 	std::ifstream stream(sanitized_path, std::ios::binary);
@@ -48,11 +49,26 @@ std::pair<uint64_t, uint64_t> pack_file_gen::read_file_size_compressed(const std
 		input_buffer.clear();
 		input_buffer.resize(size, '\0');
 		stream.read(input_buffer.data(), size);
-		util::compress(input_buffer, level, compressed_buffer);
+		compress_input(codec, level, block_size);
 		return std::make_pair(size, compressed_buffer.size());
 	} else
 		throw path_not_found_exception("Couldn't open asset file '" + path + "'.");
 }
+void pack_file_gen::compress_input(util::compression_codec codec, int level, uint64_t input_block_size) {
+	const auto& c = util::get_codec(codec);
+	block_ends.clear();
+	if(!input_block_size || input_buffer.size() <= input_block_size) {
+		c.compress(input_buffer.data(), input_buffer.size(), level, compressed_buffer);
+		return;
+	}
+	compressed_buffer.clear();
+	for(uint64_t block_offset = 0; block_offset < input_buffer.size(); block_offset += input_block_size) {
+		auto size = std::min<uint64_t>(input_block_size, input_buffer.size() - block_offset);
+		c.compress(input_buffer.data() + block_offset, size, level, block_buffer);
+		compressed_buffer.insert(compressed_buffer.end(), block_buffer.begin(), block_buffer.end());
+		block_ends.push_back(compressed_buffer.size());
+	}
+}
 void pack_file_gen::update_content_offset(uint64_t new_content_offset) {
 	for(auto& entry : entries) {
 		entry.meta_data.offset -= content_offset;
@@ -113,11 +129,12 @@ void pack_file_gen::copy_file_content_compressed(std::fstream& into, const pack_
 		input_buffer.clear();
 		input_buffer.resize(size, '\0');
 		stream.read(input_buffer.data(), size);
-		util::compress(input_buffer, entry.compression_level, compressed_buffer);
+		compress_input(entry.meta_data.codec, entry.compression_level, entry.meta_data.block_size);
 		into.write(compressed_buffer.data(), compressed_buffer.size());
 		if(std::max(uint64_t(stream.gcount()), uint64_t(0)) != entry.meta_data.size)
 			throw io_exception("Size mismatch for file '" + entry.path + "'.");
-		if(compressed_buffer.size() != entry.meta_data.compressed_size)
+		if(compressed_buffer.size() != entry.meta_data.compressed_size ||
+		   block_ends != entry.meta_data.block_ends)
 			throw io_exception("Compressed size mismatch for file '" + entry.path + "'.");
 	} else
 		throw path_not_found_exception("Couldn't open asset file '" + entry.path + "'.");
@@ -143,11 +160,21 @@ void pack_file_gen::add_file(const std::string& path, const std::string& name) {
 	next_pos += size;
 }
 void pack_file_gen::add_file_compressed(const std::string& path, const std::string& name, int level) {
-	if(level > 9) level = 9;
+	add_file_compressed(path, name, util::compression_codec::zlib, level);
+}
+void pack_file_gen::add_file_compressed(const std::string& path, const std::string& name,
+										util::compression_codec codec, int level) {
+	if(codec == util::compression_codec::none) {
+		add_file(path, name);
+		return;
+	}
+	if(level < -1) level = -1;
 	uint64_t size;
 	uint64_t compressed_size;
-	std::tie(size, compressed_size) = read_file_size_compressed(path, level);
-	entries.emplace_back(path, name, next_pos, size, compressed_size, level);
+	std::tie(size, compressed_size) = read_file_size_compressed(path, codec, level);
+	auto entry_block_size = block_ends.empty() ? 0 : block_size;
+	entries.emplace_back(path, name, next_pos, size, compressed_size, codec, level, entry_block_size,
+						 block_ends);
 	next_pos += compressed_size;
 }
 void pack_file_gen::compile_pack_file(const std::string& output_file) {
@@ -0,0 +1,149 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_base/src/memory/allocation_functions.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+// The counting versions of the global allocation functions. This file is not part of mce_base but of the
+// object library mce_allocation_tracking, because replacement functions in a static library only take effect
+// if the linker happens to pull in their object file. Linking the object library into an executable always
+// does.
+
+#include <algorithm>
+#include <cstdlib>
+#include <mce/memory/allocation_tracking.hpp>
+#include <new>
+
+namespace {
+
+struct replacement_marker {
+	replacement_marker() noexcept {
+		mce::memory::detail::mark_allocation_functions_replaced();
+	}
+} marker;
+
+void* tracked_allocate(std::size_t size) {
+	mce::memory::detail::record_allocation(size);
+	if(size == 0) size = 1;
+	for(;;) {
+		void* ptr = std::malloc(size);
+		if(ptr) return ptr;
+		auto handler = std::get_new_handler();
+		if(!handler) throw std::bad_alloc();
+		handler();
+	}
+}
+
+void* tracked_allocate(std::size_t size, std::align_val_t alignment) {
+	mce::memory::detail::record_allocation(size);
+	auto align = std::max(std::size_t(alignment), sizeof(void*));
+	if(size == 0) size = 1;
+	for(;;) {
+#ifdef _MSC_VER
+		void* ptr = _aligned_malloc(size, align);
+#else
+		void* ptr = nullptr;
+		if(posix_memalign(&ptr, align, size)) ptr = nullptr;
+#endif
+		if(ptr) return ptr;
+		auto handler = std::get_new_handler();
+		if(!handler) throw std::bad_alloc();
+		handler();
+	}
+}
+
+void tracked_deallocate(void* ptr) noexcept {
+	if(!ptr) return;
+	mce::memory::detail::record_deallocation();
+	std::free(ptr);
+}
+
+void tracked_deallocate(void* ptr, std::align_val_t) noexcept {
+	if(!ptr) return;
+	mce::memory::detail::record_deallocation();
+#ifdef _MSC_VER
+	_aligned_free(ptr);
+#else
+	std::free(ptr);
+#endif
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+	return tracked_allocate(size);
+}
+void* operator new[](std::size_t size) {
+	return tracked_allocate(size);
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	try {
+		return tracked_allocate(size);
+	} catch(...) {
+		return nullptr;
+	}
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+	try {
+		return tracked_allocate(size);
+	} catch(...) {
+		return nullptr;
+	}
+}
+void* operator new(std::size_t size, std::align_val_t alignment) {
+	return tracked_allocate(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+	return tracked_allocate(size, alignment);
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+	try {
+		return tracked_allocate(size, alignment);
+	} catch(...) {
+		return nullptr;
+	}
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+	try {
+		return tracked_allocate(size, alignment);
+	} catch(...) {
+		return nullptr;
+	}
+}
+
+void operator delete(void* ptr) noexcept {
+	tracked_deallocate(ptr);
+}
+void operator delete[](void* ptr) noexcept {
+	tracked_deallocate(ptr);
+}
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+	tracked_deallocate(ptr);
+}
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+	tracked_deallocate(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept {
+	tracked_deallocate(ptr);
+}
+void operator delete[](void* ptr, std::size_t) noexcept {
+	tracked_deallocate(ptr);
+}
+void operator delete(void* ptr, std::align_val_t alignment) noexcept {
+	tracked_deallocate(ptr, alignment);
+}
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept {
+	tracked_deallocate(ptr, alignment);
+}
+void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+	tracked_deallocate(ptr, alignment);
+}
+void operator delete[](void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+	tracked_deallocate(ptr, alignment);
+}
+void operator delete(void* ptr, std::size_t, std::align_val_t alignment) noexcept {
+	tracked_deallocate(ptr, alignment);
+}
+void operator delete[](void* ptr, std::size_t, std::align_val_t alignment) noexcept {
+	tracked_deallocate(ptr, alignment);
+}
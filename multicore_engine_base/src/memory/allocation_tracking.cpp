@@ -0,0 +1,126 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_base/src/memory/allocation_tracking.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <mce/memory/allocation_tracking.hpp>
+#include <new>
+
+namespace mce {
+namespace memory {
+
+namespace {
+
+// The thread-local state is constant-initialized and trivially destructible to allow using it from the
+// allocation functions at any time during the lifetime of a thread without allocating itself.
+struct thread_allocation_state {
+	allocation_counters counters;
+	allocation_zone* zone;
+};
+
+thread_local thread_allocation_state local_state{{}, nullptr};
+
+// Constant-initialized to be set before or during the dynamic initialization of the counting versions.
+bool allocation_functions_replaced = false;
+
+std::atomic<uint64_t> global_allocations{0};
+std::atomic<uint64_t> global_deallocations{0};
+std::atomic<uint64_t> global_allocated_bytes{0};
+
+std::atomic<allocation_zone*> zones{nullptr};
+
+} // namespace
+
+namespace detail {
+
+struct allocation_tracking_access {
+	static void record_allocation(uint64_t size) noexcept {
+		auto& state = local_state;
+		state.counters.allocations++;
+		state.counters.allocated_bytes += size;
+		global_allocations.fetch_add(1, std::memory_order_relaxed);
+		global_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+		if(state.zone) {
+			state.zone->allocations_.fetch_add(1, std::memory_order_relaxed);
+			state.zone->allocated_bytes_.fetch_add(size, std::memory_order_relaxed);
+		}
+	}
+	static void record_deallocation() noexcept {
+		auto& state = local_state;
+		state.counters.deallocations++;
+		global_deallocations.fetch_add(1, std::memory_order_relaxed);
+		if(state.zone) {
+			state.zone->deallocations_.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+	static void register_zone(allocation_zone* zone) noexcept {
+		auto head = zones.load(std::memory_order_relaxed);
+		do {
+			zone->next_ = head;
+		} while(!zones.compare_exchange_weak(head, zone, std::memory_order_release,
+											 std::memory_order_relaxed));
+	}
+	static std::vector<std::pair<const char*, allocation_counters>> zone_counters() {
+		std::vector<std::pair<const char*, allocation_counters>> result;
+		for(auto zone = zones.load(std::memory_order_acquire); zone; zone = zone->next_) {
+			result.emplace_back(zone->name(), zone->counters());
+		}
+		return result;
+	}
+};
+
+void mark_allocation_functions_replaced() noexcept {
+	allocation_functions_replaced = true;
+}
+
+void record_allocation(uint64_t size) noexcept {
+	allocation_tracking_access::record_allocation(size);
+}
+
+void record_deallocation() noexcept {
+	allocation_tracking_access::record_deallocation();
+}
+
+} // namespace detail
+
+bool allocation_tracking_enabled() noexcept {
+	return allocation_functions_replaced;
+}
+
+allocation_counters thread_allocation_counters() noexcept {
+	return local_state.counters;
+}
+
+allocation_counters global_allocation_counters() noexcept {
+	return {global_allocations.load(std::memory_order_relaxed),
+			global_deallocations.load(std::memory_order_relaxed),
+			global_allocated_bytes.load(std::memory_order_relaxed)};
+}
+
+allocation_zone::allocation_zone(const char* name) noexcept : name_{name} {
+	detail::allocation_tracking_access::register_zone(this);
+}
+
+void allocation_zone::reset() noexcept {
+	allocations_.store(0, std::memory_order_relaxed);
+	deallocations_.store(0, std::memory_order_relaxed);
+	allocated_bytes_.store(0, std::memory_order_relaxed);
+}
+
+allocation_zone_scope::allocation_zone_scope(allocation_zone& zone) noexcept : previous_{local_state.zone} {
+	local_state.zone = &zone;
+}
+
+allocation_zone_scope::~allocation_zone_scope() noexcept {
+	local_state.zone = previous_;
+}
+
+std::vector<std::pair<const char*, allocation_counters>> allocation_zone_counters() {
+	return detail::allocation_tracking_access::zone_counters();
+}
+
+} // namespace memory
+} // namespace mce
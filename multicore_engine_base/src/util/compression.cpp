@@ -8,6 +8,15 @@
 #include <cstdint>
 #include <cstring>
 #include <mce/util/compression.hpp>
+#include <memory>
+
+#ifdef MCE_COMPRESSION_LZ4
+#include <lz4.h>
+#include <lz4hc.h>
+#endif
+#ifdef MCE_COMPRESSION_ZSTD
+#include <zstd.h>
+#endif
 
 // The implementation of the compress and decompress functions is based on http://www.zlib.net/zlib_how.html
 
@@ -20,13 +29,16 @@ std::vector<char> compress(const std::vector<char>& input, int level) {
 	return ret;
 }
 void compress(const std::vector<char>& input, int level, std::vector<char>& out_buffer) {
+	compress(input.data(), input.size(), level, out_buffer);
+}
+void compress(const char* input, size_t input_size, int level, std::vector<char>& out_buffer) {
 	out_buffer.clear();
 	using namespace detail::zlib_wrappers;
 	{
 		zlib_deflate_stream strm(level);
-		size_t remaining_input = input.size();
+		size_t remaining_input = input_size;
 		size_t input_chunk_size = std::min(remaining_input, size_t(std::numeric_limits<unsigned int>::max()));
-		const unsigned char* input_chunk_ptr = reinterpret_cast<const unsigned char*>(input.data());
+		const unsigned char* input_chunk_ptr = reinterpret_cast<const unsigned char*>(input);
 		constexpr size_t output_chunk_size = 0x40000;
 		flush_mode flush = flush_mode::no;
 		do {
@@ -85,5 +97,203 @@ void decompress(const std::vector<char>& input, std::vector<char>& out_buffer) {
 	}
 }
 
+void decompress(const char* input, size_t input_size, char* output, size_t output_size) {
+	using namespace detail::zlib_wrappers;
+	zlib_inflate_stream strm;
+	constexpr size_t max_chunk_size = std::numeric_limits<unsigned int>::max();
+	const unsigned char* input_ptr = reinterpret_cast<const unsigned char*>(input);
+	unsigned char* output_ptr = reinterpret_cast<unsigned char*>(output);
+	size_t remaining_input = input_size;
+	size_t remaining_output = output_size;
+	// Receives the first byte beyond the expected size to detect data that is larger than expected.
+	unsigned char overflow_byte = 0;
+	bool overflow_provided = false;
+	return_code rc = return_code::ok;
+	do {
+		if(strm.input_available() == 0) {
+			if(!remaining_input) throw compression_exception("Compressed data ended unexpectedly.");
+			size_t chunk_size = std::min(remaining_input, max_chunk_size);
+			strm.provide_input(input_ptr, chunk_size);
+			input_ptr += chunk_size;
+			remaining_input -= chunk_size;
+		}
+		if(strm.output_available() == 0 && !overflow_provided) {
+			if(remaining_output) {
+				size_t chunk_size = std::min(remaining_output, max_chunk_size);
+				strm.provide_output(output_ptr, chunk_size);
+				output_ptr += chunk_size;
+				remaining_output -= chunk_size;
+			} else {
+				strm.provide_output(&overflow_byte, 1);
+				overflow_provided = true;
+			}
+		}
+		rc = strm.inflate(flush_mode::no);
+		if(rc == return_code::need_dict) zlib_check_error(return_code::error_data);
+		if(overflow_provided && strm.output_available() == 0)
+			throw compression_exception("Decompressed data is larger than expected.");
+	} while(rc != return_code::stream_end);
+	if(remaining_output || (!overflow_provided && strm.output_available()))
+		throw compression_exception("Decompressed data is smaller than expected.");
+}
+
+namespace {
+
+void check_decompressed_size(size_t actual_size, size_t expected_size) {
+	if(actual_size < expected_size)
+		throw compression_exception("Decompressed data is smaller than expected.");
+	if(actual_size > expected_size)
+		throw compression_exception("Decompressed data is larger than expected.");
+}
+
+class stored_codec final : public codec {
+public:
+	compression_codec id() const noexcept override {
+		return compression_codec::none;
+	}
+	void compress(const char* input, size_t input_size, int, std::vector<char>& out_buffer) const override {
+		out_buffer.assign(input, input + input_size);
+	}
+	void decompress(const char* input, size_t input_size, char* output, size_t output_size) const override {
+		check_decompressed_size(input_size, output_size);
+		if(input_size) std::memcpy(output, input, input_size);
+	}
+};
+
+class zlib_codec final : public codec {
+public:
+	compression_codec id() const noexcept override {
+		return compression_codec::zlib;
+	}
+	void compress(const char* input, size_t input_size, int level,
+				  std::vector<char>& out_buffer) const override {
+		util::compress(input, input_size, std::min(level, Z_BEST_COMPRESSION), out_buffer);
+	}
+	void decompress(const char* input, size_t input_size, char* output, size_t output_size) const override {
+		util::decompress(input, input_size, output, output_size);
+	}
+};
+
+#ifdef MCE_COMPRESSION_LZ4
+class lz4_codec final : public codec {
+	static int checked_int_size(size_t size) {
+		if(size > size_t(LZ4_MAX_INPUT_SIZE)) throw buffer_size_exception("Buffer too big for LZ4.");
+		return int(size);
+	}
+
+public:
+	compression_codec id() const noexcept override {
+		return compression_codec::lz4;
+	}
+	// The default level uses the fast LZ4 compressor, explicit levels use LZ4HC, which produces smaller
+	// output that decompresses at the same speed.
+	void compress(const char* input, size_t input_size, int level,
+				  std::vector<char>& out_buffer) const override {
+		int size = checked_int_size(input_size);
+		out_buffer.resize(size_t(LZ4_compressBound(size)));
+		int capacity = int(out_buffer.size());
+		int result = level < 0 ? LZ4_compress_default(input, out_buffer.data(), size, capacity)
+							   : LZ4_compress_HC(input, out_buffer.data(), size, capacity,
+												 std::min(level, LZ4HC_CLEVEL_MAX));
+		if(result <= 0) throw compression_exception("LZ4 compression failed.");
+		out_buffer.resize(size_t(result));
+	}
+	void decompress(const char* input, size_t input_size, char* output, size_t output_size) const override {
+		int result = LZ4_decompress_safe(input, output, checked_int_size(input_size),
+										 checked_int_size(output_size));
+		// A negative result also covers data that would decompress to more than output_size bytes.
+		if(result < 0) throw compression_exception("LZ4 data error.");
+		check_decompressed_size(size_t(result), output_size);
+	}
+};
+#endif
+
+#ifdef MCE_COMPRESSION_ZSTD
+class zstd_codec final : public codec {
+	struct dctx_deleter {
+		void operator()(ZSTD_DCtx* ctx) const noexcept {
+			ZSTD_freeDCtx(ctx);
+		}
+	};
+
+	static void check_error(size_t result) {
+		if(ZSTD_isError(result))
+			throw compression_exception(std::string("Zstandard error: ") + ZSTD_getErrorName(result) + ".");
+	}
+
+public:
+	compression_codec id() const noexcept override {
+		return compression_codec::zstd;
+	}
+	void compress(const char* input, size_t input_size, int level,
+				  std::vector<char>& out_buffer) const override {
+		if(level < 0) level = ZSTD_CLEVEL_DEFAULT;
+		out_buffer.resize(ZSTD_compressBound(input_size));
+		size_t result = ZSTD_compress(out_buffer.data(), out_buffer.size(), input, input_size,
+									  std::min(level, ZSTD_maxCLevel()));
+		check_error(result);
+		out_buffer.resize(result);
+	}
+	void decompress(const char* input, size_t input_size, char* output, size_t output_size) const override {
+		// Reuse one decompression context per thread instead of allocating one for every call.
+		thread_local std::unique_ptr<ZSTD_DCtx, dctx_deleter> ctx{ZSTD_createDCtx()};
+		if(!ctx) throw compression_exception("Zstandard memory error.");
+		size_t result = ZSTD_decompressDCtx(ctx.get(), output, output_size, input, input_size);
+		check_error(result);
+		check_decompressed_size(result, output_size);
+	}
+};
+#endif
+
+} // namespace
+
+bool codec_available(compression_codec id) noexcept {
+	switch(id) {
+	case compression_codec::none:
+	case compression_codec::zlib: return true;
+#ifdef MCE_COMPRESSION_LZ4
+	case compression_codec::lz4: return true;
+#endif
+#ifdef MCE_COMPRESSION_ZSTD
+	case compression_codec::zstd: return true;
+#endif
+	default: return false;
+	}
+}
+
+const codec& get_codec(compression_codec id) {
+	static const stored_codec stored;
+	static const zlib_codec zlib;
+#ifdef MCE_COMPRESSION_LZ4
+	static const lz4_codec lz4;
+#endif
+#ifdef MCE_COMPRESSION_ZSTD
+	static const zstd_codec zstd;
+#endif
+	switch(id) {
+	case compression_codec::none: return stored;
+	case compression_codec::zlib: return zlib;
+#ifdef MCE_COMPRESSION_LZ4
+	case compression_codec::lz4: return lz4;
+#endif
+#ifdef MCE_COMPRESSION_ZSTD
+	case compression_codec::zstd: return zstd;
+#endif
+	default:
+		throw compression_exception("Compression codec '" + std::string(codec_name(id)) +
+									"' is not supported by this build.");
+	}
+}
+
+const char* codec_name(compression_codec id) noexcept {
+	switch(id) {
+	case compression_codec::none: return "none";
+	case compression_codec::zlib: return "zip";
+	case compression_codec::lz4: return "lz4";
+	case compression_codec::zstd: return "zstd";
+	default: return "<invalid codec>";
+	}
+}
+
 } // namespace util
 } // namespace mce
@@ -38,6 +38,30 @@ bool equal_ignore_case(boost::string_view str_a, boost::string_view str_b) {
 	return std::equal(str_a.begin(), str_a.end(), str_b.begin(), str_b.end(),
 					  [](auto a, auto b) { return std::tolower(a) == std::tolower(b); });
 }
+bool matches_wildcard(boost::string_view str, boost::string_view pattern) {
+	size_t s = 0;
+	size_t p = 0;
+	// Positions to resume at when the part after the last * doesn't match, npos if there was no * yet.
+	size_t star_p = pattern.npos;
+	size_t star_s = 0;
+	while(s < str.size()) {
+		if(p < pattern.size() && (pattern[p] == '?' || pattern[p] == str[s])) {
+			++s;
+			++p;
+		} else if(p < pattern.size() && pattern[p] == '*') {
+			star_p = p++;
+			star_s = s;
+		} else if(star_p != pattern.npos) {
+			// Let the last * consume one more character and retry.
+			p = star_p + 1;
+			s = ++star_s;
+		} else {
+			return false;
+		}
+	}
+	while(p < pattern.size() && pattern[p] == '*') ++p;
+	return p == pattern.size();
+}
 
 boost::string_view trim_left(boost::string_view str) {
 	auto pos = str.find_first_not_of(" \t\r\n");
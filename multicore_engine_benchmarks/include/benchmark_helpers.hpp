@@ -0,0 +1,41 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_benchmarks/include/benchmark_helpers.hpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#ifndef BENCHMARK_HELPERS_HPP_
+#define BENCHMARK_HELPERS_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace mce {
+namespace benchmarks {
+
+/// Returns the maximum number of threads used by the multi-threaded benchmarks.
+inline int max_benchmark_threads() {
+	return int(std::max(std::thread::hardware_concurrency(), 1u));
+}
+
+/// Generates a reproducible sequence of pseudo-random keys in [0,max_key) for lookup benchmarks.
+inline std::vector<uint32_t> benchmark_keys(size_t count, uint32_t max_key, uint32_t seed = 1) {
+	std::vector<uint32_t> keys;
+	keys.reserve(count);
+	// xorshift32 to keep the sequence identical across standard library implementations.
+	uint32_t state = seed * 2654435761u + 1;
+	for(size_t i = 0; i < count; ++i) {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		keys.push_back(state % max_key);
+	}
+	return keys;
+}
+
+} // namespace benchmarks
+} // namespace mce
+
+#endif /* BENCHMARK_HELPERS_HPP_ */
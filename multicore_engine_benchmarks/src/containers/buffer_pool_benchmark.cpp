@@ -0,0 +1,79 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_benchmarks/src/containers/buffer_pool_benchmark.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <benchmark/benchmark.h>
+#include <benchmark_helpers.hpp>
+#include <mce/containers/byte_buffer_pool.hpp>
+#include <mce/containers/scratch_pad_pool.hpp>
+#include <memory>
+#include <vector>
+
+namespace mce {
+namespace benchmarks {
+
+static void containers_byte_buffer_pool_allocate(benchmark::State& state) {
+	static containers::byte_buffer_pool pool;
+	auto size = size_t(state.range(0));
+	for(auto _ : state) {
+		auto buffer = pool.allocate_buffer(size);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(containers_byte_buffer_pool_allocate)
+		->RangeMultiplier(16)
+		->Range(16, 1 << 16)
+		->ThreadRange(1, max_benchmark_threads())
+		->UseRealTime();
+
+static void baseline_new_byte_array(benchmark::State& state) {
+	auto size = size_t(state.range(0));
+	for(auto _ : state) {
+		auto buffer = std::make_unique<char[]>(size);
+		benchmark::DoNotOptimize(buffer.get());
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(baseline_new_byte_array)
+		->RangeMultiplier(16)
+		->Range(16, 1 << 16)
+		->ThreadRange(1, max_benchmark_threads())
+		->UseRealTime();
+
+static void containers_scratch_pad_pool_get(benchmark::State& state) {
+	static containers::scratch_pad_pool<std::vector<uint32_t>> pool;
+	auto size = size_t(state.range(0));
+	for(auto _ : state) {
+		auto scratch_pad = pool.get();
+		scratch_pad->resize(size);
+		benchmark::DoNotOptimize(scratch_pad->data());
+		scratch_pad->clear();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(containers_scratch_pad_pool_get)
+		->RangeMultiplier(16)
+		->Range(16, 1 << 16)
+		->ThreadRange(1, max_benchmark_threads())
+		->UseRealTime();
+
+static void baseline_std_vector_scratch_pad(benchmark::State& state) {
+	auto size = size_t(state.range(0));
+	for(auto _ : state) {
+		std::vector<uint32_t> scratch_pad;
+		scratch_pad.resize(size);
+		benchmark::DoNotOptimize(scratch_pad.data());
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(baseline_std_vector_scratch_pad)
+		->RangeMultiplier(16)
+		->Range(16, 1 << 16)
+		->ThreadRange(1, max_benchmark_threads())
+		->UseRealTime();
+
+} // namespace benchmarks
+} // namespace mce
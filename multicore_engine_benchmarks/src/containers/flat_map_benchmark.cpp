@@ -0,0 +1,90 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_benchmarks/src/containers/flat_map_benchmark.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <benchmark/benchmark.h>
+#include <benchmark_helpers.hpp>
+#include <boost/container/flat_map.hpp>
+#include <boost/container/small_vector.hpp>
+#include <map>
+#include <mce/containers/dual_container_map.hpp>
+#include <mce/containers/generic_flat_map.hpp>
+#include <mce/containers/split_flat_map.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace mce {
+namespace benchmarks {
+
+namespace {
+
+template <typename T>
+using vector = std::vector<T>;
+template <typename T>
+using small_vector = boost::container::small_vector<T, 16>;
+
+// The lookups alternate between present and absent keys by drawing from twice the key range.
+template <typename Map>
+void map_lookup_benchmark(benchmark::State& state) {
+	auto size = uint32_t(state.range(0));
+	Map map;
+	for(uint32_t i = 0; i < size; ++i) {
+		map.insert_or_assign(i * 2, i);
+	}
+	auto keys = benchmark_keys(1024, size * 4);
+	for(auto _ : state) {
+		uint32_t found = 0;
+		for(auto key : keys) {
+			found += map.find(key) != map.end();
+		}
+		benchmark::DoNotOptimize(found);
+	}
+	state.SetItemsProcessed(state.iterations() * int64_t(keys.size()));
+}
+
+template <typename Map>
+void map_insert_benchmark(benchmark::State& state) {
+	auto size = uint32_t(state.range(0));
+	auto keys = benchmark_keys(size, size * 4);
+	for(auto _ : state) {
+		Map map;
+		for(auto key : keys) {
+			map.insert_or_assign(key, key);
+		}
+		benchmark::DoNotOptimize(map);
+	}
+	state.SetItemsProcessed(state.iterations() * int64_t(size));
+}
+
+using generic_flat_map_type = containers::generic_flat_map<vector, uint32_t, uint32_t>;
+using dual_container_map_type = containers::dual_container_map<vector, uint32_t, uint32_t>;
+using split_flat_map_type = containers::split_flat_map<vector, uint32_t, uint32_t>;
+using small_generic_flat_map_type = containers::generic_flat_map<small_vector, uint32_t, uint32_t>;
+using small_split_flat_map_type = containers::split_flat_map<small_vector, uint32_t, uint32_t>;
+using boost_flat_map_type = boost::container::flat_map<uint32_t, uint32_t>;
+using std_map_type = std::map<uint32_t, uint32_t>;
+using std_unordered_map_type = std::unordered_map<uint32_t, uint32_t>;
+
+} // namespace
+
+BENCHMARK_TEMPLATE(map_lookup_benchmark, generic_flat_map_type)->RangeMultiplier(4)->Range(4, 4096);
+BENCHMARK_TEMPLATE(map_lookup_benchmark, dual_container_map_type)->RangeMultiplier(4)->Range(4, 4096);
+BENCHMARK_TEMPLATE(map_lookup_benchmark, split_flat_map_type)->RangeMultiplier(4)->Range(4, 4096);
+// Small maps with inline storage, for which split_flat_map is intended.
+BENCHMARK_TEMPLATE(map_lookup_benchmark, small_generic_flat_map_type)->RangeMultiplier(2)->Range(1, 64);
+BENCHMARK_TEMPLATE(map_lookup_benchmark, small_split_flat_map_type)->RangeMultiplier(2)->Range(1, 64);
+BENCHMARK_TEMPLATE(map_lookup_benchmark, boost_flat_map_type)->RangeMultiplier(4)->Range(4, 4096);
+BENCHMARK_TEMPLATE(map_lookup_benchmark, std_map_type)->RangeMultiplier(4)->Range(4, 4096);
+BENCHMARK_TEMPLATE(map_lookup_benchmark, std_unordered_map_type)->RangeMultiplier(4)->Range(4, 4096);
+
+BENCHMARK_TEMPLATE(map_insert_benchmark, generic_flat_map_type)->RangeMultiplier(4)->Range(4, 4096);
+BENCHMARK_TEMPLATE(map_insert_benchmark, dual_container_map_type)->RangeMultiplier(4)->Range(4, 4096);
+BENCHMARK_TEMPLATE(map_insert_benchmark, split_flat_map_type)->RangeMultiplier(4)->Range(4, 4096);
+BENCHMARK_TEMPLATE(map_insert_benchmark, boost_flat_map_type)->RangeMultiplier(4)->Range(4, 4096);
+BENCHMARK_TEMPLATE(map_insert_benchmark, std_map_type)->RangeMultiplier(4)->Range(4, 4096);
+BENCHMARK_TEMPLATE(map_insert_benchmark, std_unordered_map_type)->RangeMultiplier(4)->Range(4, 4096);
+
+} // namespace benchmarks
+} // namespace mce
@@ -0,0 +1,131 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_benchmarks/src/containers/object_pool_benchmark.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <benchmark/benchmark.h>
+#include <benchmark_helpers.hpp>
+#include <mce/containers/simple_smart_object_pool.hpp>
+#include <mce/containers/smart_object_pool.hpp>
+#include <mce/containers/unordered_object_pool.hpp>
+#include <memory>
+#include <vector>
+
+namespace mce {
+namespace benchmarks {
+
+namespace {
+
+struct pooled_object {
+	uint64_t data[4];
+	explicit pooled_object(uint64_t value) noexcept : data{value, value, value, value} {}
+};
+
+constexpr int objects_per_iteration = 64;
+
+} // namespace
+
+static void containers_smart_object_pool_emplace_release(benchmark::State& state) {
+	static containers::smart_object_pool<pooled_object> pool;
+	std::vector<containers::smart_pool_ptr<pooled_object>> objects;
+	objects.reserve(objects_per_iteration);
+	for(auto _ : state) {
+		for(int i = 0; i < objects_per_iteration; ++i) {
+			objects.push_back(pool.emplace(uint64_t(i)));
+		}
+		benchmark::DoNotOptimize(objects.data());
+		objects.clear();
+	}
+	state.SetItemsProcessed(state.iterations() * objects_per_iteration);
+}
+BENCHMARK(containers_smart_object_pool_emplace_release)
+		->ThreadRange(1, max_benchmark_threads())
+		->UseRealTime();
+
+static void containers_simple_smart_object_pool_emplace_release(benchmark::State& state) {
+	// process_pending can't run concurrently with emplace, therefore each thread uses its own pool and
+	// processes the pending changes after each batch like a single-writer phase would.
+	containers::simple_smart_object_pool<pooled_object> pool;
+	std::vector<std::shared_ptr<pooled_object>> objects;
+	objects.reserve(objects_per_iteration);
+	for(auto _ : state) {
+		for(int i = 0; i < objects_per_iteration; ++i) {
+			objects.push_back(pool.emplace(uint64_t(i)));
+		}
+		pool.process_pending();
+		benchmark::DoNotOptimize(objects.data());
+		objects.clear();
+		pool.process_pending();
+	}
+	state.SetItemsProcessed(state.iterations() * objects_per_iteration);
+}
+BENCHMARK(containers_simple_smart_object_pool_emplace_release)
+		->ThreadRange(1, max_benchmark_threads())
+		->UseRealTime();
+
+static void baseline_std_make_shared_release(benchmark::State& state) {
+	std::vector<std::shared_ptr<pooled_object>> objects;
+	objects.reserve(objects_per_iteration);
+	for(auto _ : state) {
+		for(int i = 0; i < objects_per_iteration; ++i) {
+			objects.push_back(std::make_shared<pooled_object>(uint64_t(i)));
+		}
+		benchmark::DoNotOptimize(objects.data());
+		objects.clear();
+	}
+	state.SetItemsProcessed(state.iterations() * objects_per_iteration);
+}
+BENCHMARK(baseline_std_make_shared_release)->ThreadRange(1, max_benchmark_threads())->UseRealTime();
+
+static void containers_unordered_object_pool_emplace_erase(benchmark::State& state) {
+	containers::unordered_object_pool<pooled_object> pool;
+	std::vector<containers::unordered_object_pool<pooled_object>::iterator> objects;
+	objects.reserve(objects_per_iteration);
+	for(auto _ : state) {
+		for(int i = 0; i < objects_per_iteration; ++i) {
+			objects.push_back(pool.emplace(uint64_t(i)));
+		}
+		for(auto& object : objects) {
+			pool.erase(object);
+		}
+		objects.clear();
+	}
+	state.SetItemsProcessed(state.iterations() * objects_per_iteration);
+}
+BENCHMARK(containers_unordered_object_pool_emplace_erase);
+
+static void containers_unordered_object_pool_iterate(benchmark::State& state) {
+	containers::unordered_object_pool<pooled_object> pool;
+	for(int64_t i = 0; i < state.range(0); ++i) {
+		pool.emplace(uint64_t(i));
+	}
+	for(auto _ : state) {
+		uint64_t sum = 0;
+		for(auto& object : pool) {
+			sum += object.data[0];
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(containers_unordered_object_pool_iterate)->Range(64, 1 << 16);
+
+static void baseline_std_vector_iterate(benchmark::State& state) {
+	std::vector<pooled_object> objects;
+	for(int64_t i = 0; i < state.range(0); ++i) {
+		objects.emplace_back(uint64_t(i));
+	}
+	for(auto _ : state) {
+		uint64_t sum = 0;
+		for(auto& object : objects) {
+			sum += object.data[0];
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(baseline_std_vector_iterate)->Range(64, 1 << 16);
+
+} // namespace benchmarks
+} // namespace mce
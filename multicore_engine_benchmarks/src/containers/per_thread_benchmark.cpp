@@ -0,0 +1,77 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_benchmarks/src/containers/per_thread_benchmark.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <benchmark/benchmark.h>
+#include <benchmark_helpers.hpp>
+#include <mce/containers/per_thread.hpp>
+#include <tbb/enumerable_thread_specific.h>
+
+namespace mce {
+namespace benchmarks {
+
+namespace {
+
+// Padded to keep the baselines free of false sharing like the per_thread objects in the engine.
+struct alignas(64) counter {
+	uint64_t value = 0;
+};
+
+constexpr int accesses_per_iteration = 64;
+
+} // namespace
+
+static void containers_per_thread_get(benchmark::State& state) {
+	static containers::per_thread<counter> values{size_t(max_benchmark_threads())};
+	for(auto _ : state) {
+		for(int i = 0; i < accesses_per_iteration; ++i) {
+			values.get().value++;
+			benchmark::ClobberMemory();
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * accesses_per_iteration);
+}
+BENCHMARK(containers_per_thread_get)->ThreadRange(1, max_benchmark_threads())->UseRealTime();
+
+static void containers_per_thread_growable_get(benchmark::State& state) {
+	static containers::per_thread<counter> values(containers::growable_slots_tag{}, 1);
+	for(auto _ : state) {
+		for(int i = 0; i < accesses_per_iteration; ++i) {
+			values.get().value++;
+			benchmark::ClobberMemory();
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * accesses_per_iteration);
+}
+BENCHMARK(containers_per_thread_growable_get)->ThreadRange(1, max_benchmark_threads())->UseRealTime();
+
+static void baseline_tbb_enumerable_thread_specific_local(benchmark::State& state) {
+	static tbb::enumerable_thread_specific<counter> values;
+	for(auto _ : state) {
+		for(int i = 0; i < accesses_per_iteration; ++i) {
+			values.local().value++;
+			benchmark::ClobberMemory();
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * accesses_per_iteration);
+}
+BENCHMARK(baseline_tbb_enumerable_thread_specific_local)
+		->ThreadRange(1, max_benchmark_threads())
+		->UseRealTime();
+
+static void baseline_thread_local(benchmark::State& state) {
+	static thread_local counter value;
+	for(auto _ : state) {
+		for(int i = 0; i < accesses_per_iteration; ++i) {
+			value.value++;
+			benchmark::ClobberMemory();
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * accesses_per_iteration);
+}
+BENCHMARK(baseline_thread_local)->ThreadRange(1, max_benchmark_threads())->UseRealTime();
+
+} // namespace benchmarks
+} // namespace mce
@@ -0,0 +1,56 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_benchmarks/src/util/copy_on_write_benchmark.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <benchmark/benchmark.h>
+#include <benchmark_helpers.hpp>
+#include <mce/util/copy_on_write.hpp>
+#include <mce/util/epoch_copy_on_write.hpp>
+#include <vector>
+
+namespace mce {
+namespace benchmarks {
+
+namespace {
+
+constexpr int reads_per_iteration = 64;
+constexpr int iterations_per_write = 1024;
+
+// All threads read the current version, the first thread additionally replaces it periodically to keep the
+// reclamation paths of the containers busy.
+template <typename Cow>
+void cow_read_benchmark(benchmark::State& state) {
+	static Cow cow;
+	int writes_due = iterations_per_write;
+	for(auto _ : state) {
+		for(int i = 0; i < reads_per_iteration; ++i) {
+			auto size = cow.get()->size();
+			benchmark::DoNotOptimize(size);
+		}
+		if(state.thread_index() == 0 && --writes_due == 0) {
+			cow.do_transaction([](std::vector<int>& v) {
+				if(v.size() >= 64) v.clear();
+				v.push_back(int(v.size()));
+			});
+			writes_due = iterations_per_write;
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * reads_per_iteration);
+}
+
+using shared_ptr_cow = util::copy_on_write<std::vector<int>>;
+using epoch_cow = util::epoch_copy_on_write<std::vector<int>>;
+
+} // namespace
+
+BENCHMARK_TEMPLATE(cow_read_benchmark, shared_ptr_cow)
+		->ThreadRange(1, max_benchmark_threads())
+		->UseRealTime();
+BENCHMARK_TEMPLATE(cow_read_benchmark, epoch_cow)
+		->ThreadRange(1, max_benchmark_threads())
+		->UseRealTime();
+
+} // namespace benchmarks
+} // namespace mce
@@ -0,0 +1,70 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_benchmarks/src/util/message_queue_benchmark.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <benchmark/benchmark.h>
+#include <benchmark_helpers.hpp>
+#include <mce/util/bounded_message_queue.hpp>
+#include <mce/util/message_queue.hpp>
+#include <mce/util/spin_lock.hpp>
+#include <mutex>
+#include <tbb/concurrent_queue.h>
+
+namespace mce {
+namespace benchmarks {
+
+namespace {
+
+constexpr int messages_per_iteration = 64;
+
+// Each thread pushes a batch of messages and pops the same number, so that the queue stays small while all
+// threads contend on it.
+template <typename Queue>
+void queue_push_pop_benchmark(benchmark::State& state) {
+	static Queue queue;
+	for(auto _ : state) {
+		for(int i = 0; i < messages_per_iteration; ++i) {
+			queue.push(i);
+		}
+		int value = 0;
+		for(int i = 0; i < messages_per_iteration; ++i) {
+			while(!queue.try_pop(value))
+				;
+		}
+		benchmark::DoNotOptimize(value);
+	}
+	state.SetItemsProcessed(state.iterations() * messages_per_iteration);
+}
+
+using spin_lock_queue = util::message_queue<int, util::spin_lock>;
+using adaptive_spin_lock_queue = util::message_queue<int, util::adaptive_spin_lock>;
+using mutex_queue = util::message_queue<int, std::mutex>;
+using tbb_queue = tbb::concurrent_queue<int>;
+
+// The capacity leaves room for the messages of all threads.
+struct bounded_queue : util::bounded_message_queue<int> {
+	bounded_queue() : bounded_message_queue(1024 * 64) {}
+};
+
+} // namespace
+
+BENCHMARK_TEMPLATE(queue_push_pop_benchmark, spin_lock_queue)
+		->ThreadRange(1, max_benchmark_threads())
+		->UseRealTime();
+BENCHMARK_TEMPLATE(queue_push_pop_benchmark, adaptive_spin_lock_queue)
+		->ThreadRange(1, max_benchmark_threads())
+		->UseRealTime();
+BENCHMARK_TEMPLATE(queue_push_pop_benchmark, mutex_queue)
+		->ThreadRange(1, max_benchmark_threads())
+		->UseRealTime();
+BENCHMARK_TEMPLATE(queue_push_pop_benchmark, bounded_queue)
+		->ThreadRange(1, max_benchmark_threads())
+		->UseRealTime();
+BENCHMARK_TEMPLATE(queue_push_pop_benchmark, tbb_queue)
+		->ThreadRange(1, max_benchmark_threads())
+		->UseRealTime();
+
+} // namespace benchmarks
+} // namespace mce
@@ -0,0 +1,61 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_benchmarks/src/util/ring_chunk_placer_benchmark.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <mce/util/ring_chunk_placer.hpp>
+#include <memory>
+#include <vector>
+
+namespace mce {
+namespace benchmarks {
+
+// Places chunks of the given size and frees all but the most recent chunk when the buffer is full, which
+// mimics staging buffers where the chunks of the frame in flight are still in use.
+static void util_ring_chunk_placer_place_chunk(benchmark::State& state) {
+	const size_t buffer_size = 1 << 20;
+	auto buffer = std::make_unique<char[]>(buffer_size);
+	std::vector<char> data(size_t(state.range(0)), 'x');
+	util::ring_chunk_placer placer(buffer.get(), buffer_size);
+	const void* previous_chunk_end = placer.in_position();
+	const void* last_chunk_end = previous_chunk_end;
+	for(auto _ : state) {
+		auto chunk = placer.place_chunk(data.data(), data.size(), 16);
+		if(!chunk) {
+			placer.free_to(previous_chunk_end);
+			chunk = placer.place_chunk(data.data(), data.size(), 16);
+			if(!chunk) {
+				state.SkipWithError("Chunk could not be placed after freeing.");
+				break;
+			}
+		}
+		benchmark::DoNotOptimize(chunk);
+		previous_chunk_end = last_chunk_end;
+		last_chunk_end = placer.in_position();
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(util_ring_chunk_placer_place_chunk)->RangeMultiplier(8)->Range(16, 1 << 16);
+
+// Uses a bump pointer over the same buffer as the lower bound for placing the chunks.
+static void baseline_memcpy_bump_pointer(benchmark::State& state) {
+	const size_t buffer_size = 1 << 20;
+	auto buffer = std::make_unique<char[]>(buffer_size);
+	std::vector<char> data(size_t(state.range(0)), 'x');
+	size_t position = 0;
+	for(auto _ : state) {
+		position = (position + 15) & ~size_t(15);
+		if(position + data.size() > buffer_size) position = 0;
+		std::memcpy(buffer.get() + position, data.data(), data.size());
+		benchmark::DoNotOptimize(buffer.get() + position);
+		position += data.size();
+	}
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(baseline_memcpy_bump_pointer)->RangeMultiplier(8)->Range(16, 1 << 16);
+
+} // namespace benchmarks
+} // namespace mce
@@ -0,0 +1,61 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_benchmarks/src/util/spin_lock_benchmark.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <benchmark/benchmark.h>
+#include <benchmark_helpers.hpp>
+#include <mce/util/spin_lock.hpp>
+#include <mutex>
+
+namespace mce {
+namespace benchmarks {
+
+namespace {
+
+// The critical section increments a counter that is shared by all threads, the argument specifies the
+// number of additional increments of a thread-local counter outside of the critical section. The largest
+// thread count oversubscribes the cores, which shows how the locks behave when lock holders are preempted.
+template <typename Lock>
+void lock_benchmark(benchmark::State& state) {
+	static Lock lock;
+	static uint64_t shared_counter = 0;
+	auto outside_work = state.range(0);
+	uint64_t local_counter = 0;
+	for(auto _ : state) {
+		{
+			std::lock_guard<Lock> guard(lock);
+			shared_counter++;
+		}
+		for(int64_t i = 0; i < outside_work; ++i) {
+			local_counter++;
+			benchmark::DoNotOptimize(local_counter);
+		}
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(lock_benchmark, util::spin_lock)
+		->Arg(0)
+		->Arg(100)
+		->ThreadRange(1, max_benchmark_threads())
+		->Threads(2 * max_benchmark_threads())
+		->UseRealTime();
+BENCHMARK_TEMPLATE(lock_benchmark, util::adaptive_spin_lock)
+		->Arg(0)
+		->Arg(100)
+		->ThreadRange(1, max_benchmark_threads())
+		->Threads(2 * max_benchmark_threads())
+		->UseRealTime();
+BENCHMARK_TEMPLATE(lock_benchmark, std::mutex)
+		->Arg(0)
+		->Arg(100)
+		->ThreadRange(1, max_benchmark_threads())
+		->Threads(2 * max_benchmark_threads())
+		->UseRealTime();
+
+} // namespace benchmarks
+} // namespace mce
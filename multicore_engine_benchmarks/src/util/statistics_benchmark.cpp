@@ -0,0 +1,37 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_benchmarks/src/util/statistics_benchmark.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <benchmark_helpers.hpp>
+#include <mce/util/statistics.hpp>
+
+namespace mce {
+namespace benchmarks {
+
+static void util_aggregate_statistic_record(benchmark::State& state) {
+	static util::aggregate_statistic<int64_t> statistic;
+	int64_t value = state.thread_index();
+	for(auto _ : state) {
+		statistic.record(value++);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(util_aggregate_statistic_record)->ThreadRange(1, max_benchmark_threads())->UseRealTime();
+
+// Only maintains the sum, which is the minimum cost of any shared aggregate.
+static void baseline_atomic_fetch_add(benchmark::State& state) {
+	static std::atomic<int64_t> sum{0};
+	int64_t value = state.thread_index();
+	for(auto _ : state) {
+		sum.fetch_add(value++, std::memory_order_relaxed);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(baseline_atomic_fetch_add)->ThreadRange(1, max_benchmark_threads())->UseRealTime();
+
+} // namespace benchmarks
+} // namespace mce
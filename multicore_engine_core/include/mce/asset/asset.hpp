@@ -56,6 +56,12 @@ private:
 	std::vector<asset_completion_handler> completion_handlers;
 	std::vector<error_handler> error_handlers;
 	mutable std::condition_variable completed_cv;
+	// Tick of the asset_manager access clock at the last request of the asset, used for LRU eviction.
+	std::atomic<uint64_t> last_use_{0};
+	// Guarded by the load queue mutex of the asset_manager: The number of requests waiting in the load queue
+	// and whether the waiting load was skipped because all of them were cancelled.
+	unsigned int queued_requests_ = 0;
+	bool abandoned_ = false;
 
 public:
 	/// \brief Creates an asset object with the given name. Should only be used within the asset system but
@@ -0,0 +1,76 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/include/mce/asset/asset_cache_statistic.hpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#ifndef MCE_ASSET_ASSET_CACHE_STATISTIC_HPP_
+#define MCE_ASSET_ASSET_CACHE_STATISTIC_HPP_
+
+/**
+ * \file
+ * Defines a statistic that outputs the cache counters of an asset_manager.
+ */
+
+#include <mce/asset/asset_manager.hpp>
+#include <mce/util/statistics.hpp>
+#include <ostream>
+
+namespace mce {
+namespace asset {
+
+/// Outputs the hit rate, eviction counters and resident bytes of the cache of an asset_manager.
+/**
+ * The statistic references the asset_manager and must not be evaluated after it was destroyed. Clearing the
+ * statistic resets the request and eviction counters of the asset_manager.
+ */
+class asset_cache_statistic : public util::statistic_base<7> {
+	asset_manager& manager;
+
+public:
+	/// Creates an asset_cache_statistic for the given asset_manager.
+	explicit asset_cache_statistic(asset_manager& manager)
+			: statistic_base{{{"", "hits", "misses", "hit_rate", "evictions", "evicted_bytes",
+							   "resident_bytes", "budget", ""}}},
+			  manager{manager} {}
+
+	/// Resets the request and eviction counters of the asset_manager.
+	void clear() noexcept {
+		manager.reset_cache_statistics();
+	}
+
+	/// Encapsulates a statistics evaluation result.
+	struct result {
+		asset_cache_statistics counters; ///< The counters of the cache.
+		label_set labels;				 ///< The labels used on output.
+
+		/// Outputs the formated result to the given stream using the given separator.
+		void output_to(std::ostream& ostr, const char* separator = ";", bool suppress_header = false,
+					   bool suppress_footer = false) const {
+			if(!suppress_header) labels.output_header(ostr, separator);
+			labels.output_prefix(ostr, separator);
+			const auto& c = counters;
+			ostr << c.hits << separator << c.misses << separator << c.hit_rate() << separator << c.evictions
+				 << separator << c.evicted_bytes << separator << c.resident_bytes << separator << c.budget;
+			labels.output_suffix(ostr, separator);
+			ostr << "\n";
+			if(!suppress_footer) labels.output_footer(ostr, separator);
+		}
+
+		/// Allows outputting the result data to an ostream.
+		friend std::ostream& operator<<(std::ostream& ostr, const result& res) {
+			res.output_to(ostr);
+			return ostr;
+		}
+	};
+
+	/// Evaluates the current counters of the cache.
+	result evaluate() const {
+		return {manager.cache_statistics(), *labels()};
+	}
+};
+
+} // namespace asset
+} // namespace mce
+
+#endif /* MCE_ASSET_ASSET_CACHE_STATISTIC_HPP_ */
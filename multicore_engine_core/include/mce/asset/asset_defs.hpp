@@ -12,6 +12,7 @@
  * Provides type definitions for the asset system.
  */
 
+#include <atomic>
 #include <cstdint>
 #include <exception>
 #include <mce/util/local_function.hpp>
@@ -39,10 +40,47 @@ typedef util::local_function<128, void(const asset_ptr& asset)> asset_completion
 typedef std::shared_ptr<const char> file_content_ptr;
 /// Type for size values of files.
 typedef size_t file_size;
+/// Definition for completion handler callbacks used when files have been read.
+typedef util::local_function<128, void(const file_content_ptr& content, file_size size)>
+		file_read_completion_handler;
 
 /// Definition for callbacks used when errors are encountered while loading assets or load units.
 typedef util::local_function<128, void(std::exception_ptr)> error_handler;
 
+/// Specifies the urgency of an asynchronous asset request.
+/**
+ * Pending loads are started in the order of their priority and in request order within a priority. A load
+ * that is requested again at a higher priority while still waiting is promoted to that priority.
+ */
+enum class load_priority : uint8_t {
+	immediate, ///< Needed for the current frame, e.g. content in view of the camera.
+	high,	   ///< Needed soon, e.g. content close to the view.
+	normal,	   ///< The default priority.
+	background ///< Speculative prefetching, only started when nothing more urgent is waiting.
+};
+
+/// Allows cancelling the asset requests that were issued with it.
+/**
+ * Copies of a token share their state, cancelling one of them cancels the requests made with any copy.
+ * Cancelled requests don't call their completion handler but their error handler with an
+ * operation_cancelled_exception. A waiting load is skipped if all requests for it were cancelled.
+ */
+class load_cancellation_token {
+	std::shared_ptr<std::atomic<bool>> cancelled_;
+
+public:
+	/// Creates a token that is not cancelled.
+	load_cancellation_token() : cancelled_{std::make_shared<std::atomic<bool>>(false)} {}
+	/// Cancels the requests made with this token.
+	void cancel() noexcept {
+		cancelled_->store(true);
+	}
+	/// Checks if the token was cancelled.
+	bool cancelled() const noexcept {
+		return cancelled_->load();
+	}
+};
+
 } // namespace asset
 } // namespace mce
 
@@ -40,6 +40,9 @@ protected:
 	/// Provides implementations with a way to launch arbitrary task function objects on the asset_manager.
 	template <typename F>
 	static void launch_async_task(asset_manager& asset_manager, F&& f);
+	/// \brief Provides implementations with a way to keep the worker threads of the asset_manager running
+	/// until the returned object is destroyed, e.g. while a reader may still launch the completion of a load.
+	static std::shared_ptr<void> keep_task_pool_running(asset_manager& asset_manager);
 	/// \brief Provides implementations with a way to complete the loading process of the given asset with the
 	/// given content.
 	static void finish_loading(const std::shared_ptr<mce::asset::asset>& asset, const file_content_ptr& data,
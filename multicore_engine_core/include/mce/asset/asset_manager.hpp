@@ -13,16 +13,24 @@
  */
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <boost/container/vector.hpp>
+#include <cstdint>
+#include <deque>
 #include <exception>
+#include <limits>
 #include <mce/asset/asset_defs.hpp>
+#include <mce/containers/concurrent_hash_map.hpp>
 #include <mce/exceptions.hpp>
-#include <mce/util/copy_on_write.hpp>
+#include <mce/util/epoch_copy_on_write.hpp>
+#include <mce/util/symbol.hpp>
 #include <memory>
 #include <mutex>
-#include <shared_mutex>
+#include <optional>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #ifdef _MSC_VER
@@ -31,7 +39,6 @@
 #pragma warning(disable : 4005)
 #endif
 
-#include <boost/container/flat_map.hpp>
 #include <boost/thread/future.hpp>
 #include <mce/asset/cleaned_asio_ioservice.hpp>
 
@@ -44,36 +51,83 @@ namespace asset {
 class asset_loader;
 class asset;
 
+/// Snapshot of the counters of the asset cache of an asset_manager.
+struct asset_cache_statistics {
+	uint64_t hits = 0;			 ///< Requests for assets that already had a cache entry.
+	uint64_t misses = 0;		 ///< Requests that created a new cache entry.
+	uint64_t evictions = 0;		 ///< Loaded assets removed from the cache by eviction or start_clean.
+	uint64_t evicted_bytes = 0;	 ///< The total size of the removed assets.
+	uint64_t resident_bytes = 0; ///< The total size of the loaded assets currently held by the cache.
+	uint64_t budget = 0;		 ///< The configured byte budget of the cache.
+
+	/// Returns the fraction of requests that were served from the cache or 0 if there were no requests.
+	double hit_rate() const noexcept {
+		auto requests = hits + misses;
+		return requests ? double(hits) / double(requests) : 0.0;
+	}
+};
+
 /// Manages the loading and retention of asset data in the engine.
 class asset_manager {
-	util::copy_on_write<std::vector<std::shared_ptr<asset_loader>>> asset_loaders;
-	std::shared_timed_mutex loaded_assets_rw_lock;
-	boost::container::flat_map<std::string, std::shared_ptr<asset>> loaded_assets;
+	util::epoch_copy_on_write<std::vector<std::shared_ptr<asset_loader>>> asset_loaders;
+	containers::concurrent_hash_map<util::symbol, std::shared_ptr<asset>> loaded_assets;
 	boost::asio::io_service task_pool;
 	std::vector<std::thread> workers;
 	std::unique_ptr<boost::asio::io_service::work> work;
+	// The number of cached assets sampled to select each asset evicted to get back into the budget.
+	static constexpr size_t eviction_sample_size = 16;
+	std::atomic<uint64_t> access_clock{0};
+	std::atomic<uint64_t> cache_budget_{std::numeric_limits<uint64_t>::max()};
+	std::atomic<uint64_t> resident_bytes{0};
+	std::atomic<uint64_t> cache_hits{0};
+	std::atomic<uint64_t> cache_misses{0};
+	std::atomic<uint64_t> evictions{0};
+	std::atomic<uint64_t> evicted_bytes{0};
+	std::atomic<bool> eviction_pending{false};
+
+	struct pending_load {
+		util::symbol name;
+		std::shared_ptr<asset> asset_to_load;
+		std::optional<load_cancellation_token> token;
+	};
+	std::mutex load_queue_mutex;
+	std::array<std::deque<pending_load>, 4> load_queues;
 
-	struct future_load_task {
-		std::shared_ptr<boost::promise<std::shared_ptr<const asset>>> promise;
-		std::string name;
-		asset_manager* manager;
-		// cppcheck-suppress passedByValue
-		future_load_task(std::string name, asset_manager* manager)
-				: promise(std::make_shared<boost::promise<std::shared_ptr<const asset>>>()),
-				  name{std::move(name)}, manager{manager} {}
-		void operator()();
+	template <typename F, typename E>
+	struct multi_load_state {
+		std::vector<std::shared_ptr<const asset>> assets;
+		std::atomic<size_t> pending;
+		std::atomic<bool> failed{false};
+		F completion_handler;
+		E error_handler;
+		multi_load_state(size_t count, F&& completion_handler, E&& error_handler)
+				: assets(count), pending{count}, completion_handler(std::move(completion_handler)),
+				  error_handler(std::move(error_handler)) {}
 	};
-	std::shared_ptr<const asset> load_asset_sync_core(const std::string& name);
-	std::shared_ptr<const asset> call_loaders_sync(const std::shared_ptr<asset>& asset_to_load);
+	std::shared_ptr<asset> create_cached_asset(util::symbol name);
+	void note_cache_access(asset& cached_asset, bool inserted) noexcept;
+	void note_resident(uint64_t size);
+	void note_removed(const asset& removed_asset) noexcept;
+	void evict_to_budget();
+	bool enqueue_load(util::symbol name, const std::shared_ptr<asset>& asset_to_load, load_priority priority,
+					  const load_cancellation_token* token);
+	void discard_abandoned(util::symbol name, const std::shared_ptr<asset>& abandoned_asset);
+	void dispatch_load();
+	void start_load(const std::shared_ptr<asset>& asset_to_load);
+	template <typename F, typename E>
+	std::shared_ptr<const asset> load_asset_async_core(util::symbol name, F completion_handler,
+													   E error_handler, load_priority priority,
+													   const load_cancellation_token* token);
+	std::shared_ptr<const asset> call_loaders_sync(const std::shared_ptr<asset>& asset_to_load, bool owned);
 
 public:
 	friend class asset_loader;
 	/// Initializes the asset_manager.
 	/**
-	 * Spawns worker threads for asynchronous tasks like asset loading and the corresponding completion
-	 * handlers.
+	 * Spawns the given number of worker threads for asynchronous tasks like asset loading and the
+	 * corresponding completion handlers, 0 selects twice the number of hardware threads.
 	 */
-	asset_manager();
+	explicit asset_manager(unsigned int worker_thread_count = 0);
 	/// Waits for all pending asynchronous tasks to complete and destroys the asset manager.
 	~asset_manager();
 	/// Forbids copying an asset_manager.
@@ -81,21 +135,117 @@ public:
 	/// Forbids copying an asset_manager.
 	asset_manager& operator=(const asset_manager&) = delete;
 	/// Asynchronously load the given asset and run the given completion handler when it is loaded.
+	/**
+	 * The overloads taking the name as a std::string intern it as a util::symbol. Callers that request the
+	 * same asset repeatedly should keep the symbol and use the overloads taking it to avoid the interning.
+	 */
 	template <typename F>
-	std::shared_ptr<const asset> load_asset_async(const std::string& name, F&& completion_handler) {
+	std::shared_ptr<const asset> load_asset_async(util::symbol name, F&& completion_handler) {
 		return load_asset_async(name, std::forward<F>(completion_handler), [](std::exception_ptr) {});
 	}
-	/// \brief Asynchronously load the given asset and run the given completion handler when it is loaded and
-	/// use the given error handler when loading fails.
+	/// Asynchronously load the given asset and run the given completion handler when it is loaded.
+	template <typename F>
+	std::shared_ptr<const asset> load_asset_async(const std::string& name, F&& completion_handler) {
+		return load_asset_async(util::symbol(name), std::forward<F>(completion_handler));
+	}
+	/// \brief Asynchronously load the given asset with the given priority and run the given completion
+	/// handler when it is loaded and use the given error handler when loading fails.
+	template <typename F, typename E>
+	std::shared_ptr<const asset> load_asset_async(util::symbol name, F completion_handler, E error_handler,
+												  load_priority priority = load_priority::normal) {
+		return load_asset_async_core(name, std::move(completion_handler), std::move(error_handler), priority,
+									 nullptr);
+	}
+	/// \brief Asynchronously load the given asset with the given priority and run the given completion
+	/// handler when it is loaded and use the given error handler when loading fails or the request is
+	/// cancelled using the given token.
+	template <typename F, typename E>
+	std::shared_ptr<const asset> load_asset_async(util::symbol name, F completion_handler, E error_handler,
+												  load_priority priority,
+												  const load_cancellation_token& token) {
+		return load_asset_async_core(name, std::move(completion_handler), std::move(error_handler), priority,
+									 &token);
+	}
+	/// \brief Asynchronously load the given asset with the given priority and run the given completion
+	/// handler when it is loaded and use the given error handler when loading fails.
 	template <typename F, typename E>
 	std::shared_ptr<const asset> load_asset_async(const std::string& name, F completion_handler,
-												  E error_handler);
+												  E error_handler,
+												  load_priority priority = load_priority::normal) {
+		return load_asset_async(util::symbol(name), std::move(completion_handler), std::move(error_handler),
+								priority);
+	}
+	/// \brief Asynchronously load the given asset with the given priority and run the given completion
+	/// handler when it is loaded and use the given error handler when loading fails or the request is
+	/// cancelled using the given token.
+	template <typename F, typename E>
+	std::shared_ptr<const asset> load_asset_async(const std::string& name, F completion_handler,
+												  E error_handler, load_priority priority,
+												  const load_cancellation_token& token) {
+		return load_asset_async(util::symbol(name), std::move(completion_handler), std::move(error_handler),
+								priority, token);
+	}
+	/// \brief Asynchronously load all of the given assets and run the given completion handler once when all
+	/// of them are loaded or the given error handler once when loading any of them fails.
+	/**
+	 * The completion handler must have the signature <code>void(std::vector<asset_ptr> assets)</code> and
+	 * receives the assets in the order of the given names. The error_handler function object must have the
+	 * signature <code>void(std::exception_ptr)</code> and receives the first error. No thread is blocked
+	 * while waiting, the handlers are run by the thread completing the last asset or reporting the first
+	 * error, like the handlers of load_asset_async. Unlike those, these handlers don't need to fit into the
+	 * handler wrapper types, because they are only stored once for all assets.
+	 */
+	template <typename F, typename E>
+	void load_assets_async(const std::vector<util::symbol>& names, F completion_handler, E error_handler,
+						   load_priority priority = load_priority::normal);
 	/// Load the given asset and block the calling thread until the asset is loaded.
-	std::shared_ptr<const asset> load_asset_sync(const std::string& name);
-	/// Asynchronously load the given asset, signal completion using the returned future.
-	boost::unique_future<std::shared_ptr<const asset>> load_asset_future(const std::string& name);
+	std::shared_ptr<const asset> load_asset_sync(util::symbol name);
+	/// Load the given asset and block the calling thread until the asset is loaded.
+	std::shared_ptr<const asset> load_asset_sync(const std::string& name) {
+		return load_asset_sync(util::symbol(name));
+	}
+	/// \brief Asynchronously load the given asset with the given priority, signal completion using the
+	/// returned future.
+	/**
+	 * The loading doesn't occupy a worker thread while waiting, only waiting on the returned future blocks.
+	 */
+	boost::unique_future<std::shared_ptr<const asset>>
+	load_asset_future(util::symbol name, load_priority priority = load_priority::normal);
+	/// \brief Asynchronously load the given asset with the given priority, signal completion using the
+	/// returned future, which receives an operation_cancelled_exception if the given token is cancelled.
+	boost::unique_future<std::shared_ptr<const asset>>
+	load_asset_future(util::symbol name, load_priority priority, const load_cancellation_token& token);
+	/// \brief Asynchronously load the given asset with the given priority, signal completion using the
+	/// returned future.
+	boost::unique_future<std::shared_ptr<const asset>>
+	load_asset_future(const std::string& name, load_priority priority = load_priority::normal) {
+		return load_asset_future(util::symbol(name), priority);
+	}
+	/// \brief Asynchronously load the given asset with the given priority, signal completion using the
+	/// returned future, which receives an operation_cancelled_exception if the given token is cancelled.
+	boost::unique_future<std::shared_ptr<const asset>>
+	load_asset_future(const std::string& name, load_priority priority, const load_cancellation_token& token) {
+		return load_asset_future(util::symbol(name), priority, token);
+	}
 	/// Starts a cleanup task, that unloads unused assets.
 	void start_clean();
+	/// Sets the byte budget for the loaded assets held by the cache.
+	/**
+	 * Whenever a completed load makes the loaded assets exceed the budget, a background task on the worker
+	 * threads evicts assets that are not referenced outside of the cache until the cache fits into the budget
+	 * again. Each evicted asset is the least recently requested one of a small random sample of the cached
+	 * assets, which approximates LRU order. Referenced assets are never evicted, the budget can therefore be
+	 * exceeded temporarily when the referenced assets alone don't fit into it. Defaults to no limit.
+	 */
+	void cache_budget(uint64_t bytes);
+	/// Returns the byte budget for the loaded assets held by the cache.
+	uint64_t cache_budget() const noexcept {
+		return cache_budget_.load(std::memory_order_relaxed);
+	}
+	/// Returns a snapshot of the cache counters, which may be slightly inconsistent under concurrent loads.
+	asset_cache_statistics cache_statistics() const noexcept;
+	/// Resets the request and eviction counters of the cache, the resident bytes are kept.
+	void reset_cache_statistics() noexcept;
 	/// Start making the given load_unit available.
 	void start_pin_load_unit(const std::string& name);
 	/// \brief Start making the given load_unit available and call the given completion handler when done or
@@ -121,52 +271,75 @@ namespace mce {
 namespace asset {
 
 template <typename F, typename E>
-std::shared_ptr<const asset> asset_manager::load_asset_async(const std::string& name, F completion_handler,
-															 E error_handler) {
+std::shared_ptr<const asset> asset_manager::load_asset_async_core(util::symbol name, F completion_handler,
+																  E error_handler, load_priority priority,
+																  const load_cancellation_token* token) {
 	std::shared_ptr<asset> result;
-	{
-		// Acquire read lock
-		std::shared_lock<std::shared_timed_mutex> lock(loaded_assets_rw_lock);
-		auto it = loaded_assets.find(name);
-		if(it != loaded_assets.end()) {
-			result = it->second;
+	for(;;) {
+		auto entry = loaded_assets.find_or_insert(name, [this, name]() { return create_cached_asset(name); });
+		result = std::move(entry.first);
+		// Requests for waiting loads are queued even if the asset is already queued, to allow promoting it.
+		if(!result->ready() && !enqueue_load(name, result, priority, token)) {
+			discard_abandoned(name, result);
+			continue;
 		}
+		note_cache_access(*result, entry.second);
+		break;
+	}
+	if(!token) {
+		result->run_when_loaded(std::move(completion_handler), std::move(error_handler));
+		return result;
 	}
-	if(!result) {
-		// Acquire write lock
-		std::unique_lock<std::shared_timed_mutex> lock(loaded_assets_rw_lock);
-		// Double check if the asset is still not in the map.
-		auto it = loaded_assets.find(name);
-		if(it != loaded_assets.end()) {
-			result = it->second;
-		} else {
-			auto tmp = std::make_shared<asset>(name);
-			loaded_assets[name] = tmp;
-			tmp->run_when_loaded(std::move(completion_handler), std::move(error_handler));
-			task_pool.post([tmp, this]() {
-				if(tmp->try_obtain_load_ownership()) {
-					try {
-						auto local_asset_loaders = asset_loaders.get();
-						for(auto& loader : *local_asset_loaders) {
-							if(loader->start_load_asset(tmp, *this, false)) return;
-						}
-					} catch(...) {
-						tmp->raise_error_flag(std::current_exception());
-						throw;
-					}
-					tmp->raise_error_flag(std::make_exception_ptr(
-							path_not_found_exception("Couldn't find asset '" + tmp->name() +
-													 "' through any of the registered loaders.")));
+	// Both handlers are shared, because a cancelled request calls the error handler instead of the completion
+	// handler.
+	auto handlers =
+			std::make_shared<std::pair<F, E>>(std::move(completion_handler), std::move(error_handler));
+	auto request_token = *token;
+	result->run_when_loaded(
+			[handlers, request_token](const asset_ptr& loaded_asset) {
+				if(request_token.cancelled()) {
+					handlers->second(std::make_exception_ptr(operation_cancelled_exception(
+							"The request for asset '" + loaded_asset->name() + "' was cancelled.")));
+				} else {
+					handlers->first(loaded_asset);
+				}
+			},
+			[handlers, request_token, name](std::exception_ptr e) {
+				if(request_token.cancelled()) {
+					e = std::make_exception_ptr(operation_cancelled_exception(
+							"The request for asset '" + name.str() + "' was cancelled."));
 				}
+				handlers->second(e);
 			});
-			return tmp;
-		}
-	}
-
-	if(result) result->run_when_loaded(std::move(completion_handler), std::move(error_handler));
 	return result;
 }
 
+template <typename F, typename E>
+void asset_manager::load_assets_async(const std::vector<util::symbol>& names, F completion_handler,
+									  E error_handler, load_priority priority) {
+	if(names.empty()) {
+		completion_handler(std::vector<std::shared_ptr<const asset>>());
+		return;
+	}
+	auto state = std::make_shared<multi_load_state<F, E>>(names.size(), std::move(completion_handler),
+														  std::move(error_handler));
+	for(size_t i = 0; i < names.size(); ++i) {
+		load_asset_async(names[i],
+						 [state, i](const asset_ptr& loaded_asset) {
+							 state->assets[i] = loaded_asset;
+							 // A failed asset never decrements the counter, so the completion can't follow an
+							 // error.
+							 if(state->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+								 state->completion_handler(std::move(state->assets));
+							 }
+						 },
+						 [state](std::exception_ptr e) {
+							 if(!state->failed.exchange(true)) state->error_handler(e);
+						 },
+						 priority);
+	}
+}
+
 } // namespace asset
 } // namespace mce
 
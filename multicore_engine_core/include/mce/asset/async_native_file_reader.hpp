@@ -0,0 +1,76 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/include/mce/asset/async_native_file_reader.hpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#ifndef ASSET_ASYNC_NATIVE_FILE_READER_HPP_
+#define ASSET_ASYNC_NATIVE_FILE_READER_HPP_
+
+/**
+ * \file
+ * Defines a file_reader that reads files from the file system asynchronously where supported.
+ */
+
+#include <mce/asset/asset_defs.hpp>
+#include <mce/asset/file_reader.hpp>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace mce {
+namespace asset {
+
+/// Loads files directly from the operating system file system without blocking the asset worker threads.
+/**
+ * On Linux the reads started through start_read_file are queued in the submission queue of an io_uring and
+ * completed on a completion thread owned by the reader, which runs the completion handlers. The calling
+ * thread only takes a short lock to queue the read, the completion thread submits all reads queued since
+ * its last wake-up with a single io_uring_enter call. The handlers should be short or hand off their work,
+ * as file_asset_loader does by posting the completion of the asset to the task pool of the asset_manager.
+ * If the io_uring can't be created (old kernels or restricted system call filters), too many reads are in
+ * flight or the submission queue is full, the files are read using pread on the calling thread instead.
+ * Reads that the io_uring refuses to accept are completed using pread on the completion thread instead of
+ * being left pending.
+ *
+ * Opening the file and determining its size still happen synchronously on the thread calling
+ * start_read_file, only the reading of the content is asynchronous. The asset_manager therefore still needs
+ * its worker threads for the file system lookups and doesn't reduce their number when this reader is used.
+ *
+ * On other platforms the reader behaves like native_file_reader.
+ */
+class async_native_file_reader final : public file_reader {
+	struct impl;
+	std::unique_ptr<impl> impl_;
+
+public:
+	/// Creates the reader with a submission queue of the given depth.
+	explicit async_native_file_reader(unsigned int queue_depth = 256);
+	/// Waits for all reads in flight to complete, including their handlers, and destroys the reader.
+	~async_native_file_reader() noexcept;
+	/// Forbids copying.
+	async_native_file_reader(const async_native_file_reader&) = delete;
+	/// Forbids copying.
+	async_native_file_reader& operator=(const async_native_file_reader&) = delete;
+
+	/// Returns true if start_read_file submits reads asynchronously.
+	bool async_backend_active() const noexcept;
+	/// Reads the given file from the given path prefix into memory.
+	virtual std::pair<file_content_ptr, file_size> read_file(const std::string& prefix,
+															 const std::string& file) override;
+	/// \brief Starts reading the given file from the given path prefix and calls the completion handler with
+	/// the content or the error handler if reading the existing file fails.
+	virtual bool start_read_file(const std::string& prefix, const std::string& file,
+								 file_read_completion_handler completion_handler,
+								 error_handler error_handler) override;
+	/// \brief Reads the given byte range of the given file from the given path prefix into memory, without
+	/// reading the rest of the file.
+	virtual std::pair<file_content_ptr, file_size> read_file_range(const std::string& prefix,
+																   const std::string& file, file_size offset,
+																   file_size size) override;
+};
+
+} // namespace asset
+} // namespace mce
+
+#endif /* ASSET_ASYNC_NATIVE_FILE_READER_HPP_ */
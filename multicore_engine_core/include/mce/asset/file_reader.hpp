@@ -12,6 +12,7 @@
  * Defines the interface for file readers used by asset loaders.
  */
 
+#include <algorithm>
 #include <mce/asset/asset_defs.hpp>
 #include <string>
 #include <utility>
@@ -28,6 +29,36 @@ public:
 	/// Hook function to read the given file into memory using the given prefix.
 	virtual std::pair<file_content_ptr, file_size> read_file(const std::string& prefix,
 															 const std::string& file) = 0;
+	/// \brief Hook function to start reading the given file using the given prefix and call the completion
+	/// handler with the content or the error handler if reading the existing file fails.
+	/**
+	 * Returns false without calling any of the handlers if the file doesn't exist. The handlers are called
+	 * either before this function returns or later on a thread of the reader. The default implementation
+	 * reads the file synchronously using read_file.
+	 */
+	virtual bool start_read_file(const std::string& prefix, const std::string& file,
+								 file_read_completion_handler completion_handler, error_handler) {
+		auto content = read_file(prefix, file);
+		if(!content.first) return false;
+		completion_handler(content.first, content.second);
+		return true;
+	}
+	/// \brief Hook function to read the given byte range of the given file using the given prefix into
+	/// memory.
+	/**
+	 * The range is clipped to the end of the file and the returned size is the size of the clipped range. As
+	 * for read_file a null content pointer means that the file could not be read. The default implementation
+	 * reads the whole file using read_file and returns a pointer into it that keeps the whole content alive.
+	 */
+	virtual std::pair<file_content_ptr, file_size> read_file_range(const std::string& prefix,
+																   const std::string& file, file_size offset,
+																   file_size size) {
+		auto content = read_file(prefix, file);
+		if(!content.first) return content;
+		offset = std::min(offset, content.second);
+		size = std::min(size, content.second - offset);
+		return std::make_pair(file_content_ptr(content.first, content.first.get() + offset), size);
+	}
 };
 
 } // namespace asset
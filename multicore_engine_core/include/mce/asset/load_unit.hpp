@@ -24,6 +24,8 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -45,7 +47,7 @@ public:
 		meta_ready,
 		/// Meta data loaded, loading pay-load data
 		data_loading,
-		/// Loading complete
+		/// Loading complete, or meta data loaded if the assets are read individually from the pay-load
 		data_ready,
 		/// Loading failed
 		error
@@ -56,6 +58,8 @@ private:
 	mutable std::mutex modification_mutex;
 	std::string name_;
 	load_unit_meta_data meta_data_;
+	// Maps the asset names to their index in meta_data_.assets, the keys refer to the names in meta_data_.
+	std::unordered_map<std::string_view, size_t> asset_index_;
 	std::shared_ptr<const char> payload_data_;
 	size_t size_;
 	std::vector<load_unit_completion_handler> completion_handlers;
@@ -68,6 +72,7 @@ public:
 	/// in the metadata.
 	class asset_resolution_cookie {
 		friend class load_unit;
+		friend class load_unit_asset_loader;
 		const mce::asset::load_unit* load_unit;
 		uint64_t offset;
 		uint64_t size;
@@ -98,13 +103,14 @@ public:
 	/// Resolves the named asset within the load_unit for later access by get_asset_content.
 	/**
 	 * This uses the meta data (and therefore requires them to be ready) to determine where in the load_unit
-	 * the data for the asset are stored and how big the data block is.
+	 * the data for the asset are stored and how big the data block is. The lookup uses a hash index built
+	 * when the meta data are loaded.
 	 */
 	asset_resolution_cookie resolve_asset(const std::string& name) const;
 	/// \brief Returns a ownership-participating pointer to the content and the size of the content of a
 	/// previously resolved asset.
 	/**
-	 * Requires that the pay-load of the load_unit is ready.
+	 * Requires that the pay-load of the load_unit is ready and was loaded as a whole.
 	 */
 	std::pair<std::shared_ptr<const char>, size_t>
 	get_asset_content(const asset_resolution_cookie& resolution_cookie) const;
@@ -178,7 +184,7 @@ public:
 		return cur_state == state::meta_ready || cur_state == state::data_loading ||
 			   cur_state == state::data_ready;
 	}
-	/// Checks if the load_unit is ready (meta data and pay-load).
+	/// Checks if the load_unit is ready (meta data and pay-load, if loaded as a whole).
 	bool ready() const noexcept {
 		return current_state_ == state::data_ready;
 	}
@@ -12,12 +12,14 @@
  * Defines an asset_loader that works using load units.
  */
 
+#include <cstdint>
 #include <mce/asset/asset_defs.hpp>
 #include <mce/asset/asset_loader.hpp>
 #include <mce/containers/scratch_pad_pool.hpp>
 #include <memory>
 #include <shared_mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -25,26 +27,82 @@ namespace mce {
 namespace asset {
 class load_unit;
 
-/// Implements loading of assets through load units that are read into memory as a whole.
+/// Implements loading of assets through load units that are read into memory as a whole or per asset.
+/**
+ * By default the pay-load of a load unit is read as a whole after its meta data and assets resolve when the
+ * complete pay-load is in memory. In payload_mode::streaming the pay-load is not preloaded, instead each
+ * requested asset is read from its range of the pay-load file as soon as the meta data are available. The
+ * ranges are read using file_reader::read_file_range, which the readers of the engine implement without
+ * reading the rest of the file. Readers relying on its default implementation read the whole pay-load file
+ * for every asset and should not be used for streaming.
+ *
+ * When multiple pinned load units contain an asset of the same name, the load unit pinned first is used. The
+ * loader maintains an index from asset names to the load unit providing them, which is updated when the
+ * meta data of a pinned load unit are loaded or a load unit is unpinned. Requests are resolved using one
+ * lookup in the index unless the meta data of a pinned load unit are still loading.
+ */
 class load_unit_asset_loader final : public asset_loader {
+public:
+	/// Specifies how the pay-load of load units is read.
+	enum class payload_mode {
+		/// The pay-load is read as a whole when a load unit is pinned or used, pinning completes after it.
+		preload,
+		/// Each asset is read from its range of the pay-load, pinning completes after loading the meta data.
+		streaming
+	};
+
+private:
+	struct pinned_load_unit {
+		std::shared_ptr<load_unit> unit;
+		uint64_t pin_order;
+		bool indexed; // The assets are in the index or the meta data failed to load.
+	};
+	struct indexed_asset {
+		std::shared_ptr<load_unit> unit;
+		uint64_t pin_order;
+		// The range of the asset in the pay-load of the load unit.
+		uint64_t offset;
+		uint64_t size;
+	};
+
 	std::shared_timed_mutex load_units_rw_lock;
-	std::vector<std::shared_ptr<load_unit>> load_units;
+	std::vector<pinned_load_unit> load_units;
+	std::unordered_map<std::string, indexed_asset> asset_index;
+	uint64_t next_pin_order = 0;
+	size_t unindexed_load_units = 0;
 	const std::vector<path_prefix> prefixes;
+	const payload_mode payload_mode_;
 	containers::scratch_pad_pool<std::vector<std::shared_ptr<load_unit>>> load_unit_scratch;
 
 	std::pair<file_content_ptr, file_size> load_file_from_prefixes(const std::string& name) const;
+	std::pair<file_content_ptr, file_size>
+	load_file_range_from_prefixes(const std::string& name, file_size offset, file_size size) const;
+	void complete_meta_data_loading(const std::shared_ptr<load_unit>& load_unit,
+									asset_manager& asset_manager) const;
+	void load_asset_range(const std::shared_ptr<asset>& asset, const std::shared_ptr<load_unit>& load_unit,
+						  uint64_t offset, uint64_t size) const;
 	void start_payload_loading(const std::shared_ptr<load_unit>& load_unit,
 							   asset_manager& asset_manager) const;
 	void prepare_load_unit_meta_data(const std::shared_ptr<load_unit>& load_unit,
-									 asset_manager& asset_manager) const;
+									 asset_manager& asset_manager);
+	void index_load_unit(const std::shared_ptr<load_unit>& load_unit);
+	bool start_load_from_unit(const std::shared_ptr<asset>& asset,
+							  const std::shared_ptr<load_unit>& load_unit, asset_manager& asset_manager,
+							  bool sync_hint);
+	void start_load_range(const std::shared_ptr<asset>& asset, const std::shared_ptr<load_unit>& load_unit,
+						  uint64_t offset, uint64_t size, asset_manager& asset_manager, bool sync_hint);
 	std::shared_ptr<load_unit> start_pin_load_unit_helper(const std::string& name,
 														  asset_manager& asset_manager);
 
 public:
-	/// Creates a file_asset_loader using the given path prefixes and with an empty load unit prefix.
-	explicit load_unit_asset_loader(const std::vector<path_prefix>& prefixes);
-	/// Creates a file_asset_loader using the given path prefixes and with an empty load unit prefix.
-	explicit load_unit_asset_loader(std::vector<path_prefix>&& prefixes);
+	/// \brief Creates a load_unit_asset_loader using the given path prefixes and with an empty load unit
+	/// prefix, reading pay-loads in the given mode.
+	explicit load_unit_asset_loader(const std::vector<path_prefix>& prefixes,
+									payload_mode mode = payload_mode::preload);
+	/// \brief Creates a load_unit_asset_loader using the given path prefixes and with an empty load unit
+	/// prefix, reading pay-loads in the given mode.
+	explicit load_unit_asset_loader(std::vector<path_prefix>&& prefixes,
+									payload_mode mode = payload_mode::preload);
 	virtual bool start_load_asset(const std::shared_ptr<asset>& asset, asset_manager& asset_manager,
 								  bool sync_hint) override;
 	virtual void start_pin_load_unit(const std::string& name, asset_manager& asset_manager) override;
@@ -0,0 +1,95 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/include/mce/asset/mapped_pack_file_reader.hpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#ifndef ASSET_MAPPED_PACK_FILE_READER_HPP_
+#define ASSET_MAPPED_PACK_FILE_READER_HPP_
+
+/**
+ * \file
+ * Defines a file_reader that reads from memory-mapped pack files.
+ */
+
+#include <boost/container/flat_map.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <mce/asset/asset_defs.hpp>
+#include <mce/asset/file_reader.hpp>
+#include <mce/asset/pack_file_meta_data.hpp>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace mce {
+namespace asset {
+
+/// Loads files from within pack files by mapping the pack files into memory.
+/**
+ * Each pack file is mapped once and shared between all concurrent reads. Uncompressed elements are returned
+ * as pointers into the mapping without copying them, the returned pointers keep the mapping alive.
+ * Compressed elements are decompressed into newly allocated memory like in pack_file_reader.
+ */
+class mapped_pack_file_reader final : public file_reader {
+public:
+	/// Specifies the expected order of reads from a pack file, which is passed to the OS as a paging hint.
+	enum class access_pattern {
+		/// Elements are read in arbitrary order, read-ahead is reduced.
+		random,
+		/// Elements are mostly read in the order of their offsets, read-ahead is increased.
+		sequential
+	};
+
+private:
+	struct mapped_pack {
+		boost::interprocess::file_mapping file;
+		boost::interprocess::mapped_region region;
+		pack_file_meta_data metadata;
+		// Maps the element names to the elements, the keys refer to the names in metadata.
+		std::unordered_map<std::string_view, const pack_file_element_meta_data*> element_index;
+
+		mapped_pack(const std::string& pack_file_name, access_pattern pattern);
+		const pack_file_element_meta_data* find_element(const std::string& name) const {
+			auto it = element_index.find(name);
+			return it != element_index.end() ? it->second : nullptr;
+		}
+		const char* data() const noexcept {
+			return static_cast<const char*>(region.get_address());
+		}
+		size_t size() const noexcept {
+			return region.get_size();
+		}
+	};
+	access_pattern pattern_;
+	std::shared_timed_mutex packs_rw_lock;
+	boost::container::flat_map<std::string, std::shared_ptr<const mapped_pack>> mapped_packs;
+
+	std::shared_ptr<const mapped_pack> get_pack(const std::string& prefix);
+	static std::pair<file_content_ptr, file_size>
+	read_element_range(const std::shared_ptr<const mapped_pack>& pack,
+					   const pack_file_element_meta_data& element, uint64_t offset, uint64_t size);
+
+public:
+	/// Creates a reader that gives the given access pattern hint for the pack files it maps.
+	explicit mapped_pack_file_reader(access_pattern pattern = access_pattern::random) : pattern_{pattern} {}
+	/// Loads the given file from the pack file given in the prefix.
+	virtual std::pair<file_content_ptr, file_size> read_file(const std::string& prefix,
+															 const std::string& file) override;
+	/// \brief Loads the given byte range of the given file from the pack file given in the prefix.
+	/**
+	 * Uncompressed ranges are returned as pointers into the mapping. For elements that are compressed in
+	 * blocks only the blocks covering the range are decompressed.
+	 */
+	virtual std::pair<file_content_ptr, file_size> read_file_range(const std::string& prefix,
+																   const std::string& file, file_size offset,
+																   file_size size) override;
+};
+
+} // namespace asset
+} // namespace mce
+
+#endif /* ASSET_MAPPED_PACK_FILE_READER_HPP_ */
@@ -26,6 +26,10 @@ public:
 	/// Reads the given file from the given path prefix into memory.
 	virtual std::pair<file_content_ptr, file_size> read_file(const std::string& prefix,
 															 const std::string& file) override;
+	/// Reads only the given byte range of the given file from the given path prefix into memory.
+	virtual std::pair<file_content_ptr, file_size> read_file_range(const std::string& prefix,
+																   const std::string& file, file_size offset,
+																   file_size size) override;
 };
 
 } // namespace asset
@@ -0,0 +1,54 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/include/mce/asset/pack_file_blocks.hpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#ifndef ASSET_PACK_FILE_BLOCKS_HPP_
+#define ASSET_PACK_FILE_BLOCKS_HPP_
+
+/**
+ * \file
+ * Provides the decompression of byte ranges of compressed pack file elements.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <mce/asset/pack_file_meta_data.hpp>
+
+namespace mce {
+namespace asset {
+
+/// Describes the part of a compressed pack file element that needs to be decompressed to read a byte range.
+struct pack_file_block_span {
+	size_t first_block;		   ///< The first block to decompress.
+	size_t end_block;		   ///< The block after the last block to decompress.
+	uint64_t compressed_begin; ///< The begin of the compressed data relative to the offset of the element.
+	uint64_t compressed_end;   ///< The end of the compressed data relative to the offset of the element.
+	uint64_t data_begin;	   ///< The offset of the first decompressed byte within the element.
+	uint64_t data_end;		   ///< The offset after the last decompressed byte within the element.
+};
+
+/// \brief Returns the blocks of the given compressed element that cover the given byte range, which must lie
+/// within the element.
+/**
+ * Elements that are not blocked are treated as a single block that covers the whole element.
+ */
+pack_file_block_span pack_file_compressed_span(const pack_file_element_meta_data& element, uint64_t offset,
+											   uint64_t size) noexcept;
+
+/// Decompresses the given span of the given compressed element into the given output buffer.
+/**
+ * The compressed data must begin at compressed_begin of the span and the output buffer must be large enough
+ * for the uncompressed data of the span. If the span contains multiple blocks, they are decompressed in
+ * parallel using TBB.
+ *
+ * Throws a compression_exception if the codec is not supported by this build or the data is corrupt.
+ */
+void decompress_pack_file_span(const pack_file_element_meta_data& element, const pack_file_block_span& span,
+							   const char* compressed_data, char* output);
+
+} // namespace asset
+} // namespace mce
+
+#endif /* ASSET_PACK_FILE_BLOCKS_HPP_ */
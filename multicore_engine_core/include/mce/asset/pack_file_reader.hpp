@@ -24,6 +24,8 @@
 #include <memory>
 #include <shared_mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -36,14 +38,24 @@ class pack_file_reader final : public file_reader {
 		std::atomic_flag lock_flag = ATOMIC_FLAG_INIT;
 		std::ifstream stream;
 		pack_file_meta_data metadata;
+		// Maps the element names to the elements, the keys refer to the names in metadata.
+		std::unordered_map<std::string_view, const pack_file_element_meta_data*> element_index;
 		std::vector<char> compressed_buffer;
-		std::vector<char> decompressed_buffer;
 		explicit pack_file_source(const std::string& pack_file_name)
 				: stream{pack_file_name, std::ios::binary} {
 			if(!stream) throw path_not_found_exception("Unable to open file '" + pack_file_name + "'.");
 			bstream::istream_bstream bstr(stream);
 			bstr >> metadata;
 			if(!bstr) throw io_exception("Unable to read meta data from file '" + pack_file_name + "'.");
+			element_index.reserve(metadata.elements.size());
+			// For duplicate names the first element is used, emplace keeps the existing entry.
+			for(const auto& element : metadata.elements) {
+				element_index.emplace(element.name, &element);
+			}
+		}
+		const pack_file_element_meta_data* find_element(const std::string& name) const {
+			auto it = element_index.find(name);
+			return it != element_index.end() ? it->second : nullptr;
 		}
 		bool try_lock() noexcept {
 			return !lock_flag.test_and_set();
@@ -56,11 +68,22 @@ class pack_file_reader final : public file_reader {
 	boost::container::flat_multimap<std::string, std::shared_ptr<pack_file_source>> opened_pack_file_sources;
 
 	util::lock_ptr_wrapper<pack_file_source> get_source_stream(const std::string& prefix);
+	static std::pair<file_content_ptr, file_size>
+	read_element_range(pack_file_source& source, const pack_file_element_meta_data& element, uint64_t offset,
+					   uint64_t size);
 
 public:
 	/// Loads the given file from the pack file given in the prefix into memory.
 	virtual std::pair<file_content_ptr, file_size> read_file(const std::string& prefix,
 															 const std::string& file) override;
+	/// \brief Loads the given byte range of the given file from the pack file given in the prefix into
+	/// memory.
+	/**
+	 * For elements that are compressed in blocks only the blocks covering the range are decompressed.
+	 */
+	virtual std::pair<file_content_ptr, file_size> read_file_range(const std::string& prefix,
+																   const std::string& file, file_size offset,
+																   file_size size) override;
 };
 
 } // namespace asset
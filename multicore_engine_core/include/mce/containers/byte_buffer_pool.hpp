@@ -14,6 +14,9 @@
 
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <mce/containers/per_thread.hpp>
+#include <mce/util/instrumented_lock.hpp>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -73,6 +76,14 @@ public:
 	}
 };
 
+// Only accessed by the owning thread, release_resources() invalidates the chunks through the generation.
+struct byte_buffer_pool_thread_chunk {
+	uint64_t generation = 0;
+	std::shared_ptr<byte_buffer_pool_buffer> buffer;
+	size_t offset = 0;
+	size_t end = 0;
+};
+
 } // namespace detail
 
 /// Manages the shared ownership over a buffer in byte_buffer_pool.
@@ -236,25 +247,38 @@ public:
 
 /// Provides a thread-safe pool for byte buffers to minimize heap allocation calls.
 /**
- * The buffers are sub-allocated from larger pool buffers, which can also be reused.
+ * The buffers are sub-allocated from larger pool buffers, which can also be reused. Each thread allocating
+ * from the pool takes a chunk of buffer_size / min_slots bytes from the current pool buffer and sub-allocates
+ * from it without synchronization with other threads. The pool is only locked when a thread needs a new
+ * chunk. The pool buffers are shared by the chunks of all threads, new pool buffers are therefore only
+ * created when the existing ones are exhausted.
+ *
+ * The chunks are never touched by other threads. release_resources() only advances a release generation
+ * and each thread drops its chunk when it sees the changed generation in its next allocation.
  */
 class byte_buffer_pool {
 	std::shared_ptr<detail::byte_buffer_pool_buffer> current_pool_buffer;
 	std::vector<std::shared_ptr<detail::byte_buffer_pool_buffer>> stashed_pool_buffers;
 	size_t current_pool_buffer_offset = 0;
-	mutable std::mutex pool_mutex;
+	std::unique_ptr<per_thread<detail::byte_buffer_pool_thread_chunk>> thread_chunks;
+	std::atomic<uint64_t> release_generation{1};
+	mutable util::instrumented_lock<> pool_mutex{"containers.byte_buffer_pool"};
 	size_t pool_buffer_size_;
+	size_t thread_chunk_size_;
 	size_t min_slots_;
 	boost::rational<size_t> growth_factor_;
 
 	void reallocate(size_t buff_size);
-	void* try_alloc_buffer_block(size_t size) const noexcept;
+	void refill_chunk(detail::byte_buffer_pool_thread_chunk& chunk, size_t size);
 
 public:
 	/// Creates a byte_buffer_pool with the given allocation parameters.
 	byte_buffer_pool(size_t buffer_size = 0x100000, size_t min_slots = 0x10,
 					 boost::rational<size_t> growth_factor = {3u, 2u});
 	/// Allows move construction.
+	/**
+	 * The moved-from pool can only be destroyed or assigned to.
+	 */
 	byte_buffer_pool(byte_buffer_pool&& other) noexcept;
 	/// Allows move construction.
 	byte_buffer_pool& operator=(byte_buffer_pool&& other) noexcept;
@@ -262,6 +286,10 @@ public:
 	pooled_byte_buffer_ptr allocate_buffer(size_t size);
 	/// \brief Drops the ownership of the pool buffers to allow freeing unused ones, however they will be kept
 	/// alive as long as buffers exist in them.
+	/**
+	 * The chunks the threads are currently allocating from are dropped by the threads on their next
+	 * allocation. Until then, the chunk of an idle thread keeps its pool buffer alive.
+	 */
 	void release_resources() noexcept;
 	/// Returns the total (not just free) space in the pool buffers of the pool.
 	size_t capacity() const noexcept;
@@ -0,0 +1,585 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/include/mce/containers/concurrent_hash_map.hpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#ifndef CONTAINERS_CONCURRENT_HASH_MAP_HPP_
+#define CONTAINERS_CONCURRENT_HASH_MAP_HPP_
+
+/**
+ * \file
+ * Defines a sharded open-addressing hash map with lock-free lookups.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mce/util/epoch_reclamation.hpp>
+#include <mce/util/instrumented_lock.hpp>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(__SANITIZE_THREAD__)
+#define MCE_CONCURRENT_HASH_MAP_THREAD_SANITIZER
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define MCE_CONCURRENT_HASH_MAP_THREAD_SANITIZER
+#endif
+#endif
+
+// The vectorized group probing reads the control bytes with plain loads, which thread sanitizers report as a
+// data race. Sanitized builds therefore use the relaxed per-byte loads.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#ifndef MCE_CONCURRENT_HASH_MAP_THREAD_SANITIZER
+#include <immintrin.h>
+#define MCE_CONCURRENT_HASH_MAP_HAS_SSE2
+#endif
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace mce {
+namespace containers {
+
+/// Provides the default hash function for concurrent_hash_map.
+/**
+ * Equivalent to std::hash<Key> except for std::string keys, for which the hash is transparent and also
+ * accepts std::string_view and string literals to allow lookups without constructing a std::string.
+ */
+template <typename Key>
+struct concurrent_hash_map_hash : std::hash<Key> {};
+
+/// Provides the default hash function for concurrent_hash_map with std::string keys.
+template <>
+struct concurrent_hash_map_hash<std::string> {
+	/// Marks the hash function as accepting all types that are convertible to std::string_view.
+	using is_transparent = void;
+	/// Calculates the hash for the given string.
+	size_t operator()(std::string_view str) const noexcept {
+		return std::hash<std::string_view>{}(str);
+	}
+};
+
+namespace detail {
+
+// Finalizes the user-supplied hash values which are often weak (e.g. the identity for integers) because the
+// bits are split into the shard index, the group index and the control byte.
+inline uint64_t concurrent_hash_map_mix(uint64_t hash) noexcept {
+	hash ^= hash >> 32;
+	hash *= 0x9E3779B97F4A7C15ull;
+	hash ^= hash >> 29;
+	return hash;
+}
+
+inline unsigned concurrent_hash_map_first_bit(uint32_t bits) noexcept {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, bits);
+	return unsigned(index);
+#else
+	return unsigned(__builtin_ctz(bits));
+#endif
+}
+
+} // namespace detail
+
+/// Implements a hash map that supports concurrent lookups and modifications from multiple threads.
+/**
+ * The map is divided into shards selected by the hash of the key. Each shard is an open-addressing hash table
+ * with a control byte per slot, which holds 7 bits of the hash for occupied slots, and probes groups of 16
+ * slots at once by comparing their control bytes using SSE2 where available.
+ *
+ * Lookups do not lock and do not write to shared memory. Entries are stored in immutable nodes that are only
+ * destroyed through the epoch-based reclamation in mce/util/epoch_reclamation.hpp after they were removed or
+ * replaced. Modifications lock the affected shard, so modifications of keys in different shards run in
+ * parallel. Because values are not modified in place, lookups return copies of the values or pass them to a
+ * function object while the node is protected.
+ *
+ * Hash and KeyEqual can be transparent (e.g. concurrent_hash_map_hash<std::string> and std::equal_to<>) to
+ * allow heterogeneous lookups. Function objects passed to visit, for_each and erase_if must not modify the
+ * map.
+ */
+template <typename Key, typename Value, typename Hash = concurrent_hash_map_hash<Key>,
+		  typename KeyEqual = std::equal_to<>>
+class concurrent_hash_map {
+public:
+	using key_type = Key;		///< The type of the keys.
+	using mapped_type = Value;  ///< The type of the values.
+	using hasher = Hash;		///< The type of the hash function.
+	using key_equal = KeyEqual; ///< The type of the key comparison function.
+
+private:
+	static constexpr size_t cacheline_alignment = 64;
+	static constexpr size_t group_size = 16;
+	static constexpr size_t max_shard_count = size_t(1) << 16;
+	static constexpr uint8_t empty_control = 0x80;
+	static constexpr uint8_t deleted_control = 0xFE;
+
+	static_assert(sizeof(std::atomic<uint8_t>) == 1, "The group probing requires plain byte atomics.");
+
+	struct node {
+		uint64_t hash;
+		Key key;
+		Value value;
+
+		template <typename K, typename V>
+		node(uint64_t hash, K&& key, V&& value)
+				: hash{hash}, key(std::forward<K>(key)), value(std::forward<V>(value)) {}
+	};
+
+	struct table {
+		size_t group_mask;
+		// Only accessed under the write lock of the owning shard.
+		size_t growth_left;
+		std::unique_ptr<std::atomic<uint8_t>[]> control;
+		std::unique_ptr<std::atomic<node*>[]> slots;
+
+		explicit table(size_t group_count)
+				: group_mask{group_count - 1}, growth_left{group_count * group_size * 7 / 8},
+				  control{std::make_unique<std::atomic<uint8_t>[]>(group_count * group_size)},
+				  slots{std::make_unique<std::atomic<node*>[]>(group_count * group_size)} {
+			for(size_t i = 0; i < capacity(); ++i) {
+				control[i].store(empty_control, std::memory_order_relaxed);
+				slots[i].store(nullptr, std::memory_order_relaxed);
+			}
+		}
+		size_t capacity() const noexcept {
+			return (group_mask + 1) * group_size;
+		}
+	};
+
+	struct alignas(cacheline_alignment) shard {
+		std::atomic<table*> current{nullptr};
+		std::atomic<size_t> size{0};
+		util::instrumented_lock<> write_lock{"containers.concurrent_hash_map"};
+	};
+
+	std::unique_ptr<shard[]> shards_;
+	size_t shard_mask_;
+	Hash hash_;
+	KeyEqual key_equal_;
+
+	// Returns a bit mask of the slots in the group starting at ctrl whose control byte is equal to value.
+	// Lookups read the control bytes concurrently with writers, with a single vector load where available.
+	// The bytes are only used as a hint and the candidate slots are validated using acquire loads of the node
+	// pointers, a stale group therefore only affects entries that are modified concurrently.
+	static uint32_t match_control(const std::atomic<uint8_t>* ctrl, uint8_t value) noexcept {
+#ifdef MCE_CONCURRENT_HASH_MAP_HAS_SSE2
+		auto group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+		return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(char(value)))));
+#else
+		uint32_t result = 0;
+		for(size_t i = 0; i < group_size; ++i) {
+			if(ctrl[i].load(std::memory_order_relaxed) == value) result |= uint32_t(1) << i;
+		}
+		return result;
+#endif
+	}
+	// Returns a bit mask of the slots in the group starting at ctrl that are empty or deleted.
+	static uint32_t match_free(const std::atomic<uint8_t>* ctrl) noexcept {
+#ifdef MCE_CONCURRENT_HASH_MAP_HAS_SSE2
+		// Only the control bytes for free slots have the most significant bit set.
+		return uint32_t(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))));
+#else
+		uint32_t result = 0;
+		for(size_t i = 0; i < group_size; ++i) {
+			if(ctrl[i].load(std::memory_order_relaxed) & 0x80) result |= uint32_t(1) << i;
+		}
+		return result;
+#endif
+	}
+
+	template <typename K>
+	uint64_t hash_of(const K& key) const {
+		return detail::concurrent_hash_map_mix(uint64_t(hash_(key)));
+	}
+	shard& shard_for(uint64_t hash) const noexcept {
+		return shards_[size_t(hash >> 48) & shard_mask_];
+	}
+	static uint8_t control_for(uint64_t hash) noexcept {
+		return uint8_t(hash & 0x7F);
+	}
+
+	// Returns the slot index of the node with the given key or the capacity of the table if it is missing.
+	template <typename K>
+	size_t find_index(const table& t, uint64_t hash, const K& key) const {
+		auto h2 = control_for(hash);
+		size_t group = size_t(hash >> 7) & t.group_mask;
+		// Triangular probing visits every group because the group count is a power of two. The probing
+		// terminates because every table keeps at least an eighth of its slots empty.
+		for(size_t step = 1;; ++step) {
+			auto ctrl = t.control.get() + group * group_size;
+			for(auto bits = match_control(ctrl, h2); bits; bits &= bits - 1) {
+				auto index = group * group_size + detail::concurrent_hash_map_first_bit(bits);
+				const node* n = t.slots[index].load(std::memory_order_acquire);
+				if(n && n->hash == hash && key_equal_(n->key, key)) return index;
+			}
+			if(match_control(ctrl, empty_control)) return t.capacity();
+			group = (group + step) & t.group_mask;
+		}
+	}
+	template <typename K>
+	const node* find_node(const shard& s, uint64_t hash, const K& key) const {
+		const table* t = s.current.load(std::memory_order_acquire);
+		if(!t) return nullptr;
+		auto index = find_index(*t, hash, key);
+		if(index == t->capacity()) return nullptr;
+		return t->slots[index].load(std::memory_order_acquire);
+	}
+
+	// Places the node in a free slot of the given table without checking for an existing key.
+	static void place_node(table& t, node* n) noexcept {
+		size_t group = size_t(n->hash >> 7) & t.group_mask;
+		for(size_t step = 1;; ++step) {
+			auto bits = match_free(t.control.get() + group * group_size);
+			if(bits) {
+				auto index = group * group_size + detail::concurrent_hash_map_first_bit(bits);
+				if(t.control[index].load(std::memory_order_relaxed) == empty_control) t.growth_left--;
+				t.slots[index].store(n, std::memory_order_release);
+				t.control[index].store(control_for(n->hash), std::memory_order_release);
+				return;
+			}
+			group = (group + step) & t.group_mask;
+		}
+	}
+
+	// Replaces the table of the shard by a new one that has room for at least one more node and returns the
+	// old table, which needs to be retired after the write lock is released. Must be called with the write
+	// lock of the shard held.
+	static table* grow(shard& s) {
+		auto old_table = s.current.load(std::memory_order_relaxed);
+		auto size = s.size.load(std::memory_order_relaxed);
+		size_t group_count = 1;
+		// Keeps the load after the rehash at most at half the capacity to amortize the rehashing.
+		while(group_count * group_size * 7 / 8 < 2 * (size + 1)) {
+			group_count *= 2;
+		}
+		auto new_table = std::make_unique<table>(group_count);
+		if(old_table) {
+			for(size_t i = 0; i < old_table->capacity(); ++i) {
+				auto n = old_table->slots[i].load(std::memory_order_relaxed);
+				if(n) place_node(*new_table, n);
+			}
+		}
+		s.current.store(new_table.release(), std::memory_order_release);
+		return old_table;
+	}
+
+	// Inserts the given node that must not have a key that is already present and returns a table to retire
+	// or nullptr. Must be called with the write lock of the shard held.
+	static table* insert_new_node(shard& s, node* n) {
+		table* retired_table = nullptr;
+		auto t = s.current.load(std::memory_order_relaxed);
+		if(!t || t->growth_left == 0) {
+			retired_table = grow(s);
+			t = s.current.load(std::memory_order_relaxed);
+		}
+		place_node(*t, n);
+		s.size.fetch_add(1, std::memory_order_relaxed);
+		return retired_table;
+	}
+
+	// Removes the node in the given slot from the table and returns it. Must be called with the write lock of
+	// the shard held.
+	static node* remove_slot(shard& s, table& t, size_t index) noexcept {
+		auto n = t.slots[index].load(std::memory_order_relaxed);
+		t.control[index].store(deleted_control, std::memory_order_release);
+		t.slots[index].store(nullptr, std::memory_order_release);
+		s.size.fetch_sub(1, std::memory_order_relaxed);
+		return n;
+	}
+
+	static void retire(table* t) {
+		if(t) util::epoch_retire(t);
+	}
+	static void retire(node* n) {
+		if(n) util::epoch_retire(n);
+	}
+
+public:
+	/// \brief Creates an empty map with the given number of shards, which is rounded up to a power of two,
+	/// and the given hash and key comparison functions.
+	explicit concurrent_hash_map(size_t shard_count = 16, const Hash& hash = Hash(),
+								 const KeyEqual& key_equal = KeyEqual())
+			: hash_(hash), key_equal_(key_equal) {
+		size_t count = 1;
+		while(count < shard_count && count < max_shard_count) {
+			count *= 2;
+		}
+		shards_ = std::make_unique<shard[]>(count);
+		shard_mask_ = count - 1;
+	}
+	/// Forbids copying.
+	concurrent_hash_map(const concurrent_hash_map&) = delete;
+	/// Forbids copying.
+	concurrent_hash_map& operator=(const concurrent_hash_map&) = delete;
+	/// \brief Destroys the map and its entries, which requires that no other thread accesses the map
+	/// concurrently.
+	~concurrent_hash_map() noexcept {
+		for(size_t i = 0; i <= shard_mask_; ++i) {
+			auto t = shards_[i].current.load(std::memory_order_acquire);
+			if(!t) continue;
+			for(size_t j = 0; j < t->capacity(); ++j) {
+				delete t->slots[j].load(std::memory_order_relaxed);
+			}
+			delete t;
+		}
+	}
+
+	/// \brief Calls f with a const reference to the value for the given key if it is present and returns
+	/// true, otherwise returns false.
+	/**
+	 * The reference is only valid during the call of f.
+	 */
+	template <typename K, typename F>
+	bool visit(const K& key, F&& f) const {
+		auto hash = hash_of(key);
+		util::epoch_guard guard;
+		auto n = find_node(shard_for(hash), hash, key);
+		if(!n) return false;
+		std::forward<F>(f)(static_cast<const Value&>(n->value));
+		return true;
+	}
+	/// Returns a copy of the value for the given key or an empty optional if the key is not present.
+	template <typename K>
+	std::optional<Value> find(const K& key) const {
+		auto hash = hash_of(key);
+		util::epoch_guard guard;
+		auto n = find_node(shard_for(hash), hash, key);
+		if(!n) return std::nullopt;
+		return n->value;
+	}
+	/// Checks if the given key is present.
+	template <typename K>
+	bool contains(const K& key) const {
+		auto hash = hash_of(key);
+		util::epoch_guard guard;
+		return find_node(shard_for(hash), hash, key) != nullptr;
+	}
+
+	/// \brief Inserts the given key and value if the key is not present and returns true, otherwise leaves
+	/// the map unchanged and returns false.
+	template <typename K, typename V>
+	bool insert(K&& key, V&& value) {
+		auto hash = hash_of(key);
+		auto& s = shard_for(hash);
+		table* retired_table = nullptr;
+		{
+			std::lock_guard<decltype(s.write_lock)> lock(s.write_lock);
+			auto t = s.current.load(std::memory_order_relaxed);
+			if(t && find_index(*t, hash, key) != t->capacity()) return false;
+			auto n = std::make_unique<node>(hash, std::forward<K>(key), std::forward<V>(value));
+			retired_table = insert_new_node(s, n.get());
+			n.release();
+		}
+		retire(retired_table);
+		return true;
+	}
+	/// \brief Inserts the given key and value or replaces the value if the key is already present and returns
+	/// true if the key was inserted.
+	template <typename K, typename V>
+	bool insert_or_assign(K&& key, V&& value) {
+		auto hash = hash_of(key);
+		auto& s = shard_for(hash);
+		table* retired_table = nullptr;
+		node* retired_node = nullptr;
+		{
+			std::lock_guard<decltype(s.write_lock)> lock(s.write_lock);
+			auto t = s.current.load(std::memory_order_relaxed);
+			auto index = t ? find_index(*t, hash, key) : 0;
+			auto n = std::make_unique<node>(hash, std::forward<K>(key), std::forward<V>(value));
+			if(t && index != t->capacity()) {
+				retired_node = t->slots[index].load(std::memory_order_relaxed);
+				t->slots[index].store(n.release(), std::memory_order_release);
+			} else {
+				retired_table = insert_new_node(s, n.get());
+				n.release();
+			}
+		}
+		retire(retired_table);
+		retire(retired_node);
+		return retired_node == nullptr;
+	}
+	/// \brief Returns a copy of the value for the given key and false if the key is present, otherwise
+	/// inserts the key with the value returned by make_value and returns a copy of that value and true.
+	/**
+	 * make_value is called at most once while holding the write lock of the shard containing the key. This
+	 * allows creating the value only if it is needed without racing with other threads that try to insert
+	 * the same key.
+	 */
+	template <typename K, typename F>
+	std::pair<Value, bool> find_or_insert(K&& key, F&& make_value) {
+		auto hash = hash_of(key);
+		auto& s = shard_for(hash);
+		{
+			util::epoch_guard guard;
+			auto n = find_node(s, hash, key);
+			if(n) return {n->value, false};
+		}
+		table* retired_table = nullptr;
+		std::pair<Value, bool> result = [&]() -> std::pair<Value, bool> {
+			std::lock_guard<decltype(s.write_lock)> lock(s.write_lock);
+			auto t = s.current.load(std::memory_order_relaxed);
+			if(t) {
+				auto index = find_index(*t, hash, key);
+				if(index != t->capacity()) {
+					return {t->slots[index].load(std::memory_order_relaxed)->value, false};
+				}
+			}
+			auto n = std::make_unique<node>(hash, std::forward<K>(key), std::forward<F>(make_value)());
+			retired_table = insert_new_node(s, n.get());
+			return {n.release()->value, true};
+		}();
+		retire(retired_table);
+		return result;
+	}
+
+	/// Removes the given key if it is present and returns true, otherwise returns false.
+	template <typename K>
+	bool erase(const K& key) {
+		auto hash = hash_of(key);
+		auto& s = shard_for(hash);
+		node* retired_node = nullptr;
+		{
+			std::lock_guard<decltype(s.write_lock)> lock(s.write_lock);
+			auto t = s.current.load(std::memory_order_relaxed);
+			if(!t) return false;
+			auto index = find_index(*t, hash, key);
+			if(index == t->capacity()) return false;
+			retired_node = remove_slot(s, *t, index);
+		}
+		retire(retired_node);
+		return true;
+	}
+	/// \brief Removes the given key if it is present and the predicate, called as pred(const Value&) while
+	/// holding the write lock of the shard, returns true and returns if the entry was removed.
+	template <typename K, typename P>
+	bool erase_if(const K& key, P pred) {
+		auto hash = hash_of(key);
+		auto& s = shard_for(hash);
+		node* retired_node = nullptr;
+		{
+			std::lock_guard<decltype(s.write_lock)> lock(s.write_lock);
+			auto t = s.current.load(std::memory_order_relaxed);
+			if(!t) return false;
+			auto index = find_index(*t, hash, key);
+			if(index == t->capacity()) return false;
+			if(!pred(static_cast<const Value&>(t->slots[index].load(std::memory_order_relaxed)->value))) {
+				return false;
+			}
+			retired_node = remove_slot(s, *t, index);
+		}
+		retire(retired_node);
+		return true;
+	}
+	/// \brief Removes all entries for which the predicate, called as pred(const Key&, const Value&), returns
+	/// true and returns the number of removed entries.
+	/**
+	 * Each shard is locked while its entries are checked. Entries inserted concurrently into shards that were
+	 * already processed are not checked.
+	 */
+	template <typename P>
+	size_t erase_if(P pred) {
+		size_t removed = 0;
+		std::vector<node*> retired_nodes;
+		for(size_t i = 0; i <= shard_mask_; ++i) {
+			auto& s = shards_[i];
+			{
+				std::lock_guard<decltype(s.write_lock)> lock(s.write_lock);
+				auto t = s.current.load(std::memory_order_relaxed);
+				if(!t) continue;
+				for(size_t j = 0; j < t->capacity(); ++j) {
+					auto n = t->slots[j].load(std::memory_order_relaxed);
+					if(n && pred(static_cast<const Key&>(n->key), static_cast<const Value&>(n->value))) {
+						retired_nodes.push_back(remove_slot(s, *t, j));
+					}
+				}
+			}
+			for(auto n : retired_nodes) {
+				retire(n);
+			}
+			removed += retired_nodes.size();
+			retired_nodes.clear();
+		}
+		return removed;
+	}
+	/// Removes all entries.
+	void clear() {
+		erase_if([](const Key&, const Value&) { return true; });
+	}
+
+	/// Calls f as f(const Key&, const Value&) for all entries.
+	/**
+	 * The iteration is weakly consistent: Entries that are inserted, replaced or removed concurrently may or
+	 * may not be visited, but entries that are present and unmodified during the whole iteration are visited
+	 * exactly once.
+	 */
+	template <typename F>
+	void for_each(F f) const {
+		util::epoch_guard guard;
+		for(size_t i = 0; i <= shard_mask_; ++i) {
+			const table* t = shards_[i].current.load(std::memory_order_acquire);
+			if(!t) continue;
+			for(size_t j = 0; j < t->capacity(); ++j) {
+				const node* n = t->slots[j].load(std::memory_order_acquire);
+				if(n) f(static_cast<const Key&>(n->key), static_cast<const Value&>(n->value));
+			}
+		}
+	}
+
+	/// \brief Calls f as f(const Key&, const Value&) for up to max_entries entries, starting the search at a
+	/// slot selected by the given position, and returns the number of visited entries.
+	/**
+	 * Passing random positions allows sampling the map without visiting all entries. Fewer than max_entries
+	 * entries are only visited if the map holds fewer entries. The consistency is the same as for for_each.
+	 */
+	template <typename F>
+	size_t for_each_sample(size_t position, size_t max_entries, F f) const {
+		util::epoch_guard guard;
+		size_t visited = 0;
+		for(size_t i = 0; i <= shard_mask_ && visited < max_entries; ++i) {
+			const table* t = shards_[(position + i) & shard_mask_].current.load(std::memory_order_acquire);
+			if(!t) continue;
+			// The capacity is a power of two.
+			auto slot_mask = t->capacity() - 1;
+			auto first_slot = position / (shard_mask_ + 1);
+			for(size_t j = 0; j < t->capacity() && visited < max_entries; ++j) {
+				const node* n = t->slots[(first_slot + j) & slot_mask].load(std::memory_order_acquire);
+				if(!n) continue;
+				f(static_cast<const Key&>(n->key), static_cast<const Value&>(n->value));
+				++visited;
+			}
+		}
+		return visited;
+	}
+
+	/// Returns the number of entries, which may already be outdated if the map is modified concurrently.
+	size_t size() const noexcept {
+		size_t result = 0;
+		for(size_t i = 0; i <= shard_mask_; ++i) {
+			result += shards_[i].size.load(std::memory_order_relaxed);
+		}
+		return result;
+	}
+	/// Checks if the map is empty, which may already be outdated if the map is modified concurrently.
+	bool empty() const noexcept {
+		return size() == 0;
+	}
+	/// Returns the number of shards.
+	size_t shard_count() const noexcept {
+		return shard_mask_ + 1;
+	}
+};
+
+} // namespace containers
+} // namespace mce
+
+#endif /* CONTAINERS_CONCURRENT_HASH_MAP_HPP_ */
@@ -8,9 +8,9 @@
 #define MCE_CONTAINERS_DYNAMIC_ARRAY_HPP_
 
 #include <iterator>
-#include <mce/memory/align.hpp>
 #include <mce/util/traits.hpp>
 #include <memory>
+#include <memory_resource>
 #include <type_traits>
 
 namespace mce {
@@ -91,27 +91,44 @@ struct construct_helper<T, false> {
  * requirements needed for reallocation on T.
  * The complete array can be move and copy assigned and constructed but the object doesn't support resizing
  * without replacing.
+ *
+ * The memory for the elements is obtained from the std::pmr::memory_resource of the std::pmr allocator
+ * passed to the constructors taking std::allocator_arg_t (e.g. the per-thread arenas of
+ * mce::memory::frame_arena) or from the default resource otherwise. Copies use the default resource unless
+ * an allocator is given explicitly. In contrast to std::pmr containers, move assignment and swapping take
+ * over the allocator of the source because they never move the individual elements.
  */
 template <typename T>
 class dynamic_array {
-	std::unique_ptr<char[]> raw_data_;
+public:
+	/// The type of the allocator used to obtain the memory for the elements.
+	using allocator_type = std::pmr::polymorphic_allocator<T>;
+
+private:
+	std::pmr::memory_resource* resource_ = std::pmr::get_default_resource();
 	T* data_;
 	size_t size_;
+	size_t capacity_;
 
 	void allocate(size_t size) {
-		auto space = size * sizeof(T) + alignof(T);
-		raw_data_ = std::make_unique<char[]>(space);
-		void* aptr = raw_data_.get();
-		if(!memory::align(alignof(T), size * sizeof(T), aptr, space)) {
-			throw std::bad_alloc();
-		}
-		data_ = reinterpret_cast<T*>(aptr);
+		data_ = size ? allocator_type(resource_).allocate(size) : nullptr;
+		capacity_ = size;
+	}
+	void deallocate() noexcept {
+		if(data_) allocator_type(resource_).deallocate(data_, capacity_);
+		data_ = nullptr;
+		capacity_ = 0;
 	}
 	void free() {
 		for(size_t i = 0; i < size_; ++i) {
 			data_[i].~T();
 		}
 	}
+	void free_and_deallocate() noexcept {
+		free();
+		size_ = 0;
+		deallocate();
+	}
 	template <typename... Args, typename U = T>
 	void construct(void* ptr, Args&&... args) {
 		detail::construct_helper<U, std::is_constructible<U, Args...>::value>::construct(
@@ -141,29 +158,45 @@ public:
 	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
 	/// Creates an empty dynamic_array.
-	dynamic_array() : data_{nullptr}, size_{0} {}
+	dynamic_array() : data_{nullptr}, size_{0}, capacity_{0} {}
+
+	/// Creates an empty dynamic_array that uses the given allocator.
+	dynamic_array(std::allocator_arg_t, const allocator_type& alloc)
+			: resource_{alloc.resource()}, data_{nullptr}, size_{0}, capacity_{0} {}
 
 	/// Creates a dynamic_array containing the given number of copies of the given value.
-	dynamic_array(size_type size, const_reference value) : data_{nullptr}, size_{0} {
+	dynamic_array(size_type size, const_reference value)
+			: dynamic_array(std::allocator_arg, allocator_type(), size, value) {}
+
+	/// \brief Creates a dynamic_array containing the given number of copies of the given value using the
+	/// given allocator.
+	dynamic_array(std::allocator_arg_t, const allocator_type& alloc, size_type size, const_reference value)
+			: resource_{alloc.resource()}, data_{nullptr}, size_{0}, capacity_{0} {
 		allocate(size);
 		for(; size_ < size; ++size_) {
 			try {
 				construct(data_ + size_, value);
 			} catch(...) {
-				free();
+				free_and_deallocate();
 				throw;
 			}
 		}
 	}
 
 	/// Creates a dynamic_array containing the values from the given std::initializer_list.
-	explicit dynamic_array(std::initializer_list<value_type> values) : data_{nullptr}, size_{0} {
+	explicit dynamic_array(std::initializer_list<value_type> values)
+			: dynamic_array(std::allocator_arg, allocator_type(), values) {}
+
+	/// \brief Creates a dynamic_array containing the values from the given std::initializer_list using the
+	/// given allocator.
+	dynamic_array(std::allocator_arg_t, const allocator_type& alloc, std::initializer_list<value_type> values)
+			: resource_{alloc.resource()}, data_{nullptr}, size_{0}, capacity_{0} {
 		allocate(values.size());
 		for(const auto& val : values) {
 			try {
 				construct(data_ + size_, val);
 			} catch(...) {
-				free();
+				free_and_deallocate();
 				throw;
 			}
 			++size_;
@@ -181,27 +214,42 @@ public:
 	 * deduction using generator_param(F).
 	 */
 	template <typename... Args>
-	dynamic_array(size_type size, Args&&... args) : data_{nullptr}, size_{0} {
+	dynamic_array(size_type size, Args&&... args)
+			: dynamic_array(std::allocator_arg, allocator_type(), size, std::forward<Args>(args)...) {}
+
+	/// \brief Creates a dynamic_array with the given number of values constructed by forwarding the given
+	/// constructor arguments using the given allocator.
+	/**
+	 * The place holder tags described for the constructor without allocator are supported.
+	 */
+	template <typename... Args>
+	dynamic_array(std::allocator_arg_t, const allocator_type& alloc, size_type size, Args&&... args)
+			: resource_{alloc.resource()}, data_{nullptr}, size_{0}, capacity_{0} {
 		allocate(size);
 		for(size_type i = 0; size_ < size; ++size_, ++i) {
 			try {
 				construct(data_ + size_,
 						  detail::dynamic_array_ctor_param_switch_helper<Args>::pass(args, i)...);
 			} catch(...) {
-				free();
+				free_and_deallocate();
 				throw;
 			}
 		}
 	}
 
 	/// Constructs a dynamic_array by copying the given dynamic_array and it's contents.
-	dynamic_array(const dynamic_array& other) : data_{nullptr}, size_{0} {
+	dynamic_array(const dynamic_array& other) : dynamic_array(std::allocator_arg, allocator_type(), other) {}
+
+	/// \brief Constructs a dynamic_array by copying the given dynamic_array and it's contents using the given
+	/// allocator.
+	dynamic_array(std::allocator_arg_t, const allocator_type& alloc, const dynamic_array& other)
+			: resource_{alloc.resource()}, data_{nullptr}, size_{0}, capacity_{0} {
 		allocate(other.size());
 		for(const auto& val : other) {
 			try {
 				construct(data_ + size_, val);
 			} catch(...) {
-				free();
+				free_and_deallocate();
 				throw;
 			}
 			++size_;
@@ -209,18 +257,23 @@ public:
 	}
 
 	/// Replaces this dynamic_array with a copy of the given array.
+	/**
+	 * The copy keeps using the allocator of this dynamic_array.
+	 */
 	dynamic_array& operator=(const dynamic_array& other) {
 		if(this == std::addressof(other)) return *this;
 		free();
-		if(size_ != other.size_) {
+		size_ = 0;
+		if(capacity_ != other.size_) {
+			deallocate();
 			allocate(other.size_);
 		}
-		size_ = 0;
 		for(const auto& val : other) {
 			try {
 				construct(data_ + size_, val);
 			} catch(...) {
 				free();
+				size_ = 0;
 				throw;
 			}
 			++size_;
@@ -230,25 +283,32 @@ public:
 
 	/// Allows move-construction.
 	dynamic_array(dynamic_array&& other) noexcept
-			: raw_data_{std::move(other.raw_data_)}, data_{other.data_}, size_{other.size_} {
+			: resource_{other.resource_}, data_{other.data_}, size_{other.size_}, capacity_{other.capacity_} {
 		other.data_ = nullptr;
 		other.size_ = 0;
+		other.capacity_ = 0;
 	}
 
 	/// Replaces this dynamic_array by moving the given array into it.
+	/**
+	 * This dynamic_array takes over the allocator of the given array together with its contents.
+	 */
 	dynamic_array& operator=(dynamic_array&& other) noexcept {
-		free();
-		raw_data_ = std::move(other.raw_data_);
+		if(this == std::addressof(other)) return *this;
+		free_and_deallocate();
+		resource_ = other.resource_;
 		data_ = other.data_;
 		size_ = other.size_;
+		capacity_ = other.capacity_;
 		other.data_ = nullptr;
 		other.size_ = 0;
+		other.capacity_ = 0;
 		return *this;
 	}
 
 	/// Destroys the array and it's contents.
 	~dynamic_array() noexcept {
-		free();
+		free_and_deallocate();
 	}
 
 	/// Allows read-write access to the element with the given index with bounds check.
@@ -379,6 +439,11 @@ public:
 		return data_;
 	}
 
+	/// Returns a copy of the allocator used by the dynamic_array.
+	allocator_type get_allocator() const noexcept {
+		return allocator_type(resource_);
+	}
+
 	/// Returns the number of elements in the dynamic_array.
 	size_type size() const noexcept {
 		return size_;
@@ -387,9 +452,10 @@ public:
 	/// Swaps the contents of *this and other.
 	void swap(dynamic_array& other) noexcept {
 		using std::swap;
-		swap(raw_data_, other.raw_data_);
+		swap(resource_, other.resource_);
 		swap(data_, other.data_);
 		swap(size_, other.size_);
+		swap(capacity_, other.capacity_);
 	}
 
 	/// Swaps the contents of both given dynamic_array objects.
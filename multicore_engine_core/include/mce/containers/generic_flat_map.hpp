@@ -17,11 +17,13 @@
 #include <cstdint>
 #include <functional>
 #include <iterator>
+#include <memory_resource>
 #include <stdexcept>
 #include <string>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace mce {
 namespace containers {
@@ -921,7 +923,7 @@ public:
 
 	/// Returns the number of key-value-pairs matching the given key in the map.
 	size_t count(const Key& key) const {
-		auto range = equal_range(key);
+		auto range = this->equal_range(key);
 		return std::distance(range.first, range.second);
 	}
 
@@ -953,6 +955,20 @@ void swap(generic_flat_multimap<Container, Key, Value, Compare>& m1,
 	m1.swap(m2);
 }
 
+/// \brief Alias template for a generic_flat_map that stores its elements in a std::pmr::vector and therefore
+/// obtains its memory from a std::pmr::memory_resource.
+/**
+ * The resource is given by passing a std::pmr::polymorphic_allocator (or a pointer to the resource) to the
+ * constructor, e.g. as <code>pmr_flat_map<int, float> m(frame_arena.allocator());</code>.
+ */
+template <typename Key, typename Value, typename Compare = std::less<>>
+using pmr_flat_map = generic_flat_map<std::pmr::vector, Key, Value, Compare>;
+
+/// \brief Alias template for a generic_flat_multimap that stores its elements in a std::pmr::vector and
+/// therefore obtains its memory from a std::pmr::memory_resource.
+template <typename Key, typename Value, typename Compare = std::less<>>
+using pmr_flat_multimap = generic_flat_multimap<std::pmr::vector, Key, Value, Compare>;
+
 } // namespace containers
 } // namespace mce
 
@@ -7,28 +7,141 @@
 #ifndef MCE_CONTAINERS_PER_THREAD_HPP_
 #define MCE_CONTAINERS_PER_THREAD_HPP_
 
+#include <array>
 #include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iterator>
 #include <mce/containers/dynamic_array.hpp>
 #include <mce/exceptions.hpp>
+#include <mce/util/unused.hpp>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace mce {
 namespace containers {
 
-/// \brief Provides functionality to assign indexes from a fixed-size range of index slots to threads in a
-/// lock-free way.
-class per_thread_index {
-	size_t total_slots_;
-	std::atomic<size_t> used_slots_;
-	dynamic_array<std::atomic<std::thread::id>> owners_;
+/// \brief Tag type to select the constructors of per_thread_index and per_thread that add slots on demand
+/// instead of throwing when all slots are taken.
+struct growable_slots_tag {};
+
+template <typename T>
+class per_thread;
+
+namespace detail {
+
+struct per_thread_cache_entry {
+	uint64_t generation;
+	size_t index;
+	void* element;
+};
+
+constexpr unsigned per_thread_cache_bits = 4;
+
+// Returns the entry of the thread-local direct-mapped slot cache that is responsible for the given instance.
+// Generations are unique across all instances, a matching generation therefore identifies the entry as
+// belonging to the instance even if several instances map to the same entry.
+inline per_thread_cache_entry& per_thread_cache(uint64_t instance_id) noexcept {
+	thread_local per_thread_cache_entry cache[1u << per_thread_cache_bits] = {};
+	return cache[(instance_id * UINT64_C(0x9E3779B97F4A7C15)) >> (64 - per_thread_cache_bits)];
+}
+
+uint64_t next_per_thread_generation() noexcept;
+
+struct per_thread_index_state {
+	static constexpr size_t max_segments = 32;
+
+	// Segment 0 holds initial_slots slots, every further segment doubles the total number of slots.
+	std::array<std::unique_ptr<std::atomic<std::thread::id>[]>, max_segments> owner_segments;
+	size_t initial_slots;
+	bool growable;
+	size_t segment_count;
+	std::atomic<size_t> total_slots;
+	std::atomic<size_t> used_slots;
+	std::atomic<size_t> released_count;
+	std::vector<size_t> released_slots;
+	std::atomic<uint64_t> generation;
+	std::mutex mutex;
+	std::function<void(size_t segment, size_t first, size_t count)> grow_hook;
+
+	per_thread_index_state(size_t initial_slots, bool growable);
+
+	std::pair<size_t, size_t> location(size_t index) const noexcept {
+		if(index < initial_slots) return {0, index};
+		size_t segment = 0;
+		for(size_t i = index / initial_slots; i; i >>= 1) ++segment;
+		return {segment, index - (initial_slots << (segment - 1))};
+	}
+	std::atomic<std::thread::id>& owner(size_t index) noexcept {
+		auto loc = location(index);
+		return owner_segments[loc.first][loc.second];
+	}
+	void grow(size_t required_slots);
+	void release_slot(size_t index, uint64_t slot_generation, std::thread::id thread) noexcept;
+	void clear();
+};
+
+template <typename T>
+struct per_thread_param_rebase_helper {
+	static const T& rebase(const T& t, size_t) {
+		return t;
+	}
+};
 
+template <typename Integral>
+struct per_thread_param_rebase_helper<index_param_tag<Integral>> {
+	static auto rebase(index_param_tag<Integral>, size_t first) {
+		return generator_param([first](size_t index) { return Integral(first + index); });
+	}
+};
+
+template <typename Functor>
+struct per_thread_param_rebase_helper<generator_param_tag<Functor>> {
+	static auto rebase(const generator_param_tag<Functor>& gt, size_t first) {
+		return generator_param(
+				[f = gt.f, first](size_t index) mutable -> decltype(auto) { return f(first + index); });
+	}
+};
+
+} // namespace detail
+
+/// \brief Provides functionality to assign indexes from a range of index slots to threads in a lock-free way.
+/**
+ * The index of a thread is cached in thread-local storage and validated against a generation of the instance
+ * that changes on clear(). Looking up the index of a thread that already has a slot therefore only costs a
+ * thread-local load and a comparison.
+ *
+ * The slot of a thread is released when the thread exits and is handed out again to threads requesting a
+ * slot later.
+ */
+class per_thread_index {
 public:
 	/// The type used for sizes and indices.
 	using size_type = std::size_t;
 
-	/// Creates a per_thread with the given number of slots for the threads.
-	explicit per_thread_index(size_type slots)
-			: total_slots_{slots}, used_slots_{0}, owners_(slots, std::thread::id()) {}
+private:
+	std::shared_ptr<detail::per_thread_index_state> state_;
+	uint64_t instance_id_;
+
+	template <typename T>
+	friend class per_thread;
+
+	uint64_t generation() const noexcept {
+		return state_->generation.load(std::memory_order_relaxed);
+	}
+	size_type acquire_slot(detail::per_thread_cache_entry& entry);
+
+public:
+	/// Creates a per_thread_index with the given fixed number of slots for the threads.
+	explicit per_thread_index(size_type slots);
+	/// \brief Creates a per_thread_index with the given initial number of slots that doubles the number of
+	/// slots whenever all of them are taken.
+	per_thread_index(growable_slots_tag, size_type initial_slots);
 
 	/// Forbids copying.
 	per_thread_index(const per_thread_index&) = delete;
@@ -41,33 +154,29 @@ public:
 
 	/// Looks up and returns the index for the calling thread.
 	/**
-	 * If there are no slots left and the thread has no associated slot yet, an exception of type
-	 * mce::resource_depleted_exception is thrown.
+	 * If there are no slots left, the instance is not growable and the thread has no associated slot yet, an
+	 * exception of type mce::resource_depleted_exception is thrown.
 	 */
 	size_type slot_index() {
-		auto used = used_slots_.load();
-		auto my_id = std::this_thread::get_id();
-		for(size_type i = 0; i < used; ++i) {
-			if(owners_[i].load() == my_id) return i;
-		}
-		auto my_index = used_slots_.load();
-		do {
-			if(my_index == total_slots_) {
-				throw mce::resource_depleted_exception("No more slots available.");
-			}
-		} while(!used_slots_.compare_exchange_weak(my_index, my_index + 1));
-		owners_[my_index] = my_id;
-		return my_index;
+		auto& entry = detail::per_thread_cache(instance_id_);
+		if(entry.generation == generation()) return entry.index;
+		return acquire_slot(entry);
 	}
 
 	/// Returns the total number of slots in the pool.
 	size_type total_slots() const {
-		return total_slots_;
+		return state_->total_slots.load();
 	}
 
-	/// Returns the number of slots used by / assigned to a thread.
+	/// \brief Returns the number of slots used by / assigned to a thread including slots that were released
+	/// by exited threads.
 	size_type used_slots() const {
-		return used_slots_.load();
+		return state_->used_slots.load();
+	}
+
+	/// Returns true if the number of slots grows on demand.
+	bool growable() const noexcept {
+		return state_->growable;
 	}
 
 	/// Clears the index assignment and causes threads to reselect indices on next slot_index().
@@ -76,19 +185,159 @@ public:
 	 * execute concurrently with any other operation on this object.
 	 */
 	void clear() {
-		for(size_type i = 0; i < total_slots_; ++i) {
-			owners_[i] = std::thread::id();
-		}
-		used_slots_ = 0;
+		state_->clear();
 	}
 };
 
-/// \brief Provides a fixed size pool of objects that are associated to using threads but can also be accessed
+/// \brief Provides a pool of objects that are associated to using threads but can also be accessed
 /// single-threaded (e.g. by a management thread)..
+/**
+ * Objects of exited threads are kept and handed to threads requesting an object later. Pools created with
+ * growable_slots_tag construct additional objects when all of them are taken. The objects are never moved,
+ * references obtained from get() therefore stay valid while the pool grows.
+ */
 template <typename T>
 class per_thread {
 	per_thread_index index_mapping_;
-	dynamic_array<T> values_;
+	std::array<std::unique_ptr<dynamic_array<T>>, detail::per_thread_index_state::max_segments>
+			value_segments_;
+	std::function<std::unique_ptr<dynamic_array<T>>(size_t first, size_t count)> segment_factory_;
+
+	template <typename Params, size_t... Indices>
+	static std::unique_ptr<dynamic_array<T>> make_segment(const Params& params, size_t first, size_t count,
+														  std::index_sequence<Indices...>) {
+		// Unused if no constructor parameters are given.
+		UNUSED(params);
+		UNUSED(first);
+		return std::make_unique<dynamic_array<T>>(
+				count, detail::per_thread_param_rebase_helper<std::tuple_element_t<Indices, Params>>::rebase(
+							   std::get<Indices>(params), first)...);
+	}
+
+	T& element(size_t index) noexcept {
+		auto loc = index_mapping_.state_->location(index);
+		return (*value_segments_[loc.first])[loc.second];
+	}
+	const T& element(size_t index) const noexcept {
+		auto loc = index_mapping_.state_->location(index);
+		return (*value_segments_[loc.first])[loc.second];
+	}
+
+	template <typename Pool, typename Value>
+	class iterator_ {
+		Pool* pool_ = nullptr;
+		size_t index_ = 0;
+
+		iterator_(Pool* pool, size_t index) noexcept : pool_{pool}, index_{index} {}
+
+		friend class per_thread<T>;
+		template <typename, typename>
+		friend class iterator_;
+
+	public:
+		/// Specifies the category of the iterator.
+		using iterator_category = std::random_access_iterator_tag;
+		/// The type of the elements.
+		using value_type = std::remove_const_t<Value>;
+		/// The type used for distances between iterators.
+		using difference_type = std::ptrdiff_t;
+		/// The type used for pointers to the elements.
+		using pointer = Value*;
+		/// The type used for references to the elements.
+		using reference = Value&;
+
+		/// Creates an iterator that doesn't refer to any element.
+		iterator_() noexcept = default;
+		/// Allows conversion of read-write iterators to read-only iterators.
+		template <typename P, typename V,
+				  typename = std::enable_if_t<std::is_convertible<V*, Value*>::value>>
+		iterator_(const iterator_<P, V>& other) noexcept : pool_{other.pool_}, index_{other.index_} {}
+
+		/// Accesses the referred element.
+		reference operator*() const noexcept {
+			return pool_->element(index_);
+		}
+		/// Accesses the referred element.
+		pointer operator->() const noexcept {
+			return std::addressof(pool_->element(index_));
+		}
+		/// Accesses the element at the given offset from the referred element.
+		reference operator[](difference_type offset) const noexcept {
+			return pool_->element(index_ + offset);
+		}
+		/// Moves the iterator to the next element.
+		iterator_& operator++() noexcept {
+			++index_;
+			return *this;
+		}
+		/// Moves the iterator to the next element and returns the previous state.
+		iterator_ operator++(int) noexcept {
+			auto it = *this;
+			++index_;
+			return it;
+		}
+		/// Moves the iterator to the previous element.
+		iterator_& operator--() noexcept {
+			--index_;
+			return *this;
+		}
+		/// Moves the iterator to the previous element and returns the previous state.
+		iterator_ operator--(int) noexcept {
+			auto it = *this;
+			--index_;
+			return it;
+		}
+		/// Moves the iterator by the given offset.
+		iterator_& operator+=(difference_type offset) noexcept {
+			index_ += offset;
+			return *this;
+		}
+		/// Moves the iterator by the given offset in reverse direction.
+		iterator_& operator-=(difference_type offset) noexcept {
+			index_ -= offset;
+			return *this;
+		}
+		/// Returns an iterator moved by the given offset.
+		friend iterator_ operator+(iterator_ it, difference_type offset) noexcept {
+			return it += offset;
+		}
+		/// Returns an iterator moved by the given offset.
+		friend iterator_ operator+(difference_type offset, iterator_ it) noexcept {
+			return it += offset;
+		}
+		/// Returns an iterator moved by the given offset in reverse direction.
+		friend iterator_ operator-(iterator_ it, difference_type offset) noexcept {
+			return it -= offset;
+		}
+		/// Returns the distance between the given iterators.
+		friend difference_type operator-(const iterator_& a, const iterator_& b) noexcept {
+			return difference_type(a.index_) - difference_type(b.index_);
+		}
+		/// Checks if the given iterators refer to the same element.
+		friend bool operator==(const iterator_& a, const iterator_& b) noexcept {
+			return a.pool_ == b.pool_ && a.index_ == b.index_;
+		}
+		/// Checks if the given iterators refer to different elements.
+		friend bool operator!=(const iterator_& a, const iterator_& b) noexcept {
+			return !(a == b);
+		}
+		/// Checks if a refers to an element before the element referred to by b.
+		friend bool operator<(const iterator_& a, const iterator_& b) noexcept {
+			return a.index_ < b.index_;
+		}
+		/// Checks if a refers to an element after the element referred to by b.
+		friend bool operator>(const iterator_& a, const iterator_& b) noexcept {
+			return a.index_ > b.index_;
+		}
+		/// Checks if a refers to an element before or equal to the element referred to by b.
+		friend bool operator<=(const iterator_& a, const iterator_& b) noexcept {
+			return a.index_ <= b.index_;
+		}
+		/// Checks if a refers to an element after or equal to the element referred to by b.
+		friend bool operator>=(const iterator_& a, const iterator_& b) noexcept {
+			return a.index_ >= b.index_;
+		}
+	};
 
 public:
 	/// The type of the values in the pool.
@@ -104,9 +353,9 @@ public:
 	/// The type used for read-only pointers to the elements.
 	using const_pointer = const value_type*;
 	/// The type of read-write iterators over the elements.
-	using iterator = pointer;
+	using iterator = iterator_<per_thread, value_type>;
 	/// The type of read-only iterators over the elements.
-	using const_iterator = const_pointer;
+	using const_iterator = iterator_<const per_thread, const value_type>;
 	/// The type of read-write iterators over the elements with reversed traversal.
 	using reverse_iterator = std::reverse_iterator<iterator>;
 	/// The type of read-only iterators over the elements with reversed traversal.
@@ -123,8 +372,29 @@ public:
 	 * deduction using generator_param(F).
 	 */
 	template <typename... Args>
-	per_thread(size_type slots, Args&&... args)
-			: index_mapping_{slots}, values_(slots, std::forward<Args>(args)...) {}
+	per_thread(size_type slots, Args&&... args) : index_mapping_{slots} {
+		value_segments_[0] = std::make_unique<dynamic_array<T>>(slots, std::forward<Args>(args)...);
+	}
+
+	/// \brief Creates a per_thread with the given initial number of slots that constructs additional objects
+	/// when all slots are taken.
+	/**
+	 * The constructor parameters are handled as in the fixed-size constructor. They are copied and kept to
+	 * construct the objects of the additional slots later, place holder tags receive the global index of the
+	 * new objects.
+	 */
+	template <typename... Args>
+	per_thread(growable_slots_tag tag, size_type initial_slots, Args&&... args)
+			: index_mapping_{tag, initial_slots} {
+		segment_factory_ = [params = std::make_tuple(std::forward<Args>(args)...)](size_t first,
+																				   size_t count) {
+			return make_segment(params, first, count, std::index_sequence_for<Args...>{});
+		};
+		value_segments_[0] = segment_factory_(0, index_mapping_.total_slots());
+		index_mapping_.state_->grow_hook = [this](size_t segment, size_t first, size_t count) {
+			value_segments_[segment] = segment_factory_(first, count);
+		};
+	}
 
 	/// Forbids copying.
 	per_thread(const per_thread&) = delete;
@@ -137,74 +407,80 @@ public:
 
 	/// Looks up and returns the index for the calling thread.
 	/**
-	 * If there are no slots left and the thread has no associated slot yet, an exception of type
-	 * mce::resource_depleted_exception is thrown.
+	 * If there are no slots left, the pool is not growable and the thread has no associated slot yet, an
+	 * exception of type mce::resource_depleted_exception is thrown.
 	 */
 	size_type slot_index() {
 		return index_mapping_.slot_index();
 	}
 	/// Looks up the index for the calling thread and returns a reference to the associated object.
 	/**
-	 * If there are no slots left and the thread has no associated slot yet, an exception of type
-	 * mce::resource_depleted_exception is thrown.
+	 * If there are no slots left, the pool is not growable and the thread has no associated slot yet, an
+	 * exception of type mce::resource_depleted_exception is thrown.
 	 */
 	reference get() {
-		return values_[slot_index()];
+		auto& entry = detail::per_thread_cache(index_mapping_.instance_id_);
+		if(entry.generation == index_mapping_.generation() && entry.element) {
+			return *static_cast<T*>(entry.element);
+		}
+		if(entry.generation != index_mapping_.generation()) index_mapping_.acquire_slot(entry);
+		entry.element = std::addressof(element(entry.index));
+		return *static_cast<T*>(entry.element);
 	}
 
 	/// Returns an read-write iterator referring to the beginning of the used part of the objects array.
 	iterator begin() noexcept {
-		return values_.begin();
+		return iterator(this, 0);
 	}
 	/// Returns an read-only iterator referring to the beginning of the used part of the objects array.
 	const_iterator begin() const noexcept {
-		return values_.begin();
+		return const_iterator(this, 0);
 	}
 	/// Returns an read-only iterator referring to the beginning of the used part of the objects array.
 	const_iterator cbegin() const noexcept {
-		return values_.cbegin();
+		return const_iterator(this, 0);
 	}
 	/// Returns an read-write iterator referring to the end of the used part of the objects array.
 	iterator end() noexcept {
-		return values_.begin() + index_mapping_.used_slots();
+		return iterator(this, index_mapping_.used_slots());
 	}
 	/// Returns an read-only iterator referring to the end of the used part of the objects array.
 	const_iterator end() const noexcept {
-		return values_.begin() + index_mapping_.used_slots();
+		return const_iterator(this, index_mapping_.used_slots());
 	}
 	/// Returns an read-only iterator referring to the end of the used part of the objects array.
 	const_iterator cend() const noexcept {
-		return values_.cbegin() + index_mapping_.used_slots();
+		return const_iterator(this, index_mapping_.used_slots());
 	}
 	/// \brief Returns an read-write iterator referring to the beginning of the used part of the objects array
 	/// in reverse order.
 	reverse_iterator rbegin() noexcept {
-		return end();
+		return reverse_iterator(end());
 	}
 	/// \brief Returns an read-only iterator referring to the beginning of the used part of the objects array
 	/// in reverse order.
 	const_reverse_iterator rbegin() const noexcept {
-		return end();
+		return const_reverse_iterator(end());
 	}
 	/// \brief Returns an read-only iterator referring to the beginning of the used part of the objects array
 	/// in reverse order.
 	const_reverse_iterator crbegin() const noexcept {
-		return cend();
+		return const_reverse_iterator(cend());
 	}
 	/// \brief Returns an read-write iterator referring to the end of the used part of the objects array in
 	/// reverse order.
 	reverse_iterator rend() noexcept {
-		return begin();
+		return reverse_iterator(begin());
 	}
 	/// \brief Returns an read-only iterator referring to the end of the used part of the objects array in
 	/// reverse order.
 	const_reverse_iterator rend() const noexcept {
-		return begin();
+		return const_reverse_iterator(begin());
 	}
 	/// \brief Returns an read-only iterator referring to the end of the used part of the objects array in
 	/// reverse order.
 	const_reverse_iterator crend() const noexcept {
-		return cbegin();
+		return const_reverse_iterator(cbegin());
 	}
 
 	/// Returns the total number of slots in the pool.
@@ -212,7 +488,8 @@ public:
 		return index_mapping_.total_slots();
 	}
 
-	/// Returns the number of slots used by / assigned to a thread.
+	/// \brief Returns the number of slots used by / assigned to a thread including slots that were released
+	/// by exited threads.
 	size_type used_slots() const noexcept {
 		return index_mapping_.used_slots();
 	}
@@ -229,115 +506,115 @@ public:
 	/// \brief Proxy class used to provide const access to the full range of the objects array instead of just
 	/// the used part.
 	class const_all_range {
-		const dynamic_array<T>& values_;
-		explicit const_all_range(const dynamic_array<T>& values) : values_{values} {}
+		const per_thread<T>& pool_;
+		explicit const_all_range(const per_thread<T>& pool) : pool_{pool} {}
 
 		friend class per_thread<T>;
 
 	public:
 		/// Returns an read-only iterator referring to the beginning of the objects array.
 		const_iterator begin() const noexcept {
-			return values_.begin();
+			return pool_.begin();
 		}
 		/// Returns an read-only iterator referring to the beginning of the objects array.
 		const_iterator cbegin() const noexcept {
-			return values_.cbegin();
+			return pool_.cbegin();
 		}
 		/// Returns an read-only iterator referring to the end of the objects array.
 		const_iterator end() const noexcept {
-			return values_.end();
+			return pool_.begin() + pool_.total_slots();
 		}
 		/// Returns an read-only iterator referring to the end of the objects array.
 		const_iterator cend() const noexcept {
-			return values_.cend();
+			return pool_.cbegin() + pool_.total_slots();
 		}
 		/// Returns an read-only iterator referring to the beginning of the objects array in reverse order.
 		const_reverse_iterator rbegin() const noexcept {
-			return end();
+			return const_reverse_iterator(end());
 		}
 		/// Returns an read-only iterator referring to the beginning of the objects array in reverse order.
 		const_reverse_iterator crbegin() const noexcept {
-			return end();
+			return const_reverse_iterator(end());
 		}
 		/// Returns an read-only iterator referring to the end of the objects array in reverse order.
 		const_reverse_iterator rend() const noexcept {
-			return begin();
+			return const_reverse_iterator(begin());
 		}
 		/// Returns an read-only iterator referring to the end of the objects array in reverse order.
 		const_reverse_iterator crend() const noexcept {
-			return begin();
+			return const_reverse_iterator(begin());
 		}
 	};
 
 	/// \brief Proxy class used to provide access to the full range of the objects array instead of just
 	/// the used part.
 	class all_range {
-		dynamic_array<T>& values_;
-		explicit all_range(dynamic_array<T>& values) : values_{values} {}
+		per_thread<T>& pool_;
+		explicit all_range(per_thread<T>& pool) : pool_{pool} {}
 
 		friend class per_thread<T>;
 
 	public:
 		/// Returns an read-write iterator referring to the beginning of the objects array.
 		iterator begin() noexcept {
-			return values_.begin();
+			return pool_.begin();
 		}
 		/// Returns an read-only iterator referring to the beginning of the objects array.
 		const_iterator begin() const noexcept {
-			return values_.begin();
+			return pool_.cbegin();
 		}
 		/// Returns an read-only iterator referring to the beginning of the objects array.
 		const_iterator cbegin() const noexcept {
-			return values_.cbegin();
+			return pool_.cbegin();
 		}
 		/// Returns an read-write iterator referring to the end of the objects array.
 		iterator end() noexcept {
-			return values_.end();
+			return pool_.begin() + pool_.total_slots();
 		}
 		/// Returns an read-only iterator referring to the end of the objects array.
 		const_iterator end() const noexcept {
-			return values_.end();
+			return pool_.cbegin() + pool_.total_slots();
 		}
 		/// Returns an read-only iterator referring to the end of the objects array.
 		const_iterator cend() const noexcept {
-			return values_.cend();
+			return pool_.cbegin() + pool_.total_slots();
 		}
 		/// Returns an read-write iterator referring to the beginning of the objects array in reverse order.
 		reverse_iterator rbegin() noexcept {
-			return end();
+			return reverse_iterator(end());
 		}
 		/// Returns an read-only iterator referring to the beginning of the objects array in reverse order.
 		const_reverse_iterator rbegin() const noexcept {
-			return end();
+			return const_reverse_iterator(end());
 		}
 		/// Returns an read-only iterator referring to the beginning of the objects array in reverse order.
 		const_reverse_iterator crbegin() const noexcept {
-			return cend();
+			return const_reverse_iterator(cend());
 		}
 		/// Returns an read-write iterator referring to the end of the objects array in reverse order.
 		reverse_iterator rend() noexcept {
-			return begin();
+			return reverse_iterator(begin());
 		}
 		/// Returns an read-only iterator referring to the end of the objects array in reverse order.
 		const_reverse_iterator rend() const noexcept {
-			return begin();
+			return const_reverse_iterator(begin());
 		}
 		/// Returns an read-only iterator referring to the end of the objects array in reverse order.
 		const_reverse_iterator crend() const noexcept {
-			return cbegin();
+			return const_reverse_iterator(cbegin());
 		}
 	};
 
 	/// Returns a proxy range object that provides access over the full range of the objects array instead of
 	/// just the used part.
 	all_range all() noexcept {
-		return all_range(values_);
+		return all_range(*this);
 	}
 
 	/// Returns a proxy range object that provides const access over the full range of the objects array
 	/// instead of just the used part.
 	const_all_range all() const noexcept {
-		return const_all_range(values_);
+		return const_all_range(*this);
 	}
 };
 
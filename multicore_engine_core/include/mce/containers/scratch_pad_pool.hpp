@@ -12,13 +12,48 @@
  * Defines a generic pool to handle temporary resources.
  */
 
+#include <cstddef>
+#include <mce/util/instrumented_lock.hpp>
+#include <memory>
+#include <memory_resource>
 #include <mutex>
 #include <stack>
 #include <type_traits>
+#include <vector>
 
 namespace mce {
 namespace containers {
 
+namespace detail {
+
+template <typename T,
+		  bool = std::uses_allocator<T, std::pmr::polymorphic_allocator<std::byte>>::value,
+		  bool = std::is_constructible<T, std::allocator_arg_t,
+									   const std::pmr::polymorphic_allocator<std::byte>&>::value>
+struct scratch_pad_pool_construct_helper {
+	static T construct(std::pmr::memory_resource*) {
+		return T();
+	}
+};
+
+template <typename T>
+struct scratch_pad_pool_construct_helper<T, true, true> {
+	static T construct(std::pmr::memory_resource* resource) {
+		if(!resource) return T();
+		return T(std::allocator_arg, std::pmr::polymorphic_allocator<std::byte>(resource));
+	}
+};
+
+template <typename T>
+struct scratch_pad_pool_construct_helper<T, true, false> {
+	static T construct(std::pmr::memory_resource* resource) {
+		if(!resource) return T();
+		return T(std::pmr::polymorphic_allocator<std::byte>(resource));
+	}
+};
+
+} // namespace detail
+
 /// This class provides a thread-safe pool of temporary containers of type T for intermediate buffers.
 /**
  * The advantage of having a pool of such containers allows them to grow to appropriate size and be reused
@@ -43,6 +78,13 @@ namespace containers {
  *
  * //When obj goes out of scope the container is handed back to the pool.
  * \endcode
+ *
+ * If the pool is constructed with a std::pmr::memory_resource and T uses a std::pmr allocator (e.g.
+ * std::pmr::vector<some_type>), new T-objects are created using that resource. Because the objects keep
+ * their memory while they are in the pool, the resource must outlive the pool and must not release memory
+ * in bulk while the objects exist, i.e. the arenas of mce::memory::frame_arena are not suitable. As the
+ * objects are handed out to different threads, the resource must be thread-safe, e.g. a
+ * std::pmr::synchronized_pool_resource.
  */
 template <typename T>
 class scratch_pad_pool {
@@ -50,15 +92,24 @@ class scratch_pad_pool {
 				  "scratch_pad_pool<T> can only be used efficiently if T is nothrow movable.");
 
 private:
-	std::mutex pool_mutex;
-	std::stack<T> pool;
+	util::instrumented_lock<> pool_mutex{"containers.scratch_pad_pool"};
+	std::stack<T, std::vector<T>> pool;
+	std::pmr::memory_resource* resource = nullptr;
 	void give_back(T&& obj) noexcept {
 		obj.clear();
-		std::lock_guard<std::mutex> lock(pool_mutex);
+		std::lock_guard<decltype(pool_mutex)> lock(pool_mutex);
 		pool.push(std::move_if_noexcept(obj));
 	}
 
 public:
+	/// Creates an empty pool that default-constructs new T-objects.
+	scratch_pad_pool() = default;
+	/// Creates an empty pool that constructs new T-objects using the given memory resource.
+	/**
+	 * If T is not allocator-aware, the resource is ignored and new T-objects are default-constructed.
+	 */
+	explicit scratch_pad_pool(std::pmr::memory_resource* resource) : resource{resource} {}
+
 	/// \brief RAII-wrapper for a handed out T-object that takes care of handing it back into the pool when
 	/// going out of scope.
 	class object {
@@ -111,9 +162,9 @@ public:
 	 * into the pool, essentially growing the pool.
 	 */
 	object get() {
-		std::lock_guard<std::mutex> lock(pool_mutex);
+		std::lock_guard<decltype(pool_mutex)> lock(pool_mutex);
 		if(pool.empty()) {
-			return object(this, T());
+			return object(this, detail::scratch_pad_pool_construct_helper<T>::construct(resource));
 		} else {
 			object o(this, std::move_if_noexcept(pool.top()));
 			pool.pop();
@@ -21,6 +21,7 @@
 #include <mce/containers/scratch_pad_pool.hpp>
 #include <mce/containers/smart_pool_ptr.hpp>
 #include <mce/memory/aligned_new.hpp>
+#include <mce/memory/block_allocation_policies.hpp>
 #include <mce/util/local_function.hpp>
 #include <memory>
 #include <mutex>
@@ -56,8 +57,13 @@ struct smart_object_pool_range;
  * However locking is used for managing the list of free object blocks and the pending destruction list,
  * therefore creating and destroying objects implies locking and destroying and iterator on the structure may
  * trigger locking if it is the last active iterator.
+ *
+ * The memory for the blocks is obtained through Block_Allocation_Policy (see
+ * memory::default_block_allocation_policy and memory::huge_page_block_allocation_policy), which allows
+ * placing large and frequently iterated pools in huge pages to reduce TLB misses.
  */
-template <typename T, size_t block_size = 0x10000u>
+template <typename T, size_t block_size = 0x10000u,
+		  typename Block_Allocation_Policy = memory::default_block_allocation_policy>
 class smart_object_pool {
 	template <typename It>
 	friend struct smart_object_pool_range;
@@ -218,10 +224,9 @@ private:
 	};
 
 	struct block final : public detail::smart_object_pool_block_interface {
-		ALIGNED_NEW_AND_DELETE(block)
 		block_entry entries[block_size];
 		alignas(cacheline_alignment) ref_count_ ref_counts[block_size];
-		alignas(cacheline_alignment) smart_object_pool<T, block_size>* owning_pool;
+		alignas(cacheline_alignment) smart_object_pool<T, block_size, Block_Allocation_Policy>* owning_pool;
 		std::atomic<block*> next_block{nullptr};
 		std::atomic<block*> prev_block;
 		const size_t block_index;
@@ -250,7 +255,7 @@ private:
 		}
 
 		// May only be called inside of a lock on free list
-		block(smart_object_pool<T, block_size>* owning_pool, block_entry_link& prev,
+		block(smart_object_pool<T, block_size, Block_Allocation_Policy>* owning_pool, block_entry_link& prev,
 			  block* prev_block = nullptr) noexcept
 				: owning_pool{owning_pool}, prev_block{prev_block}, block_index{owning_pool->block_count} {
 			ref_counts[block_size - 1].strong = {-1, 0u};
@@ -352,7 +357,7 @@ private:
 
 	alignas(cacheline_alignment) std::mutex free_list_mutex;
 	block_entry_link first_free_entry = {nullptr, nullptr};
-	std::vector<std::unique_ptr<block>> blocks;
+	std::vector<memory::policy_allocated_ptr<block, Block_Allocation_Policy>> blocks;
 	std::atomic<size_t> allocated_objects{0};
 	std::atomic<block*> first_block{nullptr};
 	std::atomic<size_t> block_count{0};
@@ -383,10 +388,12 @@ private:
 	// May only be called when holding a lock on free list mutex
 	void grow() {
 		if(blocks.empty()) {
-			blocks.emplace_back(std::make_unique<block>(this, first_free_entry));
+			blocks.emplace_back(
+					memory::make_policy_allocated<block, Block_Allocation_Policy>(this, first_free_entry));
 			first_block = blocks.front().get();
 		} else {
-			blocks.emplace_back(std::make_unique<block>(this, first_free_entry, blocks.back().get()));
+			blocks.emplace_back(memory::make_policy_allocated<block, Block_Allocation_Policy>(
+					this, first_free_entry, blocks.back().get()));
 		}
 		++block_count;
 	}
@@ -530,21 +537,22 @@ public:
 		using reference = It_T&;
 
 	private:
+		typedef smart_object_pool<T, block_size, Block_Allocation_Policy> pool_type;
 		Target_T target;
-		const smart_object_pool<T, block_size>* pool;
+		const pool_type* pool;
 		bool is_limiter = false;
-		friend class smart_object_pool<T, block_size>;
+		friend class smart_object_pool<T, block_size, Block_Allocation_Policy>;
 		template <typename It>
 		friend struct smart_object_pool_range;
 
 		struct no_skip_tag {};
 
-		iterator_(Target_T target, const smart_object_pool<T, block_size>* pool, no_skip_tag)
+		iterator_(Target_T target, const pool_type* pool, no_skip_tag)
 				: target(target), pool{pool} {
 			++(pool->active_iterators);
 		}
 
-		iterator_(Target_T target, const smart_object_pool<T, block_size>* pool)
+		iterator_(Target_T target, const pool_type* pool)
 				: target(target), pool{pool} {
 			++(pool->active_iterators);
 			skip_until_valid();
@@ -568,7 +576,7 @@ public:
 					// library spec const objects should not be observably not thread-safe. This problem is
 					// avoided here due to process_deferred_destruction being internally synchronized in
 					// respect to the thread-safety contract of smart_object_pool.
-					const_cast<smart_object_pool<T, block_size>*>(pool)->process_deferred_destruction();
+					const_cast<pool_type*>(pool)->process_deferred_destruction();
 				}
 			}
 		}
@@ -904,9 +912,10 @@ public:
 	void process_pending() const noexcept {}
 };
 
-template <typename T, size_t block_size>
-scratch_pad_pool<std::vector<typename smart_object_pool<T, block_size>::pending_destruction_list_entry>>
-		smart_object_pool<T, block_size>::pending_destruction_scratch_pads;
+template <typename T, size_t block_size, typename Block_Allocation_Policy>
+scratch_pad_pool<std::vector<
+		typename smart_object_pool<T, block_size, Block_Allocation_Policy>::pending_destruction_list_entry>>
+		smart_object_pool<T, block_size, Block_Allocation_Policy>::pending_destruction_scratch_pads;
 
 } // namespace containers
 } // namespace mce
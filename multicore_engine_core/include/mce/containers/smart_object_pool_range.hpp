@@ -80,27 +80,24 @@ struct smart_object_pool_range {
 };
 
 /// Makes a smart_object_pool_range for the given smart_object_pool.
-template <typename T, size_t block_size = 0x10000u>
-smart_object_pool_range<typename smart_object_pool<T, block_size>::iterator>
-make_pool_range(smart_object_pool<T, block_size>& pool) {
-	return smart_object_pool_range<typename smart_object_pool<T, block_size>::iterator>(pool.begin(),
-																						pool.end());
+template <typename T, size_t block_size, typename Block_Allocation_Policy>
+smart_object_pool_range<typename smart_object_pool<T, block_size, Block_Allocation_Policy>::iterator>
+make_pool_range(smart_object_pool<T, block_size, Block_Allocation_Policy>& pool) {
+	return {pool.begin(), pool.end()};
 }
 
 /// Makes a constant smart_object_pool_range for the given smart_object_pool.
-template <typename T, size_t block_size = 0x10000u>
-smart_object_pool_range<typename smart_object_pool<T, block_size>::const_iterator>
-make_pool_range(const smart_object_pool<T, block_size>& pool) {
-	return smart_object_pool_range<typename smart_object_pool<T, block_size>::const_iterator>(pool.begin(),
-																							  pool.end());
+template <typename T, size_t block_size, typename Block_Allocation_Policy>
+smart_object_pool_range<typename smart_object_pool<T, block_size, Block_Allocation_Policy>::const_iterator>
+make_pool_range(const smart_object_pool<T, block_size, Block_Allocation_Policy>& pool) {
+	return {pool.begin(), pool.end()};
 }
 
 /// Makes a constant smart_object_pool_range for the given smart_object_pool.
-template <typename T, size_t block_size = 0x10000u>
-smart_object_pool_range<typename smart_object_pool<T, block_size>::const_iterator>
-make_pool_const_range(smart_object_pool<T, block_size>& pool) {
-	return smart_object_pool_range<typename smart_object_pool<T, block_size>::const_iterator>(pool.cbegin(),
-																							  pool.cend());
+template <typename T, size_t block_size, typename Block_Allocation_Policy>
+smart_object_pool_range<typename smart_object_pool<T, block_size, Block_Allocation_Policy>::const_iterator>
+make_pool_const_range(smart_object_pool<T, block_size, Block_Allocation_Policy>& pool) {
+	return {pool.cbegin(), pool.cend()};
 }
 
 /// Makes a tbb::blocked_range for the given simple_smart_object_pool.
@@ -24,7 +24,7 @@ namespace containers {
 template <typename T>
 class weak_pool_ptr;
 
-template <typename U, size_t block_size>
+template <typename U, size_t block_size, typename Block_Allocation_Policy>
 class smart_object_pool;
 
 namespace detail {
@@ -53,7 +53,7 @@ class smart_pool_ptr {
 						  // constructor
 	detail::smart_object_pool_block_interface* block;
 
-	template <typename U, size_t block_size>
+	template <typename U, size_t block_size, typename Block_Allocation_Policy>
 	friend class smart_object_pool;
 	template <typename U>
 	friend class weak_pool_ptr;
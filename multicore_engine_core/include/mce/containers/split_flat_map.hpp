@@ -0,0 +1,495 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/include/mce/containers/split_flat_map.hpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#ifndef CONTAINERS_SPLIT_FLAT_MAP_HPP_
+#define CONTAINERS_SPLIT_FLAT_MAP_HPP_
+
+/**
+ * \file
+ * Defines a flat map type that stores keys and values in separate sorted containers.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define MCE_SPLIT_FLAT_MAP_HAS_SSE2
+#endif
+
+namespace mce {
+namespace containers {
+
+namespace detail {
+
+/// \brief Determines if the keys of type Key under the comparator Compare can be searched using vector
+/// instructions.
+template <typename Key, typename Compare>
+struct split_flat_map_simd_searchable
+		: std::integral_constant<bool, std::is_integral<Key>::value && sizeof(Key) == 4 &&
+											   (std::is_same<Compare, std::less<>>::value ||
+												std::is_same<Compare, std::less<Key>>::value)> {};
+
+template <typename Key, typename Compare, bool = split_flat_map_simd_searchable<Key, Compare>::value>
+struct split_flat_map_search_helper {
+	// Counts the keys that compare less than key in a small sorted range.
+	static size_t count_less(const Key* keys, size_t count, const Key& key, const Compare& compare) {
+		size_t result = 0;
+		for(size_t i = 0; i < count; ++i) {
+			result += compare(keys[i], key) ? 1 : 0;
+		}
+		return result;
+	}
+};
+
+template <typename Key, typename Compare>
+struct split_flat_map_search_helper<Key, Compare, true> {
+	// Counts the keys that compare less than key in a small sorted range using a branch-free compare over
+	// all keys.
+	static size_t count_less(const Key* keys, size_t count, const Key& key, const Compare&) {
+		size_t i = 0;
+		size_t result = 0;
+#ifdef MCE_SPLIT_FLAT_MAP_HAS_SSE2
+		// The vector compare is signed, unsigned keys are mapped to the signed range preserving the order.
+		const int32_t bias = std::is_signed<Key>::value ? 0 : INT32_MIN;
+		const int32_t biased_key = int32_t(uint32_t(key) ^ uint32_t(bias));
+#ifdef __AVX2__
+		if(count >= 8) {
+			const __m256i bias_vec = _mm256_set1_epi32(bias);
+			const __m256i key_vec = _mm256_set1_epi32(biased_key);
+			__m256i acc = _mm256_setzero_si256();
+			for(; i + 8 <= count; i += 8) {
+				auto values = _mm256_xor_si256(
+						_mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i)), bias_vec);
+				// Lanes with a smaller key are all ones (= -1).
+				acc = _mm256_sub_epi32(acc, _mm256_cmpgt_epi32(key_vec, values));
+			}
+			auto acc128 = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+			acc128 = _mm_add_epi32(acc128, _mm_shuffle_epi32(acc128, 0x4E));
+			acc128 = _mm_add_epi32(acc128, _mm_shuffle_epi32(acc128, 0xB1));
+			result += size_t(_mm_cvtsi128_si32(acc128));
+		}
+#endif
+		if(count - i >= 4) {
+			const __m128i bias_vec = _mm_set1_epi32(bias);
+			const __m128i key_vec = _mm_set1_epi32(biased_key);
+			__m128i acc = _mm_setzero_si128();
+			for(; i + 4 <= count; i += 4) {
+				auto values =
+						_mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i)), bias_vec);
+				// Lanes with a smaller key are all ones (= -1).
+				acc = _mm_sub_epi32(acc, _mm_cmpgt_epi32(key_vec, values));
+			}
+			acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0x4E));
+			acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, 0xB1));
+			result += size_t(_mm_cvtsi128_si32(acc));
+		}
+#endif
+		for(; i < count; ++i) {
+			result += keys[i] < key ? 1 : 0;
+		}
+		return result;
+	}
+};
+
+} // namespace detail
+
+/// \brief Implements a map by keeping the keys and the values in sorted order in two separate linear
+/// Containers.
+/**
+ * In contrast to mce::containers::generic_flat_map the keys are stored contiguously and not interleaved with
+ * the values. A lookup therefore only touches the cache lines of the keys. Lookups narrow the range of
+ * candidates down to at most linear_search_threshold keys using a binary search and then count the smaller
+ * keys in the remaining range. For 32-bit integral keys with std::less as the comparator, this count is done
+ * using SSE2 or AVX2 compares (depending on the target architecture), which is branch-free and considerably
+ * faster than a binary search for the small maps this class is intended for.
+ *
+ * Because keys and values are stored separately, iterators don't refer to std::pair objects but return
+ * pairs of references to the key and the value, i.e. std::pair<const Key&, Value&> for mutable iterators and
+ * std::pair<const Key&, const Value&> for constant iterators, by value.
+ *
+ * Container is used for both keys and values and must provide random access iterators, contiguous storage
+ * and the members of a sequence container (e.g. std::vector or boost::container::small_vector).
+ */
+template <template <typename> class Container, typename Key, typename Value, typename Compare = std::less<>>
+class split_flat_map {
+	Container<Key> keys_;
+	Container<Value> values_;
+	Compare compare_;
+
+	template <typename K>
+	size_t lower_bound_index(const K& key) const {
+		const Key* keys = keys_.data();
+		size_t first = 0;
+		size_t count = keys_.size();
+		while(count > linear_search_threshold) {
+			size_t half = count / 2;
+			if(compare_(keys[first + half], key)) {
+				first += half + 1;
+				count -= half + 1;
+			} else {
+				count = half;
+			}
+		}
+		using search_helper = detail::split_flat_map_search_helper<Key, Compare>;
+		return first + search_helper::count_less(keys + first, count, key, compare_);
+	}
+	template <typename K>
+	size_t find_index(const K& key) const {
+		auto index = lower_bound_index(key);
+		if(index < keys_.size() && !compare_(key, keys_[index])) return index;
+		return keys_.size();
+	}
+
+public:
+	/// The maximum number of keys that are searched by counting instead of binary search.
+	static constexpr size_t linear_search_threshold = 32;
+
+	/// The type of the keys.
+	using key_type = Key;
+	/// The type of the values.
+	using mapped_type = Value;
+	/// The type of references to elements returned by iterators.
+	using reference = std::pair<const Key&, Value&>;
+	/// The type of references to elements returned by constant iterators.
+	using const_reference = std::pair<const Key&, const Value&>;
+
+	/// Iterator type for split_flat_map.
+	/**
+	 * Satisfies the requirements of the RandomAccessIterator concept except that dereferencing returns a
+	 * pair of references by value.
+	 */
+	template <typename Map, typename Reference>
+	class iterator_ {
+		Map* map_;
+		size_t index_;
+
+		iterator_(Map* map, size_t index) noexcept : map_{map}, index_{index} {}
+
+		template <typename, typename>
+		friend class iterator_;
+		friend class split_flat_map;
+
+		struct arrow_proxy {
+			Reference ref;
+			Reference* operator->() noexcept {
+				return &ref;
+			}
+		};
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = Reference;
+		using difference_type = ptrdiff_t;
+		using pointer = arrow_proxy;
+		using reference = Reference;
+
+		/// Creates an iterator that doesn't refer to any element.
+		iterator_() noexcept : map_{nullptr}, index_{0} {}
+		/// Converts a mutable iterator to a constant one.
+		template <typename M, typename R,
+				  typename = std::enable_if_t<std::is_convertible<M*, Map*>::value>>
+		// cppcheck-suppress noExplicitConstructor
+		iterator_(const iterator_<M, R>& other) noexcept : map_{other.map_}, index_{other.index_} {}
+
+		/// Returns a pair of references to the key and value of the currently referenced element.
+		reference operator*() const noexcept {
+			return reference(map_->keys_[index_], map_->values_[index_]);
+		}
+		/// Allows member access to the pair of references for the currently referenced element.
+		pointer operator->() const noexcept {
+			return pointer{**this};
+		}
+		/// Returns the pair of references for the element n elements ahead.
+		reference operator[](difference_type n) const noexcept {
+			return *(*this + n);
+		}
+		/// Returns true if and only if *this and other refer to the same element of the same map.
+		bool operator==(const iterator_& other) const noexcept {
+			return map_ == other.map_ && index_ == other.index_;
+		}
+		/// Returns false if and only if *this and other refer to the same element of the same map.
+		bool operator!=(const iterator_& other) const noexcept {
+			return !(*this == other);
+		}
+		/// Returns true if *this refers to an element before the one referred to by other.
+		bool operator<(const iterator_& other) const noexcept {
+			return index_ < other.index_;
+		}
+		/// Returns true if *this refers to an element after the one referred to by other.
+		bool operator>(const iterator_& other) const noexcept {
+			return index_ > other.index_;
+		}
+		/// Returns true if *this refers to the same element as other or one before it.
+		bool operator<=(const iterator_& other) const noexcept {
+			return index_ <= other.index_;
+		}
+		/// Returns true if *this refers to the same element as other or one after it.
+		bool operator>=(const iterator_& other) const noexcept {
+			return index_ >= other.index_;
+		}
+		/// Advances the iterator to the next element and returns the new iterator.
+		iterator_& operator++() noexcept {
+			++index_;
+			return *this;
+		}
+		/// Advances the iterator to the next element and returns the old iterator.
+		iterator_ operator++(int) noexcept {
+			auto it = *this;
+			++index_;
+			return it;
+		}
+		/// Moves the iterator to the previous element and returns the new iterator.
+		iterator_& operator--() noexcept {
+			--index_;
+			return *this;
+		}
+		/// Moves the iterator to the previous element and returns the old iterator.
+		iterator_ operator--(int) noexcept {
+			auto it = *this;
+			--index_;
+			return it;
+		}
+		/// Advances the iterator n elements ahead.
+		iterator_& operator+=(difference_type n) noexcept {
+			index_ = size_t(difference_type(index_) + n);
+			return *this;
+		}
+		/// Moves the iterator n elements back.
+		iterator_& operator-=(difference_type n) noexcept {
+			index_ = size_t(difference_type(index_) - n);
+			return *this;
+		}
+		/// Returns a copy of it advanced n elements ahead.
+		friend iterator_ operator+(iterator_ it, difference_type n) noexcept {
+			return it += n;
+		}
+		/// Returns a copy of it advanced n elements ahead.
+		friend iterator_ operator+(difference_type n, iterator_ it) noexcept {
+			return it += n;
+		}
+		/// Returns a copy of it moved n elements back.
+		friend iterator_ operator-(iterator_ it, difference_type n) noexcept {
+			return it -= n;
+		}
+		/// Returns the distance between the two iterators.
+		friend difference_type operator-(const iterator_& a, const iterator_& b) noexcept {
+			return difference_type(a.index_) - difference_type(b.index_);
+		}
+	};
+
+	/// RandomAccessIterator
+	using iterator = iterator_<split_flat_map, reference>;
+	/// Constant RandomAccessIterator
+	using const_iterator = iterator_<const split_flat_map, const_reference>;
+	/// Reverse RandomAccessIterator
+	using reverse_iterator = std::reverse_iterator<iterator>;
+	/// Reverse constant RandomAccessIterator
+	using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+	/// Creates an empty map.
+	split_flat_map() = default;
+	/// Creates an empty map with the given comparator.
+	explicit split_flat_map(const Compare& compare) : compare_(compare) {}
+
+	/// \brief Inserts a new element with the given key and value by forward-constructing them only if there
+	/// is no element with the given key already in the map.
+	/**
+	 * The function returns an iterator to the inserted element and true if the element was inserted or an
+	 * iterator to the existing element and false otherwise.
+	 */
+	template <typename K, typename V>
+	std::pair<iterator, bool> insert(K&& key, V&& value) {
+		auto index = lower_bound_index(key);
+		if(index < keys_.size() && !compare_(key, keys_[index])) return {iterator(this, index), false};
+		keys_.insert(keys_.begin() + index, std::forward<K>(key));
+		try {
+			values_.insert(values_.begin() + index, std::forward<V>(value));
+		} catch(...) {
+			keys_.erase(keys_.begin() + index);
+			throw;
+		}
+		return {iterator(this, index), true};
+	}
+
+	/// Assigns the given value to the given key or inserts it for the given key if the key doesn't exist.
+	/**
+	 * The function returns an iterator to the inserted element and true if the element was new or an
+	 * iterator to the assigned element and false otherwise.
+	 */
+	template <typename K, typename V>
+	std::pair<iterator, bool> insert_or_assign(K&& key, V&& value) {
+		auto index = lower_bound_index(key);
+		if(index < keys_.size() && !compare_(key, keys_[index])) {
+			values_[index] = std::forward<V>(value);
+			return {iterator(this, index), false};
+		}
+		return insert(std::forward<K>(key), std::forward<V>(value));
+	}
+
+	/// Removes the element referenced by pos from the map and returns an iterator to the following element.
+	iterator erase(const_iterator pos) {
+		keys_.erase(keys_.begin() + pos.index_);
+		values_.erase(values_.begin() + pos.index_);
+		return iterator(this, pos.index_);
+	}
+	/// Removes the element that matches the given key from the map if it exists.
+	/**
+	 * Returns the number of removed elements.
+	 */
+	size_t erase(const Key& key) {
+		auto index = find_index(key);
+		if(index == keys_.size()) return 0;
+		erase(const_iterator(this, index));
+		return 1;
+	}
+	/// Removes all elements from the map.
+	void clear() noexcept {
+		keys_.clear();
+		values_.clear();
+	}
+	/// Reserves space for the given number of elements.
+	void reserve(size_t capacity) {
+		keys_.reserve(capacity);
+		values_.reserve(capacity);
+	}
+
+	/// \brief Looks up the element with the given key and returns an iterator to it or a past-end-iterator
+	/// if no such element exists.
+	iterator find(const Key& key) {
+		return iterator(this, find_index(key));
+	}
+	/// \brief Looks up the element with the given key and returns a const_iterator to it or a
+	/// past-end-iterator if no such element exists.
+	const_iterator find(const Key& key) const {
+		return const_iterator(this, find_index(key));
+	}
+	/// \brief Returns an iterator referencing the first element whose key is not less than the given key or a
+	/// past-end-iterator if no such element exist.
+	iterator lower_bound(const Key& key) {
+		return iterator(this, lower_bound_index(key));
+	}
+	/// \brief Returns a const_iterator referencing the first element whose key is not less than the given key
+	/// or a past-end-iterator if no such element exist.
+	const_iterator lower_bound(const Key& key) const {
+		return const_iterator(this, lower_bound_index(key));
+	}
+	/// Returns the number of elements matching the given key in the map (0 or 1).
+	size_t count(const Key& key) const {
+		return find_index(key) != keys_.size() ? 1 : 0;
+	}
+
+	/// Allows access to the value for the given key with bounds checking.
+	Value& at(const Key& key) {
+		auto index = find_index(key);
+		if(index == keys_.size()) throw std::out_of_range("Key not found.");
+		return values_[index];
+	}
+	/// Allows read-only access to the value for the given key with bounds checking.
+	const Value& at(const Key& key) const {
+		auto index = find_index(key);
+		if(index == keys_.size()) throw std::out_of_range("Key not found.");
+		return values_[index];
+	}
+
+	/// Returns whether the map is empty (true) or not (false).
+	bool empty() const noexcept {
+		return keys_.empty();
+	}
+	/// Returns the number of elements in the map.
+	size_t size() const noexcept {
+		return keys_.size();
+	}
+	/// Returns the sorted keys of the map.
+	const Container<Key>& keys() const noexcept {
+		return keys_;
+	}
+	/// Returns the values of the map in the order of their keys.
+	const Container<Value>& values() const noexcept {
+		return values_;
+	}
+
+	/// Returns an iterator to the first element in the map or a past-end-iterator if the map is empty.
+	iterator begin() noexcept {
+		return iterator(this, 0);
+	}
+	/// Returns a const_iterator to the first element in the map or a past-end-iterator if the map is empty.
+	const_iterator begin() const noexcept {
+		return const_iterator(this, 0);
+	}
+	/// Returns a const_iterator to the first element in the map or a past-end-iterator if the map is empty.
+	const_iterator cbegin() const noexcept {
+		return const_iterator(this, 0);
+	}
+	/// Returns a past-end-iterator for the map.
+	iterator end() noexcept {
+		return iterator(this, keys_.size());
+	}
+	/// Returns a constant past-end-iterator for the map.
+	const_iterator end() const noexcept {
+		return const_iterator(this, keys_.size());
+	}
+	/// Returns a constant past-end-iterator for the map.
+	const_iterator cend() const noexcept {
+		return const_iterator(this, keys_.size());
+	}
+	/// Returns a reverse iterator to the last element in the map.
+	reverse_iterator rbegin() noexcept {
+		return reverse_iterator(end());
+	}
+	/// Returns a constant reverse iterator to the last element in the map.
+	const_reverse_iterator rbegin() const noexcept {
+		return const_reverse_iterator(end());
+	}
+	/// Returns a constant reverse iterator to the last element in the map.
+	const_reverse_iterator crbegin() const noexcept {
+		return const_reverse_iterator(cend());
+	}
+	/// Returns a past-start-reverse-iterator for the map.
+	reverse_iterator rend() noexcept {
+		return reverse_iterator(begin());
+	}
+	/// Returns a constant past-start-reverse-iterator for the map.
+	const_reverse_iterator rend() const noexcept {
+		return const_reverse_iterator(begin());
+	}
+	/// Returns a constant past-start-reverse-iterator for the map.
+	const_reverse_iterator crend() const noexcept {
+		return const_reverse_iterator(cbegin());
+	}
+
+	/// Swaps the contents of *this with other by swapping their components.
+	void swap(split_flat_map& other) {
+		using std::swap;
+		swap(keys_, other.keys_);
+		swap(values_, other.values_);
+		swap(compare_, other.compare_);
+	}
+	/// Swaps the contents of the given maps.
+	friend void swap(split_flat_map& a, split_flat_map& b) {
+		a.swap(b);
+	}
+
+	/// Compares *this and other for equality of the elements stored in them.
+	bool operator==(const split_flat_map& other) const {
+		return keys_ == other.keys_ && values_ == other.values_;
+	}
+	/// Compares *this and other for inequality of the elements stored in them.
+	bool operator!=(const split_flat_map& other) const {
+		return !(*this == other);
+	}
+};
+
+} // namespace containers
+} // namespace mce
+
+#endif /* CONTAINERS_SPLIT_FLAT_MAP_HPP_ */
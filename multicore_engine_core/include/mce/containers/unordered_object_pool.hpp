@@ -17,6 +17,7 @@
 #include <cassert>
 #include <cstdint>
 #include <iterator>
+#include <mce/memory/block_allocation_policies.hpp>
 #include <mce/util/unused.hpp>
 #include <memory>
 #include <mutex>
@@ -99,9 +100,13 @@ struct unsafe_internals_policy {
  *
  * The order of the objects is unspecified because the pool assigns new objects to empty slots in the blocks
  * using an internal (free-list based) scheme.
+ *
+ * The memory for the blocks is obtained through Block_Allocation_Policy (see
+ * memory::default_block_allocation_policy and memory::huge_page_block_allocation_policy).
  */
 template <typename T, size_t block_size = 0x10000u,
-		  typename Lock_Policy = unordered_object_pool_lock_policies::safe_internals_policy>
+		  typename Lock_Policy = unordered_object_pool_lock_policies::safe_internals_policy,
+		  typename Block_Allocation_Policy = memory::default_block_allocation_policy>
 class unordered_object_pool {
 private:
 	union block_entry;
@@ -309,7 +314,7 @@ private:
 
 	lock management_data_lock;
 	block_entry_link first_free_entry = {nullptr, nullptr};
-	std::vector<std::unique_ptr<block>> blocks;
+	std::vector<memory::policy_allocated_ptr<block, Block_Allocation_Policy>> blocks;
 	sync_type<size_t> active_objects{0};
 	sync_type<block*> first_block{nullptr};
 	sync_type<size_t> block_count{0};
@@ -334,8 +339,9 @@ public:
 
 		active_objects = other.active_objects;
 		blocks.reserve(other.blocks.size());
-		std::transform(other.blocks.begin(), other.blocks.end(), std::back_inserter(blocks),
-					   [](auto& b) { return std::make_unique<block>(*b); });
+		std::transform(other.blocks.begin(), other.blocks.end(), std::back_inserter(blocks), [](auto& b) {
+			return memory::make_policy_allocated<block, Block_Allocation_Policy>(*b);
+		});
 		fix_block_ptrs();
 		size_t free_entries = recalculate_freelist();
 		assert(active_objects + free_entries == capacity());
@@ -391,8 +397,9 @@ public:
 		blocks.clear();
 		first_free_entry = {nullptr, nullptr};
 		blocks.reserve(other.blocks.size());
-		std::transform(other.blocks.begin(), other.blocks.end(), std::back_inserter(blocks),
-					   [](auto& b) { return std::make_unique<block>(*b); });
+		std::transform(other.blocks.begin(), other.blocks.end(), std::back_inserter(blocks), [](auto& b) {
+			return memory::make_policy_allocated<block, Block_Allocation_Policy>(*b);
+		});
 		fix_block_ptrs();
 		size_t free_entries = recalculate_freelist();
 		assert(active_objects + free_entries == capacity());
@@ -434,7 +441,7 @@ public:
 	template <typename It_T, typename Target_T>
 	class iterator_ {
 		Target_T target;
-		friend class unordered_object_pool<T, block_size>;
+		friend class unordered_object_pool<T, block_size, Lock_Policy, Block_Allocation_Policy>;
 
 		explicit iterator_(Target_T target) : target(target) {
 			skip_until_valid();
@@ -810,9 +817,11 @@ private:
 	// May only be called when holding lock
 	void grow() {
 		if(blocks.empty()) {
-			blocks.emplace_back(std::make_unique<block>(first_free_entry));
+			blocks.emplace_back(
+					memory::make_policy_allocated<block, Block_Allocation_Policy>(first_free_entry));
 		} else {
-			blocks.emplace_back(std::make_unique<block>(first_free_entry, blocks.back().get()));
+			blocks.emplace_back(memory::make_policy_allocated<block, Block_Allocation_Policy>(
+					first_free_entry, blocks.back().get()));
 		}
 		block_count = blocks.size();
 		if(blocks.empty()) {
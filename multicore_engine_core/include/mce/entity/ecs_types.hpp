@@ -17,6 +17,7 @@
 #include <glm/gtc/quaternion.hpp>
 #include <mce/containers/smart_pool_ptr.hpp>
 #include <mce/entity/component.hpp>
+#include <mce/memory/block_allocation_policies.hpp>
 
 namespace mce {
 namespace containers {
@@ -44,8 +45,13 @@ typedef mce::containers::smart_pool_ptr<mce::entity::component> component_pool_p
 template <typename T>
 using component_impl_pool_ptr = mce::containers::smart_pool_ptr<T>;
 /// Specifies the template for systems and system states to use to store component objects.
-template <typename T, size_t block_size = 0x10000u>
-using component_pool = mce::containers::smart_object_pool<T, block_size>;
+/**
+ * The Block_Allocation_Policy allows selecting the memory source for the pool blocks per component type,
+ * e.g. mce::memory::huge_page_block_allocation_policy for large and frequently iterated pools.
+ */
+template <typename T, size_t block_size = 0x10000u,
+		  typename Block_Allocation_Policy = mce::memory::default_block_allocation_policy>
+using component_pool = mce::containers::smart_object_pool<T, block_size, Block_Allocation_Policy>;
 #else
 /// Specifies the smart pointer type used to manage the lifetime of component objects.
 typedef std::shared_ptr<mce::entity::component> component_pool_ptr;
@@ -54,7 +60,11 @@ typedef std::shared_ptr<mce::entity::component> component_pool_ptr;
 template <typename T>
 using component_impl_pool_ptr = std::shared_ptr<T>;
 /// Specifies the template for systems and system states to use to store component objects.
-template <typename T, size_t = 0x10000u>
+/**
+ * The block size and Block_Allocation_Policy parameters are ignored because simple_smart_object_pool does not
+ * allocate objects in blocks.
+ */
+template <typename T, size_t = 0x10000u, typename = mce::memory::default_block_allocation_policy>
 using component_pool = mce::containers::simple_smart_object_pool<T>;
 #endif
 
@@ -18,8 +18,8 @@
 #include <glm/gtx/quaternion.hpp>
 #include <mce/bstream/ibstream.hpp>
 #include <mce/bstream/obstream.hpp>
-#include <mce/containers/generic_flat_map.hpp>
 #include <mce/containers/smart_pool_ptr.hpp>
+#include <mce/containers/split_flat_map.hpp>
 #include <mce/entity/component.hpp>
 #include <mce/entity/component_type_id_manager.hpp>
 #include <mce/entity/ecs_types.hpp>
@@ -40,7 +40,7 @@ private:
 	entity_orientation_t orientation_{1.0f, 0.0f, 0.0f, 0.0f};
 	template <typename T>
 	using component_container = boost::container::small_vector<T, 16>;
-	containers::generic_flat_map<component_container, component_type_id_t, component_pool_ptr> components_;
+	containers::split_flat_map<component_container, component_type_id_t, component_pool_ptr> components_;
 	bool marker_for_despawn = false;
 
 	friend class entity_manager;
@@ -93,7 +93,7 @@ public:
 	/// Adds the given component to the entity.
 	void add_component(component_pool_ptr&& comp);
 	/// Allows access to the container containing the associated component objects.
-	const containers::generic_flat_map<component_container, component_type_id_t, component_pool_ptr>&
+	const containers::split_flat_map<component_container, component_type_id_t, component_pool_ptr>&
 	components() const {
 		return components_;
 	}
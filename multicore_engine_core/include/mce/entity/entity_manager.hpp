@@ -19,6 +19,8 @@
 #include <mce/entity/component_type.hpp>
 #include <mce/entity/ecs_types.hpp>
 #include <mce/entity/entity.hpp>
+#include <mce/util/instrumented_lock.hpp>
+#include <mce/util/symbol.hpp>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
@@ -44,14 +46,14 @@ class entity_manager {
 	containers::unordered_object_pool<entity> entities;
 	// TODO: Check if this can be non-atomic:
 	std::atomic<bool> read_only_mode{false};
-	mutable std::mutex id_map_mutex;
+	mutable util::instrumented_lock<> id_map_mutex{"entity.entity_manager.id_map"};
 	boost::container::flat_map<entity_id_t, containers::unordered_object_pool<entity>::iterator>
 			entity_id_map;
-	mutable std::mutex name_map_mutex;
+	mutable util::instrumented_lock<> name_map_mutex{"entity.entity_manager.name_map"};
 	boost::container::flat_map<std::string, entity_id_t> entity_name_map;
 	// The following members may only be written to in strictly single-threaded access:
-	boost::container::flat_map<std::string, std::unique_ptr<entity_configuration>> entity_configurations;
-	boost::container::flat_map<std::string, std::unique_ptr<abstract_component_type>> component_types;
+	boost::container::flat_map<util::symbol, std::unique_ptr<entity_configuration>> entity_configurations;
+	boost::container::flat_map<util::symbol, std::unique_ptr<abstract_component_type>> component_types;
 	boost::container::flat_map<component_type_id_t, abstract_component_type*> component_types_by_id;
 
 public:
@@ -98,9 +100,15 @@ public:
 	/// \brief Returns a pointer to the entity_configuration with the given name or nullptr if no such
 	/// entity_configuration exists.
 	const entity_configuration* find_entity_configuration(const std::string& name) const;
+	/// \brief Returns a pointer to the entity_configuration with the given name or nullptr if no such
+	/// entity_configuration exists.
+	const entity_configuration* find_entity_configuration(util::symbol name) const;
 	/// \brief Returns a pointer to the abstract_component_type with the given name or nullptr if no such
 	/// abstract_component_type exists.
 	const abstract_component_type* find_component_type(const std::string& name) const;
+	/// \brief Returns a pointer to the abstract_component_type with the given name or nullptr if no such
+	/// abstract_component_type exists.
+	const abstract_component_type* find_component_type(util::symbol name) const;
 	/// \brief Returns a pointer to the abstract_component_type with the given type id or nullptr if no such
 	/// abstract_component_type exists.
 	const abstract_component_type* find_component_type(component_type_id_t id) const;
@@ -125,8 +133,8 @@ public:
 	void register_component_type(const std::string& name, const F& factory_function) {
 		bool success = false;
 		decltype(component_types)::iterator it;
-		std::tie(it, success) =
-				component_types.emplace(name, make_component_type<T>(engine, name, factory_function));
+		auto type = make_component_type<T>(engine, name, factory_function);
+		std::tie(it, success) = component_types.emplace(util::symbol(name), std::move(type));
 		if(!success) throw duplicate_component_type_exception("Duplicate component type name.");
 		component_types_by_id.emplace(it->second->id(), it->second.get());
 	}
@@ -0,0 +1,108 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/include/mce/memory/block_allocation_policies.hpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#ifndef MEMORY_BLOCK_ALLOCATION_POLICIES_HPP_
+#define MEMORY_BLOCK_ALLOCATION_POLICIES_HPP_
+
+/**
+ * \file
+ * Defines policies for allocating the memory of large blocks in object pools.
+ */
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace mce {
+namespace memory {
+
+/// Allocates size bytes aligned to alignment from the general heap.
+void* aligned_heap_allocate(std::size_t size, std::size_t alignment);
+/// Releases memory obtained from aligned_heap_allocate.
+void aligned_heap_deallocate(void* ptr) noexcept;
+
+/// Allocates size bytes aligned to a huge page boundary and requests huge page backing from the OS.
+/**
+ * On Linux this first attempts to map explicitly reserved huge pages (hugetlbfs) and falls back to an
+ * anonymous mapping that is advised to be backed by transparent huge pages. If neither is supported the
+ * mapping still provides valid memory using regular pages. On other platforms the memory is taken from the
+ * general heap.
+ */
+void* huge_page_allocate(std::size_t size);
+/// Releases memory obtained from huge_page_allocate with the same size.
+void huge_page_deallocate(void* ptr, std::size_t size) noexcept;
+
+/// Specifies the granularity used for huge page allocations (2 MiB).
+constexpr std::size_t huge_page_size = std::size_t(0x200000u);
+
+/// Allocates pool blocks on the general heap with the required alignment (the default behavior).
+struct default_block_allocation_policy {
+	/// Allocates memory for size bytes with the given alignment.
+	static void* allocate(std::size_t size, std::size_t alignment) {
+		return aligned_heap_allocate(size, alignment);
+	}
+	/// Releases memory of size bytes with the given alignment that was obtained from allocate.
+	static void deallocate(void* ptr, std::size_t, std::size_t) noexcept {
+		aligned_heap_deallocate(ptr);
+	}
+};
+
+/// \brief Allocates pool blocks in huge-page-aligned mappings that are backed by huge pages where supported
+/// to reduce TLB misses when iterating over large pools.
+/**
+ * Blocks smaller than half of a huge page are taken from the general heap because rounding them up to a
+ * full huge page would waste most of the mapping.
+ */
+struct huge_page_block_allocation_policy {
+	/// Allocates memory for size bytes with the given alignment.
+	static void* allocate(std::size_t size, std::size_t alignment) {
+		if(!use_huge_pages(size, alignment)) return aligned_heap_allocate(size, alignment);
+		return huge_page_allocate(size);
+	}
+	/// Releases memory of size bytes with the given alignment that was obtained from allocate.
+	static void deallocate(void* ptr, std::size_t size, std::size_t alignment) noexcept {
+		if(!use_huge_pages(size, alignment)) return aligned_heap_deallocate(ptr);
+		huge_page_deallocate(ptr, size);
+	}
+
+private:
+	static bool use_huge_pages(std::size_t size, std::size_t alignment) noexcept {
+		return size >= huge_page_size / 2 && alignment <= huge_page_size;
+	}
+};
+
+/// Deleter for objects created using make_policy_allocated.
+template <typename T, typename Allocation_Policy>
+struct policy_allocated_deleter {
+	/// Destroys the given object and releases its memory using Allocation_Policy.
+	void operator()(T* ptr) const noexcept {
+		if(!ptr) return;
+		ptr->~T();
+		Allocation_Policy::deallocate(ptr, sizeof(T), alignof(T));
+	}
+};
+
+/// Smart pointer type for objects created using make_policy_allocated.
+template <typename T, typename Allocation_Policy>
+using policy_allocated_ptr = std::unique_ptr<T, policy_allocated_deleter<T, Allocation_Policy>>;
+
+/// Creates an object of type T in memory obtained from Allocation_Policy.
+template <typename T, typename Allocation_Policy, typename... Args>
+policy_allocated_ptr<T, Allocation_Policy> make_policy_allocated(Args&&... args) {
+	void* mem = Allocation_Policy::allocate(sizeof(T), alignof(T));
+	try {
+		return policy_allocated_ptr<T, Allocation_Policy>(new(mem) T(std::forward<Args>(args)...));
+	} catch(...) {
+		Allocation_Policy::deallocate(mem, sizeof(T), alignof(T));
+		throw;
+	}
+}
+
+} // namespace memory
+} // namespace mce
+
+#endif /* MEMORY_BLOCK_ALLOCATION_POLICIES_HPP_ */
@@ -0,0 +1,171 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/include/mce/memory/frame_arena.hpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#ifndef MEMORY_FRAME_ARENA_HPP_
+#define MEMORY_FRAME_ARENA_HPP_
+
+/**
+ * \file
+ * Defines memory resources for short-lived allocations that are released in bulk at the end of a frame.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mce/containers/per_thread.hpp>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace mce {
+namespace memory {
+
+/// Implements a std::pmr::memory_resource that allocates linearly from large chunks of memory.
+/**
+ * Allocating only bumps an offset in the current chunk and deallocating individual allocations does nothing.
+ * Instead all allocations are released together using #reset. The chunks are obtained from an upstream
+ * memory resource and kept across resets. When a reset finds that more than one chunk was needed, the chunks
+ * are replaced by a single chunk of their combined size. Therefore the arena reaches a steady state after a
+ * few resets, in which no memory is requested from the upstream resource any more.
+ *
+ * The resource is not thread-safe, it is intended to be used by a single thread at a time (see
+ * mce::memory::frame_arena for thread-local arenas).
+ */
+class linear_arena_resource : public std::pmr::memory_resource {
+	struct chunk {
+		char* data;
+		size_t size;
+	};
+	std::pmr::memory_resource* upstream_;
+	std::vector<chunk> chunks_;
+	size_t initial_chunk_size_;
+	size_t current_chunk_ = 0;
+	size_t offset_ = 0;
+	size_t allocated_bytes_ = 0;
+
+	void add_chunk(size_t size);
+	void release_chunks() noexcept;
+
+protected:
+	/// Allocates bytes bytes with the given alignment from the current chunk or a new one.
+	void* do_allocate(size_t bytes, size_t alignment) override;
+	/// Does nothing, the memory is released by #reset.
+	void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+	/// Returns true only for the same object, because memory can not be deallocated through other arenas.
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+public:
+	/// The size of the first chunk used by default.
+	static constexpr size_t default_initial_chunk_size = size_t(0x10000u);
+
+	/// \brief Creates an arena that requests chunks starting with initial_chunk_size from the given upstream
+	/// resource.
+	/**
+	 * No memory is requested until the first allocation.
+	 */
+	explicit linear_arena_resource(size_t initial_chunk_size = default_initial_chunk_size,
+								   std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+	/// Returns all chunks to the upstream resource.
+	~linear_arena_resource() noexcept;
+	/// Forbids copying.
+	linear_arena_resource(const linear_arena_resource&) = delete;
+	/// Forbids copying.
+	linear_arena_resource& operator=(const linear_arena_resource&) = delete;
+
+	/// Releases all allocations from the arena at once.
+	/**
+	 * Objects in memory allocated from the arena must not be accessed after the reset. Their destructors are
+	 * not called. If more than one chunk was used since the last reset, the chunks are coalesced into one,
+	 * which can throw std::bad_alloc when the upstream resource can't satisfy the request. In this case the
+	 * arena is empty but still usable.
+	 */
+	void reset();
+
+	/// Returns the number of bytes handed out since the last reset, including alignment padding.
+	size_t allocated_bytes() const noexcept {
+		return allocated_bytes_;
+	}
+	/// Returns the combined size of all chunks currently held by the arena.
+	size_t capacity() const noexcept;
+	/// Returns the number of chunks currently held by the arena.
+	size_t chunk_count() const noexcept {
+		return chunks_.size();
+	}
+	/// Returns the resource from which the arena obtains its chunks.
+	std::pmr::memory_resource* upstream_resource() const noexcept {
+		return upstream_;
+	}
+};
+
+/// Provides per-thread linear arenas for allocations that only live until the end of a frame.
+/**
+ * Each thread allocates from its own mce::memory::linear_arena_resource, making allocations free of
+ * synchronization. The arenas are multi-buffered over frames_in_flight frames: #advance_frame makes the next
+ * set of arenas current and resets it, so memory allocated in a frame stays valid while the following
+ * frames_in_flight - 1 frames are processed. With the default of two sets, work started in one frame may
+ * therefore still use its temporary data during the next frame.
+ *
+ * Containers can use the arenas through std::pmr::polymorphic_allocator, e.g. using
+ * <code>std::pmr::vector<int> v(arena.allocator<int>());</code>. Such containers must be destroyed or
+ * abandoned before their arena set is reset.
+ *
+ * #advance_frame must be called by one thread at a time and not concurrently with allocations from
+ * resources that were obtained before the previous call to #advance_frame.
+ */
+class frame_arena {
+	std::vector<std::unique_ptr<containers::per_thread<linear_arena_resource>>> frames_;
+	std::atomic<uint64_t> current_frame_{0};
+
+	containers::per_thread<linear_arena_resource>& current_set() noexcept {
+		return *frames_[current_frame_.load(std::memory_order_acquire) % frames_.size()];
+	}
+
+public:
+	/// Creates a frame_arena with frames_in_flight buffered sets of per-thread arenas.
+	/**
+	 * The arenas obtain chunks starting with initial_chunk_size bytes from the given upstream resource. The
+	 * number of threads using the frame_arena is not limited.
+	 */
+	explicit frame_arena(size_t frames_in_flight = 2,
+						 size_t initial_chunk_size = linear_arena_resource::default_initial_chunk_size,
+						 std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+	/// Forbids copying.
+	frame_arena(const frame_arena&) = delete;
+	/// Forbids copying.
+	frame_arena& operator=(const frame_arena&) = delete;
+
+	/// Returns the arena of the calling thread for the current frame.
+	std::pmr::memory_resource* resource() {
+		return &current_set().get();
+	}
+	/// Returns an allocator for the arena of the calling thread for the current frame.
+	template <typename T = std::byte>
+	std::pmr::polymorphic_allocator<T> allocator() {
+		return std::pmr::polymorphic_allocator<T>(resource());
+	}
+
+	/// Ends the current frame and resets the arenas of the oldest frame to be reused for the next one.
+	void advance_frame();
+
+	/// Returns the number of frames that have been advanced.
+	uint64_t current_frame() const noexcept {
+		return current_frame_.load(std::memory_order_acquire);
+	}
+	/// Returns the number of buffered arena sets.
+	size_t frames_in_flight() const noexcept {
+		return frames_.size();
+	}
+	/// Returns the number of bytes allocated in the current frame by all threads.
+	/**
+	 * Must not be called concurrently with allocations.
+	 */
+	size_t allocated_bytes() const noexcept;
+};
+
+} // namespace memory
+} // namespace mce
+
+#endif /* MEMORY_FRAME_ARENA_HPP_ */
@@ -0,0 +1,299 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/include/mce/util/bounded_message_queue.hpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#ifndef MCE_UTIL_BOUNDED_MESSAGE_QUEUE_HPP_
+#define MCE_UTIL_BOUNDED_MESSAGE_QUEUE_HPP_
+
+/**
+ * \file
+ * Defines a lock-free bounded thread-safe queue.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <mce/util/finally.hpp>
+#include <mce/util/futex.hpp>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace mce {
+namespace util {
+
+/// Provides a lock-free bounded multi-producer multi-consumer FIFO queue for communication between threads.
+/**
+ * The queue stores up to capacity() objects of type T in a ring buffer that is allocated once at
+ * construction. Each cell of the ring buffer carries a sequence number that allows producers and consumers
+ * to claim cells using a single compare-and-swap on the respective position counter without taking locks.
+ *
+ * The non-blocking operations (try_push, try_pop, pop_batch) never block. The blocking operations (push,
+ * pop) first attempt the non-blocking variant and only park the calling thread on a futex if the queue is
+ * full or empty respectively. Producers and consumers only issue wake-up calls if a thread is actually
+ * parked.
+ *
+ * In contrast to #mce::util::message_queue the queue does not allocate memory per element, but T must be
+ * nothrow move constructible and pushing fails (or blocks) while the queue is full.
+ */
+template <typename T>
+class bounded_message_queue {
+	static_assert(std::is_nothrow_move_constructible<T>::value,
+				  "bounded_message_queue<T> requires T to be nothrow move constructible.");
+	static constexpr size_t cacheline_alignment = 64;
+
+	union cell_storage {
+		T object;
+		cell_storage() noexcept {}
+		~cell_storage() noexcept {}
+		cell_storage(const cell_storage&) = delete;
+		cell_storage& operator=(const cell_storage&) = delete;
+	};
+
+	struct cell {
+		std::atomic<size_t> sequence;
+		cell_storage storage;
+	};
+
+	std::unique_ptr<cell[]> cells;
+	size_t mask;
+
+	alignas(cacheline_alignment) std::atomic<size_t> enqueue_pos{0};
+	alignas(cacheline_alignment) std::atomic<size_t> dequeue_pos{0};
+	alignas(cacheline_alignment) std::atomic<uint32_t> push_events{0};
+	std::atomic<uint32_t> waiting_consumers{0};
+	alignas(cacheline_alignment) std::atomic<uint32_t> pop_events{0};
+	std::atomic<uint32_t> waiting_producers{0};
+
+	static size_t round_capacity(size_t capacity) noexcept {
+		size_t res = 2;
+		while(res < capacity) res <<= 1;
+		return res;
+	}
+
+	static void notify(std::atomic<uint32_t>& events, std::atomic<uint32_t>& waiters) noexcept {
+		// Pairs with the fence in wait to ensure that either the waiter sees the state change or we see the
+		// waiter.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if(waiters.load(std::memory_order_relaxed) > 0) {
+			events.fetch_add(1, std::memory_order_release);
+			futex_wake_one(events);
+		}
+	}
+
+	template <typename F>
+	static void wait(std::atomic<uint32_t>& events, std::atomic<uint32_t>& waiters, F&& retry) noexcept {
+		auto observed_events = events.load(std::memory_order_acquire);
+		waiters.fetch_add(1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if(!retry()) futex_wait(events, observed_events);
+		waiters.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	// Returns the cell for the given position if it is ready to be written, otherwise nullptr.
+	cell* claim_push_cell() noexcept {
+		size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+		for(;;) {
+			cell* c = &cells[pos & mask];
+			size_t seq = c->sequence.load(std::memory_order_acquire);
+			auto diff = intptr_t(seq) - intptr_t(pos);
+			if(diff == 0) {
+				if(enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) return c;
+			} else if(diff < 0) {
+				return nullptr; // Full
+			} else {
+				pos = enqueue_pos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	// Claims up to max_count consecutive filled cells and returns the position of the first one.
+	size_t claim_pop_cells(size_t max_count, size_t& pos) noexcept {
+		pos = dequeue_pos.load(std::memory_order_relaxed);
+		for(;;) {
+			size_t ready = 0;
+			while(ready < max_count) {
+				size_t seq = cells[(pos + ready) & mask].sequence.load(std::memory_order_acquire);
+				if(intptr_t(seq) - intptr_t(pos + ready + 1) != 0) break;
+				++ready;
+			}
+			if(ready == 0) {
+				size_t seq = cells[pos & mask].sequence.load(std::memory_order_acquire);
+				if(intptr_t(seq) - intptr_t(pos + 1) < 0) return 0; // Empty
+				pos = dequeue_pos.load(std::memory_order_relaxed);
+				continue;
+			}
+			if(dequeue_pos.compare_exchange_weak(pos, pos + ready, std::memory_order_relaxed)) return ready;
+		}
+	}
+
+	template <typename U>
+	bool try_push_impl(U&& value, std::true_type) noexcept {
+		cell* c = claim_push_cell();
+		if(!c) return false;
+		size_t pos = c->sequence.load(std::memory_order_relaxed);
+		new(&c->storage.object) T(std::forward<U>(value));
+		c->sequence.store(pos + 1, std::memory_order_release);
+		notify(push_events, waiting_consumers);
+		return true;
+	}
+
+	template <typename U>
+	bool try_push_impl(U&& value, std::false_type) {
+		if(full()) return false;
+		T tmp(std::forward<U>(value));
+		return try_push_impl(std::move(tmp), std::true_type{});
+	}
+
+	template <typename U>
+	void push_impl(U&& value, std::true_type) noexcept {
+		// The value is only consumed once a cell was successfully claimed.
+		while(!try_push_impl(std::forward<U>(value), std::true_type{})) {
+			wait(pop_events, waiting_producers, [this]() { return !full(); });
+		}
+	}
+
+	template <typename U>
+	void push_impl(U&& value, std::false_type) {
+		T tmp(std::forward<U>(value));
+		push_impl(std::move(tmp), std::true_type{});
+	}
+
+	void release_cell(size_t pos) noexcept {
+		cell& c = cells[pos & mask];
+		c.storage.object.~T();
+		c.sequence.store(pos + mask + 1, std::memory_order_release);
+	}
+
+public:
+	/// Creates a queue that can hold at least the given number of elements.
+	/**
+	 * The capacity is rounded up to the next power of two.
+	 */
+	explicit bounded_message_queue(size_t capacity)
+			: cells{std::make_unique<cell[]>(round_capacity(capacity))}, mask{round_capacity(capacity) - 1} {
+		for(size_t i = 0; i <= mask; ++i) {
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	/// Destroys the queue and the elements remaining in it.
+	~bounded_message_queue() noexcept {
+		size_t pos;
+		while(claim_pop_cells(1, pos)) {
+			release_cell(pos);
+		}
+	}
+
+	/// Forbids copying.
+	bounded_message_queue(const bounded_message_queue&) = delete;
+	/// Forbids copying.
+	bounded_message_queue& operator=(const bounded_message_queue&) = delete;
+
+	/// Attempts to add the given object to the end of the queue and returns false if the queue is full.
+	/**
+	 * If constructing T from value can throw, the new element is constructed before a cell is claimed.
+	 * In that case an rvalue argument may be moved from even if the call returns false.
+	 */
+	template <typename U>
+	bool try_push(U&& value) noexcept(std::is_nothrow_constructible<T, U&&>::value) {
+		return try_push_impl(std::forward<U>(value), std::is_nothrow_constructible<T, U&&>{});
+	}
+
+	/// Adds the given object to the end of the queue and blocks while the queue is full.
+	template <typename U>
+	void push(U&& value) noexcept(std::is_nothrow_constructible<T, U&&>::value) {
+		push_impl(std::forward<U>(value), std::is_nothrow_constructible<T, U&&>{});
+	}
+
+	/// \brief If an element is available at the front of the queue it is assigned to target and true is
+	/// returned, otherwise false is returned.
+	bool try_pop(T& target) noexcept(std::is_nothrow_move_assignable<T>::value) {
+		size_t pos;
+		if(!claim_pop_cells(1, pos)) return false;
+		auto release = finally([this, pos]() {
+			release_cell(pos);
+			notify(pop_events, waiting_producers);
+		});
+		target = std::move(cells[pos & mask].storage.object);
+		return true;
+	}
+
+	/// Takes the element from the front of the queue and blocks if no element is available.
+	T pop() noexcept {
+		size_t pos;
+		while(!claim_pop_cells(1, pos)) {
+			wait(push_events, waiting_consumers, [this]() { return !empty(); });
+		}
+		T value = std::move(cells[pos & mask].storage.object);
+		release_cell(pos);
+		notify(pop_events, waiting_producers);
+		return value;
+	}
+
+	/// \brief Moves up to max_count elements from the front of the queue into the buffer starting at target
+	/// and returns the number of elements that were taken.
+	/**
+	 * The elements are claimed in as few atomic operations as possible, which amortizes the synchronization
+	 * overhead over the batch. Returns 0 without blocking if the queue is empty.
+	 */
+	template <typename It>
+	size_t pop_batch(It target, size_t max_count) noexcept(std::is_nothrow_move_assignable<T>::value) {
+		size_t taken = 0;
+		while(taken < max_count) {
+			size_t pos;
+			size_t count = claim_pop_cells(max_count - taken, pos);
+			if(!count) break;
+			size_t i = 0;
+			auto release = finally([this, pos, count, &i]() {
+				// Release the remaining claimed cells even if assigning an element threw.
+				for(; i < count; ++i) release_cell(pos + i);
+				notify(pop_events, waiting_producers);
+			});
+			for(; i < count; ++target) {
+				*target = std::move(cells[(pos + i) & mask].storage.object);
+				release_cell(pos + i);
+				++i;
+			}
+			taken += count;
+		}
+		return taken;
+	}
+
+	/// Determines if the queue is currently empty.
+	bool empty() const noexcept {
+		size_t pos = dequeue_pos.load(std::memory_order_acquire);
+		size_t seq = cells[pos & mask].sequence.load(std::memory_order_acquire);
+		return intptr_t(seq) - intptr_t(pos + 1) < 0;
+	}
+
+	/// Determines if the queue is currently full.
+	bool full() const noexcept {
+		size_t pos = enqueue_pos.load(std::memory_order_acquire);
+		size_t seq = cells[pos & mask].sequence.load(std::memory_order_acquire);
+		return intptr_t(seq) - intptr_t(pos) < 0;
+	}
+
+	/// Returns the number of objects currently in the queue.
+	/**
+	 * The value is only a snapshot and may be outdated when concurrent operations are in progress.
+	 */
+	size_t size() const noexcept {
+		size_t deq = dequeue_pos.load(std::memory_order_acquire);
+		size_t enq = enqueue_pos.load(std::memory_order_acquire);
+		return enq > deq ? std::min(enq - deq, capacity()) : 0;
+	}
+
+	/// Returns the maximum number of objects the queue can hold.
+	size_t capacity() const noexcept {
+		return mask + 1;
+	}
+};
+
+} // namespace util
+} // namespace mce
+
+#endif /* MCE_UTIL_BOUNDED_MESSAGE_QUEUE_HPP_ */
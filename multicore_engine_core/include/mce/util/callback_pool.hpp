@@ -15,9 +15,12 @@
 #include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <cstdint>
 #include <functional>
+#include <mce/containers/per_thread.hpp>
 #include <mce/memory/align.hpp>
 #include <mce/util/finally.hpp>
+#include <mce/util/instrumented_lock.hpp>
 #include <memory>
 #include <mutex>
 #include <numeric>
@@ -145,6 +148,14 @@ public:
 	}
 };
 
+// Only accessed by the owning thread, release_resources() invalidates the chunks through the generation.
+struct callback_pool_thread_chunk {
+	uint64_t generation = 0;
+	std::shared_ptr<callback_pool_buffer> buffer;
+	size_t offset = 0;
+	size_t end = 0;
+};
+
 } // namespace detail
 template <typename>
 class callback_pool_function {};
@@ -211,30 +222,40 @@ public:
 };
 
 /// Provides a thread-safe memory pool for backing callback_pool_function objects.
+/**
+ * Each thread allocating from the pool takes a chunk of buffer_size / min_slots bytes from the current
+ * buffer and sub-allocates from it without synchronization with other threads. The pool is only locked when
+ * a thread needs a new chunk. New buffers are only created when the existing ones are exhausted.
+ *
+ * The chunks are never touched by other threads. release_resources() only advances a release generation
+ * and each thread drops its chunk when it sees the changed generation in its next allocation.
+ */
 class callback_pool {
 	std::shared_ptr<detail::callback_pool_buffer> current_buffer;
 	std::vector<std::shared_ptr<detail::callback_pool_buffer>> stashed_buffers;
 	size_t current_buffer_offset = 0;
-	mutable std::mutex pool_mutex;
+	std::unique_ptr<containers::per_thread<detail::callback_pool_thread_chunk>> thread_chunks;
+	std::atomic<uint64_t> release_generation{1};
+	mutable util::instrumented_lock<> pool_mutex{"util.callback_pool"};
 	size_t buffer_size_;
+	size_t thread_chunk_size_;
 	size_t min_slots_;
 	boost::rational<size_t> growth_factor_;
 
 	void reallocate(size_t obj_size, size_t obj_alignment);
-	void* try_alloc_obj_block(size_t size, size_t alignment) const noexcept;
+	void refill_chunk(detail::callback_pool_thread_chunk& chunk, size_t obj_size, size_t obj_alignment);
+	static void* try_alloc_obj_block(const detail::callback_pool_thread_chunk& chunk, size_t size,
+									 size_t alignment) noexcept;
 
 public:
 	/// Creates a callback_pool with the given allocation parameters.
 	callback_pool(size_t buffer_size = 0x100000, size_t min_slots = 0x10,
-				  boost::rational<size_t> growth_factor = {3u, 2u})
-			: buffer_size_{buffer_size}, min_slots_{min_slots}, growth_factor_{1u} {
-		// Allocate two buffers with the given buffer size.
-		reallocate(1, 1);
-		reallocate(1, 1);
-		growth_factor_ = growth_factor;
-	}
+				  boost::rational<size_t> growth_factor = {3u, 2u});
 
 	/// Allows move-construction.
+	/**
+	 * The moved-from pool can only be destroyed or assigned to.
+	 */
 	callback_pool(callback_pool&& other) noexcept;
 	/// Allows move-assignment.
 	callback_pool& operator=(callback_pool&& other) noexcept;
@@ -244,31 +265,32 @@ public:
 			  typename = std::enable_if_t<callback_pool_function<Signature>::template is_valid_function_value<
 					  std::decay_t<F>>::value>>
 	callback_pool_function<Signature> allocate_function(F&& f) {
-		std::unique_lock<std::mutex> lock(pool_mutex);
 		using fun = detail::callback_pool_function_impl<std::decay_t<F>, Signature>;
-		auto loc = try_alloc_obj_block(sizeof(fun), alignof(fun));
+		auto& chunk = thread_chunks->get();
+		void* loc = nullptr;
+		if(chunk.generation == release_generation.load(std::memory_order_relaxed)) {
+			loc = try_alloc_obj_block(chunk, sizeof(fun), alignof(fun));
+		}
 		if(!loc) {
-			reallocate(sizeof(fun), alignof(fun));
-			loc = try_alloc_obj_block(sizeof(fun), alignof(fun));
+			refill_chunk(chunk, sizeof(fun), alignof(fun));
+			loc = try_alloc_obj_block(chunk, sizeof(fun), alignof(fun));
 			assert(loc);
 		}
-		current_buffer->increment_ref_count();
-		current_buffer_offset =
-				reinterpret_cast<char*>(reinterpret_cast<fun*>(loc) + 1) - current_buffer->data();
-		auto buffer = current_buffer;
-		lock.unlock();
-		// Do copy outside the lock to prevent circular wait and reentrance through copy ctor.
+		chunk.buffer->increment_ref_count();
+		auto end = reinterpret_cast<char*>(reinterpret_cast<fun*>(loc) + 1);
+		chunk.offset = end - chunk.buffer->data();
+		// The copy of the function object can reenter the pool and replace the chunk.
+		auto buffer = chunk.buffer;
 		return callback_pool_function<Signature>(new(loc) fun(std::forward<F>(f)), std::move(buffer));
 	}
 
 	/// \brief Drops ownership of all memory buffers, however buffer are kept alive if functions are using
 	/// them until this is no longer the case.
-	void release_resources() noexcept {
-		std::lock_guard<std::mutex> lock(pool_mutex);
-		current_buffer.reset();
-		current_buffer_offset = 0;
-		stashed_buffers.clear();
-	}
+	/**
+	 * The chunks the threads are currently allocating from are dropped by the threads on their next
+	 * allocation. Until then, the chunk of an idle thread keeps its buffer alive.
+	 */
+	void release_resources() noexcept;
 
 	/// Returns the total (not just free) space in the buffers of the pool.
 	size_t capacity() const noexcept;
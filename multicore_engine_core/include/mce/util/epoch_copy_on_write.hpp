@@ -0,0 +1,126 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/include/mce/util/epoch_copy_on_write.hpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#ifndef MCE_UTIL_EPOCH_COPY_ON_WRITE_HPP_
+#define MCE_UTIL_EPOCH_COPY_ON_WRITE_HPP_
+
+/**
+ * \file
+ * Defines a copy on write class with read access based on epoch-based reclamation.
+ */
+
+#include <atomic>
+#include <mce/util/epoch_reclamation.hpp>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace mce {
+namespace util {
+
+/// Provides copy-on-write semantics based transactions with readers that don't need reference counting.
+/**
+ * In contrast to mce::util::copy_on_write, reading users don't share ownership of the current version using
+ * std::shared_ptr but only enter an epoch-based read-side critical section (see mce::util::epoch_guard) for
+ * the lifetime of the read_handle returned by #get. Reads therefore don't write to memory shared between
+ * threads, which avoids bouncing the cache line of a reference count between cores for read-heavy data
+ * that is accessed with high frequency.
+ *
+ * Writing users apply modifying transactions using #do_transaction. Writers are serialized using the lock
+ * given as template parameter, therefore each transaction copies the managed object exactly once. Replaced
+ * versions are reclaimed after all readers that could have observed them are finished.
+ *
+ * Read handles must not be kept for a long time because they delay the reclamation of all objects retired
+ * in the meantime and they must be released by the thread that obtained them.
+ *
+ * The type T must satisfy the concept CopyConstructible from the standard library.
+ */
+template <typename T, typename Lock = std::mutex>
+class epoch_copy_on_write {
+	std::atomic<const T*> current;
+	Lock write_lock;
+
+public:
+	/// Provides read access to the version of the managed object that was current when it was obtained.
+	class read_handle {
+		epoch_guard guard;
+		const T* object;
+
+		explicit read_handle(const std::atomic<const T*>& current)
+				: object{current.load(std::memory_order_acquire)} {}
+
+		friend class epoch_copy_on_write<T, Lock>;
+
+	public:
+		/// Forbids copying.
+		read_handle(const read_handle&) = delete;
+		/// Forbids copying.
+		read_handle& operator=(const read_handle&) = delete;
+
+		/// Accesses the managed object.
+		const T& operator*() const noexcept {
+			return *object;
+		}
+		/// Accesses the managed object.
+		const T* operator->() const noexcept {
+			return object;
+		}
+		/// Returns a pointer to the managed object.
+		const T* get() const noexcept {
+			return object;
+		}
+	};
+
+	/// Default-constructs the managed object.
+	epoch_copy_on_write() : current{new T()} {}
+	/// Constructs the managed object by copying the given value.
+	explicit epoch_copy_on_write(const T& value) : current{new T(value)} {}
+	/// Constructs the managed object by moving the given value.
+	explicit epoch_copy_on_write(T&& value) : current{new T(std::move(value))} {}
+	/// Destroys the current version of the managed object.
+	/**
+	 * Must not be called while read handles for the object exist.
+	 */
+	~epoch_copy_on_write() noexcept {
+		delete current.load(std::memory_order_acquire);
+	}
+	/// The epoch_copy_on_write object itself can neither be copied nor moved.
+	epoch_copy_on_write(const epoch_copy_on_write&) = delete;
+	/// The epoch_copy_on_write object itself can neither be copied nor moved.
+	epoch_copy_on_write& operator=(const epoch_copy_on_write&) = delete;
+
+	/// Returns a handle that provides access to the current version of the managed object.
+	/**
+	 * The version stays available for the lifetime of the handle.
+	 */
+	read_handle get() const {
+		return read_handle(current);
+	}
+
+	/// Applies a modifying transaction to the managed object.
+	/**
+	 * The given function object must be callable with a signature of void(T&). It is called exactly once on
+	 * a copy of the current version while holding the write lock. The modified copy then atomically replaces
+	 * the current version. If f throws, the current version is left unchanged.
+	 */
+	template <typename F>
+	void do_transaction(F f) {
+		const T* old_object;
+		{
+			std::lock_guard<Lock> lock(write_lock);
+			old_object = current.load(std::memory_order_relaxed);
+			auto new_object = std::make_unique<T>(*old_object);
+			f(*new_object);
+			current.store(new_object.release(), std::memory_order_release);
+		}
+		epoch_retire(old_object);
+	}
+};
+
+} // namespace util
+} // namespace mce
+
+#endif /* MCE_UTIL_EPOCH_COPY_ON_WRITE_HPP_ */
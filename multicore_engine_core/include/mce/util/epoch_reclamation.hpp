@@ -0,0 +1,113 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/include/mce/util/epoch_reclamation.hpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#ifndef MCE_UTIL_EPOCH_RECLAMATION_HPP_
+#define MCE_UTIL_EPOCH_RECLAMATION_HPP_
+
+/**
+ * \file
+ * Provides epoch-based reclamation of objects that are shared with lock-free readers.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace mce {
+namespace util {
+
+namespace detail {
+
+struct epoch_limbo_list;
+
+struct epoch_thread_record {
+	// (epoch << 1) | 1 while the owning thread is inside a read-side critical section, 0 otherwise.
+	std::atomic<uint64_t> state{0};
+	std::atomic<bool> in_use{false};
+	epoch_thread_record* next = nullptr;
+	// The objects retired by the threads owning the record, kept with the record when the thread exits.
+	epoch_limbo_list* limbo = nullptr;
+	// Only accessed by the owning thread.
+	unsigned nesting = 0;
+};
+
+inline std::atomic<uint64_t> global_epoch{1};
+
+epoch_thread_record* acquire_epoch_thread_record();
+
+inline epoch_thread_record& local_epoch_thread_record() {
+	thread_local epoch_thread_record* record = nullptr;
+	if(!record) record = acquire_epoch_thread_record();
+	return *record;
+}
+
+} // namespace detail
+
+/// Marks a read-side critical section for the epoch-based reclamation during its lifetime.
+/**
+ * Objects that were retired using epoch_retire are not destroyed before all read-side critical sections
+ * that were active at the time of the retirement have ended. Readers can therefore access objects that are
+ * published through atomic pointers without reference counting or locking. Entering and leaving a critical
+ * section only touches the thread-local epoch record of the calling thread.
+ *
+ * Guards can be nested and must be destroyed by the thread that created them. Waiting for epoch_synchronize
+ * while holding a guard deadlocks.
+ */
+class epoch_guard {
+	detail::epoch_thread_record& record;
+
+public:
+	/// Enters a read-side critical section.
+	epoch_guard() : record{detail::local_epoch_thread_record()} {
+		if(record.nesting++ == 0) {
+			record.state.store((detail::global_epoch.load(std::memory_order_relaxed) << 1) | 1,
+							   std::memory_order_relaxed);
+			// Orders the announcement before the loads of protected pointers. Pairs with the fence in the
+			// epoch advancement.
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+		}
+	}
+	/// Leaves the read-side critical section.
+	~epoch_guard() noexcept {
+		if(--record.nesting == 0) {
+			record.state.store(0, std::memory_order_release);
+		}
+	}
+	/// Forbids copying.
+	epoch_guard(const epoch_guard&) = delete;
+	/// Forbids copying.
+	epoch_guard& operator=(const epoch_guard&) = delete;
+};
+
+/// \brief Hands the given object over to the epoch-based reclamation which calls deleter on it as soon as no
+/// read-side critical section can access it any more.
+/**
+ * The object must have been made unreachable for new readers before retiring it. Retired objects are
+ * collected in a list of the calling thread, which is reclaimed by that thread whenever it holds enough
+ * objects and by epoch_synchronize. The deleter may therefore be called on any thread that calls
+ * epoch_retire or epoch_synchronize. Exceptions thrown by deleters are dropped. If the object can not be
+ * registered for reclamation, std::bad_alloc is thrown and the ownership stays with the caller.
+ */
+void epoch_retire(void* object, void (*deleter)(void*));
+
+/// \brief Hands the given object over to the epoch-based reclamation which deletes it as soon as no
+/// read-side critical section can access it any more.
+template <typename T>
+void epoch_retire(T* object) {
+	epoch_retire(const_cast<void*>(static_cast<const void*>(object)),
+				 [](void* ptr) { delete static_cast<T*>(ptr); });
+}
+
+/// Blocks until all objects retired before the call by any thread are reclaimed.
+void epoch_synchronize();
+
+/// Returns the number of retired objects that are not reclaimed yet.
+size_t epoch_pending_reclamations();
+
+} // namespace util
+} // namespace mce
+
+#endif /* MCE_UTIL_EPOCH_RECLAMATION_HPP_ */
@@ -0,0 +1,36 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/include/mce/util/futex.hpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#ifndef MCE_UTIL_FUTEX_HPP_
+#define MCE_UTIL_FUTEX_HPP_
+
+/**
+ * \file
+ * Provides minimal wait and wake operations on atomic words for building blocking synchronization primitives.
+ */
+
+#include <atomic>
+#include <cstdint>
+
+namespace mce {
+namespace util {
+
+/// Blocks the calling thread as long as word contains the value expected.
+/**
+ * The call may return spuriously, callers must therefore recheck their wait condition in a loop.
+ * On Linux this is implemented using the futex system call. On other platforms the calling thread only
+ * yields its time slice, which turns waiting loops into yielding spin loops.
+ */
+void futex_wait(std::atomic<uint32_t>& word, uint32_t expected) noexcept;
+/// Wakes at most one thread that is blocked in futex_wait on word.
+void futex_wake_one(std::atomic<uint32_t>& word) noexcept;
+/// Wakes all threads that are blocked in futex_wait on word.
+void futex_wake_all(std::atomic<uint32_t>& word) noexcept;
+
+} // namespace util
+} // namespace mce
+
+#endif /* MCE_UTIL_FUTEX_HPP_ */
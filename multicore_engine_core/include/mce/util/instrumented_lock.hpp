@@ -0,0 +1,189 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/include/mce/util/instrumented_lock.hpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#ifndef MCE_UTIL_INSTRUMENTED_LOCK_HPP_
+#define MCE_UTIL_INSTRUMENTED_LOCK_HPP_
+
+/**
+ * \file
+ * Provides a lock wrapper that records contention statistics per lock name.
+ *
+ * The recording is only active if the engine is built with the CMake option MCE_LOCK_STATISTICS, which
+ * defines the macro of the same name. Otherwise instrumented_lock is the wrapped lock type with an
+ * additional constructor that ignores the name.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace mce {
+namespace util {
+
+/// Is true if instrumented_lock records statistics.
+#ifdef MCE_LOCK_STATISTICS
+constexpr bool lock_statistics_enabled = true;
+#else
+constexpr bool lock_statistics_enabled = false;
+#endif
+
+/// Holds a snapshot of the counters for the locks with a given name.
+struct lock_counters_snapshot {
+	uint64_t acquisitions = 0;			 ///< The number of successful acquisitions.
+	uint64_t contended_acquisitions = 0; ///< The number of acquisitions that had to wait.
+	uint64_t wait_time_ns = 0;			 ///< The total time spent waiting in contended acquisitions.
+	uint64_t max_wait_time_ns = 0;		 ///< The longest time spent waiting in one acquisition.
+	uint64_t hold_time_ns = 0;			 ///< The total time the locks were held exclusively.
+};
+
+/// Holds the counters that are shared by all instrumented_lock objects with the same name.
+/**
+ * The counters are registered globally by name and are never destroyed.
+ */
+class alignas(64) lock_counters {
+	std::atomic<uint64_t> acquisitions_{0};
+	std::atomic<uint64_t> contended_acquisitions_{0};
+	std::atomic<uint64_t> wait_time_ns_{0};
+	std::atomic<uint64_t> max_wait_time_ns_{0};
+	std::atomic<uint64_t> hold_time_ns_{0};
+
+public:
+	/// Records an acquisition that succeeded without waiting.
+	void record_acquisition() noexcept {
+		acquisitions_.fetch_add(1, std::memory_order_relaxed);
+	}
+	/// Records an acquisition that had to wait for the given time.
+	void record_contended_acquisition(uint64_t wait_time_ns) noexcept {
+		acquisitions_.fetch_add(1, std::memory_order_relaxed);
+		contended_acquisitions_.fetch_add(1, std::memory_order_relaxed);
+		wait_time_ns_.fetch_add(wait_time_ns, std::memory_order_relaxed);
+		auto max_wait = max_wait_time_ns_.load(std::memory_order_relaxed);
+		while(max_wait < wait_time_ns &&
+			  !max_wait_time_ns_.compare_exchange_weak(max_wait, wait_time_ns, std::memory_order_relaxed))
+			;
+	}
+	/// Records the given time for which a lock was held exclusively.
+	void record_hold_time(uint64_t hold_time_ns) noexcept {
+		hold_time_ns_.fetch_add(hold_time_ns, std::memory_order_relaxed);
+	}
+	/// Returns the current values of the counters.
+	lock_counters_snapshot snapshot() const noexcept {
+		return {acquisitions_.load(std::memory_order_relaxed),
+				contended_acquisitions_.load(std::memory_order_relaxed),
+				wait_time_ns_.load(std::memory_order_relaxed),
+				max_wait_time_ns_.load(std::memory_order_relaxed),
+				hold_time_ns_.load(std::memory_order_relaxed)};
+	}
+	/// Resets the counters to zero.
+	void reset() noexcept;
+};
+
+/// \brief Returns the counters for the locks with the given name, creating them on first use.
+/**
+ * The name must be a string with static storage duration.
+ */
+lock_counters& named_lock_counters(const char* name);
+/// Returns the names and counter snapshots of all registered lock names ordered by name.
+std::vector<std::pair<const char*, lock_counters_snapshot>> all_lock_counters();
+/// Resets the counters of all registered lock names.
+void reset_lock_counters() noexcept;
+
+#ifdef MCE_LOCK_STATISTICS
+
+/// Wraps a lock of type Lock and records the acquisitions and the wait and hold times under a name.
+/**
+ * All objects constructed with the same name share their counters, e.g. the locks of all instances of a
+ * class. The counters can be written through statistics_manager by registering a lock_statistic.
+ *
+ * Supports the shared locking operations if Lock does. For shared acquisitions only the count and the wait
+ * time are recorded, because the hold times of multiple holders can't be tracked in the lock object.
+ */
+template <typename Lock = std::mutex>
+class instrumented_lock {
+	using clock = std::chrono::steady_clock;
+
+	Lock lock_;
+	lock_counters* counters_;
+	clock::time_point hold_start_;
+
+	static uint64_t nanoseconds_since(clock::time_point start) noexcept {
+		return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+	}
+
+public:
+	/// Creates a lock that records its statistics under the given name with static storage duration.
+	explicit instrumented_lock(const char* name) : counters_{&named_lock_counters(name)} {}
+	/// Forbids copying.
+	instrumented_lock(const instrumented_lock&) = delete;
+	/// Forbids copying.
+	instrumented_lock& operator=(const instrumented_lock&) = delete;
+
+	/// Acquires the lock exclusively.
+	void lock() {
+		if(lock_.try_lock()) {
+			counters_->record_acquisition();
+		} else {
+			auto wait_start = clock::now();
+			lock_.lock();
+			counters_->record_contended_acquisition(nanoseconds_since(wait_start));
+		}
+		hold_start_ = clock::now();
+	}
+	/// Tries to acquire the lock exclusively without waiting.
+	bool try_lock() {
+		if(!lock_.try_lock()) return false;
+		counters_->record_acquisition();
+		hold_start_ = clock::now();
+		return true;
+	}
+	/// Releases the exclusive ownership of the lock.
+	void unlock() {
+		auto hold_time = nanoseconds_since(hold_start_);
+		lock_.unlock();
+		counters_->record_hold_time(hold_time);
+	}
+
+	/// Acquires shared ownership of the lock.
+	void lock_shared() {
+		if(lock_.try_lock_shared()) {
+			counters_->record_acquisition();
+		} else {
+			auto wait_start = clock::now();
+			lock_.lock_shared();
+			counters_->record_contended_acquisition(nanoseconds_since(wait_start));
+		}
+	}
+	/// Tries to acquire shared ownership of the lock without waiting.
+	bool try_lock_shared() {
+		if(!lock_.try_lock_shared()) return false;
+		counters_->record_acquisition();
+		return true;
+	}
+	/// Releases the shared ownership of the lock.
+	void unlock_shared() {
+		lock_.unlock_shared();
+	}
+};
+
+#else
+
+/// Wraps a lock of type Lock without recording statistics, because MCE_LOCK_STATISTICS is disabled.
+template <typename Lock = std::mutex>
+class instrumented_lock : public Lock {
+public:
+	/// Creates the lock and ignores the name.
+	constexpr explicit instrumented_lock(const char*) noexcept {}
+};
+
+#endif
+
+} // namespace util
+} // namespace mce
+
+#endif /* MCE_UTIL_INSTRUMENTED_LOCK_HPP_ */
@@ -0,0 +1,197 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/include/mce/util/perf_counters.hpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#ifndef MCE_UTIL_PERF_COUNTERS_HPP_
+#define MCE_UTIL_PERF_COUNTERS_HPP_
+
+/**
+ * \file
+ * Provides hardware performance counters that are attributed to named profiling zones.
+ *
+ * The counters are only recorded if the engine is built for Linux with the CMake option MCE_PERF_COUNTERS,
+ * which defines the macro of the same name. The counters are then read using perf_event_open. Otherwise the
+ * MCE_PERF_ZONE macro expands to nothing and all counters stay zero.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace mce {
+namespace util {
+
+namespace detail {
+struct perf_counters_access;
+} // namespace detail
+
+/// Is true if the profiling zones record hardware performance counters.
+#ifdef MCE_PERF_COUNTERS
+constexpr bool perf_counters_enabled = true;
+#else
+constexpr bool perf_counters_enabled = false;
+#endif
+
+/// Holds values of the hardware performance counters.
+struct perf_counter_values {
+	uint64_t cycles = 0;		///< The number of CPU cycles.
+	uint64_t instructions = 0;  ///< The number of retired instructions.
+	uint64_t llc_misses = 0;	///< The number of last level cache misses.
+	uint64_t branch_misses = 0; ///< The number of mispredicted branches.
+
+	/// \brief Returns the counter differences between *this and the given earlier state, clamping
+	/// differences that would be negative to zero.
+	perf_counter_values operator-(const perf_counter_values& other) const noexcept {
+		return {clamped_difference(cycles, other.cycles),
+				clamped_difference(instructions, other.instructions),
+				clamped_difference(llc_misses, other.llc_misses),
+				clamped_difference(branch_misses, other.branch_misses)};
+	}
+
+private:
+	static uint64_t clamped_difference(uint64_t value, uint64_t earlier_value) noexcept {
+		return value > earlier_value ? value - earlier_value : 0;
+	}
+};
+
+/// \brief Holds unscaled values of the hardware performance counters together with the times required to
+/// scale them.
+/**
+ * The kernel may have to multiplex the counters with other events, in which case they only count while they
+ * are scheduled on the PMU. Differences between readings are scaled by the ratio of the enabled to the
+ * running time in the interval between them, instead of subtracting separately scaled cumulative values,
+ * whose scaling factors differ and can therefore produce negative differences.
+ */
+struct perf_counter_reading {
+	perf_counter_values raw;   ///< The unscaled counter values.
+	uint64_t time_enabled = 0; ///< The time in nanoseconds for which the counters were enabled.
+	uint64_t time_running = 0; ///< The time in nanoseconds for which the counters were counting.
+
+	/// \brief Returns the scaled counter differences between *this and the given earlier reading.
+	/**
+	 * Differences that would be negative, e.g. because one of the readings failed and contains zeros, are
+	 * clamped to zero.
+	 */
+	perf_counter_values operator-(const perf_counter_reading& other) const noexcept;
+};
+
+/// \brief Checks if the hardware performance counters can be read by the calling thread, which opens the
+/// counters for the thread if it has not done so yet.
+/**
+ * Returns false if the engine is built without MCE_PERF_COUNTERS or if the operating system refuses access
+ * to the counters, e.g. because of the perf_event_paranoid setting or in a virtual machine without a virtual
+ * PMU.
+ */
+bool perf_counters_available() noexcept;
+/// \brief Returns the current unscaled values of the counters for the calling thread and their times or zeros
+/// if they are not available.
+perf_counter_reading thread_perf_counter_reading() noexcept;
+/// \brief Returns the current values of the counters for the calling thread or zeros if they are not
+/// available.
+/**
+ * The values are scaled to compensate for time in which the kernel had to multiplex the counters with other
+ * events. Deltas over an interval should be computed from thread_perf_counter_reading instead, because the
+ * scaling factor changes over time.
+ */
+perf_counter_values thread_perf_counters() noexcept;
+
+/// Represents a named profiling zone to which the hardware counter deltas of its scopes are attributed.
+/**
+ * The counters are per thread, therefore a zone only measures the work of the thread executing a scope for
+ * it. To profile parallel algorithms the scopes need to be placed in the bodies that run on the workers.
+ * Nested zones both receive the deltas of the inner scope.
+ *
+ * Zones must have static storage duration because they are registered globally and never unregistered. The
+ * macro MCE_PERF_ZONE defines such a zone together with a scope for it.
+ */
+class perf_counter_zone {
+	const char* name_;
+	std::atomic<uint64_t> samples_{0};
+	std::atomic<uint64_t> cycles_{0};
+	std::atomic<uint64_t> instructions_{0};
+	std::atomic<uint64_t> llc_misses_{0};
+	std::atomic<uint64_t> branch_misses_{0};
+	perf_counter_zone* next_ = nullptr;
+
+	friend struct detail::perf_counters_access;
+
+public:
+	/// Creates and registers a zone with the given name that must be a string with static storage duration.
+	explicit perf_counter_zone(const char* name) noexcept;
+	/// Forbids copying.
+	perf_counter_zone(const perf_counter_zone&) = delete;
+	/// Forbids copying.
+	perf_counter_zone& operator=(const perf_counter_zone&) = delete;
+
+	/// Returns the name of the zone.
+	const char* name() const noexcept {
+		return name_;
+	}
+	/// Returns the number of completed scopes for the zone.
+	uint64_t samples() const noexcept {
+		return samples_.load(std::memory_order_relaxed);
+	}
+	/// Returns the sums of the counter deltas of the completed scopes for the zone.
+	perf_counter_values counters() const noexcept {
+		return {cycles_.load(std::memory_order_relaxed), instructions_.load(std::memory_order_relaxed),
+				llc_misses_.load(std::memory_order_relaxed), branch_misses_.load(std::memory_order_relaxed)};
+	}
+	/// Adds the given counter deltas as one sample to the zone.
+	void record(const perf_counter_values& delta) noexcept;
+	/// Resets the counters of the zone to zero.
+	void reset() noexcept;
+};
+
+/// Attributes the hardware counter deltas of the calling thread during the lifetime of the scope to a zone.
+class perf_counter_zone_scope {
+	perf_counter_zone* zone_;
+	perf_counter_reading start_;
+
+public:
+	/// Starts measuring for the given zone.
+	explicit perf_counter_zone_scope(perf_counter_zone& zone) noexcept
+			: zone_{&zone}, start_{thread_perf_counter_reading()} {}
+	/// Adds the counter deltas since the construction to the zone.
+	~perf_counter_zone_scope() noexcept {
+		zone_->record(thread_perf_counter_reading() - start_);
+	}
+	/// Forbids copying.
+	perf_counter_zone_scope(const perf_counter_zone_scope&) = delete;
+	/// Forbids copying.
+	perf_counter_zone_scope& operator=(const perf_counter_zone_scope&) = delete;
+};
+
+/// Holds the values of a profiling zone.
+struct perf_counter_zone_values {
+	const char* name;			///< The name of the zone.
+	uint64_t samples;			///< The number of completed scopes.
+	perf_counter_values values; ///< The sums of the counter deltas.
+};
+
+/// Returns the names and counters of all registered zones.
+std::vector<perf_counter_zone_values> perf_counter_zones();
+/// Resets the counters of all registered zones.
+void reset_perf_counter_zones() noexcept;
+
+} // namespace util
+} // namespace mce
+
+#define MCE_PERF_ZONE_CONCAT_IMPL(A, B) A##B
+#define MCE_PERF_ZONE_CONCAT(A, B) MCE_PERF_ZONE_CONCAT_IMPL(A, B)
+
+/// \brief Attributes the hardware performance counter deltas of the rest of the enclosing block to a zone
+/// with the given name, if performance counters are enabled.
+#ifdef MCE_PERF_COUNTERS
+#define MCE_PERF_ZONE(NAME)                                                                         \
+	static ::mce::util::perf_counter_zone MCE_PERF_ZONE_CONCAT(mce_perf_zone_, __LINE__){NAME};     \
+	::mce::util::perf_counter_zone_scope MCE_PERF_ZONE_CONCAT(mce_perf_zone_scope_, __LINE__) {     \
+		MCE_PERF_ZONE_CONCAT(mce_perf_zone_, __LINE__)                                              \
+	}
+#else
+#define MCE_PERF_ZONE(NAME)
+#endif
+
+#endif /* MCE_UTIL_PERF_COUNTERS_HPP_ */
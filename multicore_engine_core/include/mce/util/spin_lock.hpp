@@ -9,35 +9,138 @@
 
 /**
  * \file
- * Defines a spin lock class.
+ * Defines spin lock classes.
  */
 
 #include <atomic>
+#include <cstdint>
+#include <mce/util/futex.hpp>
+#include <thread>
+
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+#include <immintrin.h>
+#define MCE_SPIN_LOCK_HAS_MM_PAUSE
+#endif
 
 namespace mce {
 namespace util {
+namespace detail {
+
+/// Signals the CPU that the calling thread is in a spin-wait loop.
+/**
+ * On x86 this issues a pause instruction which reduces the power consumption of the loop, avoids the memory
+ * order violation penalty when leaving the loop and frees execution resources for an SMT sibling.
+ */
+inline void cpu_relax() noexcept {
+#ifdef MCE_SPIN_LOCK_HAS_MM_PAUSE
+	_mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+	__asm__ __volatile__("yield");
+#endif
+}
+
+/// Implements exponential backoff for spin-wait loops.
+/**
+ * Each call to pause spins for twice as many relax iterations as the previous one until max_relax_count is
+ * reached. After that every call yields the time slice of the calling thread to allow a preempted lock
+ * holder to make progress.
+ */
+class spin_backoff {
+	static constexpr uint32_t max_relax_count = 1024;
+	uint32_t relax_count = 1;
 
-/// Implements a spin lock on top of atomic_flag that fulfills the Lockable concept from the standard library.
+public:
+	/// Waits for the current backoff duration and increases it for the next call.
+	void pause() noexcept {
+		if(relax_count <= max_relax_count) {
+			for(uint32_t i = 0; i < relax_count; ++i) {
+				cpu_relax();
+			}
+			relax_count <<= 1;
+		} else {
+			std::this_thread::yield();
+		}
+	}
+	/// Returns true if the backoff has exhausted its spinning phase and started yielding.
+	bool exhausted() const noexcept {
+		return relax_count > max_relax_count;
+	}
+};
+
+} // namespace detail
+
+/// Implements a spin lock that fulfills the Lockable concept from the standard library.
 /**
- * In contrast to std::mutex this lock does not relinquish the CPU time slice but waits in a tight loop for
+ * In contrast to std::mutex this lock does not relinquish the CPU time slice but waits in a loop for
  * acquiring the lock. This type of lock is useful for scenarios where a lock is held very shortly.
+ *
+ * Waiting threads only read the lock state while it is taken (test-and-test-and-set) to avoid bouncing the
+ * cache line between the waiting cores and back off exponentially using pause instructions. Under long
+ * contention the waiting threads yield their time slice to not starve a preempted lock holder.
  */
 class spin_lock {
-	std::atomic_flag flag = ATOMIC_FLAG_INIT;
+	std::atomic<bool> locked{false};
+
+public:
+	/// Waits until the lock is acquired by the calling thread.
+	void lock() noexcept {
+		detail::spin_backoff backoff;
+		for(;;) {
+			if(!locked.exchange(true, std::memory_order_acquire)) return;
+			while(locked.load(std::memory_order_relaxed)) {
+				backoff.pause();
+			}
+		}
+	}
+	/// Attempts to acquire the lock immediately but doesn't wait for the lock if already taken.
+	bool try_lock() noexcept {
+		return !locked.load(std::memory_order_relaxed) && !locked.exchange(true, std::memory_order_acquire);
+	}
+	/// Releases the lock.
+	void unlock() noexcept {
+		locked.store(false, std::memory_order_release);
+	}
+};
+
+/// Implements a lock that spins for a short time and then parks the waiting thread on a futex.
+/**
+ * The lock fulfills the Lockable concept from the standard library. It combines the low latency of
+ * #mce::util::spin_lock for short critical sections with the behavior of a mutex under long contention,
+ * where waiting threads sleep instead of burning CPU time. Unlocking only performs a system call if threads
+ * are parked on the lock.
+ */
+class adaptive_spin_lock {
+	// 0: unlocked, 1: locked without parked waiters, 2: locked with potentially parked waiters
+	std::atomic<uint32_t> state{0};
 
 public:
 	/// Waits until the lock is acquired by the calling thread.
 	void lock() noexcept {
-		while(flag.test_and_set(std::memory_order_acquire))
-			;
+		uint32_t expected = 0;
+		if(state.compare_exchange_strong(expected, 1, std::memory_order_acquire)) return;
+		detail::spin_backoff backoff;
+		while(!backoff.exhausted()) {
+			backoff.pause();
+			expected = 0;
+			if(state.load(std::memory_order_relaxed) == 0 &&
+			   state.compare_exchange_strong(expected, 1, std::memory_order_acquire))
+				return;
+		}
+		// Spin budget exhausted -> announce waiting and park until the lock is released.
+		while(state.exchange(2, std::memory_order_acquire) != 0) {
+			futex_wait(state, 2);
+		}
 	}
 	/// Attempts to acquire the lock immediately but doesn't wait for the lock if already taken.
 	bool try_lock() noexcept {
-		return !flag.test_and_set(std::memory_order_acquire);
+		uint32_t expected = 0;
+		return state.compare_exchange_strong(expected, 1, std::memory_order_acquire);
 	}
 	/// Releases the lock.
 	void unlock() noexcept {
-		flag.clear(std::memory_order_release);
+		if(state.exchange(0, std::memory_order_release) == 2) {
+			futex_wake_one(state);
+		}
 	}
 };
 
@@ -19,7 +19,9 @@
 #include <limits>
 #include <mce/containers/dynamic_array.hpp>
 #include <mce/exceptions.hpp>
+#include <mce/util/instrumented_lock.hpp>
 #include <mce/util/locked.hpp>
+#include <mce/util/perf_counters.hpp>
 #include <mce/util/type_id.hpp>
 #include <memory>
 #include <mutex>
@@ -357,6 +359,109 @@ public:
 	}
 };
 
+/// Provides the counters of all instrumented_lock names as a statistic.
+/**
+ * The counters are global, therefore all lock_statistic objects show the same values and clearing one of
+ * them resets the counters for all. The statistic has no rows if the engine is built without
+ * MCE_LOCK_STATISTICS.
+ */
+class lock_statistic : public statistic_base<6> {
+public:
+	/// Creates a lock_statistic.
+	lock_statistic()
+			: statistic_base{{{"", "lock", "acquisitions", "contended", "wait_ns", "max_wait_ns", "hold_ns",
+							   ""}}} {}
+
+	/// Resets the counters of all lock names.
+	void clear() noexcept {
+		reset_lock_counters();
+	}
+
+	/// Encapsulates a statistics evaluation result.
+	struct result {
+		std::vector<std::pair<const char*, lock_counters_snapshot>> locks; ///< The counters per lock name.
+		label_set labels; ///< The labels used on output.
+
+		/// Outputs the formated result to the given stream using the given separator.
+		void output_to(std::ostream& ostr, const char* separator = ";", bool suppress_header = false,
+					   bool suppress_footer = false) const {
+			if(!suppress_header) labels.output_header(ostr, separator);
+			for(const auto& lock : locks) {
+				labels.output_prefix(ostr, separator);
+				const auto& c = lock.second;
+				ostr << lock.first << separator << c.acquisitions << separator << c.contended_acquisitions
+					 << separator << c.wait_time_ns << separator << c.max_wait_time_ns << separator
+					 << c.hold_time_ns;
+				labels.output_suffix(ostr, separator);
+				ostr << "\n";
+			}
+			if(!suppress_footer) labels.output_footer(ostr, separator);
+		}
+
+		/// Allows outputting the result data to an ostream.
+		friend std::ostream& operator<<(std::ostream& ostr, const result& res) {
+			res.output_to(ostr);
+			return ostr;
+		}
+	};
+
+	/// Evaluates the current counters of all lock names.
+	result evaluate() const {
+		return {all_lock_counters(), *labels()};
+	}
+};
+
+/// Outputs the hardware performance counters of all profiling zones defined using MCE_PERF_ZONE.
+/**
+ * The counters are global, therefore all perf_counter_statistic objects show the same values and clearing
+ * one of them resets the counters for all. The statistic has no rows if the engine is built without
+ * MCE_PERF_COUNTERS and only zero counters if the operating system doesn't provide access to them.
+ */
+class perf_counter_statistic : public statistic_base<6> {
+public:
+	/// Creates a perf_counter_statistic.
+	perf_counter_statistic()
+			: statistic_base{{{"", "zone", "samples", "cycles", "instructions", "llc_misses", "branch_misses",
+							   ""}}} {}
+
+	/// Resets the counters of all zones.
+	void clear() noexcept {
+		reset_perf_counter_zones();
+	}
+
+	/// Encapsulates a statistics evaluation result.
+	struct result {
+		std::vector<perf_counter_zone_values> zones; ///< The counters per zone.
+		label_set labels;							 ///< The labels used on output.
+
+		/// Outputs the formated result to the given stream using the given separator.
+		void output_to(std::ostream& ostr, const char* separator = ";", bool suppress_header = false,
+					   bool suppress_footer = false) const {
+			if(!suppress_header) labels.output_header(ostr, separator);
+			for(const auto& zone : zones) {
+				labels.output_prefix(ostr, separator);
+				const auto& v = zone.values;
+				ostr << zone.name << separator << zone.samples << separator << v.cycles << separator
+					 << v.instructions << separator << v.llc_misses << separator << v.branch_misses;
+				labels.output_suffix(ostr, separator);
+				ostr << "\n";
+			}
+			if(!suppress_footer) labels.output_footer(ostr, separator);
+		}
+
+		/// Allows outputting the result data to an ostream.
+		friend std::ostream& operator<<(std::ostream& ostr, const result& res) {
+			res.output_to(ostr);
+			return ostr;
+		}
+	};
+
+	/// Evaluates the current counters of all zones.
+	result evaluate() const {
+		return {perf_counter_zones(), *labels()};
+	}
+};
+
 namespace detail {
 
 struct statistics_container_base {
@@ -0,0 +1,125 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/include/mce/util/symbol.hpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#ifndef MCE_UTIL_SYMBOL_HPP_
+#define MCE_UTIL_SYMBOL_HPP_
+
+/**
+ * \file
+ * Provides interned strings for names that are compared and hashed frequently.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace mce {
+namespace util {
+
+/// Represents an interned string that is identified by a 32-bit id.
+/**
+ * Interning a string stores it once in an engine-wide symbol table that is never cleared. All symbols for
+ * equal strings have the same id, which makes comparing symbols an integer comparison. The hash of the
+ * string is calculated once when it is interned and stored in the symbol. The string storage is stable, so
+ * references to it obtained through str() stay valid for the rest of the program.
+ *
+ * Interning is thread-safe and lookups of already interned strings don't lock. The ordering of symbols is
+ * by id and therefore depends on the order of interning and not on the strings.
+ *
+ * Strings should be interned once, e.g. when a name is parsed or an object is registered, and then be passed
+ * around as symbols.
+ */
+class symbol {
+	uint32_t id_;
+	uint32_t hash_;
+
+	symbol(uint32_t id, uint32_t hash) noexcept : id_{id}, hash_{hash} {}
+
+	friend class symbol_table_access;
+
+public:
+	/// Creates a symbol for the empty string.
+	symbol() noexcept : id_{0}, hash_{0} {}
+	/// Interns the given string and creates a symbol for it.
+	explicit symbol(std::string_view str);
+	/// \brief Returns the symbol for the given string if it was already interned or an empty optional
+	/// otherwise.
+	/**
+	 * Allows looking up names given as strings without growing the symbol table, because a string that was
+	 * never interned can't be a key in a symbol-based container.
+	 */
+	static std::optional<symbol> find(std::string_view str);
+
+	/// Returns the id of the symbol, which is 0 for the empty string.
+	uint32_t id() const noexcept {
+		return id_;
+	}
+	/// Returns the precomputed hash of the string, which is 0 for the empty string.
+	uint32_t hash() const noexcept {
+		return hash_;
+	}
+	/// Checks if the symbol represents the empty string.
+	bool empty() const noexcept {
+		return id_ == 0;
+	}
+	/// Returns the interned string.
+	const std::string& str() const noexcept;
+	/// Returns a view of the interned string.
+	std::string_view view() const noexcept {
+		return str();
+	}
+
+	/// Checks if two symbols represent the same string.
+	friend bool operator==(symbol a, symbol b) noexcept {
+		return a.id_ == b.id_;
+	}
+	/// Checks if two symbols represent different strings.
+	friend bool operator!=(symbol a, symbol b) noexcept {
+		return a.id_ != b.id_;
+	}
+	/// Orders symbols by their id.
+	friend bool operator<(symbol a, symbol b) noexcept {
+		return a.id_ < b.id_;
+	}
+	/// Orders symbols by their id.
+	friend bool operator<=(symbol a, symbol b) noexcept {
+		return a.id_ <= b.id_;
+	}
+	/// Orders symbols by their id.
+	friend bool operator>(symbol a, symbol b) noexcept {
+		return a.id_ > b.id_;
+	}
+	/// Orders symbols by their id.
+	friend bool operator>=(symbol a, symbol b) noexcept {
+		return a.id_ >= b.id_;
+	}
+	/// Writes the interned string to the given stream.
+	friend std::ostream& operator<<(std::ostream& ostr, symbol sym) {
+		return ostr << sym.str();
+	}
+};
+
+} // namespace util
+} // namespace mce
+
+namespace std {
+
+/// Provides the precomputed hash of mce::util::symbol for unordered containers.
+template <>
+struct hash<mce::util::symbol> {
+	/// Returns the precomputed hash of the given symbol.
+	size_t operator()(mce::util::symbol sym) const noexcept {
+		return sym.hash();
+	}
+};
+
+} // namespace std
+
+#endif /* MCE_UTIL_SYMBOL_HPP_ */
@@ -6,10 +6,14 @@
 
 #include <mce/asset/asset.hpp>
 #include <mce/asset/asset_loader.hpp>
+#include <mce/asset/asset_manager.hpp>
 
 namespace mce {
 namespace asset {
 
+std::shared_ptr<void> asset_loader::keep_task_pool_running(asset_manager& asset_manager) {
+	return std::make_shared<boost::asio::io_service::work>(asset_manager.task_pool);
+}
 void asset_loader::finish_loading(const std::shared_ptr<asset>& asset, const file_content_ptr& data,
 								  file_size size) {
 	asset->complete_loading(data, size);
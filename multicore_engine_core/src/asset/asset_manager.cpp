@@ -7,16 +7,47 @@
 #ifndef ASSET_ASSET_MANAGER_CPP_
 #define ASSET_ASSET_MANAGER_CPP_
 
-#include <boost/range/algorithm_ext/erase.hpp>
+#include <algorithm>
+#include <cassert>
 #include <mce/asset/asset_manager.hpp>
 #include <mce/asset/cleaned_asio_ioservice.hpp>
+#include <mce/util/epoch_reclamation.hpp>
+#include <optional>
+#include <random>
+#include <vector>
 
 namespace mce {
 namespace asset {
 
-asset_manager::asset_manager() {
+namespace {
+
+template <typename Load>
+boost::unique_future<std::shared_ptr<const asset>> load_into_future(Load load) {
+	auto promise = std::make_shared<boost::promise<std::shared_ptr<const asset>>>();
+	auto future = promise->get_future();
+	load([promise](const asset_ptr& loaded_asset) { promise->set_value(loaded_asset); },
+		 [promise](std::exception_ptr e) {
+			 // boost::current_exception only preserves the standard exception base types, cancellation is
+			 // therefore copied explicitly to allow catching it on get().
+			 try {
+				 try {
+					 std::rethrow_exception(e);
+				 } catch(const operation_cancelled_exception& cancelled) {
+					 promise->set_exception(cancelled);
+				 } catch(...) {
+					 promise->set_exception(boost::current_exception());
+				 }
+			 } catch(...) {
+			 }
+		 });
+	return future;
+}
+
+} // namespace
+
+asset_manager::asset_manager(unsigned int worker_thread_count) {
 	work = std::make_unique<boost::asio::io_service::work>(task_pool);
-	unsigned int worker_thread_count = 2 * std::max(std::thread::hardware_concurrency(), 1u);
+	if(!worker_thread_count) worker_thread_count = 2 * std::max(std::thread::hardware_concurrency(), 1u);
 	for(unsigned int i = 0; i < worker_thread_count; ++i) {
 		workers.emplace_back([this]() {
 			task_pool.run(); // Enter thread pool
@@ -32,13 +63,186 @@ asset_manager::~asset_manager() {
 
 void asset_manager::start_clean() {
 	task_pool.post([this]() {
-		std::unique_lock<std::shared_timed_mutex> lock(loaded_assets_rw_lock);
-		boost::remove_erase_if(loaded_assets,
-							   [](const auto& element) { return element.second.use_count() == 1; });
+		loaded_assets.erase_if([this](util::symbol, const std::shared_ptr<asset>& loaded_asset) {
+			if(loaded_asset.use_count() != 1) return false;
+			note_removed(*loaded_asset);
+			return true;
+		});
 	});
 }
-std::shared_ptr<const asset> asset_manager::call_loaders_sync(const std::shared_ptr<asset>& asset_to_load) {
-	if(asset_to_load->try_obtain_load_ownership()) {
+
+std::shared_ptr<asset> asset_manager::create_cached_asset(util::symbol name) {
+	auto result = std::make_shared<asset>(name.str());
+	// Registered before any requester's handlers and run while the loader still references the asset,
+	// therefore the size is accounted before the asset can become an eviction candidate.
+	result->run_when_loaded([this](const asset_ptr& loaded_asset) { note_resident(loaded_asset->size()); },
+							[](std::exception_ptr) {});
+	return result;
+}
+
+void asset_manager::note_cache_access(asset& cached_asset, bool inserted) noexcept {
+	if(inserted) {
+		cache_misses.fetch_add(1, std::memory_order_relaxed);
+	} else {
+		cache_hits.fetch_add(1, std::memory_order_relaxed);
+	}
+	// Every request advances the clock, requests of different assets therefore never share a tick.
+	cached_asset.last_use_.store(access_clock.fetch_add(1, std::memory_order_relaxed) + 1,
+								 std::memory_order_relaxed);
+}
+
+void asset_manager::note_resident(uint64_t size) {
+	auto resident = resident_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+	if(resident <= cache_budget_.load(std::memory_order_relaxed)) return;
+	if(!eviction_pending.exchange(true)) {
+		task_pool.post([this]() { evict_to_budget(); });
+	}
+}
+
+void asset_manager::note_removed(const asset& removed_asset) noexcept {
+	if(!removed_asset.ready()) return;
+	resident_bytes.fetch_sub(removed_asset.size(), std::memory_order_relaxed);
+	evictions.fetch_add(1, std::memory_order_relaxed);
+	evicted_bytes.fetch_add(removed_asset.size(), std::memory_order_relaxed);
+}
+
+void asset_manager::evict_to_budget() {
+	// Cleared first, loads completing during this pass schedule another one if they exceed the budget.
+	eviction_pending = false;
+	auto budget = cache_budget_.load(std::memory_order_relaxed);
+	if(resident_bytes.load(std::memory_order_relaxed) <= budget) return;
+	// Approximates LRU by evicting the least recently requested asset of a small random sample, which keeps
+	// the cost per evicted asset independent of the number of cached assets.
+	std::minstd_rand random(uint32_t(access_clock.load(std::memory_order_relaxed)));
+	// Bounds the samples without an eviction in case the cached assets are referenced, every load that
+	// exceeds the budget schedules another pass.
+	auto max_failed_samples = loaded_assets.size() / eviction_sample_size + 1;
+	size_t failed_samples = 0;
+	bool evicted = false;
+	while(failed_samples < max_failed_samples && resident_bytes.load(std::memory_order_relaxed) > budget) {
+		std::optional<util::symbol> oldest_name;
+		uint64_t oldest_use = 0;
+		auto select_oldest = [&oldest_name, &oldest_use](util::symbol name,
+														 const std::shared_ptr<asset>& cached_asset) {
+			if(cached_asset.use_count() != 1 || !cached_asset->ready()) return;
+			auto last_use = cached_asset->last_use_.load(std::memory_order_relaxed);
+			if(oldest_name && last_use >= oldest_use) return;
+			oldest_name = name;
+			oldest_use = last_use;
+		};
+		loaded_assets.for_each_sample(random(), eviction_sample_size, select_oldest);
+		// Rechecked under the shard lock, the asset may have been requested since it was sampled.
+		auto still_oldest = [this, oldest_use](const std::shared_ptr<asset>& cached_asset) {
+			auto last_use = cached_asset->last_use_.load(std::memory_order_relaxed);
+			if(cached_asset.use_count() != 1 || last_use != oldest_use) return false;
+			note_removed(*cached_asset);
+			return true;
+		};
+		if(oldest_name && loaded_assets.erase_if(*oldest_name, still_oldest)) {
+			evicted = true;
+		} else {
+			++failed_samples;
+		}
+	}
+	// The map only drops its references to evicted assets when the epoch-based reclamation frees the removed
+	// nodes. Waiting for it here frees the memory of the evicted assets together with the accounting.
+	if(evicted) util::epoch_synchronize();
+}
+
+void asset_manager::cache_budget(uint64_t bytes) {
+	cache_budget_ = bytes;
+	if(resident_bytes.load(std::memory_order_relaxed) > bytes && !eviction_pending.exchange(true)) {
+		task_pool.post([this]() { evict_to_budget(); });
+	}
+}
+
+asset_cache_statistics asset_manager::cache_statistics() const noexcept {
+	asset_cache_statistics result;
+	result.hits = cache_hits.load(std::memory_order_relaxed);
+	result.misses = cache_misses.load(std::memory_order_relaxed);
+	result.evictions = evictions.load(std::memory_order_relaxed);
+	result.evicted_bytes = evicted_bytes.load(std::memory_order_relaxed);
+	result.resident_bytes = resident_bytes.load(std::memory_order_relaxed);
+	result.budget = cache_budget_.load(std::memory_order_relaxed);
+	return result;
+}
+
+void asset_manager::reset_cache_statistics() noexcept {
+	cache_hits = 0;
+	cache_misses = 0;
+	evictions = 0;
+	evicted_bytes = 0;
+}
+bool asset_manager::enqueue_load(util::symbol name, const std::shared_ptr<asset>& asset_to_load,
+								 load_priority priority, const load_cancellation_token* token) {
+	{
+		std::lock_guard<std::mutex> lock(load_queue_mutex);
+		if(asset_to_load->abandoned_) return false;
+		if(asset_to_load->current_state() != asset::state::initial) return true;
+		++asset_to_load->queued_requests_;
+		load_queues[size_t(priority)].push_back(
+				{name, asset_to_load, token ? std::make_optional(*token) : std::nullopt});
+	}
+	// Each queued request posts one dispatch task, which starts the most urgent waiting load when it runs.
+	task_pool.post([this]() { dispatch_load(); });
+	return true;
+}
+
+void asset_manager::discard_abandoned(util::symbol name, const std::shared_ptr<asset>& abandoned_asset) {
+	loaded_assets.erase_if(name, [&abandoned_asset](const std::shared_ptr<asset>& cached_asset) {
+		return cached_asset == abandoned_asset;
+	});
+}
+
+void asset_manager::dispatch_load() {
+	pending_load request;
+	bool abandon = false;
+	{
+		std::lock_guard<std::mutex> lock(load_queue_mutex);
+		auto queue = std::find_if(load_queues.begin(), load_queues.end(),
+								  [](const std::deque<pending_load>& q) { return !q.empty(); });
+		assert(queue != load_queues.end());
+		request = std::move(queue->front());
+		queue->pop_front();
+		auto& queued_asset = *request.asset_to_load;
+		--queued_asset.queued_requests_;
+		if(request.token && request.token->cancelled()) {
+			// Skip the load only if no other request is waiting for it and nobody started it yet.
+			if(queued_asset.queued_requests_ != 0 || !queued_asset.try_obtain_load_ownership()) return;
+			queued_asset.abandoned_ = true;
+			abandon = true;
+		}
+	}
+	if(abandon) {
+		// Removed from the cache before failing, so that later requests load it again instead of failing.
+		discard_abandoned(request.name, request.asset_to_load);
+		request.asset_to_load->raise_error_flag(std::make_exception_ptr(operation_cancelled_exception(
+				"All requests for asset '" + request.name.str() + "' were cancelled.")));
+		return;
+	}
+	start_load(request.asset_to_load);
+}
+
+void asset_manager::start_load(const std::shared_ptr<asset>& asset_to_load) {
+	// Fails for requests of promoted or synchronously loaded assets, which were already started.
+	if(!asset_to_load->try_obtain_load_ownership()) return;
+	try {
+		auto local_asset_loaders = asset_loaders.get();
+		for(auto& loader : *local_asset_loaders) {
+			if(loader->start_load_asset(asset_to_load, *this, false)) return;
+		}
+	} catch(...) {
+		asset_to_load->raise_error_flag(std::current_exception());
+		throw;
+	}
+	asset_to_load->raise_error_flag(std::make_exception_ptr(
+			path_not_found_exception("Couldn't find asset '" + asset_to_load->name() +
+									 "' through any of the registered loaders.")));
+}
+
+std::shared_ptr<const asset> asset_manager::call_loaders_sync(const std::shared_ptr<asset>& asset_to_load,
+															  bool owned) {
+	if(owned) {
 		try {
 			auto local_asset_loaders = asset_loaders.get();
 			for(auto& loader : *local_asset_loaders) {
@@ -63,61 +267,45 @@ std::shared_ptr<const asset> asset_manager::call_loaders_sync(const std::shared_
 	}
 }
 
-std::shared_ptr<const asset> asset_manager::load_asset_sync_core(const std::string& name) {
-	// Acquire write lock
-	std::unique_lock<std::shared_timed_mutex> lock(loaded_assets_rw_lock);
-	auto it = loaded_assets.find(name);
-	if(it != loaded_assets.end()) {
-		auto res = it->second;
-		lock.unlock();
-		return call_loaders_sync(res);
-	} else {
-		std::shared_ptr<asset> result = std::make_shared<asset>(name);
-		loaded_assets[name] = result;
-		lock.unlock();
-		return call_loaders_sync(result);
-	}
-}
-
-std::shared_ptr<const asset> asset_manager::load_asset_sync(const std::string& name) {
-	{
-		// Acquire read lock
-		std::shared_lock<std::shared_timed_mutex> lock(loaded_assets_rw_lock);
-		auto it = loaded_assets.find(name);
-		if(it != loaded_assets.end()) {
-			auto res = it->second;
-			lock.unlock();
-			return call_loaders_sync(res);
+std::shared_ptr<const asset> asset_manager::load_asset_sync(util::symbol name) {
+	for(;;) {
+		auto entry = loaded_assets.find_or_insert(name, [this, name]() { return create_cached_asset(name); });
+		bool owned = false;
+		if(!entry.first->ready()) {
+			// Taking the ownership under the queue lock prevents racing with the skipping of cancelled loads.
+			std::unique_lock<std::mutex> lock(load_queue_mutex);
+			if(entry.first->abandoned_) {
+				lock.unlock();
+				discard_abandoned(name, entry.first);
+				continue;
+			}
+			owned = entry.first->try_obtain_load_ownership();
 		}
+		note_cache_access(*entry.first, entry.second);
+		return call_loaders_sync(entry.first, owned);
 	}
-	return load_asset_sync_core(name);
 }
-void asset_manager::future_load_task::operator()() {
-	try {
-		promise->set_value(manager->load_asset_sync_core(name));
-	} catch(...) {
-		try {
-			promise->set_exception(std::current_exception());
-		} catch(...) {
-		}
+boost::unique_future<std::shared_ptr<const asset>> asset_manager::load_asset_future(util::symbol name,
+																					load_priority priority) {
+	auto existing = loaded_assets.find(name);
+	if(existing && (*existing)->ready()) {
+		note_cache_access(**existing, false);
+		return boost::make_ready_future(std::shared_ptr<const asset>(*existing));
 	}
+	return load_into_future([this, name, priority](auto completion_handler, auto error_handler) {
+		load_asset_async(name, std::move(completion_handler), std::move(error_handler), priority);
+	});
 }
-boost::unique_future<std::shared_ptr<const asset>> asset_manager::load_asset_future(const std::string& name) {
-	{
-		// Acquire read lock
-		std::shared_lock<std::shared_timed_mutex> lock(loaded_assets_rw_lock);
-		auto it = loaded_assets.find(name);
-		if(it != loaded_assets.end()) {
-			if(it->second->ready()) return boost::make_ready_future(std::shared_ptr<const asset>(it->second));
-			if(it->second->has_error())
-				return boost::make_exceptional_future<std::shared_ptr<const asset>>(
-						path_not_found_exception("Requested asset '" + name + "' is cached as failed."));
-		}
+boost::unique_future<std::shared_ptr<const asset>>
+asset_manager::load_asset_future(util::symbol name, load_priority priority,
+								 const load_cancellation_token& token) {
+	if(token.cancelled()) {
+		return boost::make_exceptional_future<std::shared_ptr<const asset>>(operation_cancelled_exception(
+				"The request for asset '" + name.str() + "' was cancelled."));
 	}
-	future_load_task load_task{name, this};
-	auto future = load_task.promise->get_future();
-	task_pool.post(load_task);
-	return future;
+	return load_into_future([this, name, priority, &token](auto completion_handler, auto error_handler) {
+		load_asset_async(name, std::move(completion_handler), std::move(error_handler), priority, token);
+	});
 }
 void asset_manager::start_pin_load_unit(const std::string& name) {
 	auto local_asset_loaders = asset_loaders.get();
@@ -0,0 +1,472 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/src/asset/async_native_file_reader.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <mce/asset/async_native_file_reader.hpp>
+#include <mce/asset/native_file_reader.hpp>
+#include <mce/exceptions.hpp>
+#include <mce/util/path_util.hpp>
+
+#ifdef __linux__
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <mutex>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#define MCE_ASYNC_NATIVE_FILE_READER_IO_URING
+#endif
+
+namespace mce {
+namespace asset {
+
+#ifdef MCE_ASYNC_NATIVE_FILE_READER_IO_URING
+
+namespace {
+
+std::string full_path(const std::string& prefix, const std::string& file) {
+	std::string path = prefix;
+	path += '/';
+	path += file;
+	util::sanitize_path_inplace(path);
+	return path;
+}
+
+// Opens the given regular file for reading and determines its size, returns -1 if that isn't possible.
+int open_file(const std::string& path, file_size& size) {
+	int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if(fd < 0) return -1;
+	struct stat file_stat;
+	if(fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode)) {
+		close(fd);
+		return -1;
+	}
+	size = file_size(file_stat.st_size);
+	return fd;
+}
+
+bool pread_all(int fd, char* buffer, file_size size, file_size offset = 0) {
+	file_size position = 0;
+	while(position < size) {
+		auto result = pread(fd, buffer + position, size - position, off_t(offset + position));
+		if(result < 0 && errno == EINTR) continue;
+		if(result <= 0) return false;
+		position += file_size(result);
+	}
+	return true;
+}
+
+std::shared_ptr<char> allocate_content(file_size size) {
+	return std::shared_ptr<char>(new char[size], [](char* ptr) { delete[] ptr; });
+}
+
+io_exception read_error(const std::string& path) {
+	return io_exception("Error reading file '" + path + "'.");
+}
+
+} // namespace
+
+struct async_native_file_reader::impl {
+	struct read_request {
+		int fd;
+		std::string path;
+		std::shared_ptr<char> content;
+		file_size size;
+		file_size position;
+		iovec buffer_range;
+		file_read_completion_handler on_completion;
+		error_handler on_error;
+		// Makes the handoff through the kernel visible to the C++ memory model and thread sanitizers.
+		std::atomic<unsigned> submissions{0};
+	};
+
+	// Limits single reads to stay within the 32 bit length of the submission queue entries.
+	static constexpr file_size max_read_size = file_size(1) << 30;
+	// Limits the retries of transient submission failures before the queued reads fall back to pread.
+	static constexpr int max_submit_attempts = 16;
+
+	int ring_fd = -1;
+	int wake_fd = -1;
+	void* sq_ring = MAP_FAILED;
+	size_t sq_ring_size = 0;
+	void* cq_ring = MAP_FAILED;
+	size_t cq_ring_size = 0;
+	void* sqe_memory = MAP_FAILED;
+	size_t sqe_memory_size = 0;
+	unsigned* sq_head = nullptr;
+	unsigned* sq_tail = nullptr;
+	unsigned* sq_mask = nullptr;
+	unsigned* sq_array = nullptr;
+	unsigned sq_entries = 0;
+	io_uring_sqe* sqes = nullptr;
+	unsigned* cq_head = nullptr;
+	unsigned* cq_tail = nullptr;
+	unsigned* cq_mask = nullptr;
+	io_uring_cqe* cqes = nullptr;
+	unsigned cq_entries = 0;
+
+	// Only guards the submission queue tail, the submissions are flushed by the completion thread.
+	std::mutex submission_mutex;
+	// Set when entries were queued since the last flush, only the first of them wakes the completion thread.
+	bool flush_requested = false;
+	std::atomic<unsigned> in_flight{0};
+	std::atomic<bool> stopping{false};
+	// Only used by the completion thread, reserved for a full submission queue.
+	std::vector<read_request*> refused_requests;
+	std::thread completion_thread;
+
+	explicit impl(unsigned int queue_depth) {
+		io_uring_params params;
+		std::memset(&params, 0, sizeof(params));
+		ring_fd = int(syscall(__NR_io_uring_setup, std::max(queue_depth, 1u), &params));
+		if(ring_fd < 0) return;
+		sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+		cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+		bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+		if(single_mmap) sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+		sq_ring = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd,
+					   IORING_OFF_SQ_RING);
+		if(sq_ring == MAP_FAILED) {
+			release_ring();
+			return;
+		}
+		if(single_mmap) {
+			cq_ring = sq_ring;
+		} else {
+			cq_ring = mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd,
+						   IORING_OFF_CQ_RING);
+			if(cq_ring == MAP_FAILED) {
+				release_ring();
+				return;
+			}
+		}
+		sqe_memory_size = params.sq_entries * sizeof(io_uring_sqe);
+		sqe_memory = mmap(nullptr, sqe_memory_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+						  ring_fd, IORING_OFF_SQES);
+		if(sqe_memory == MAP_FAILED) {
+			release_ring();
+			return;
+		}
+		auto sq_base = static_cast<char*>(sq_ring);
+		sq_head = reinterpret_cast<unsigned*>(sq_base + params.sq_off.head);
+		sq_tail = reinterpret_cast<unsigned*>(sq_base + params.sq_off.tail);
+		sq_mask = reinterpret_cast<unsigned*>(sq_base + params.sq_off.ring_mask);
+		sq_array = reinterpret_cast<unsigned*>(sq_base + params.sq_off.array);
+		sq_entries = params.sq_entries;
+		sqes = static_cast<io_uring_sqe*>(sqe_memory);
+		auto cq_base = static_cast<char*>(cq_ring);
+		cq_head = reinterpret_cast<unsigned*>(cq_base + params.cq_off.head);
+		cq_tail = reinterpret_cast<unsigned*>(cq_base + params.cq_off.tail);
+		cq_mask = reinterpret_cast<unsigned*>(cq_base + params.cq_off.ring_mask);
+		cqes = reinterpret_cast<io_uring_cqe*>(cq_base + params.cq_off.cqes);
+		cq_entries = params.cq_entries;
+		// Queued submissions and stopping are signaled through a separate event instead of a submission,
+		// which could fail.
+		wake_fd = eventfd(0, EFD_CLOEXEC);
+		if(wake_fd < 0) {
+			release_ring();
+			return;
+		}
+		try {
+			refused_requests.reserve(sq_entries);
+			completion_thread = std::thread([this]() { run_completions(); });
+		} catch(...) {
+			release_ring();
+		}
+	}
+	~impl() noexcept {
+		if(ring_fd < 0) return;
+		stopping = true;
+		// Wakes up the completion thread in case it waits for completions.
+		wake_completion_thread();
+		completion_thread.join();
+		release_ring();
+	}
+
+	void release_ring() noexcept {
+		if(sqe_memory != MAP_FAILED) munmap(sqe_memory, sqe_memory_size);
+		if(cq_ring != MAP_FAILED && cq_ring != sq_ring) munmap(cq_ring, cq_ring_size);
+		if(sq_ring != MAP_FAILED) munmap(sq_ring, sq_ring_size);
+		sqe_memory = cq_ring = sq_ring = MAP_FAILED;
+		if(wake_fd >= 0) close(wake_fd);
+		wake_fd = -1;
+		if(ring_fd >= 0) close(ring_fd);
+		ring_fd = -1;
+	}
+
+	bool active() const noexcept {
+		return ring_fd >= 0;
+	}
+
+	// Reserves a completion queue slot, so that the completion queue can't overflow.
+	bool try_reserve_slot() noexcept {
+		if(in_flight.fetch_add(1, std::memory_order_relaxed) < cq_entries) return true;
+		in_flight.fetch_sub(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	void wake_completion_thread() noexcept {
+		uint64_t wake_up = 1;
+		while(write(wake_fd, &wake_up, sizeof(wake_up)) < 0 && errno == EINTR) {
+		}
+	}
+
+	// Queues the entry for the next flush by the completion thread and returns false if the submission queue
+	// is full. The kernel only consumes entries in flush_submissions, the queue is therefore only drained by
+	// the completion thread.
+	bool queue_submission(const io_uring_sqe& entry) noexcept {
+		bool wake_up = false;
+		{
+			std::lock_guard<std::mutex> lock(submission_mutex);
+			unsigned tail = *sq_tail;
+			if(tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE) >= sq_entries) return false;
+			unsigned index = tail & *sq_mask;
+			sqes[index] = entry;
+			sq_array[index] = index;
+			__atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+			wake_up = !flush_requested;
+			flush_requested = true;
+		}
+		// Entries queued by the completion thread itself are flushed before it waits again.
+		if(wake_up && std::this_thread::get_id() != completion_thread.get_id()) wake_completion_thread();
+		return true;
+	}
+
+	// Submits all queued entries with one io_uring_enter call. Entries the kernel refuses to accept after
+	// the bounded retries are removed from the submission queue again and completed using pread.
+	void flush_submissions() noexcept {
+		unsigned tail;
+		{
+			std::lock_guard<std::mutex> lock(submission_mutex);
+			flush_requested = false;
+			tail = *sq_tail;
+		}
+		for(int attempt = 0; attempt < max_submit_attempts; ++attempt) {
+			unsigned pending = tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+			if(!pending) return;
+			auto result = syscall(__NR_io_uring_enter, ring_fd, pending, 0, 0, nullptr, 0);
+			if(result > 0) continue;
+			if(result < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) break;
+			std::this_thread::yield();
+		}
+		{
+			std::lock_guard<std::mutex> lock(submission_mutex);
+			unsigned head = __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+			unsigned queued_tail = *sq_tail;
+			for(unsigned i = head; i != queued_tail; ++i) {
+				auto& entry = sqes[sq_array[i & *sq_mask]];
+				refused_requests.push_back(reinterpret_cast<read_request*>(uintptr_t(entry.user_data)));
+			}
+			__atomic_store_n(sq_tail, head, __ATOMIC_RELEASE);
+			flush_requested = false;
+		}
+		// The ring refused the reads, complete them synchronously instead of leaving them pending.
+		for(auto request : refused_requests) {
+			read_synchronously(request);
+		}
+		refused_requests.clear();
+	}
+
+	void read_synchronously(read_request* request) noexcept {
+		bool success = pread_all(request->fd, request->content.get() + request->position,
+								 request->size - request->position, request->position);
+		finish_request(request, success);
+	}
+
+	void submit_read(read_request* request) noexcept {
+		request->buffer_range.iov_base = request->content.get() + request->position;
+		request->buffer_range.iov_len = std::min(request->size - request->position, max_read_size);
+		io_uring_sqe entry;
+		std::memset(&entry, 0, sizeof(entry));
+		entry.opcode = IORING_OP_READV;
+		entry.fd = request->fd;
+		entry.off = request->position;
+		entry.addr = uint64_t(reinterpret_cast<uintptr_t>(&request->buffer_range));
+		entry.len = 1;
+		entry.user_data = uint64_t(reinterpret_cast<uintptr_t>(request));
+		request->submissions.fetch_add(1, std::memory_order_release);
+		if(queue_submission(entry)) return;
+		// The submission queue is full, complete the read synchronously instead of waiting for a slot.
+		read_synchronously(request);
+	}
+
+	void finish_request(read_request* request, bool success) noexcept {
+		std::unique_ptr<read_request> owned_request(request);
+		close(request->fd);
+		// Frees the slot before running the handlers, which don't use the ring.
+		in_flight.fetch_sub(1, std::memory_order_release);
+		try {
+			if(success) {
+				owned_request->on_completion(owned_request->content, owned_request->size);
+			} else {
+				owned_request->on_error(std::make_exception_ptr(read_error(owned_request->path)));
+			}
+		} catch(...) {
+			// Drop exceptions escaped from completion handlers
+		}
+	}
+
+	void process_completion(const io_uring_cqe& completion) noexcept {
+		auto request = reinterpret_cast<read_request*>(uintptr_t(completion.user_data));
+		request->submissions.load(std::memory_order_acquire);
+		if(completion.res > 0) {
+			request->position += file_size(completion.res);
+			if(request->position < request->size) {
+				submit_read(request);
+			} else {
+				finish_request(request, true);
+			}
+		} else if(completion.res == -EINTR || completion.res == -EAGAIN) {
+			submit_read(request);
+		} else {
+			// Either an error or the end of a file that was truncated after it was opened.
+			finish_request(request, false);
+		}
+	}
+
+	void run_completions() noexcept {
+		for(;;) {
+			flush_submissions();
+			unsigned head = *cq_head;
+			unsigned tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+			if(head == tail) {
+				if(stopping && in_flight.load(std::memory_order_acquire) == 0) return;
+				// Waits for completions, queued submissions or the stop request.
+				pollfd fds[2] = {{ring_fd, POLLIN, 0}, {wake_fd, POLLIN, 0}};
+				if(poll(fds, 2, -1) > 0 && (fds[1].revents & POLLIN)) {
+					uint64_t wake_ups;
+					while(read(wake_fd, &wake_ups, sizeof(wake_ups)) < 0 && errno == EINTR) {
+					}
+				}
+				continue;
+			}
+			for(; head != tail; ++head) {
+				io_uring_cqe completion = cqes[head & *cq_mask];
+				// Frees the slot before processing because processing can queue follow-up reads.
+				__atomic_store_n(cq_head, head + 1, __ATOMIC_RELEASE);
+				process_completion(completion);
+			}
+		}
+	}
+
+	std::pair<file_content_ptr, file_size> read_file(const std::string& prefix, const std::string& file) {
+		auto path = full_path(prefix, file);
+		file_size size = 0;
+		int fd = open_file(path, size);
+		if(fd < 0) return std::make_pair(file_content_ptr(), file_size(0ull));
+		auto content = allocate_content(size);
+		bool success = pread_all(fd, content.get(), size);
+		close(fd);
+		if(!success) throw read_error(path);
+		return std::make_pair(content, size);
+	}
+
+	std::pair<file_content_ptr, file_size> read_file_range(const std::string& prefix, const std::string& file,
+														   file_size offset, file_size size) {
+		auto path = full_path(prefix, file);
+		file_size file_length = 0;
+		int fd = open_file(path, file_length);
+		if(fd < 0) return std::make_pair(file_content_ptr(), file_size(0ull));
+		offset = std::min(offset, file_length);
+		size = std::min(size, file_length - offset);
+		auto content = allocate_content(size);
+		bool success = pread_all(fd, content.get(), size, offset);
+		close(fd);
+		if(!success) throw read_error(path);
+		return std::make_pair(content, size);
+	}
+
+	bool start_read_file(const std::string& prefix, const std::string& file,
+						 file_read_completion_handler completion_handler, error_handler error_handler) {
+		auto path = full_path(prefix, file);
+		file_size size = 0;
+		int fd = open_file(path, size);
+		if(fd < 0) return false;
+		auto content = allocate_content(size);
+		if(!active() || size == 0 || !try_reserve_slot()) {
+			bool success = pread_all(fd, content.get(), size);
+			close(fd);
+			if(success) {
+				completion_handler(content, size);
+			} else {
+				error_handler(std::make_exception_ptr(read_error(path)));
+			}
+			return true;
+		}
+		auto request = std::make_unique<read_request>();
+		request->fd = fd;
+		request->path = std::move(path);
+		request->content = std::move(content);
+		request->size = size;
+		request->position = 0;
+		request->on_completion = std::move(completion_handler);
+		request->on_error = std::move(error_handler);
+		// Ownership passes to the completion thread, which deletes the request in finish_request.
+		submit_read(request.release());
+		return true;
+	}
+};
+
+#else
+
+struct async_native_file_reader::impl {
+	native_file_reader reader;
+
+	explicit impl(unsigned int) {}
+
+	bool active() const noexcept {
+		return false;
+	}
+	std::pair<file_content_ptr, file_size> read_file(const std::string& prefix, const std::string& file) {
+		return reader.read_file(prefix, file);
+	}
+	bool start_read_file(const std::string& prefix, const std::string& file,
+						 file_read_completion_handler completion_handler, error_handler error_handler) {
+		return reader.start_read_file(prefix, file, std::move(completion_handler), std::move(error_handler));
+	}
+	std::pair<file_content_ptr, file_size> read_file_range(const std::string& prefix, const std::string& file,
+														   file_size offset, file_size size) {
+		return reader.read_file_range(prefix, file, offset, size);
+	}
+};
+
+#endif
+
+async_native_file_reader::async_native_file_reader(unsigned int queue_depth)
+		: impl_{std::make_unique<impl>(queue_depth)} {}
+async_native_file_reader::~async_native_file_reader() noexcept = default;
+
+bool async_native_file_reader::async_backend_active() const noexcept {
+	return impl_->active();
+}
+std::pair<file_content_ptr, file_size> async_native_file_reader::read_file(const std::string& prefix,
+																		   const std::string& file) {
+	return impl_->read_file(prefix, file);
+}
+bool async_native_file_reader::start_read_file(const std::string& prefix, const std::string& file,
+											   file_read_completion_handler completion_handler,
+											   error_handler error_handler) {
+	return impl_->start_read_file(prefix, file, std::move(completion_handler), std::move(error_handler));
+}
+std::pair<file_content_ptr, file_size> async_native_file_reader::read_file_range(const std::string& prefix,
+																				 const std::string& file,
+																				 file_size offset,
+																				 file_size size) {
+	return impl_->read_file_range(prefix, file, offset, size);
+}
+
+} // namespace asset
+} // namespace mce
@@ -11,8 +11,10 @@
 #include <mce/asset/file_reader.hpp>
 #include <mce/util/local_function.hpp>
 #include <mutex>
+#include <thread>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 namespace mce {
 namespace asset {
@@ -24,12 +26,24 @@ file_asset_loader::file_asset_loader(std::vector<path_prefix>&& prefixes) : pref
 	load_units.push_back("");
 }
 
-bool file_asset_loader::start_load_asset(const std::shared_ptr<asset>& asset, asset_manager&, bool) {
-	std::shared_lock<std::shared_timed_mutex> lock(load_units_rw_lock);
+bool file_asset_loader::start_load_asset(const std::shared_ptr<asset>& asset, asset_manager& asset_manager,
+										 bool) {
+	// Work on a copy of the load units because the readers may run the completion handlers synchronously,
+	// which must not happen while holding the lock.
+	std::vector<std::string> local_load_units;
+	{
+		std::shared_lock<std::shared_timed_mutex> lock(load_units_rw_lock);
+		local_load_units = load_units;
+	}
+	// Readers that complete on their own threads get the completion launched on the task pool, so that the
+	// handlers of the asset don't hold up the reader. The guard keeps the task pool running until then.
+	// Completions on the calling thread run directly, so synchronous loads don't wait for a free worker.
+	auto caller = std::this_thread::get_id();
+	auto task_pool_guard = keep_task_pool_running(asset_manager);
 	std::string file_path;
 	file_path.reserve(128);
 	for(const auto& prefix : prefixes) {
-		for(const auto& load_unit : load_units) {
+		for(const auto& load_unit : local_load_units) {
 			if(!load_unit.empty()) {
 				file_path = load_unit;
 				file_path += '/';
@@ -37,12 +51,26 @@ bool file_asset_loader::start_load_asset(const std::shared_ptr<asset>& asset, as
 				file_path = "";
 			}
 			file_path += asset->name();
-			file_content_ptr file_content;
-			file_size file_size = 0u;
-			std::tie(file_content, file_size) = prefix.reader->read_file(prefix.prefix, file_path);
-			if(file_content) {
-				lock.unlock();
-				finish_loading(asset, file_content, file_size);
+			if(prefix.reader->start_read_file(
+					   prefix.prefix, file_path,
+					   [asset, &asset_manager, caller, task_pool_guard](const file_content_ptr& content,
+																		file_size size) {
+						   if(std::this_thread::get_id() == caller) {
+							   finish_loading(asset, content, size);
+							   return;
+						   }
+						   launch_async_task(asset_manager, [asset, content, size, task_pool_guard]() {
+							   finish_loading(asset, content, size);
+						   });
+					   },
+					   [asset, &asset_manager, caller, task_pool_guard](std::exception_ptr e) {
+						   if(std::this_thread::get_id() == caller) {
+							   raise_error_flag(asset, e);
+							   return;
+						   }
+						   launch_async_task(asset_manager,
+											 [asset, e, task_pool_guard]() { raise_error_flag(asset, e); });
+					   })) {
 				return true;
 			}
 		}
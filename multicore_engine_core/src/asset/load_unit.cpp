@@ -25,6 +25,11 @@ void load_unit::load_meta_data(const std::shared_ptr<const char>& data, size_t s
 				io_exception("Couldn't read meta data for load unit '" + name_ + "'.")));
 		check_error_flag();
 	} else {
+		asset_index_.reserve(meta_data_.assets.size());
+		for(size_t i = 0; i < meta_data_.assets.size(); ++i) {
+			// For duplicate names the first asset is used, emplace keeps the existing entry.
+			asset_index_.emplace(meta_data_.assets[i].name, i);
+		}
 		current_state_ = state::meta_ready;
 		lock.unlock();
 		completed_cv.notify_all();
@@ -63,10 +68,10 @@ void load_unit::complete_loading(const std::shared_ptr<const char>& data, size_t
 
 load_unit::asset_resolution_cookie load_unit::resolve_asset(const std::string& name) const {
 	if(!meta_data_ready()) throw async_state_exception("Load unit meta data not ready yet.");
-	auto it = std::find_if(meta_data_.assets.begin(), meta_data_.assets.end(),
-						   [&](const asset_meta_data& element) { return name == element.name; });
-	if(it != meta_data_.assets.end()) {
-		return asset_resolution_cookie(this, it->offset, it->size);
+	auto it = asset_index_.find(name);
+	if(it != asset_index_.end()) {
+		const auto& element = meta_data_.assets[it->second];
+		return asset_resolution_cookie(this, element.offset, element.size);
 	} else {
 		return asset_resolution_cookie();
 	}
@@ -77,6 +82,7 @@ load_unit::get_asset_content(const load_unit::asset_resolution_cookie& resolutio
 	if(!ready()) throw async_state_exception("Load unit not ready yet.");
 	if(resolution_cookie.load_unit != this)
 		throw logic_exception("Invalid asset resolution cookie provided (not from this load unit).");
+	if(!payload_data_) throw async_state_exception("Load unit pay-load is not loaded as a whole.");
 	size_t offset = size_t(resolution_cookie.offset);
 	if(uint64_t(offset) != resolution_cookie.offset)
 		throw out_of_range_exception("Asset offset too big for address space.");
@@ -18,11 +18,11 @@
 
 namespace mce {
 namespace asset {
-load_unit_asset_loader::load_unit_asset_loader(const std::vector<path_prefix>& prefixes)
-		: prefixes(prefixes) {}
+load_unit_asset_loader::load_unit_asset_loader(const std::vector<path_prefix>& prefixes, payload_mode mode)
+		: prefixes(prefixes), payload_mode_(mode) {}
 
-load_unit_asset_loader::load_unit_asset_loader(std::vector<path_prefix>&& prefixes)
-		: prefixes(std::move(prefixes)) {}
+load_unit_asset_loader::load_unit_asset_loader(std::vector<path_prefix>&& prefixes, payload_mode mode)
+		: prefixes(std::move(prefixes)), payload_mode_(mode) {}
 
 std::pair<file_content_ptr, file_size>
 load_unit_asset_loader::load_file_from_prefixes(const std::string& name) const {
@@ -34,6 +34,45 @@ load_unit_asset_loader::load_file_from_prefixes(const std::string& name) const {
 	}
 	return std::make_pair(file_content_ptr(), file_size(0));
 }
+std::pair<file_content_ptr, file_size>
+load_unit_asset_loader::load_file_range_from_prefixes(const std::string& name, file_size offset,
+													  file_size size) const {
+	for(const auto& prefix : prefixes) {
+		auto file = prefix.reader->read_file_range(prefix.prefix, name, offset, size);
+		if(file.first) {
+			return file;
+		}
+	}
+	return std::make_pair(file_content_ptr(), file_size(0));
+}
+void load_unit_asset_loader::complete_meta_data_loading(const std::shared_ptr<load_unit>& load_unit,
+														asset_manager& asset_manager) const {
+	if(payload_mode_ == payload_mode::streaming) {
+		// The assets are read individually, the load unit is usable as soon as the meta data are loaded.
+		load_unit->complete_loading(std::shared_ptr<const char>(), 0);
+	} else {
+		start_payload_loading(load_unit, asset_manager);
+	}
+}
+void load_unit_asset_loader::load_asset_range(const std::shared_ptr<asset>& asset,
+											  const std::shared_ptr<load_unit>& load_unit, uint64_t offset,
+											  uint64_t size) const {
+	try {
+		file_content_ptr content;
+		file_size read_size;
+		std::tie(content, read_size) =
+				load_file_range_from_prefixes(load_unit->name() + ".lup", offset, size);
+		if(content && read_size == size) {
+			finish_loading(asset, content, read_size);
+		} else {
+			raise_error_flag(asset, std::make_exception_ptr(path_not_found_exception(
+											"Couldn't read asset '" + asset->name() + "' from load unit '" +
+											load_unit->name() + "'.")));
+		}
+	} catch(...) {
+		raise_error_flag(asset, std::current_exception());
+	}
+}
 void load_unit_asset_loader::start_payload_loading(const std::shared_ptr<load_unit>& load_unit,
 												   asset_manager& asset_manager) const {
 	launch_async_task(asset_manager, [load_unit, this]() {
@@ -56,7 +95,7 @@ void load_unit_asset_loader::start_payload_loading(const std::shared_ptr<load_un
 }
 
 void load_unit_asset_loader::prepare_load_unit_meta_data(const std::shared_ptr<load_unit>& load_unit,
-														 asset_manager& asset_manager) const {
+														 asset_manager& asset_manager) {
 	if(!load_unit->meta_data_ready()) {
 		if(load_unit->try_obtain_meta_load_ownership()) {
 			file_content_ptr content;
@@ -65,15 +104,17 @@ void load_unit_asset_loader::prepare_load_unit_meta_data(const std::shared_ptr<l
 				std::tie(content, size) = load_file_from_prefixes(load_unit->name() + ".lum");
 				if(content) {
 					load_unit->load_meta_data(content, size);
-					start_payload_loading(load_unit, asset_manager);
+					complete_meta_data_loading(load_unit, asset_manager);
 				} else {
 					load_unit->raise_error_flag(std::make_exception_ptr(path_not_found_exception(
 							"Couldn't load meta data for load unit '" + load_unit->name() + "'.")));
 				}
 			} catch(...) {
 				load_unit->raise_error_flag(std::current_exception());
+				index_load_unit(load_unit);
 				throw;
 			}
+			index_load_unit(load_unit);
 			load_unit->check_error_flag();
 		} else {
 			load_unit->internal_wait_for_meta_complete();
@@ -81,56 +122,122 @@ void load_unit_asset_loader::prepare_load_unit_meta_data(const std::shared_ptr<l
 	}
 }
 
+void load_unit_asset_loader::index_load_unit(const std::shared_ptr<load_unit>& load_unit) {
+	std::unique_lock<std::shared_timed_mutex> lock(load_units_rw_lock);
+	auto it = std::find_if(load_units.begin(), load_units.end(),
+						   [&load_unit](const pinned_load_unit& pinned) { return pinned.unit == load_unit; });
+	// Load units that were unpinned in the meantime are not indexed.
+	if(it == load_units.end() || it->indexed) return;
+	it->indexed = true;
+	--unindexed_load_units;
+	if(!load_unit->meta_data_ready()) return;
+	for(const auto& element : load_unit->meta_data_.assets) {
+		indexed_asset indexed{load_unit, it->pin_order, element.offset, element.size};
+		auto entry = asset_index.try_emplace(element.name, indexed);
+		// The meta data can be loaded in any order, the load unit pinned first takes precedence.
+		if(!entry.second && entry.first->second.pin_order > it->pin_order) {
+			entry.first->second = std::move(indexed);
+		}
+	}
+}
+
+bool load_unit_asset_loader::start_load_from_unit(const std::shared_ptr<asset>& asset,
+												  const std::shared_ptr<load_unit>& load_unit,
+												  asset_manager& asset_manager, bool sync_hint) {
+	prepare_load_unit_meta_data(load_unit, asset_manager);
+	auto resolution_cookie = load_unit->resolve_asset(asset->name());
+	if(!resolution_cookie) return false;
+	start_load_range(asset, load_unit, resolution_cookie.offset, resolution_cookie.size, asset_manager,
+					 sync_hint);
+	return true;
+}
+
+void load_unit_asset_loader::start_load_range(const std::shared_ptr<asset>& asset,
+											  const std::shared_ptr<load_unit>& load_unit, uint64_t offset,
+											  uint64_t size, asset_manager& asset_manager, bool sync_hint) {
+	if(payload_mode_ == payload_mode::streaming) {
+		if(sync_hint) {
+			load_asset_range(asset, load_unit, offset, size);
+		} else {
+			launch_async_task(asset_manager, [this, asset, load_unit, offset, size]() {
+				load_asset_range(asset, load_unit, offset, size);
+			});
+		}
+		return;
+	}
+	load_unit::asset_resolution_cookie resolution_cookie(load_unit.get(), offset, size);
+	load_unit->run_when_loaded(
+			[asset, resolution_cookie](const load_unit_ptr& load_unit) {
+				file_content_ptr content;
+				file_size size;
+				std::tie(content, size) = load_unit->get_asset_content(resolution_cookie);
+				if(content) {
+					finish_loading(asset, content, size);
+				} else {
+					raise_error_flag(asset, std::make_exception_ptr(path_not_found_exception(
+													"Couldn't load asset '" + asset->name() +
+													"' from load unit '" + load_unit->name() + "'.")));
+				}
+			},
+			[asset](std::exception_ptr e) { raise_error_flag(asset, e); });
+	if(sync_hint) {
+		if(!load_unit->ready()) {
+			if(load_unit->try_obtain_data_load_ownership()) {
+				try {
+					file_content_ptr content;
+					file_size size;
+					std::tie(content, size) = load_file_from_prefixes(load_unit->name() + ".lup");
+					if(content) {
+						load_unit->complete_loading(content, size);
+					} else {
+						load_unit->raise_error_flag(std::make_exception_ptr(path_not_found_exception(
+								"Couldn't load payload data for load unit '" + load_unit->name() + "'.")));
+					}
+				} catch(...) {
+					load_unit->raise_error_flag(std::current_exception());
+				}
+			}
+		}
+	}
+}
+
 bool load_unit_asset_loader::start_load_asset(const std::shared_ptr<asset>& asset,
 											  asset_manager& asset_manager, bool sync_hint) {
+	std::shared_ptr<load_unit> indexed_unit;
+	uint64_t offset = 0;
+	uint64_t size = 0;
+	{
+		std::shared_lock<std::shared_timed_mutex> lock(load_units_rw_lock);
+		if(unindexed_load_units == 0) {
+			auto it = asset_index.find(asset->name());
+			if(it == asset_index.end()) return false;
+			indexed_unit = it->second.unit;
+			// The entry locates the asset, it doesn't need to be resolved in the load unit again.
+			offset = it->second.offset;
+			size = it->second.size;
+		}
+	}
+	if(indexed_unit) {
+		try {
+			start_load_range(asset, indexed_unit, offset, size, asset_manager, sync_hint);
+			return true;
+		} catch(...) {
+		}
+	}
+	// While the meta data of pinned load units are still loading or if the indexed load unit failed, all load
+	// units are tried in pin order.
 	auto local_load_units = load_unit_scratch.get();
 	{
 		std::shared_lock<std::shared_timed_mutex> lock(load_units_rw_lock);
-		*local_load_units = load_units;
+		local_load_units->clear();
+		for(const auto& pinned : load_units) {
+			local_load_units->push_back(pinned.unit);
+		}
 	}
 	for(const auto& load_unit : *local_load_units) {
+		if(load_unit == indexed_unit) continue;
 		try {
-			prepare_load_unit_meta_data(load_unit, asset_manager);
-			auto resolution_cookie = load_unit->resolve_asset(asset->name());
-			if(resolution_cookie) {
-				load_unit->run_when_loaded(
-						[asset, resolution_cookie](const load_unit_ptr& load_unit) {
-							file_content_ptr content;
-							file_size size;
-							std::tie(content, size) = load_unit->get_asset_content(resolution_cookie);
-							if(content) {
-								finish_loading(asset, content, size);
-							} else {
-								raise_error_flag(asset,
-												 std::make_exception_ptr(path_not_found_exception(
-														 "Couldn't load asset '" + asset->name() +
-														 "' from load unit '" + load_unit->name() + "'.")));
-							}
-						},
-						[asset](std::exception_ptr e) { raise_error_flag(asset, e); });
-				if(sync_hint) {
-					if(!load_unit->ready()) {
-						if(load_unit->try_obtain_data_load_ownership()) {
-							try {
-								file_content_ptr content;
-								file_size size;
-								std::tie(content, size) = load_file_from_prefixes(load_unit->name() + ".lup");
-								if(content) {
-									load_unit->complete_loading(content, size);
-								} else {
-									load_unit->raise_error_flag(
-											std::make_exception_ptr(path_not_found_exception(
-													"Couldn't load payload data for load unit '" +
-													load_unit->name() + "'.")));
-								}
-							} catch(...) {
-								load_unit->raise_error_flag(std::current_exception());
-							}
-						}
-					}
-				}
-				return true;
-			}
+			if(start_load_from_unit(asset, load_unit, asset_manager, sync_hint)) return true;
 		} catch(...) {
 		}
 	}
@@ -142,13 +249,15 @@ std::shared_ptr<load_unit> load_unit_asset_loader::start_pin_load_unit_helper(co
 	std::shared_ptr<load_unit> load_unit_ptr;
 	{
 		std::unique_lock<std::shared_timed_mutex> lock(load_units_rw_lock);
-		auto it = std::find_if(load_units.begin(), load_units.end(),
-							   [&name](const auto& load_unit) { return name == load_unit->name(); });
+		auto it = std::find_if(load_units.begin(), load_units.end(), [&name](const pinned_load_unit& pinned) {
+			return pinned.unit->name() == name;
+		});
 		if(it != load_units.end()) {
-			return *it;
+			return it->unit;
 		} else {
 			load_unit_ptr = std::make_shared<load_unit>(name);
-			load_units.emplace_back(load_unit_ptr);
+			load_units.push_back({load_unit_ptr, next_pin_order++, false});
+			++unindexed_load_units;
 		}
 	}
 	launch_async_task(manager, [this, load_unit_ptr, &manager]() {
@@ -159,7 +268,7 @@ std::shared_ptr<load_unit> load_unit_asset_loader::start_pin_load_unit_helper(co
 				std::tie(content, size) = load_file_from_prefixes(load_unit_ptr->name() + ".lum");
 				if(content) {
 					load_unit_ptr->load_meta_data(content, size);
-					start_payload_loading(load_unit_ptr, manager);
+					complete_meta_data_loading(load_unit_ptr, manager);
 				} else {
 					load_unit_ptr->raise_error_flag(std::make_exception_ptr(path_not_found_exception(
 							"Couldn't load meta data for load unit '" + load_unit_ptr->name() + "'.")));
@@ -167,6 +276,7 @@ std::shared_ptr<load_unit> load_unit_asset_loader::start_pin_load_unit_helper(co
 			} catch(...) {
 				load_unit_ptr->raise_error_flag(std::current_exception());
 			}
+			index_load_unit(load_unit_ptr);
 		}
 	});
 	return load_unit_ptr;
@@ -183,9 +293,33 @@ void load_unit_asset_loader::start_pin_load_unit(const std::string& name, asset_
 }
 void load_unit_asset_loader::start_unpin_load_unit(const std::string& name, asset_manager&) {
 	std::unique_lock<std::shared_timed_mutex> lock(load_units_rw_lock);
-	load_units.erase(std::remove_if(load_units.begin(), load_units.end(),
-									[&name](const auto& load_unit) { return load_unit->name() == name; }),
-					 load_units.end());
+	auto it = std::find_if(load_units.begin(), load_units.end(),
+						   [&name](const pinned_load_unit& pinned) { return pinned.unit->name() == name; });
+	if(it == load_units.end()) return;
+	auto removed = std::move(*it);
+	load_units.erase(it);
+	if(!removed.indexed) {
+		--unindexed_load_units;
+		return;
+	}
+	// Assets provided by the removed load unit fall back to the next pinned load unit containing them.
+	for(const auto& element : removed.unit->meta_data_.assets) {
+		auto entry = asset_index.find(element.name);
+		if(entry == asset_index.end() || entry->second.unit != removed.unit) continue;
+		load_unit::asset_resolution_cookie resolution_cookie;
+		auto replacement =
+				std::find_if(load_units.begin(), load_units.end(), [&](const pinned_load_unit& pinned) {
+					if(!pinned.indexed || !pinned.unit->meta_data_ready()) return false;
+					resolution_cookie = pinned.unit->resolve_asset(element.name);
+					return bool(resolution_cookie);
+				});
+		if(replacement != load_units.end()) {
+			entry->second = indexed_asset{replacement->unit, replacement->pin_order, resolution_cookie.offset,
+										  resolution_cookie.size};
+		} else {
+			asset_index.erase(entry);
+		}
+	}
 }
 } // namespace asset
 } // namespace mce
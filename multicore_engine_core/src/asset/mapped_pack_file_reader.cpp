@@ -0,0 +1,106 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/src/asset/mapped_pack_file_reader.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <algorithm>
+#include <boost/interprocess/exceptions.hpp>
+#include <limits>
+#include <mce/asset/mapped_pack_file_reader.hpp>
+#include <mce/asset/pack_file_blocks.hpp>
+#include <mce/bstream/buffer_ibstream.hpp>
+#include <mce/exceptions.hpp>
+#include <mutex>
+
+namespace mce {
+namespace asset {
+
+namespace {
+
+boost::interprocess::file_mapping open_file_mapping(const std::string& pack_file_name) {
+	try {
+		return boost::interprocess::file_mapping(pack_file_name.c_str(), boost::interprocess::read_only);
+	} catch(const boost::interprocess::interprocess_exception&) {
+		throw path_not_found_exception("Unable to open file '" + pack_file_name + "'.");
+	}
+}
+
+} // namespace
+
+mapped_pack_file_reader::mapped_pack::mapped_pack(const std::string& pack_file_name, access_pattern pattern)
+		: file{open_file_mapping(pack_file_name)}, region{file, boost::interprocess::read_only} {
+	using boost::interprocess::mapped_region;
+	region.advise(pattern == access_pattern::sequential ? mapped_region::advice_sequential
+														: mapped_region::advice_random);
+	bstream::buffer_ibstream bstr(data(), size());
+	bstr >> metadata;
+	if(!bstr) throw io_exception("Unable to read meta data from file '" + pack_file_name + "'.");
+	element_index.reserve(metadata.elements.size());
+	for(const auto& element : metadata.elements) {
+		auto stored_size = element.compressed_size ? element.compressed_size : element.size;
+		if(element.offset > size() || stored_size > size() - element.offset)
+			throw io_exception("Pack file '" + pack_file_name + "' appears corrupt: element '" +
+							   element.name + "' exceeds the file.");
+		// For duplicate names the first element is used, emplace keeps the existing entry.
+		element_index.emplace(element.name, &element);
+	}
+}
+
+std::shared_ptr<const mapped_pack_file_reader::mapped_pack>
+mapped_pack_file_reader::get_pack(const std::string& prefix) {
+	{
+		// Take read lock
+		std::shared_lock<std::shared_timed_mutex> lock(packs_rw_lock);
+		auto it = mapped_packs.find(prefix);
+		if(it != mapped_packs.end()) return it->second;
+	}
+	// Map the pack outside of the lock, if another thread raced us, its mapping is used and ours is dropped.
+	auto pack = std::make_shared<const mapped_pack>(prefix, pattern_);
+	// Take write lock
+	std::unique_lock<std::shared_timed_mutex> lock(packs_rw_lock);
+	return mapped_packs.emplace(prefix, std::move(pack)).first->second;
+}
+
+std::pair<file_content_ptr, file_size>
+mapped_pack_file_reader::read_element_range(const std::shared_ptr<const mapped_pack>& pack,
+											const pack_file_element_meta_data& element, uint64_t offset,
+											uint64_t size) {
+	offset = std::min(offset, element.size);
+	size = std::min(size, element.size - offset);
+	if(element.compressed_size == 0) {
+		// Aliasing pointer into the mapping that shares ownership of the pack.
+		file_content_ptr content(pack, pack->data() + element.offset + offset);
+		return std::make_pair(content, size);
+	}
+	// For blocked elements only the blocks covering the range are decompressed.
+	auto span = pack_file_compressed_span(element, offset, size);
+	std::shared_ptr<char> content =
+			std::shared_ptr<char>(new char[span.data_end - span.data_begin], [](char* ptr) { delete[] ptr; });
+	decompress_pack_file_span(element, span, pack->data() + element.offset + span.compressed_begin,
+							  content.get());
+	if(offset == span.data_begin) return std::make_pair(content, size);
+	return std::make_pair(file_content_ptr(content, content.get() + (offset - span.data_begin)), size);
+}
+
+std::pair<file_content_ptr, file_size> mapped_pack_file_reader::read_file(const std::string& prefix,
+																		  const std::string& file) {
+	return read_file_range(prefix, file, 0, std::numeric_limits<file_size>::max());
+}
+
+std::pair<file_content_ptr, file_size> mapped_pack_file_reader::read_file_range(const std::string& prefix,
+																				const std::string& file,
+																				file_size offset,
+																				file_size size) {
+	try {
+		auto pack = get_pack(prefix);
+		auto pos = pack->find_element(file);
+		if(!pos) return std::make_pair(file_content_ptr(), 0ull);
+		return read_element_range(pack, *pos, offset, size);
+	} catch(...) {
+		return std::make_pair(file_content_ptr(), 0ull);
+	}
+}
+
+} // namespace asset
+} // namespace mce
@@ -4,6 +4,7 @@
  * Copyright 2015-2016 by Stefan Bodenschatz
  */
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <mce/asset/native_file_reader.hpp>
@@ -38,5 +39,27 @@ std::pair<file_content_ptr, file_size> native_file_reader::read_file(const std::
 	}
 }
 
+std::pair<file_content_ptr, file_size> native_file_reader::read_file_range(const std::string& prefix,
+																		   const std::string& file,
+																		   file_size offset, file_size size) {
+	std::string full_path = prefix;
+	full_path += '/';
+	full_path += file;
+	util::sanitize_path_inplace(full_path);
+	std::ifstream stream(full_path, std::ios::binary);
+	if(!stream) return std::make_pair(file_content_ptr(), file_size(0ull));
+	stream.seekg(0, std::ios::end);
+	file_size file_length = stream.tellg();
+	offset = std::min(offset, file_length);
+	size = std::min(size, file_length - offset);
+	decltype(stream.tellg()) size_check = size;
+	if(file_size(size_check) != size) throw buffer_size_exception("Asset too big to fit in address space.");
+	stream.seekg(offset, std::ios::beg);
+	std::shared_ptr<char> content = std::shared_ptr<char>(new char[size], [](char* ptr) { delete[] ptr; });
+	stream.read(content.get(), size);
+	if(!stream) throw io_exception("Couldn't read range of file '" + full_path + "'.");
+	return std::make_pair(content, size);
+}
+
 } // namespace asset
 } // namespace mce
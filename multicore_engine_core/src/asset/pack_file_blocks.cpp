@@ -0,0 +1,63 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/src/asset/pack_file_blocks.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <algorithm>
+#include <mce/asset/pack_file_blocks.hpp>
+#include <mce/util/compression.hpp>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+namespace mce {
+namespace asset {
+
+pack_file_block_span pack_file_compressed_span(const pack_file_element_meta_data& element, uint64_t offset,
+											   uint64_t size) noexcept {
+	if(!element.blocked()) return {0, 1, 0, element.compressed_size, 0, element.size};
+	pack_file_block_span span;
+	span.first_block = size_t(offset / element.block_size);
+	span.compressed_begin = element.block_begin(span.first_block);
+	if(!size) {
+		// Empty ranges don't need any blocks.
+		span.end_block = span.first_block;
+		span.compressed_end = span.compressed_begin;
+		span.data_begin = offset;
+		span.data_end = offset;
+		return span;
+	}
+	span.end_block = size_t((offset + size + element.block_size - 1) / element.block_size);
+	span.compressed_end = element.block_begin(span.end_block);
+	span.data_begin = span.first_block * element.block_size;
+	span.data_end = std::min(span.end_block * element.block_size, element.size);
+	return span;
+}
+
+void decompress_pack_file_span(const pack_file_element_meta_data& element, const pack_file_block_span& span,
+							   const char* compressed_data, char* output) {
+	const auto& codec = util::get_codec(element.codec);
+	if(!element.blocked()) {
+		codec.decompress(compressed_data, element.compressed_size, output, element.size);
+		return;
+	}
+	auto decompress_block = [&](size_t block) {
+		auto begin = element.block_begin(block);
+		codec.decompress(compressed_data + (begin - span.compressed_begin), element.block_ends[block] - begin,
+						 output + (block - span.first_block) * element.block_size,
+						 element.block_uncompressed_size(block));
+	};
+	if(span.end_block - span.first_block <= 1) {
+		if(span.first_block != span.end_block) decompress_block(span.first_block);
+		return;
+	}
+	// Exceptions from the blocks are propagated to the caller by TBB.
+	tbb::parallel_for(tbb::blocked_range<size_t>(span.first_block, span.end_block), [&](const auto& range) {
+		for(size_t block = range.begin(); block != range.end(); ++block) {
+			decompress_block(block);
+		}
+	});
+}
+
+} // namespace asset
+} // namespace mce
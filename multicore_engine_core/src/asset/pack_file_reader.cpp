@@ -7,8 +7,9 @@
 #include <algorithm>
 #include <boost/container/vector.hpp>
 #include <cassert>
-#include <cstring>
 #include <iterator>
+#include <limits>
+#include <mce/asset/pack_file_blocks.hpp>
 #include <mce/asset/pack_file_reader.hpp>
 #include <mce/exceptions.hpp>
 #include <mce/util/compression.hpp>
@@ -42,42 +43,49 @@ pack_file_reader::get_source_stream(const std::string& prefix) {
 	return lock_ptr;
 }
 
+std::pair<file_content_ptr, file_size>
+pack_file_reader::read_element_range(pack_file_source& source, const pack_file_element_meta_data& element,
+									 uint64_t offset, uint64_t size) {
+	offset = std::min(offset, element.size);
+	size = std::min(size, element.size - offset);
+	if(element.compressed_size == 0) {
+		std::shared_ptr<char> content =
+				std::shared_ptr<char>(new char[size], [](char* ptr) { delete[] ptr; });
+		source.stream.seekg(element.offset + offset, std::ios::beg);
+		source.stream.read(content.get(), size);
+		if(!(source.stream))
+			return std::make_pair(file_content_ptr(), 0ull);
+		else
+			return std::make_pair(content, size);
+	}
+	// For blocked elements only the blocks covering the range are read and decompressed.
+	auto span = pack_file_compressed_span(element, offset, size);
+	auto compressed_size = span.compressed_end - span.compressed_begin;
+	// The compressed buffer of the source is reused by all reads through it, it only grows.
+	source.compressed_buffer.resize(compressed_size);
+	source.stream.seekg(element.offset + span.compressed_begin, std::ios::beg);
+	source.stream.read(source.compressed_buffer.data(), compressed_size);
+	if(!(source.stream)) return std::make_pair(file_content_ptr(), 0ull);
+	std::shared_ptr<char> content =
+			std::shared_ptr<char>(new char[span.data_end - span.data_begin], [](char* ptr) { delete[] ptr; });
+	decompress_pack_file_span(element, span, source.compressed_buffer.data(), content.get());
+	if(offset == span.data_begin) return std::make_pair(content, size);
+	return std::make_pair(file_content_ptr(content, content.get() + (offset - span.data_begin)), size);
+}
+
 std::pair<file_content_ptr, file_size> pack_file_reader::read_file(const std::string& prefix,
 																   const std::string& file) {
+	return read_file_range(prefix, file, 0, std::numeric_limits<file_size>::max());
+}
+
+std::pair<file_content_ptr, file_size> pack_file_reader::read_file_range(const std::string& prefix,
+																		 const std::string& file,
+																		 file_size offset, file_size size) {
 	try {
 		auto source = get_source_stream(prefix);
-		auto pos = std::find_if(source->metadata.elements.begin(), source->metadata.elements.end(),
-								[&](const pack_file_element_meta_data& elem) { return elem.name == file; });
-		if(pos == source->metadata.elements.end()) {
-			return std::make_pair(file_content_ptr(), 0ull);
-		} else if(pos->compressed_size == 0) {
-			std::shared_ptr<char> content =
-					std::shared_ptr<char>(new char[pos->size], [](char* ptr) { delete[] ptr; });
-			source->stream.seekg(pos->offset, std::ios::beg);
-			source->stream.read(content.get(), pos->size);
-			if(!(source->stream))
-				return std::make_pair(file_content_ptr(), 0ull);
-			else
-				return std::make_pair(content, pos->size);
-		} else {
-			source->compressed_buffer.clear();
-			source->compressed_buffer.resize(pos->compressed_size, '\0');
-			source->stream.seekg(pos->offset, std::ios::beg);
-			source->stream.read(source->compressed_buffer.data(), pos->compressed_size);
-			if(!(source->stream)) {
-				return std::make_pair(file_content_ptr(), 0ull);
-			} else {
-				source->decompressed_buffer.clear();
-				util::decompress(source->compressed_buffer, source->decompressed_buffer);
-				if(source->decompressed_buffer.size() != pos->size)
-					throw io_exception(
-							"Pack file appears corrupt: asset size and decompressed data size differ.");
-				std::shared_ptr<char> content =
-						std::shared_ptr<char>(new char[pos->size], [](char* ptr) { delete[] ptr; });
-				std::memcpy(content.get(), source->decompressed_buffer.data(), pos->size);
-				return std::make_pair(content, pos->size);
-			}
-		}
+		auto pos = source->find_element(file);
+		if(!pos) return std::make_pair(file_content_ptr(), 0ull);
+		return read_element_range(*source, *pos, offset, size);
 	} catch(...) {
 		return std::make_pair(file_content_ptr(), 0ull);
 	}
@@ -10,13 +10,29 @@
 #include <mce/memory/align.hpp>
 #include <mce/util/math_tools.hpp>
 #include <numeric>
+#include <thread>
 
 namespace mce {
 namespace containers {
 
+namespace {
+
+std::unique_ptr<per_thread<detail::byte_buffer_pool_thread_chunk>> make_thread_chunks() {
+	return std::make_unique<per_thread<detail::byte_buffer_pool_thread_chunk>>(
+			growable_slots_tag{}, std::max(std::thread::hardware_concurrency(), 1u));
+}
+
+void swap_generations(std::atomic<uint64_t>& a, std::atomic<uint64_t>& b) noexcept {
+	a.store(b.exchange(a.load()));
+}
+
+} // namespace
+
 byte_buffer_pool::byte_buffer_pool(size_t buffer_size, size_t min_slots,
 								   boost::rational<size_t> growth_factor)
-		: pool_buffer_size_{buffer_size}, min_slots_{min_slots}, growth_factor_{1u} {
+		: thread_chunks{make_thread_chunks()}, pool_buffer_size_{buffer_size},
+		  thread_chunk_size_{std::max<size_t>(buffer_size / std::max<size_t>(min_slots, 1), 1)},
+		  min_slots_{min_slots}, growth_factor_{1u} {
 	// Allocate two buffers with the given buffer size.
 	reallocate(1);
 	reallocate(1);
@@ -25,38 +41,47 @@ byte_buffer_pool::byte_buffer_pool(size_t buffer_size, size_t min_slots,
 byte_buffer_pool::byte_buffer_pool(byte_buffer_pool&& other) noexcept {
 	using std::swap;
 	std::lock(pool_mutex, other.pool_mutex);
-	std::lock_guard<std::mutex> l1(pool_mutex, std::adopt_lock);
-	std::lock_guard<std::mutex> l2(other.pool_mutex, std::adopt_lock);
+	std::lock_guard<decltype(pool_mutex)> l1(pool_mutex, std::adopt_lock);
+	std::lock_guard<decltype(pool_mutex)> l2(other.pool_mutex, std::adopt_lock);
 	swap(current_pool_buffer, other.current_pool_buffer);
 	swap(stashed_pool_buffers, other.stashed_pool_buffers);
 	swap(current_pool_buffer_offset, other.current_pool_buffer_offset);
+	swap(thread_chunks, other.thread_chunks);
+	swap_generations(release_generation, other.release_generation);
 	swap(pool_buffer_size_, other.pool_buffer_size_);
+	swap(thread_chunk_size_, other.thread_chunk_size_);
 	swap(min_slots_, other.min_slots_);
 	swap(growth_factor_, other.growth_factor_);
 }
 byte_buffer_pool& byte_buffer_pool::operator=(byte_buffer_pool&& other) noexcept {
 	using std::swap;
 	std::lock(pool_mutex, other.pool_mutex);
-	std::lock_guard<std::mutex> l1(pool_mutex, std::adopt_lock);
-	std::lock_guard<std::mutex> l2(other.pool_mutex, std::adopt_lock);
+	std::lock_guard<decltype(pool_mutex)> l1(pool_mutex, std::adopt_lock);
+	std::lock_guard<decltype(pool_mutex)> l2(other.pool_mutex, std::adopt_lock);
 	swap(current_pool_buffer, other.current_pool_buffer);
 	swap(stashed_pool_buffers, other.stashed_pool_buffers);
 	swap(current_pool_buffer_offset, other.current_pool_buffer_offset);
+	swap(thread_chunks, other.thread_chunks);
+	swap_generations(release_generation, other.release_generation);
 	swap(pool_buffer_size_, other.pool_buffer_size_);
+	swap(thread_chunk_size_, other.thread_chunk_size_);
 	swap(min_slots_, other.min_slots_);
 	swap(growth_factor_, other.growth_factor_);
 	return *this;
 }
 
 void byte_buffer_pool::release_resources() noexcept {
-	std::lock_guard<std::mutex> lock(pool_mutex);
+	std::lock_guard<decltype(pool_mutex)> lock(pool_mutex);
 	current_pool_buffer.reset();
 	current_pool_buffer_offset = 0;
 	stashed_pool_buffers.clear();
+	// The chunks belong to their threads, which drop them in allocate_buffer when they see the new
+	// generation.
+	release_generation.fetch_add(1, std::memory_order_relaxed);
 }
 
 size_t byte_buffer_pool::capacity() const noexcept {
-	std::lock_guard<std::mutex> lock(pool_mutex);
+	std::lock_guard<decltype(pool_mutex)> lock(pool_mutex);
 	size_t tmp = 0;
 	if(current_pool_buffer) tmp = current_pool_buffer->size();
 	return std::accumulate(stashed_pool_buffers.begin(), stashed_pool_buffers.end(), tmp,
@@ -69,7 +94,7 @@ void byte_buffer_pool::reallocate(size_t buff_size) {
 	if(current_pool_buffer) stashed_pool_buffers.push_back(std::move(current_pool_buffer));
 	current_pool_buffer_offset = 0;
 	if(stashed_pool_buffers.size() > 1) {
-		// Try to reclaim existing buffer
+		// Try to reclaim existing buffer, buffers with chunks of threads in them are still referenced.
 		auto it = std::find_if(stashed_pool_buffers.begin(), stashed_pool_buffers.end(),
 							   [this, buff_size](const std::shared_ptr<detail::byte_buffer_pool_buffer>& b) {
 								   return b->size() >= min_slots_ * buff_size && b->ref_count() == 0;
@@ -102,26 +127,34 @@ void byte_buffer_pool::reallocate(size_t buff_size) {
 			buffer_header, detail::byte_buffer_pool_buffer_deleter(tmp));
 }
 
-void* byte_buffer_pool::try_alloc_buffer_block(size_t size) const noexcept {
-	if(!current_pool_buffer) return nullptr;
-	if(current_pool_buffer->size() < size) return nullptr;
-	void* tmp = current_pool_buffer->data() + current_pool_buffer_offset;
-	auto space = current_pool_buffer->size() - current_pool_buffer_offset;
-	if(space < size) return nullptr;
-	return tmp;
+void byte_buffer_pool::refill_chunk(detail::byte_buffer_pool_thread_chunk& chunk, size_t size) {
+	std::lock_guard<decltype(pool_mutex)> lock(pool_mutex);
+	if(!current_pool_buffer || current_pool_buffer->size() - current_pool_buffer_offset < size) {
+		reallocate(size);
+	}
+	// The chunk takes the remainder of the current pool buffer if it is too small for a full chunk.
+	auto chunk_size = std::min(std::max(thread_chunk_size_, size),
+							   current_pool_buffer->size() - current_pool_buffer_offset);
+	// The chunk holds a reference to its pool buffer to prevent reuse of the buffer while it is in use.
+	current_pool_buffer->increment_ref_count();
+	if(chunk.buffer) chunk.buffer->decrement_ref_count();
+	chunk.generation = release_generation.load(std::memory_order_relaxed);
+	chunk.buffer = current_pool_buffer;
+	chunk.offset = current_pool_buffer_offset;
+	chunk.end = current_pool_buffer_offset + chunk_size;
+	current_pool_buffer_offset += chunk_size;
 }
 
 pooled_byte_buffer_ptr byte_buffer_pool::allocate_buffer(size_t size) {
-	std::lock_guard<std::mutex> lock(pool_mutex);
-	auto loc = try_alloc_buffer_block(size);
-	if(!loc) {
-		reallocate(size);
-		loc = try_alloc_buffer_block(size);
-		assert(loc);
+	auto& chunk = thread_chunks->get();
+	if(!chunk.buffer || chunk.end - chunk.offset < size ||
+	   chunk.generation != release_generation.load(std::memory_order_relaxed)) {
+		refill_chunk(chunk, size);
 	}
-	current_pool_buffer->increment_ref_count();
-	current_pool_buffer_offset = (reinterpret_cast<char*>(loc) + size) - current_pool_buffer->data();
-	return pooled_byte_buffer_ptr(current_pool_buffer, reinterpret_cast<char*>(loc), size);
+	auto loc = chunk.buffer->data() + chunk.offset;
+	chunk.offset += size;
+	chunk.buffer->increment_ref_count();
+	return pooled_byte_buffer_ptr(chunk.buffer, loc, size);
 }
 
 } /* namespace containers */
@@ -0,0 +1,166 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/src/containers/per_thread.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <algorithm>
+#include <mce/containers/per_thread.hpp>
+
+namespace mce {
+namespace containers {
+namespace detail {
+
+uint64_t next_per_thread_generation() noexcept {
+	// Starts at 1 because zero-initialized cache entries use generation 0.
+	static std::atomic<uint64_t> next_generation{1};
+	return next_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+namespace {
+
+std::unique_ptr<std::atomic<std::thread::id>[]> make_owner_segment(size_t count) {
+	auto segment = std::make_unique<std::atomic<std::thread::id>[]>(count);
+	for(size_t i = 0; i < count; ++i) {
+		segment[i].store(std::thread::id(), std::memory_order_relaxed);
+	}
+	return segment;
+}
+
+// Releases the slots owned by a thread when the thread exits.
+class per_thread_slot_releaser {
+	struct registration {
+		std::weak_ptr<per_thread_index_state> state;
+		size_t index;
+		uint64_t generation;
+	};
+	std::vector<registration> registrations;
+
+public:
+	void add(const std::shared_ptr<per_thread_index_state>& state, size_t index, uint64_t generation) {
+		// Slots from previous generations of the same instance and of destroyed instances are obsolete.
+		registrations.erase(std::remove_if(registrations.begin(), registrations.end(),
+										   [&state](const registration& r) {
+											   return r.state.expired() || (!r.state.owner_before(state) &&
+																			!state.owner_before(r.state));
+										   }),
+							registrations.end());
+		registrations.push_back({state, index, generation});
+	}
+	~per_thread_slot_releaser() noexcept {
+		auto thread = std::this_thread::get_id();
+		for(auto& r : registrations) {
+			auto state = r.state.lock();
+			if(state) state->release_slot(r.index, r.generation, thread);
+		}
+	}
+};
+
+void register_slot_release(const std::shared_ptr<per_thread_index_state>& state, size_t index,
+						   uint64_t generation) {
+	thread_local per_thread_slot_releaser releaser;
+	releaser.add(state, index, generation);
+}
+
+} // namespace
+
+per_thread_index_state::per_thread_index_state(size_t initial_slots, bool growable)
+		: initial_slots{initial_slots}, growable{growable}, segment_count{1}, total_slots{initial_slots},
+		  used_slots{0}, released_count{0}, generation{next_per_thread_generation()} {
+	owner_segments[0] = make_owner_segment(initial_slots);
+}
+
+void per_thread_index_state::grow(size_t required_slots) {
+	std::lock_guard<std::mutex> lock(mutex);
+	while(total_slots.load() < required_slots) {
+		if(segment_count == max_segments) {
+			throw mce::resource_depleted_exception("Maximum number of slots reached.");
+		}
+		// Each segment doubles the number of slots.
+		auto first = total_slots.load();
+		auto count = first;
+		auto owners = make_owner_segment(count);
+		if(grow_hook) grow_hook(segment_count, first, count);
+		owner_segments[segment_count] = std::move(owners);
+		++segment_count;
+		// Publishes the new segments to threads observing the new total.
+		total_slots.store(first + count);
+	}
+}
+
+void per_thread_index_state::release_slot(size_t index, uint64_t slot_generation,
+										  std::thread::id thread) noexcept {
+	std::lock_guard<std::mutex> lock(mutex);
+	if(generation.load() != slot_generation) return;
+	auto& slot_owner = owner(index);
+	if(slot_owner.load() != thread) return;
+	slot_owner.store(std::thread::id());
+	released_slots.push_back(index);
+	released_count.fetch_add(1);
+}
+
+void per_thread_index_state::clear() {
+	std::lock_guard<std::mutex> lock(mutex);
+	auto used = used_slots.load();
+	for(size_t i = 0; i < used; ++i) {
+		owner(i).store(std::thread::id());
+	}
+	used_slots = 0;
+	released_slots.clear();
+	released_count = 0;
+	generation = next_per_thread_generation();
+}
+
+} // namespace detail
+
+per_thread_index::per_thread_index(size_type slots)
+		: state_{std::make_shared<detail::per_thread_index_state>(slots, false)},
+		  instance_id_{state_->generation.load()} {}
+
+per_thread_index::per_thread_index(growable_slots_tag, size_type initial_slots)
+		: state_{std::make_shared<detail::per_thread_index_state>(std::max<size_type>(initial_slots, 1),
+																  true)},
+		  instance_id_{state_->generation.load()} {}
+
+per_thread_index::size_type per_thread_index::acquire_slot(detail::per_thread_cache_entry& entry) {
+	auto& state = *state_;
+	auto generation = state.generation.load();
+	auto assign = [&entry, generation](size_type index) {
+		entry.generation = generation;
+		entry.index = index;
+		entry.element = nullptr;
+		return index;
+	};
+	auto my_id = std::this_thread::get_id();
+	// The thread might already own a slot whose cache entry was evicted by another instance.
+	auto used = state.used_slots.load();
+	for(size_type i = 0; i < used; ++i) {
+		if(state.owner(i).load() == my_id) return assign(i);
+	}
+	if(state.released_count.load() > 0) {
+		std::lock_guard<std::mutex> lock(state.mutex);
+		if(!state.released_slots.empty()) {
+			auto index = state.released_slots.back();
+			detail::register_slot_release(state_, index, generation);
+			state.released_slots.pop_back();
+			state.released_count.fetch_sub(1);
+			state.owner(index).store(my_id);
+			return assign(index);
+		}
+	}
+	auto my_index = state.used_slots.load();
+	do {
+		while(my_index >= state.total_slots.load()) {
+			if(!state.growable) {
+				throw mce::resource_depleted_exception("No more slots available.");
+			}
+			state.grow(my_index + 1);
+		}
+	} while(!state.used_slots.compare_exchange_weak(my_index, my_index + 1));
+	state.owner(my_index).store(my_id);
+	detail::register_slot_release(state_, my_index, generation);
+	return assign(my_index);
+}
+
+} // namespace containers
+} // namespace mce
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <chrono>
 #include <fstream>
+#include <mce/asset/asset_cache_statistic.hpp>
 #include <mce/asset/asset_manager.hpp>
 #include <mce/config/config_store.hpp>
 #include <mce/core/core_defs.hpp>
@@ -39,6 +40,10 @@ engine::engine()
 		  asset_manager_{std::make_unique<asset::asset_manager>()},
 		  model_data_manager_{std::make_unique<model::model_data_manager>(asset_manager())} {
 	initialize_config();
+	auto asset_cache_budget = config_store_->resolve("asset.cache.budget_mb", 0);
+	if(asset_cache_budget->value() > 0) {
+		asset_manager_->cache_budget(uint64_t(asset_cache_budget->value()) << 20);
+	}
 	stats_pimpl_ = std::make_unique<detail::engine_core_stats_pimpl>();
 	stats_pimpl_->enable_frame_time_stat = config_store_->resolve("stats.core.frametime", 0);
 	initialize_stats();
@@ -74,6 +79,15 @@ void engine::initialize_stats() {
 				statistics_manager_->create<util::histogram_statistic<std::chrono::microseconds::rep>>(
 						"core.frametime.histogram", 0, frametime_max->value(), frametime_buckets->value());
 	}
+	if(config_store_->resolve("stats.core.asset_cache", 0)->value()) {
+		statistics_manager_->create<asset::asset_cache_statistic>("core.asset_cache", *asset_manager_);
+	}
+	if(util::lock_statistics_enabled) {
+		statistics_manager_->create<util::lock_statistic>("core.locks");
+	}
+	if(util::perf_counters_enabled) {
+		statistics_manager_->create<util::perf_counter_statistic>("core.perf_counters");
+	}
 }
 
 void engine::run() {
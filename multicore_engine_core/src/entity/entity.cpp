@@ -77,9 +77,7 @@ void entity::load_from_bstream(bstream::ibstream& istr, const mce::entity::entit
 	component_container<component_type_id_t> current_component_ids;
 	component_container<component_type_id_t> created_component_ids;
 	component_container<component_type_id_t> removed_component_ids;
-	using comp_elem_t = std::pair<component_type_id_t, component_pool_ptr>;
-	std::transform(components_.begin(), components_.end(), std::back_inserter(current_component_ids),
-				   [](const comp_elem_t& e) { return e.first; });
+	current_component_ids.assign(components_.keys().begin(), components_.keys().end());
 	std::set_difference(loaded_component_ids.begin(), loaded_component_ids.end(),
 						current_component_ids.begin(), current_component_ids.end(),
 						std::back_inserter(created_component_ids));
@@ -95,7 +93,7 @@ void entity::load_from_bstream(bstream::ibstream& istr, const mce::entity::entit
 			throw invalid_component_type_exception("Unknown component_type id " + std::to_string(id) + ".");
 		components_.insert(id, comp_type->create_component(*this, comp_type->empty_configuration(), engine));
 	}
-	for(auto& comp : components_) {
+	for(auto&& comp : components_) {
 		comp.second->load_from_bstream(istr);
 	}
 }
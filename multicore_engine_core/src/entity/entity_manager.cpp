@@ -42,7 +42,7 @@ entity* entity_manager::create_entity(const entity_configuration* config) {
 	auto id = next_id++;
 	auto it = entities.emplace(id, *this);
 	if(config) config->create_components(*it);
-	std::lock_guard<std::mutex> lock(id_map_mutex);
+	std::lock_guard<decltype(id_map_mutex)> lock(id_map_mutex);
 	entity_id_map.insert(std::make_pair(id, it));
 	return it;
 }
@@ -51,7 +51,7 @@ void entity_manager::destroy_entity(entity_id_t id) {
 	assert(!read_only_mode);
 	containers::unordered_object_pool<entity>::iterator ent_it;
 	{
-		std::lock_guard<std::mutex> lock(id_map_mutex);
+		std::lock_guard<decltype(id_map_mutex)> lock(id_map_mutex);
 		auto it = entity_id_map.find(id);
 		if(it == entity_id_map.end())
 			throw missing_entity_exception("non-existent entity requested for destruction.");
@@ -63,7 +63,7 @@ void entity_manager::destroy_entity(entity_id_t id) {
 void entity_manager::destroy_entity(entity* entity) {
 	assert(!read_only_mode);
 	{
-		std::lock_guard<std::mutex> lock(id_map_mutex);
+		std::lock_guard<decltype(id_map_mutex)> lock(id_map_mutex);
 		auto count = entity_id_map.erase(entity->id());
 		if(count == 0) throw missing_entity_exception("non-existent entity requested for destruction.");
 	}
@@ -71,7 +71,7 @@ void entity_manager::destroy_entity(entity* entity) {
 }
 
 entity* entity_manager::find_entity(long long id) const {
-	std::unique_lock<std::mutex> lock(id_map_mutex, std::defer_lock);
+	std::unique_lock<decltype(id_map_mutex)> lock(id_map_mutex, std::defer_lock);
 	if(!read_only_mode) lock.lock();
 	auto it = entity_id_map.find(id);
 	if(it != entity_id_map.end()) {
@@ -81,7 +81,7 @@ entity* entity_manager::find_entity(long long id) const {
 	}
 }
 entity* entity_manager::find_entity(const std::string& name) const {
-	std::unique_lock<std::mutex> lock(name_map_mutex, std::defer_lock);
+	std::unique_lock<decltype(name_map_mutex)> lock(name_map_mutex, std::defer_lock);
 	if(!read_only_mode) lock.lock();
 	auto it = entity_name_map.find(name);
 	if(it != entity_name_map.end()) {
@@ -92,10 +92,15 @@ entity* entity_manager::find_entity(const std::string& name) const {
 }
 void entity_manager::assign_entity_name(const std::string& name, long long id) {
 	assert(!read_only_mode);
-	std::lock_guard<std::mutex> lock(name_map_mutex);
+	std::lock_guard<decltype(name_map_mutex)> lock(name_map_mutex);
 	entity_name_map[name] = id;
 }
 const entity_configuration* entity_manager::find_entity_configuration(const std::string& name) const {
+	auto name_symbol = util::symbol::find(name);
+	if(!name_symbol) return nullptr;
+	return find_entity_configuration(*name_symbol);
+}
+const entity_configuration* entity_manager::find_entity_configuration(util::symbol name) const {
 	auto it = entity_configurations.find(name);
 	if(it != entity_configurations.end()) {
 		return it->second.get();
@@ -104,6 +109,11 @@ const entity_configuration* entity_manager::find_entity_configuration(const std:
 	}
 }
 const abstract_component_type* entity_manager::find_component_type(const std::string& name) const {
+	auto name_symbol = util::symbol::find(name);
+	if(!name_symbol) return nullptr;
+	return find_component_type(*name_symbol);
+}
+const abstract_component_type* entity_manager::find_component_type(util::symbol name) const {
 	auto it = component_types.find(name);
 	if(it != component_types.end()) {
 		return it->second.get();
@@ -122,7 +132,7 @@ const abstract_component_type* entity_manager::find_component_type(component_typ
 
 void entity_manager::add_entity_configuration(std::unique_ptr<entity_configuration>&& entity_config) {
 	bool success = false;
-	const auto& name = entity_config->name();
+	util::symbol name(entity_config->name());
 	std::tie(std::ignore, success) = entity_configurations.emplace(name, std::move(entity_config));
 }
 
@@ -134,7 +144,7 @@ void entity_manager::store_entities_to_bstream(bstream::obstream& ostr) {
 		ostr << ent.id();
 		ent.store_to_bstream(ostr);
 	}
-	std::lock_guard<std::mutex> lock(name_map_mutex);
+	std::lock_guard<decltype(name_map_mutex)> lock(name_map_mutex);
 	ostr << uint64_t(entity_name_map.size());
 	for(const auto& name_id_element : entity_name_map) {
 		ostr << name_id_element.first;
@@ -169,7 +179,7 @@ void entity_manager::load_entities_from_bstream(bstream::ibstream& istr) {
 	}
 	// Fix entity references:
 	for(entity& ent : entities) {
-		for(auto& comp_entry : ent.components()) {
+		for(const auto& comp_entry : ent.components()) {
 			const component_pool_ptr& comp = comp_entry.second;
 			auto& props = comp->configuration().type().properties();
 			for(auto& abst_prop : props) {
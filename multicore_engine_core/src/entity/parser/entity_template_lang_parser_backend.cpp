@@ -46,19 +46,17 @@ operator()(const ast::entity_definition& node) {
 	}
 	auto& comp_configs = config->components();
 	for(const auto& comp_def : node.components) {
+		// Resolve the name once and compare the existing configurations by type id instead of by name.
+		auto comp_type = backend.em.find_component_type(comp_def.name);
+		if(!comp_type)
+			throw invalid_component_type_exception("Unknown component type '" + comp_def.name + "'.");
 		auto comp_conf_it = std::find_if(comp_configs.begin(), comp_configs.end(), [&](const auto& elem) {
-			return elem->type().name() == comp_def.name;
+			return elem->type().id() == comp_type->id();
 		});
 		if(comp_conf_it == comp_configs.end()) {
-			auto comp_type = backend.em.find_component_type(comp_def.name);
-			if(!comp_type)
-				throw invalid_component_type_exception("Unknown component type '" + comp_def.name + "'.");
 			comp_conf_it = comp_configs.emplace(comp_configs.end(), std::make_unique<component_configuration>(
 																			backend.em.engine, *comp_type));
 		} else if(comp_def.replace) {
-			auto comp_type = backend.em.find_component_type(comp_def.name);
-			if(!comp_type)
-				throw invalid_component_type_exception("Unknown component type '" + comp_def.name + "'.");
 			*comp_conf_it = std::make_unique<component_configuration>(backend.em.engine, *comp_type);
 		}
 		auto& comp_conf = **comp_conf_it;
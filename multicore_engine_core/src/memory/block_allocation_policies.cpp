@@ -0,0 +1,95 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/src/memory/block_allocation_policies.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <mce/memory/align.hpp>
+#include <mce/memory/block_allocation_policies.hpp>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace mce {
+namespace memory {
+
+void* aligned_heap_allocate(std::size_t size, std::size_t alignment) {
+	if(alignment < alignof(void*)) alignment = alignof(void*);
+	std::size_t space = size + alignment + sizeof(void*);
+	void* orig = ::operator new(space);
+	void* tmp = reinterpret_cast<char*>(orig) + sizeof(void*);
+	space -= sizeof(void*);
+	void* res = align(alignment, size, tmp, space);
+	assert(res);
+	if(!res) {
+		::operator delete(orig);
+		throw std::bad_alloc();
+	}
+	*(reinterpret_cast<void**>(res) - 1) = orig;
+	return res;
+}
+
+void aligned_heap_deallocate(void* ptr) noexcept {
+	if(!ptr) return;
+	::operator delete(*(reinterpret_cast<void**>(ptr) - 1));
+}
+
+namespace {
+
+std::size_t round_to_huge_pages(std::size_t size) {
+	return (size + huge_page_size - 1) & ~(huge_page_size - 1);
+}
+
+} // namespace
+
+#ifdef __linux__
+
+void* huge_page_allocate(std::size_t size) {
+	std::size_t mapping_size = round_to_huge_pages(size);
+#ifdef MAP_HUGETLB
+	// Explicit huge pages only work if the administrator reserved them, otherwise this fails immediately.
+	void* explicit_mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE,
+								  MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+	if(explicit_mapping != MAP_FAILED) return explicit_mapping;
+#endif
+	// Over-allocate by one huge page to be able to trim the mapping to a huge page boundary.
+	std::size_t padded_size = mapping_size + huge_page_size;
+	void* mapping = mmap(nullptr, padded_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(mapping == MAP_FAILED) throw std::bad_alloc();
+	auto mapping_addr = reinterpret_cast<std::uintptr_t>(mapping);
+	auto aligned_addr = (mapping_addr + huge_page_size - 1) & ~std::uintptr_t(huge_page_size - 1);
+	std::size_t head = aligned_addr - mapping_addr;
+	std::size_t tail = padded_size - head - mapping_size;
+	if(head) munmap(mapping, head);
+	if(tail) munmap(reinterpret_cast<void*>(aligned_addr + mapping_size), tail);
+	void* res = reinterpret_cast<void*>(aligned_addr);
+#ifdef MADV_HUGEPAGE
+	// Failure only means that transparent huge pages are unavailable, the memory is still usable.
+	madvise(res, mapping_size, MADV_HUGEPAGE);
+#endif
+	return res;
+}
+
+void huge_page_deallocate(void* ptr, std::size_t size) noexcept {
+	if(!ptr) return;
+	munmap(ptr, round_to_huge_pages(size));
+}
+
+#else
+
+void* huge_page_allocate(std::size_t size) {
+	return aligned_heap_allocate(round_to_huge_pages(size), huge_page_size);
+}
+
+void huge_page_deallocate(void* ptr, std::size_t) noexcept {
+	aligned_heap_deallocate(ptr);
+}
+
+#endif
+
+} // namespace memory
+} // namespace mce
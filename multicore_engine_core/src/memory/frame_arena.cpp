@@ -0,0 +1,114 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/src/memory/frame_arena.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <algorithm>
+#include <mce/memory/align.hpp>
+#include <mce/memory/frame_arena.hpp>
+#include <thread>
+
+namespace mce {
+namespace memory {
+
+linear_arena_resource::linear_arena_resource(size_t initial_chunk_size, std::pmr::memory_resource* upstream)
+		: upstream_{upstream}, initial_chunk_size_{std::max(initial_chunk_size, size_t(1))} {}
+
+linear_arena_resource::~linear_arena_resource() noexcept {
+	release_chunks();
+}
+
+void linear_arena_resource::add_chunk(size_t size) {
+	chunks_.reserve(chunks_.size() + 1);
+	auto data = static_cast<char*>(upstream_->allocate(size, alignof(std::max_align_t)));
+	chunks_.push_back({data, size});
+}
+
+void linear_arena_resource::release_chunks() noexcept {
+	for(const auto& c : chunks_) {
+		upstream_->deallocate(c.data, c.size, alignof(std::max_align_t));
+	}
+	chunks_.clear();
+}
+
+void* linear_arena_resource::do_allocate(size_t bytes, size_t alignment) {
+	for(;;) {
+		if(current_chunk_ < chunks_.size()) {
+			const auto& c = chunks_[current_chunk_];
+			void* ptr = c.data + offset_;
+			size_t space = c.size - offset_;
+			if(memory::align(alignment, bytes, ptr, space)) {
+				size_t new_offset = size_t(static_cast<char*>(ptr) - c.data) + bytes;
+				allocated_bytes_ += new_offset - offset_;
+				offset_ = new_offset;
+				return ptr;
+			}
+			if(current_chunk_ + 1 < chunks_.size()) {
+				++current_chunk_;
+				offset_ = 0;
+				continue;
+			}
+		}
+		size_t size = chunks_.empty() ? initial_chunk_size_ : chunks_.back().size * 2;
+		add_chunk(std::max(size, bytes + alignment));
+		current_chunk_ = chunks_.size() - 1;
+		offset_ = 0;
+	}
+}
+
+void linear_arena_resource::do_deallocate(void*, size_t, size_t) {}
+
+bool linear_arena_resource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+	return this == &other;
+}
+
+void linear_arena_resource::reset() {
+	current_chunk_ = 0;
+	offset_ = 0;
+	allocated_bytes_ = 0;
+	if(chunks_.size() > 1) {
+		auto total = capacity();
+		release_chunks();
+		add_chunk(total);
+	}
+}
+
+size_t linear_arena_resource::capacity() const noexcept {
+	size_t total = 0;
+	for(const auto& c : chunks_) {
+		total += c.size;
+	}
+	return total;
+}
+
+frame_arena::frame_arena(size_t frames_in_flight, size_t initial_chunk_size,
+						 std::pmr::memory_resource* upstream) {
+	frames_in_flight = std::max(frames_in_flight, size_t(1));
+	auto threads = std::max(size_t(std::thread::hardware_concurrency()), size_t(1));
+	frames_.reserve(frames_in_flight);
+	for(size_t i = 0; i < frames_in_flight; ++i) {
+		frames_.push_back(std::make_unique<containers::per_thread<linear_arena_resource>>(
+				containers::growable_slots_tag{}, threads, initial_chunk_size, upstream));
+	}
+}
+
+void frame_arena::advance_frame() {
+	auto next = current_frame_.load(std::memory_order_relaxed) + 1;
+	// The set is reset before it becomes current, allocations still go to the set of the ending frame.
+	for(auto& arena : frames_[next % frames_.size()]->all()) {
+		arena.reset();
+	}
+	current_frame_.store(next, std::memory_order_release);
+}
+
+size_t frame_arena::allocated_bytes() const noexcept {
+	size_t total = 0;
+	for(const auto& arena : frames_[current_frame() % frames_.size()]->all()) {
+		total += arena.allocated_bytes();
+	}
+	return total;
+}
+
+} // namespace memory
+} // namespace mce
@@ -6,16 +6,37 @@
 
 #include <mce/util/callback_pool.hpp>
 #include <mce/util/math_tools.hpp>
+#include <thread>
 
 namespace mce {
 namespace util {
 
+namespace {
+
+void swap_generations(std::atomic<uint64_t>& a, std::atomic<uint64_t>& b) noexcept {
+	a.store(b.exchange(a.load()));
+}
+
+} // namespace
+
+callback_pool::callback_pool(size_t buffer_size, size_t min_slots, boost::rational<size_t> growth_factor)
+		: thread_chunks{std::make_unique<containers::per_thread<detail::callback_pool_thread_chunk>>(
+				  containers::growable_slots_tag{}, std::max(std::thread::hardware_concurrency(), 1u))},
+		  buffer_size_{buffer_size},
+		  thread_chunk_size_{std::max<size_t>(buffer_size / std::max<size_t>(min_slots, 1), 1)},
+		  min_slots_{min_slots}, growth_factor_{1u} {
+	// Allocate two buffers with the given buffer size.
+	reallocate(1, 1);
+	reallocate(1, 1);
+	growth_factor_ = growth_factor;
+}
+
 void callback_pool::reallocate(size_t obj_size, size_t obj_alignment) {
 	// Stash current buffer (full or otherwise unusable when this is called)
 	if(current_buffer) stashed_buffers.push_back(std::move(current_buffer));
 	current_buffer_offset = 0;
 	if(stashed_buffers.size() > 1) {
-		// Try to reclaim existing buffer
+		// Try to reclaim existing buffer, buffers with chunks of threads in them are still referenced.
 		auto it = std::find_if(
 				stashed_buffers.begin(), stashed_buffers.end(),
 				[this, obj_size, obj_alignment](const std::shared_ptr<detail::callback_pool_buffer>& b) {
@@ -47,41 +68,77 @@ void callback_pool::reallocate(size_t obj_size, size_t obj_alignment) {
 																   detail::callback_pool_buffer_deleter(tmp));
 }
 
-void* callback_pool::try_alloc_obj_block(size_t size, size_t alignment) const noexcept {
-	if(!current_buffer) return nullptr;
-	if(current_buffer->size() < size) return nullptr;
-	void* tmp = current_buffer->data() + current_buffer_offset;
-	auto space = current_buffer->size() - current_buffer_offset;
+void callback_pool::refill_chunk(detail::callback_pool_thread_chunk& chunk, size_t obj_size,
+								 size_t obj_alignment) {
+	std::lock_guard<decltype(pool_mutex)> lock(pool_mutex);
+	auto required_size = obj_alignment + obj_size;
+	if(!current_buffer || current_buffer->size() - current_buffer_offset < required_size) {
+		reallocate(obj_size, obj_alignment);
+	}
+	// The chunk takes the remainder of the current buffer if it is too small for a full chunk.
+	auto chunk_size = std::min(std::max(thread_chunk_size_, required_size),
+							   current_buffer->size() - current_buffer_offset);
+	// The chunk holds a reference to its buffer to prevent reuse of the buffer while it is in use.
+	current_buffer->increment_ref_count();
+	if(chunk.buffer) chunk.buffer->decrement_ref_count();
+	chunk.generation = release_generation.load(std::memory_order_relaxed);
+	chunk.buffer = current_buffer;
+	chunk.offset = current_buffer_offset;
+	chunk.end = current_buffer_offset + chunk_size;
+	current_buffer_offset += chunk_size;
+}
+
+void* callback_pool::try_alloc_obj_block(const detail::callback_pool_thread_chunk& chunk, size_t size,
+										 size_t alignment) noexcept {
+	if(!chunk.buffer) return nullptr;
+	void* tmp = chunk.buffer->data() + chunk.offset;
+	auto space = chunk.end - chunk.offset;
 	return memory::align(alignment, size, tmp, space);
 }
 
+void callback_pool::release_resources() noexcept {
+	std::lock_guard<decltype(pool_mutex)> lock(pool_mutex);
+	current_buffer.reset();
+	current_buffer_offset = 0;
+	stashed_buffers.clear();
+	// The chunks belong to their threads, which drop them in allocate_function when they see the new
+	// generation.
+	release_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
 callback_pool::callback_pool(callback_pool&& other) noexcept {
 	using std::swap;
 	std::lock(pool_mutex, other.pool_mutex);
-	std::lock_guard<std::mutex> l1(pool_mutex, std::adopt_lock);
-	std::lock_guard<std::mutex> l2(other.pool_mutex, std::adopt_lock);
+	std::lock_guard<decltype(pool_mutex)> l1(pool_mutex, std::adopt_lock);
+	std::lock_guard<decltype(pool_mutex)> l2(other.pool_mutex, std::adopt_lock);
 	swap(current_buffer, other.current_buffer);
 	swap(stashed_buffers, other.stashed_buffers);
 	swap(current_buffer_offset, other.current_buffer_offset);
+	swap(thread_chunks, other.thread_chunks);
+	swap_generations(release_generation, other.release_generation);
 	swap(buffer_size_, other.buffer_size_);
+	swap(thread_chunk_size_, other.thread_chunk_size_);
 	swap(min_slots_, other.min_slots_);
 	swap(growth_factor_, other.growth_factor_);
 }
 callback_pool& callback_pool::operator=(callback_pool&& other) noexcept {
 	using std::swap;
 	std::lock(pool_mutex, other.pool_mutex);
-	std::lock_guard<std::mutex> l1(pool_mutex, std::adopt_lock);
-	std::lock_guard<std::mutex> l2(other.pool_mutex, std::adopt_lock);
+	std::lock_guard<decltype(pool_mutex)> l1(pool_mutex, std::adopt_lock);
+	std::lock_guard<decltype(pool_mutex)> l2(other.pool_mutex, std::adopt_lock);
 	swap(current_buffer, other.current_buffer);
 	swap(stashed_buffers, other.stashed_buffers);
 	swap(current_buffer_offset, other.current_buffer_offset);
+	swap(thread_chunks, other.thread_chunks);
+	swap_generations(release_generation, other.release_generation);
 	swap(buffer_size_, other.buffer_size_);
+	swap(thread_chunk_size_, other.thread_chunk_size_);
 	swap(min_slots_, other.min_slots_);
 	swap(growth_factor_, other.growth_factor_);
 	return *this;
 }
 size_t callback_pool::capacity() const noexcept {
-	std::lock_guard<std::mutex> lock(pool_mutex);
+	std::lock_guard<decltype(pool_mutex)> lock(pool_mutex);
 	size_t tmp = 0;
 	if(current_buffer) tmp = current_buffer->size();
 	return std::accumulate(
@@ -0,0 +1,153 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/src/util/epoch_reclamation.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <algorithm>
+#include <mce/util/epoch_reclamation.hpp>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mce {
+namespace util {
+
+namespace {
+
+struct retired_object {
+	uint64_t epoch;
+	void* object;
+	void (*deleter)(void*);
+};
+
+// The number of retired objects in the list of a thread that makes the thread reclaim its list.
+constexpr size_t reclamation_threshold = 64;
+
+// Thread records are never freed but reused by later threads, because readers and the epoch advancement
+// access them without synchronization.
+std::atomic<detail::epoch_thread_record*> thread_records{nullptr};
+std::atomic<size_t> pending_reclamations{0};
+
+class epoch_thread_record_releaser {
+	detail::epoch_thread_record* record = nullptr;
+
+public:
+	void assign(detail::epoch_thread_record* r) noexcept {
+		record = r;
+	}
+	~epoch_thread_record_releaser() noexcept {
+		if(record) record->in_use.store(false, std::memory_order_release);
+	}
+};
+
+// Advances the global epoch if all threads in a critical section observed the current one.
+bool try_advance_epoch() noexcept {
+	auto epoch = detail::global_epoch.load();
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	for(auto r = thread_records.load(std::memory_order_acquire); r; r = r->next) {
+		auto state = r->state.load(std::memory_order_acquire);
+		if((state & 1) && (state >> 1) != epoch) return false;
+	}
+	return detail::global_epoch.compare_exchange_strong(epoch, epoch + 1);
+}
+
+// Calls the deleters of the given objects, an exception from one deleter doesn't prevent the others.
+void reclaim(const std::vector<retired_object>& objects) noexcept {
+	for(auto& o : objects) {
+		try {
+			o.deleter(o.object);
+		} catch(...) {
+			// Drop exceptions escaped from deleters
+		}
+	}
+	pending_reclamations.fetch_sub(objects.size(), std::memory_order_relaxed);
+}
+
+} // namespace
+
+namespace detail {
+
+// The mutex is only contended when epoch_synchronize drains the lists of other threads.
+struct epoch_limbo_list {
+	std::mutex mutex;
+	std::vector<retired_object> objects;
+
+	// Removes the objects that can no longer be accessed by readers from the list.
+	std::vector<retired_object> collect_reclaimable() {
+		std::lock_guard<std::mutex> lock(mutex);
+		auto epoch = global_epoch.load();
+		// Readers that entered before the epoch following the retirement might still hold the object.
+		auto it = std::partition(objects.begin(), objects.end(),
+								 [epoch](const retired_object& o) { return o.epoch + 2 > epoch; });
+		std::vector<retired_object> reclaimable(it, objects.end());
+		objects.erase(it, objects.end());
+		return reclaimable;
+	}
+};
+
+epoch_thread_record* acquire_epoch_thread_record() {
+	thread_local epoch_thread_record_releaser releaser;
+	for(auto r = thread_records.load(std::memory_order_acquire); r; r = r->next) {
+		bool expected = false;
+		if(!r->in_use.load(std::memory_order_relaxed) &&
+		   r->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+			releaser.assign(r);
+			return r;
+		}
+	}
+	auto r = new epoch_thread_record();
+	r->limbo = new epoch_limbo_list();
+	r->in_use.store(true, std::memory_order_relaxed);
+	auto head = thread_records.load(std::memory_order_relaxed);
+	do {
+		r->next = head;
+	} while(!thread_records.compare_exchange_weak(head, r, std::memory_order_release,
+												  std::memory_order_relaxed));
+	releaser.assign(r);
+	return r;
+}
+
+} // namespace detail
+
+void epoch_retire(void* object, void (*deleter)(void*)) {
+	auto& limbo = *detail::local_epoch_thread_record().limbo;
+	size_t retired_count;
+	{
+		std::lock_guard<std::mutex> lock(limbo.mutex);
+		limbo.objects.push_back({detail::global_epoch.load(), object, deleter});
+		retired_count = limbo.objects.size();
+		pending_reclamations.fetch_add(1, std::memory_order_relaxed);
+	}
+	if(retired_count < reclamation_threshold) return;
+	try_advance_epoch();
+	std::vector<retired_object> reclaimable;
+	try {
+		reclaimable = limbo.collect_reclaimable();
+	} catch(...) {
+		// The objects stay in the list for a later attempt, the ownership of the object was already taken.
+		return;
+	}
+	reclaim(reclaimable);
+}
+
+void epoch_synchronize() {
+	auto target = detail::global_epoch.load() + 2;
+	for(;;) {
+		try_advance_epoch();
+		bool done = detail::global_epoch.load() >= target;
+		// Drains the lists of all threads, including the ones of exited or idle threads.
+		for(auto r = thread_records.load(std::memory_order_acquire); r; r = r->next) {
+			reclaim(r->limbo->collect_reclaimable());
+		}
+		if(done) return;
+		std::this_thread::yield();
+	}
+}
+
+size_t epoch_pending_reclamations() {
+	return pending_reclamations.load(std::memory_order_relaxed);
+}
+
+} // namespace util
+} // namespace mce
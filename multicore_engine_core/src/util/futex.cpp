@@ -0,0 +1,58 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/src/util/futex.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <climits>
+#include <mce/util/futex.hpp>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace mce {
+namespace util {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+			  "The futex word must have the same representation as a plain uint32_t.");
+
+#ifdef __linux__
+
+namespace {
+
+uint32_t* futex_address(std::atomic<uint32_t>& word) noexcept {
+	return reinterpret_cast<uint32_t*>(&word);
+}
+
+} // namespace
+
+void futex_wait(std::atomic<uint32_t>& word, uint32_t expected) noexcept {
+	syscall(SYS_futex, futex_address(word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+void futex_wake_one(std::atomic<uint32_t>& word) noexcept {
+	syscall(SYS_futex, futex_address(word), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+void futex_wake_all(std::atomic<uint32_t>& word) noexcept {
+	syscall(SYS_futex, futex_address(word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+
+#else
+
+void futex_wait(std::atomic<uint32_t>& word, uint32_t expected) noexcept {
+	if(word.load(std::memory_order_acquire) == expected) std::this_thread::yield();
+}
+
+void futex_wake_one(std::atomic<uint32_t>&) noexcept {}
+
+void futex_wake_all(std::atomic<uint32_t>&) noexcept {}
+
+#endif
+
+} // namespace util
+} // namespace mce
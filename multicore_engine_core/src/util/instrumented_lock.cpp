@@ -0,0 +1,70 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/src/util/instrumented_lock.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <map>
+#include <mce/util/instrumented_lock.hpp>
+#include <memory>
+#include <string>
+
+namespace mce {
+namespace util {
+
+namespace {
+
+struct lock_counters_registry {
+	std::mutex mutex;
+	// Keyed by the string contents because the same name can be passed from different translation units.
+	std::map<std::string, std::pair<const char*, std::unique_ptr<lock_counters>>> counters;
+
+	static lock_counters_registry& instance() {
+		// Intentionally leaked because locks with static storage duration can use it during destruction.
+		static auto registry = new lock_counters_registry();
+		return *registry;
+	}
+};
+
+} // namespace
+
+void lock_counters::reset() noexcept {
+	acquisitions_.store(0, std::memory_order_relaxed);
+	contended_acquisitions_.store(0, std::memory_order_relaxed);
+	wait_time_ns_.store(0, std::memory_order_relaxed);
+	max_wait_time_ns_.store(0, std::memory_order_relaxed);
+	hold_time_ns_.store(0, std::memory_order_relaxed);
+}
+
+lock_counters& named_lock_counters(const char* name) {
+	auto& registry = lock_counters_registry::instance();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	auto& entry = registry.counters[name];
+	if(!entry.second) {
+		entry.first = name;
+		entry.second = std::make_unique<lock_counters>();
+	}
+	return *entry.second;
+}
+
+std::vector<std::pair<const char*, lock_counters_snapshot>> all_lock_counters() {
+	auto& registry = lock_counters_registry::instance();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	std::vector<std::pair<const char*, lock_counters_snapshot>> result;
+	result.reserve(registry.counters.size());
+	for(const auto& entry : registry.counters) {
+		result.emplace_back(entry.second.first, entry.second.second->snapshot());
+	}
+	return result;
+}
+
+void reset_lock_counters() noexcept {
+	auto& registry = lock_counters_registry::instance();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	for(auto& entry : registry.counters) {
+		entry.second.second->reset();
+	}
+}
+
+} // namespace util
+} // namespace mce
@@ -0,0 +1,194 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/src/util/perf_counters.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <mce/util/perf_counters.hpp>
+
+#if defined(MCE_PERF_COUNTERS) && defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define MCE_PERF_COUNTERS_LINUX
+#endif
+
+namespace mce {
+namespace util {
+
+namespace {
+
+#ifdef MCE_PERF_COUNTERS_LINUX
+
+// Opens a group of hardware counters for the calling thread. The counters are read together with a single
+// read call on the group leader, which also provides the times required to scale multiplexed counters.
+class thread_perf_events {
+	static constexpr size_t event_count = 4;
+	int fds_[event_count] = {-1, -1, -1, -1};
+	bool available_ = false;
+
+	struct group_read_format {
+		uint64_t counter_count;
+		uint64_t time_enabled;
+		uint64_t time_running;
+		uint64_t values[event_count];
+	};
+
+	void close_all() noexcept {
+		for(auto& fd : fds_) {
+			if(fd >= 0) close(fd);
+			fd = -1;
+		}
+	}
+
+public:
+	thread_perf_events() noexcept {
+		const uint64_t configs[event_count] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+											   PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+		for(size_t i = 0; i < event_count; ++i) {
+			perf_event_attr attr = {};
+			attr.size = sizeof(attr);
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.config = configs[i];
+			// The group is enabled as a whole through the leader.
+			attr.disabled = (i == 0) ? 1 : 0;
+			// Excluding the kernel allows using the counters with the default perf_event_paranoid setting.
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format =
+					PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+			auto group_fd = (i == 0) ? -1 : fds_[0];
+			fds_[i] = int(syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, PERF_FLAG_FD_CLOEXEC));
+			if(fds_[i] < 0) {
+				close_all();
+				return;
+			}
+		}
+		ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+		available_ = true;
+	}
+	~thread_perf_events() noexcept {
+		close_all();
+	}
+	thread_perf_events(const thread_perf_events&) = delete;
+	thread_perf_events& operator=(const thread_perf_events&) = delete;
+
+	bool available() const noexcept {
+		return available_;
+	}
+
+	perf_counter_reading read_values() const noexcept {
+		if(!available_) return {};
+		group_read_format data;
+		if(read(fds_[0], &data, sizeof(data)) != ssize_t(sizeof(data))) return {};
+		return {{data.values[0], data.values[1], data.values[2], data.values[3]},
+				data.time_enabled,
+				data.time_running};
+	}
+
+	static thread_perf_events& local() noexcept {
+		static thread_local thread_perf_events events;
+		return events;
+	}
+};
+
+#endif
+
+std::atomic<perf_counter_zone*> zones{nullptr};
+
+} // namespace
+
+namespace detail {
+
+struct perf_counters_access {
+	static void register_zone(perf_counter_zone* zone) noexcept {
+		auto head = zones.load(std::memory_order_relaxed);
+		do {
+			zone->next_ = head;
+		} while(!zones.compare_exchange_weak(head, zone, std::memory_order_release,
+											 std::memory_order_relaxed));
+	}
+	static std::vector<perf_counter_zone_values> zone_values() {
+		std::vector<perf_counter_zone_values> result;
+		for(auto zone = zones.load(std::memory_order_acquire); zone; zone = zone->next_) {
+			result.push_back({zone->name(), zone->samples(), zone->counters()});
+		}
+		return result;
+	}
+	static void reset_zones() noexcept {
+		for(auto zone = zones.load(std::memory_order_acquire); zone; zone = zone->next_) {
+			zone->reset();
+		}
+	}
+};
+
+} // namespace detail
+
+bool perf_counters_available() noexcept {
+#ifdef MCE_PERF_COUNTERS_LINUX
+	return thread_perf_events::local().available();
+#else
+	return false;
+#endif
+}
+
+perf_counter_values perf_counter_reading::operator-(const perf_counter_reading& other) const noexcept {
+	auto delta = raw - other.raw;
+	if(time_running <= other.time_running) return delta;
+	auto running = time_running - other.time_running;
+	auto enabled = time_enabled > other.time_enabled ? time_enabled - other.time_enabled : 0;
+	if(running < enabled) {
+		// The group was not always scheduled on the PMU in the interval, extrapolate to the full interval.
+		auto scale = double(enabled) / double(running);
+		delta.cycles = uint64_t(double(delta.cycles) * scale);
+		delta.instructions = uint64_t(double(delta.instructions) * scale);
+		delta.llc_misses = uint64_t(double(delta.llc_misses) * scale);
+		delta.branch_misses = uint64_t(double(delta.branch_misses) * scale);
+	}
+	return delta;
+}
+
+perf_counter_reading thread_perf_counter_reading() noexcept {
+#ifdef MCE_PERF_COUNTERS_LINUX
+	return thread_perf_events::local().read_values();
+#else
+	return {};
+#endif
+}
+
+perf_counter_values thread_perf_counters() noexcept {
+	return thread_perf_counter_reading() - perf_counter_reading{};
+}
+
+perf_counter_zone::perf_counter_zone(const char* name) noexcept : name_{name} {
+	detail::perf_counters_access::register_zone(this);
+}
+
+void perf_counter_zone::record(const perf_counter_values& delta) noexcept {
+	samples_.fetch_add(1, std::memory_order_relaxed);
+	cycles_.fetch_add(delta.cycles, std::memory_order_relaxed);
+	instructions_.fetch_add(delta.instructions, std::memory_order_relaxed);
+	llc_misses_.fetch_add(delta.llc_misses, std::memory_order_relaxed);
+	branch_misses_.fetch_add(delta.branch_misses, std::memory_order_relaxed);
+}
+
+void perf_counter_zone::reset() noexcept {
+	samples_.store(0, std::memory_order_relaxed);
+	cycles_.store(0, std::memory_order_relaxed);
+	instructions_.store(0, std::memory_order_relaxed);
+	llc_misses_.store(0, std::memory_order_relaxed);
+	branch_misses_.store(0, std::memory_order_relaxed);
+}
+
+std::vector<perf_counter_zone_values> perf_counter_zones() {
+	return detail::perf_counters_access::zone_values();
+}
+
+void reset_perf_counter_zones() noexcept {
+	detail::perf_counters_access::reset_zones();
+}
+
+} // namespace util
+} // namespace mce
@@ -0,0 +1,105 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_core/src/util/symbol.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <atomic>
+#include <mce/containers/concurrent_hash_map.hpp>
+#include <mce/util/symbol.hpp>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace mce {
+namespace util {
+
+namespace {
+
+// The strings are stored in chunks of doubling size to allow lookups by id without locking while keeping the
+// strings at stable addresses. Chunk k holds the ids from first_chunk_size * (2^k - 1) on.
+constexpr size_t first_chunk_size = 256;
+constexpr size_t chunk_count = 24;
+
+} // namespace
+
+class symbol_table_access {
+	containers::concurrent_hash_map<std::string, symbol> symbols_;
+	std::atomic<const std::string**> chunks_[chunk_count] = {};
+	std::atomic<uint32_t> next_id_{1};
+	std::mutex chunk_allocation_lock_;
+
+	static uint32_t hash_string(std::string_view str) noexcept {
+		auto hash = uint64_t(std::hash<std::string_view>{}(str));
+		auto result = uint32_t(hash ^ (hash >> 32));
+		// 0 is reserved for the empty string.
+		return result ? result : 1;
+	}
+	static size_t chunk_index(uint32_t id) noexcept {
+		size_t chunk = 0;
+		for(size_t v = id / first_chunk_size + 1; v > 1; v >>= 1) {
+			++chunk;
+		}
+		return chunk;
+	}
+	static size_t chunk_begin(size_t chunk) noexcept {
+		return first_chunk_size * ((size_t(1) << chunk) - 1);
+	}
+
+	const std::string** chunk_for(size_t chunk) {
+		auto strings = chunks_[chunk].load(std::memory_order_acquire);
+		if(strings) return strings;
+		std::lock_guard<std::mutex> lock(chunk_allocation_lock_);
+		strings = chunks_[chunk].load(std::memory_order_relaxed);
+		if(!strings) {
+			strings = new const std::string*[first_chunk_size << chunk]();
+			chunks_[chunk].store(strings, std::memory_order_release);
+		}
+		return strings;
+	}
+
+public:
+	symbol intern(std::string_view str) {
+		if(str.empty()) return symbol();
+		auto make_symbol = [this, str]() {
+			auto id = next_id_.fetch_add(1, std::memory_order_relaxed);
+			auto chunk = chunk_index(id);
+			if(chunk >= chunk_count) throw std::length_error("Symbol table is full.");
+			auto entry = std::make_unique<std::string>(str);
+			// The string is published to other threads together with the symbol, which is inserted into the
+			// map after this function returns.
+			chunk_for(chunk)[id - chunk_begin(chunk)] = entry.release();
+			return symbol(id, hash_string(str));
+		};
+		return symbols_.find_or_insert(str, make_symbol).first;
+	}
+	std::optional<symbol> find(std::string_view str) {
+		if(str.empty()) return symbol();
+		return symbols_.find(str);
+	}
+	const std::string& str(uint32_t id) noexcept {
+		auto chunk = chunk_index(id);
+		return *chunks_[chunk].load(std::memory_order_acquire)[id - chunk_begin(chunk)];
+	}
+
+	static symbol_table_access& table() {
+		// Intentionally leaked to keep the interned strings available during static destruction.
+		static auto instance = new symbol_table_access();
+		return *instance;
+	}
+};
+
+symbol::symbol(std::string_view str) : symbol(symbol_table_access::table().intern(str)) {}
+
+std::optional<symbol> symbol::find(std::string_view str) {
+	return symbol_table_access::table().find(str);
+}
+
+const std::string& symbol::str() const noexcept {
+	static const std::string empty_string;
+	if(id_ == 0) return empty_string;
+	return symbol_table_access::table().str(id_);
+}
+
+} // namespace util
+} // namespace mce
@@ -97,8 +97,10 @@ int main(int argc, char* argv[]) {
 							internal_path = entry_path.filename().string();
 						}
 					}
-					if(section.zip_level > -2) {
-						gen.add_file_compressed(entry_path_abs.string(), internal_path, section.zip_level);
+					auto compression = section.entry_compression(entry, internal_path);
+					if(compression.codec != mce::util::compression_codec::none) {
+						gen.add_file_compressed(entry_path_abs.string(), internal_path, compression.codec,
+												compression.level);
 					} else {
 						gen.add_file(entry_path_abs.string(), internal_path);
 					}
@@ -13,6 +13,7 @@
  */
 
 #include <cassert>
+#include <mce/util/instrumented_lock.hpp>
 #include <mutex>
 #include <vulkan/vulkan.hpp>
 
@@ -68,6 +69,9 @@ struct device_memory_allocation {
 /// Provides an interface for device memory managers to allocate and free allocations polymorphically.
 class device_memory_manager_interface {
 public:
+	/// The type of the lock returned by obtain_lock.
+	using lock_type = util::instrumented_lock<>;
+
 	/// Enables polymorphic destruction.
 	virtual ~device_memory_manager_interface() noexcept = default;
 	/// Interface function to free allocations from any device memory manager.
@@ -80,7 +84,7 @@ public:
 	virtual device* associated_device() const = 0;
 	/// \brief Obtains a lock from the implementing object that protects at least the memory object of the
 	/// given allocation.
-	virtual std::unique_lock<std::mutex> obtain_lock(const device_memory_allocation& allocation) const = 0;
+	virtual std::unique_lock<lock_type> obtain_lock(const device_memory_allocation& allocation) const = 0;
 };
 
 /// Provides a RAII wrapper for managing the lifetime of a device_memory_allocation and the associated memory.
@@ -172,7 +176,7 @@ public:
 	/**
 	 * Calling this member function on move-from handles results in undefined behavior.
 	 */
-	std::unique_lock<std::mutex> obtain_lock() const {
+	std::unique_lock<device_memory_manager_interface::lock_type> obtain_lock() const {
 		assert(manager_ptr_);
 		return manager_ptr_->obtain_lock(allocation_);
 	}
@@ -64,7 +64,7 @@ private:
 	std::vector<device_memory_block> separate_blocks_;
 	int32_t next_block_id = 1;			 // 0 is invalid
 	int32_t next_separate_block_id = -1; // 0 is invalid
-	mutable std::mutex mutex_;
+	mutable lock_type mutex_{"graphics.device_memory_manager"};
 
 public:
 	/// Constructs a memory manager for the given device using the given block size.
@@ -91,7 +91,7 @@ public:
 	}
 
 	/// Obtains a lock on the memory manager.
-	std::unique_lock<std::mutex> obtain_lock(const device_memory_allocation&) const override;
+	std::unique_lock<lock_type> obtain_lock(const device_memory_allocation&) const override;
 };
 
 } /* namespace graphics */
@@ -13,6 +13,7 @@
 
 #include <boost/container/flat_map.hpp>
 #include <boost/optional.hpp>
+#include <mce/util/instrumented_lock.hpp>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -73,7 +74,7 @@ private:
 		std::shared_ptr<const pipeline> result;
 	};
 
-	mutable std::mutex manager_mutex_;
+	mutable util::instrumented_lock<> manager_mutex_{"graphics.graphics_manager"};
 	device* dev_;
 	destruction_queue_manager* dqm_;
 	std::unique_ptr<pipeline_cache> pipeline_cache_;
@@ -197,49 +198,49 @@ public:
 
 	/// Releases ownership of the descriptor_set_layout object with the given name.
 	void release_descriptor_set_layout(const std::string& name) {
-		std::lock_guard<std::mutex> lock(manager_mutex_);
+		std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 		descriptor_set_layouts_.erase(name);
 	}
 	/// Releases ownership of the framebuffer_config object with the given name.
 	void release_framebuffer_config(const std::string& name) {
-		std::lock_guard<std::mutex> lock(manager_mutex_);
+		std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 		framebuffer_configs_.erase(name);
 	}
 	/// Releases ownership of the pipeline_layout with the given name.
 	void release_pipeline_layout(const std::string& name) {
-		std::lock_guard<std::mutex> lock(manager_mutex_);
+		std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 		pipeline_layouts_.erase(name);
 	}
 	/// Releases ownership of the sampler object with the given name.
 	void release_sampler(const std::string& name) {
-		std::lock_guard<std::mutex> lock(manager_mutex_);
+		std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 		samplers_.erase(name);
 	}
 	/// Releases ownership of the subpass_graph object with the given name.
 	void release_subpass_graph(const std::string& name) {
-		std::lock_guard<std::mutex> lock(manager_mutex_);
+		std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 		subpass_graphs_.erase(name);
 	}
 	/// Releases ownership of the shader_module with the given name.
 	void release_shader_module(const std::string& name) {
-		std::lock_guard<std::mutex> lock(manager_mutex_);
+		std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 		shader_modules_.erase(name);
 	}
 	/// Releases ownership of the pipeline and pipeline_config with the given name.
 	void release_pipeline_and_config(const std::string& name) {
-		std::lock_guard<std::mutex> lock(manager_mutex_);
+		std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 		pipeline_configs_.erase(name);
 		pipelines_.erase(name);
 	}
 	/// Releases ownership of the render_pass with the given name.
 	void release_render_pass(const std::string& name) {
-		std::lock_guard<std::mutex> lock(manager_mutex_);
+		std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 		render_passes_.erase(name);
 	}
 
 	/// Returns the descriptor_set_layout with the given name or an empty shared_ptr if it doesn't exist.
 	std::shared_ptr<const descriptor_set_layout> find_descriptor_set_layout(const std::string& name) const {
-		std::lock_guard<std::mutex> lock(manager_mutex_);
+		std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 		auto it = descriptor_set_layouts_.find(name);
 		if(it != descriptor_set_layouts_.end())
 			return it->second;
@@ -249,7 +250,7 @@ public:
 
 	/// Returns the framebuffer_config with the given name or an empty shared_ptr if it doesn't exist.
 	std::shared_ptr<const framebuffer_config> find_framebuffer_config(const std::string& name) const {
-		std::lock_guard<std::mutex> lock(manager_mutex_);
+		std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 		auto it = framebuffer_configs_.find(name);
 		if(it != framebuffer_configs_.end())
 			return it->second;
@@ -259,7 +260,7 @@ public:
 
 	/// Returns the pipeline_layout with the given name or an empty shared_ptr if it doesn't exist.
 	std::shared_ptr<const pipeline_layout> find_pipeline_layout(const std::string& name) const {
-		std::lock_guard<std::mutex> lock(manager_mutex_);
+		std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 		auto it = pipeline_layouts_.find(name);
 		if(it != pipeline_layouts_.end())
 			return it->second;
@@ -269,7 +270,7 @@ public:
 
 	/// Returns the pipeline object with the given name or an empty shared_ptr if it doesn't exist.
 	std::shared_ptr<const pipeline> find_pipeline(const std::string& name) const {
-		std::lock_guard<std::mutex> lock(manager_mutex_);
+		std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 		auto it = pipelines_.find(name);
 		if(it != pipelines_.end())
 			return it->second;
@@ -279,7 +280,7 @@ public:
 
 	/// Returns the pipeline_config object with the given name or an empty shared_ptr if it doesn't exist.
 	std::shared_ptr<const pipeline_config> find_pipeline_config(const std::string& name) const {
-		std::lock_guard<std::mutex> lock(manager_mutex_);
+		std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 		auto it = pipeline_configs_.find(name);
 		if(it != pipeline_configs_.end())
 			return it->second;
@@ -289,7 +290,7 @@ public:
 
 	/// Returns the render_pass object with the given name or an empty shared_ptr if it doesn't exist.
 	std::shared_ptr<const render_pass> find_render_pass(const std::string& name) const {
-		std::lock_guard<std::mutex> lock(manager_mutex_);
+		std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 		auto it = render_passes_.find(name);
 		if(it != render_passes_.end())
 			return it->second;
@@ -299,7 +300,7 @@ public:
 
 	/// Returns the sampler object with the given name or an empty shared_ptr if it doesn't exist.
 	std::shared_ptr<const sampler> find_sampler(const std::string& name) const {
-		std::lock_guard<std::mutex> lock(manager_mutex_);
+		std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 		auto it = samplers_.find(name);
 		if(it != samplers_.end())
 			return it->second;
@@ -309,7 +310,7 @@ public:
 
 	/// Returns the shader_module object with the given name or an empty shared_ptr if it doesn't exist.
 	std::shared_ptr<const shader_module> find_shader_module(const std::string& name) const {
-		std::lock_guard<std::mutex> lock(manager_mutex_);
+		std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 		auto it = shader_modules_.find(name);
 		if(it != shader_modules_.end())
 			return it->second;
@@ -319,7 +320,7 @@ public:
 
 	/// Returns the subpass_graph object with the given name or an empty shared_ptr if it doesn't exist.
 	std::shared_ptr<const subpass_graph> find_subpass_graph(const std::string& name) const {
-		std::lock_guard<std::mutex> lock(manager_mutex_);
+		std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 		auto it = subpass_graphs_.find(name);
 		if(it != subpass_graphs_.end())
 			return it->second;
@@ -53,6 +53,13 @@ public:
 	/// \brief Asynchronously loads the shader with the given name and creates a shader module under that name
 	/// in the graphics_manager.
 	void load_shader(const std::string& name);
+	/// \brief Asynchronously loads the shaders with the given names as one batch and creates shader modules
+	/// under these names in the graphics_manager when all of them are loaded.
+	/**
+	 * If one of the shader assets fails to load, no shader module of the batch is created and all of them
+	 * are reported as failed by wait_for_completion().
+	 */
+	void load_shaders(const std::vector<std::string>& names);
 	/// \brief Waits for completion of pending load tasks and checks if errors occured, in which case an
 	/// exception is thrown.
 	void wait_for_completion();
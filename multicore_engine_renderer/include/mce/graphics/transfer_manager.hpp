@@ -19,6 +19,7 @@
 #include <mce/graphics/command_pool.hpp>
 #include <mce/graphics/image.hpp>
 #include <mce/util/callback_pool.hpp>
+#include <mce/util/instrumented_lock.hpp>
 #include <mce/util/ring_chunk_placer.hpp>
 #include <mutex>
 #include <vector>
@@ -172,7 +173,7 @@ private:
 	std::vector<vk::UniqueFence> fences;
 	containers::scratch_pad_pool<std::vector<transfer_job>> job_scratch_pad;
 	bool in_frame = false;
-	mutable std::mutex manager_mutex;
+	mutable util::instrumented_lock<> manager_mutex{"graphics.transfer_manager"};
 
 	static size_t image_alignment(const base_image& img);
 
@@ -238,7 +239,7 @@ private:
 			return false;
 	}
 
-	void start_frame_internal(uint32_t ring_index, std::unique_lock<std::mutex> lock);
+	void start_frame_internal(uint32_t ring_index, std::unique_lock<decltype(manager_mutex)> lock);
 
 public:
 	/// \brief Constructs a transfer_manager for the given device and memory manager with the given number of
@@ -271,7 +272,7 @@ public:
 	template <typename F = no_callback_tag>
 	void upload_buffer(void* data, size_t data_size, vk::Buffer dst_buffer, vk::DeviceSize dst_offset,
 					   F&& callback = no_callback_tag{}) {
-		std::lock_guard<std::mutex> lock(manager_mutex);
+		std::lock_guard<decltype(manager_mutex)> lock(manager_mutex);
 		if(!try_immediate_alloc_buffer(data, data_size, dst_buffer, dst_offset, std::forward<F>(callback))) {
 			auto byte_buff = byte_buff_pool.allocate_buffer(data_size);
 			memcpy(byte_buff, data, data_size);
@@ -287,7 +288,7 @@ public:
 	template <typename F = no_callback_tag>
 	void upload_buffer(containers::pooled_byte_buffer_ptr data, size_t data_size, vk::Buffer dst_buffer,
 					   vk::DeviceSize dst_offset, F&& callback = no_callback_tag{}) {
-		std::lock_guard<std::mutex> lock(manager_mutex);
+		std::lock_guard<decltype(manager_mutex)> lock(manager_mutex);
 		if(!try_immediate_alloc_buffer(data.data(), data_size, dst_buffer, dst_offset,
 									   std::forward<F>(callback))) {
 			waiting_jobs.push_back(
@@ -304,7 +305,7 @@ public:
 	template <typename F = no_callback_tag>
 	void upload_buffer(const std::shared_ptr<const char>& data, size_t data_size, vk::Buffer dst_buffer,
 					   vk::DeviceSize dst_offset, F&& callback = no_callback_tag{}) {
-		std::lock_guard<std::mutex> lock(manager_mutex);
+		std::lock_guard<decltype(manager_mutex)> lock(manager_mutex);
 		if(!try_immediate_alloc_buffer(data.get(), data_size, dst_buffer, dst_offset,
 									   std::forward<F>(callback))) {
 			waiting_jobs.push_back(
@@ -323,7 +324,7 @@ public:
 	template <typename F = no_callback_tag>
 	void upload_image(void* data, size_t data_size, base_image& dst_img, vk::ImageLayout final_layout,
 					  vk::ArrayProxy<const vk::BufferImageCopy> regions, F&& callback = no_callback_tag{}) {
-		std::lock_guard<std::mutex> lock(manager_mutex);
+		std::lock_guard<decltype(manager_mutex)> lock(manager_mutex);
 		if(!try_immediate_alloc_image(data, data_size, dst_img, final_layout, regions,
 									  std::forward<F>(callback))) {
 			auto byte_buff = byte_buff_pool.allocate_buffer(data_size);
@@ -346,7 +347,7 @@ public:
 	void upload_image(const std::shared_ptr<const char>& data, size_t data_size, base_image& dst_img,
 					  vk::ImageLayout final_layout, vk::ArrayProxy<const vk::BufferImageCopy> regions,
 					  F&& callback = no_callback_tag{}) {
-		std::lock_guard<std::mutex> lock(manager_mutex);
+		std::lock_guard<decltype(manager_mutex)> lock(manager_mutex);
 		if(!try_immediate_alloc_image(data.get(), data_size, dst_img, final_layout, regions,
 									  std::forward<F>(callback))) {
 			waiting_jobs.push_back(image_transfer_job(
@@ -365,7 +366,7 @@ public:
 	void upload_image(containers::pooled_byte_buffer_ptr data, size_t data_size, base_image& dst_img,
 					  vk::ImageLayout final_layout, vk::ArrayProxy<const vk::BufferImageCopy> regions,
 					  F&& callback = no_callback_tag{}) {
-		std::lock_guard<std::mutex> lock(manager_mutex);
+		std::lock_guard<decltype(manager_mutex)> lock(manager_mutex);
 		if(!try_immediate_alloc_image(data.data(), data_size, dst_img, final_layout, regions,
 									  std::forward<F>(callback))) {
 			waiting_jobs.push_back(image_transfer_job(
@@ -18,6 +18,7 @@
 #include <mce/graphics/descriptor_set_layout.hpp>
 #include <mce/graphics/descriptor_set_resources.hpp>
 #include <mce/graphics/device.hpp>
+#include <mce/util/instrumented_lock.hpp>
 #include <mce/util/array_utils.hpp>
 #include <memory>
 #include <mutex>
@@ -40,7 +41,7 @@ class destruction_queue_manager;
  * This variation is intended for long-lived and / or not thread-specific descriptors.
  */
 class unique_descriptor_pool {
-	mutable std::mutex pool_mutex_;
+	mutable util::instrumented_lock<> pool_mutex_{"graphics.unique_descriptor_pool"};
 	device* dev_;
 	vk::UniqueDescriptorPool native_pool_;
 	descriptor_set_resources max_resources_;
@@ -77,44 +78,44 @@ public:
 
 	/// Returns the number of available descriptors for the given type in the pool.
 	uint32_t available_descriptors(vk::DescriptorType type) const {
-		std::lock_guard<std::mutex> lock(pool_mutex_);
+		std::lock_guard<decltype(pool_mutex_)> lock(pool_mutex_);
 		return available_resources_.descriptors(type);
 	}
 
 	/// Returns the number of available descriptor sets in the pool.
 	uint32_t available_sets() const {
-		std::lock_guard<std::mutex> lock(pool_mutex_);
+		std::lock_guard<decltype(pool_mutex_)> lock(pool_mutex_);
 		return available_resources_.descriptor_sets();
 	}
 
 	/// Returns the total number of descriptors for the given type in the pool.
 	uint32_t max_descriptors(vk::DescriptorType type) const {
-		std::lock_guard<std::mutex> lock(pool_mutex_);
+		std::lock_guard<decltype(pool_mutex_)> lock(pool_mutex_);
 		return max_resources_.descriptors(type);
 	}
 
 	/// Returns the total number of descriptor sets in the pool.
 	uint32_t max_sets() const {
-		std::lock_guard<std::mutex> lock(pool_mutex_);
+		std::lock_guard<decltype(pool_mutex_)> lock(pool_mutex_);
 		return max_resources_.descriptor_sets();
 	}
 
 	/// Returns a description of all available resources in the pool.
 	descriptor_set_resources available_resources() const {
-		std::lock_guard<std::mutex> lock(pool_mutex_);
+		std::lock_guard<decltype(pool_mutex_)> lock(pool_mutex_);
 		return available_resources_;
 	}
 
 	/// Returns a description of the resource capacity of the pool.
 	descriptor_set_resources max_resources() const {
-		std::lock_guard<std::mutex> lock(pool_mutex_);
+		std::lock_guard<decltype(pool_mutex_)> lock(pool_mutex_);
 		return max_resources_;
 	}
 
 	/// \brief Returns the remaining number of resources (sets or descriptors) for the resource that is
 	/// closest to being depleted.
 	uint32_t min_available_resource_amount() const {
-		std::lock_guard<std::mutex> lock(pool_mutex_);
+		std::lock_guard<decltype(pool_mutex_)> lock(pool_mutex_);
 		return available_resources_.min_resource();
 	}
 
@@ -149,7 +150,7 @@ public:
 				[](const std::shared_ptr<const descriptor_set_layout>& l) { return l->native_layout(); });
 		vk::DescriptorSetAllocateInfo ai(native_pool_.get(), size, nlayouts.data());
 		{
-			std::lock_guard<std::mutex> lock(pool_mutex_);
+			std::lock_guard<decltype(pool_mutex_)> lock(pool_mutex_);
 			if(!available_resources_.sufficient_for(req)) {
 				throw mce::graphics_exception("Insufficient resources in pool for requested allocation.");
 			}
@@ -173,7 +174,7 @@ public:
  * Otherwise follows the same principles as in relying on RAII-ownership and providing thread-safety.
  */
 class growing_unique_descriptor_pool {
-	mutable std::mutex blocks_mutex_;
+	mutable util::instrumented_lock<> blocks_mutex_{"graphics.growing_unique_descriptor_pool"};
 	device* dev_;
 	descriptor_set_resources block_resources_;
 	std::vector<std::unique_ptr<unique_descriptor_pool>> blocks_;
@@ -320,7 +321,7 @@ public:
 		for(const auto& layout : layouts) {
 			req += *layout;
 		}
-		std::lock_guard<std::mutex> lock(blocks_mutex_);
+		std::lock_guard<decltype(blocks_mutex_)> lock(blocks_mutex_);
 		auto it = std::find_if(blocks_.begin(), blocks_.end(),
 							   [&req](const std::unique_ptr<unique_descriptor_pool>& blk) {
 								   return blk->available_resources().sufficient_for(req);
@@ -20,6 +20,7 @@
 #include <mce/core/system_state.hpp>
 #include <mce/entity/ecs_types.hpp>
 #include <mce/memory/aligned_new.hpp>
+#include <mce/memory/block_allocation_policies.hpp>
 #include <mce/rendering/camera_component.hpp>
 #include <mce/rendering/point_light_component.hpp>
 #include <mce/rendering/renderer_system.hpp>
@@ -47,7 +48,8 @@ class renderer_state;
 class renderer_state : public core::system_state {
 	entity::component_pool<camera_component, 4> camera_comps;
 	entity::component_pool<point_light_component> point_light_comps;
-	entity::component_pool<static_model_component> static_model_comps;
+	entity::component_pool<static_model_component, 0x10000u, memory::huge_page_block_allocation_policy>
+			static_model_comps;
 	util::locked<std::vector<std::string>> camera_preferences_;
 	std::vector<std::pair<std::string, const camera_component*>> cameras_tmp;
 
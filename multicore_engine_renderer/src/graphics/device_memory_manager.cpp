@@ -72,7 +72,7 @@ device_memory_manager::device_memory_block::try_allocate(const vk::MemoryRequire
 }
 
 void device_memory_manager::free(const device_memory_allocation& allocation) {
-	std::lock_guard<std::mutex> lock(mutex_);
+	std::lock_guard<lock_type> lock(mutex_);
 	if(allocation.block_id == 0)
 		return;						   // Invalid allocation
 	else if(allocation.block_id > 0) { // Normal block
@@ -103,7 +103,7 @@ bool device_memory_manager::device_memory_block::empty() const {
 }
 
 void device_memory_manager::cleanup(unsigned int keep_per_memory_type) {
-	std::lock_guard<std::mutex> lock(mutex_);
+	std::lock_guard<lock_type> lock(mutex_);
 	auto divider = std::stable_partition(blocks_.begin(), blocks_.end(),
 										 [](const device_memory_block& blk) { return !blk.empty(); });
 	size_t div_pos = std::distance(blocks_.begin(), divider);
@@ -123,7 +123,7 @@ void device_memory_manager::cleanup(unsigned int keep_per_memory_type) {
 device_memory_allocation device_memory_manager::allocate(const vk::MemoryRequirements& memory_requirements,
 														 bool linear,
 														 vk::MemoryPropertyFlags required_flags) {
-	std::lock_guard<std::mutex> lock(mutex_);
+	std::lock_guard<lock_type> lock(mutex_);
 	if(memory_requirements.size < block_size_) {
 		for(auto& block : blocks_) {
 			auto alloc = block.try_allocate(memory_requirements, required_flags, linear);
@@ -215,14 +215,15 @@ device_memory_manager::device_memory_manager(device* dev, vk::DeviceSize block_s
 device_memory_manager::~device_memory_manager() {}
 
 vk::DeviceSize device_memory_manager::capacity() const {
-	std::lock_guard<std::mutex> lock(mutex_);
+	std::lock_guard<lock_type> lock(mutex_);
 	return block_size_ * blocks_.size() +
 		   std::accumulate(separate_blocks_.begin(), separate_blocks_.end(), vk::DeviceSize(0u),
 						   [](vk::DeviceSize sum, const device_memory_block& blk) { return sum + blk.size; });
 }
 
-std::unique_lock<std::mutex> device_memory_manager::obtain_lock(const device_memory_allocation&) const {
-	return std::unique_lock<std::mutex>(mutex_);
+std::unique_lock<device_memory_manager::lock_type>
+device_memory_manager::obtain_lock(const device_memory_allocation&) const {
+	return std::unique_lock<lock_type>(mutex_);
 }
 
 } /* namespace graphics */
@@ -35,7 +35,7 @@ std::shared_ptr<const descriptor_set_layout>
 graphics_manager::create_descriptor_set_layout(const std::string& name,
 											   // cppcheck-suppress passedByValue
 											   std::vector<descriptor_set_layout_binding_element> bindings) {
-	std::lock_guard<std::mutex> lock(manager_mutex_);
+	std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 	auto& entry = descriptor_set_layouts_[name];
 	if(entry) throw mce::key_already_used_exception("The given name is already in use.");
 	entry = std::make_shared<descriptor_set_layout>(*dev_, dqm_, std::move(bindings));
@@ -48,7 +48,7 @@ graphics_manager::create_framebuffer_config(const std::string& name,
 											std::vector<framebuffer_attachment_config> attachment_configs,
 											// cppcheck-suppress passedByValue
 											std::vector<framebuffer_pass_config> passes) {
-	std::lock_guard<std::mutex> lock(manager_mutex_);
+	std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 	auto& entry = framebuffer_configs_[name];
 	if(entry) throw mce::key_already_used_exception("The given name is already in use.");
 	entry = std::make_shared<framebuffer_config>(std::move(attachment_configs), std::move(passes));
@@ -61,7 +61,7 @@ graphics_manager::create_framebuffer_config(const std::string& name, window& swa
 											std::vector<framebuffer_attachment_config> attachment_configs,
 											// cppcheck-suppress passedByValue
 											std::vector<framebuffer_pass_config> passes) {
-	std::lock_guard<std::mutex> lock(manager_mutex_);
+	std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 	auto& entry = framebuffer_configs_[name];
 	if(entry) throw mce::key_already_used_exception("The given name is already in use.");
 	entry = std::make_shared<framebuffer_config>(
@@ -75,7 +75,7 @@ std::shared_ptr<const pipeline_layout> graphics_manager::create_pipeline_layout(
 		std::vector<std::shared_ptr<const descriptor_set_layout>> descriptor_set_layouts,
 		// cppcheck-suppress passedByValue
 		std::vector<vk::PushConstantRange> push_constant_ranges) {
-	std::lock_guard<std::mutex> lock(manager_mutex_);
+	std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 	auto& entry = pipeline_layouts_[name];
 	if(entry) throw mce::key_already_used_exception("The given name is already in use.");
 	entry = std::make_shared<pipeline_layout>(*dev_, dqm_, std::move(descriptor_set_layouts),
@@ -86,7 +86,7 @@ std::shared_ptr<const pipeline_layout> graphics_manager::create_pipeline_layout_
 		const std::string& name, vk::ArrayProxy<const std::string> descriptor_set_layout_names,
 		// cppcheck-suppress passedByValue
 		std::vector<vk::PushConstantRange> push_constant_ranges) {
-	std::lock_guard<std::mutex> lock(manager_mutex_);
+	std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 	auto& entry = pipeline_layouts_[name];
 	if(entry) throw mce::key_already_used_exception("The given name is already in use.");
 	std::vector<std::shared_ptr<const descriptor_set_layout>> layouts;
@@ -109,7 +109,7 @@ std::shared_ptr<const render_pass> graphics_manager::create_render_pass(
 		// cppcheck-suppress passedByValue
 		std::shared_ptr<const framebuffer_config> fb_config, uint32_t fb_pass_config,
 		vk::ArrayProxy<const render_pass_attachment_access> attachment_access_modes) {
-	std::lock_guard<std::mutex> lock(manager_mutex_);
+	std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 	auto& entry = render_passes_[name];
 	if(entry) throw mce::key_already_used_exception("The given name is already in use.");
 	entry = std::make_shared<render_pass>(*dev_, dqm_, std::move(subpasses), std::move(fb_config),
@@ -120,7 +120,7 @@ std::shared_ptr<const render_pass> graphics_manager::create_render_pass(
 		const std::string& name, const std::string& subpass_graph_name, const std::string& fb_config_name,
 		uint32_t fb_pass_config,
 		vk::ArrayProxy<const render_pass_attachment_access> attachment_access_modes) {
-	std::lock_guard<std::mutex> lock(manager_mutex_);
+	std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 	auto& entry = render_passes_[name];
 	if(entry) throw mce::key_already_used_exception("The given name is already in use.");
 	auto subpasses_it = subpass_graphs_.find(subpass_graph_name);
@@ -138,7 +138,7 @@ std::shared_ptr<const subpass_graph>
 		graphics_manager::create_subpass_graph(const std::string& name, std::vector<subpass_entry> subpasses,
 											   // cppcheck-suppress passedByValue
 											   std::vector<vk::SubpassDependency> dependencies) {
-	std::lock_guard<std::mutex> lock(manager_mutex_);
+	std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 	auto& entry = subpass_graphs_[name];
 	if(entry) throw mce::key_already_used_exception("The given name is already in use.");
 	entry = std::make_shared<subpass_graph>(std::move(subpasses), std::move(dependencies));
@@ -147,7 +147,7 @@ std::shared_ptr<const subpass_graph>
 std::shared_ptr<const shader_module>
 graphics_manager::create_shader_module(const std::string& name,
 									   const asset::asset& ready_shader_binary_asset) {
-	std::lock_guard<std::mutex> lock(manager_mutex_);
+	std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 	if(!ready_shader_binary_asset.ready())
 		throw mce::async_state_exception("Given asset '" + ready_shader_binary_asset.name() + "' not ready.");
 	auto& entry = shader_modules_[name];
@@ -162,7 +162,7 @@ graphics_manager::create_sampler(const std::string& name, vk::Filter mag_filter,
 								 float mip_lod_bias, boost::optional<float> max_anisotropy,
 								 boost::optional<vk::CompareOp> compare_op, float min_lod, float max_lod,
 								 vk::BorderColor border_color, bool unnormalized_coordinates) {
-	std::lock_guard<std::mutex> lock(manager_mutex_);
+	std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 	auto& entry = samplers_[name];
 	if(entry) throw mce::key_already_used_exception("The given name is already in use.");
 	entry = std::make_shared<sampler>(*dev_, dqm_, mag_filter, min_filter, mipmap_mode, address_mode,
@@ -173,7 +173,7 @@ graphics_manager::create_sampler(const std::string& name, vk::Filter mag_filter,
 void graphics_manager::add_pending_pipeline(const std::string& name,
 											// cppcheck-suppress passedByValue
 											std::shared_ptr<const pipeline_config> cfg) {
-	std::lock_guard<std::mutex> lock(manager_mutex_);
+	std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 	auto it = pipelines_.find(name);
 	auto it_cfg = pipeline_configs_.find(name);
 	auto it_pending = std::find_if(pending_pipeline_configs_.begin(), pending_pipeline_configs_.end(),
@@ -186,7 +186,7 @@ void graphics_manager::add_pending_pipeline(const std::string& name,
 }
 
 void graphics_manager::compile_pending_pipelines() {
-	std::lock_guard<std::mutex> lock(manager_mutex_);
+	std::lock_guard<decltype(manager_mutex_)> lock(manager_mutex_);
 	static std::vector<pending_pipeline_task> processing_pipeline_configs;
 	auto clear_processing = util::finally([&]() { processing_pipeline_configs.clear(); });
 	using std::swap;
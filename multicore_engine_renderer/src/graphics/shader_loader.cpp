@@ -7,6 +7,7 @@
 #include <mce/asset/asset_manager.hpp>
 #include <mce/graphics/graphics_manager.hpp>
 #include <mce/graphics/shader_loader.hpp>
+#include <mce/util/symbol.hpp>
 #include <numeric>
 
 namespace mce {
@@ -20,36 +21,44 @@ shader_loader::~shader_loader() noexcept {
 }
 
 void shader_loader::load_shader(const std::string& name) {
+	load_shaders({name});
+}
+
+void shader_loader::load_shaders(const std::vector<std::string>& names) {
+	if(names.empty()) return;
+	std::vector<util::symbol> asset_names;
+	asset_names.reserve(names.size());
+	for(const auto& name : names) {
+		asset_names.emplace_back(name + ".spv");
+	}
 	{
 		std::lock_guard<std::mutex> lock(shaders_mtx);
 		++pending_loads;
 	}
-	amgr.load_asset_async(name + ".spv",
-						  [name, this](const asset::asset_ptr& shader_asset) {
-							  try {
-								  {
-									  std::lock_guard<std::mutex> lock(shaders_mtx);
-									  gmgr.create_shader_module(name, *shader_asset);
-									  --pending_loads;
-								  }
-								  shaders_cv.notify_one();
-							  } catch(...) {
-								  {
-									  std::lock_guard<std::mutex> lock(shaders_mtx);
-									  failed_assets.push_back(name);
-									  --pending_loads;
-								  }
-								  shaders_cv.notify_one();
-							  }
-						  },
-						  [name, this](std::exception_ptr) {
-							  {
-								  std::lock_guard<std::mutex> lock(shaders_mtx);
-								  failed_assets.push_back(name);
-								  --pending_loads;
-							  }
-							  shaders_cv.notify_one();
-						  });
+	amgr.load_assets_async(asset_names,
+						   [names, this](const std::vector<asset::asset_ptr>& shader_assets) {
+							   {
+								   std::lock_guard<std::mutex> lock(shaders_mtx);
+								   for(size_t i = 0; i < names.size(); ++i) {
+									   try {
+										   gmgr.create_shader_module(names[i], *shader_assets[i]);
+									   } catch(...) {
+										   failed_assets.push_back(names[i]);
+									   }
+								   }
+								   --pending_loads;
+							   }
+							   shaders_cv.notify_one();
+						   },
+						   [names, this](std::exception_ptr) {
+							   // No shader module of the batch is created if one of its assets fails.
+							   {
+								   std::lock_guard<std::mutex> lock(shaders_mtx);
+								   failed_assets.insert(failed_assets.end(), names.begin(), names.end());
+								   --pending_loads;
+							   }
+							   shaders_cv.notify_one();
+						   });
 }
 
 void shader_loader::wait_for_completion() {
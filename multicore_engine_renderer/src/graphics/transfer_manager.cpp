@@ -117,11 +117,11 @@ void transfer_manager::record_image_copy(void* staging_ptr, size_t data_size, vk
 }
 
 void transfer_manager::start_frame() {
-	std::unique_lock<std::mutex> lock(manager_mutex);
+	std::unique_lock<decltype(manager_mutex)> lock(manager_mutex);
 	start_frame_internal((current_ring_index + 1) % ring_slots, std::move(lock));
 }
 void transfer_manager::start_frame(uint32_t ring_index) {
-	std::unique_lock<std::mutex> lock(manager_mutex);
+	std::unique_lock<decltype(manager_mutex)> lock(manager_mutex);
 	start_frame_internal(ring_index, std::move(lock));
 }
 
@@ -135,7 +135,8 @@ void transfer_manager::reallocate_buffer(size_t min_size) {
 	swap(chunk_placer, new_chunk_placer);
 	staging_buffer_ends.assign(ring_slots, nullptr);
 }
-void transfer_manager::start_frame_internal(uint32_t ring_index, std::unique_lock<std::mutex> lock) {
+void transfer_manager::start_frame_internal(uint32_t ring_index,
+											 std::unique_lock<decltype(manager_mutex)> lock) {
 	in_frame = true;
 	auto jobs = job_scratch_pad.get();
 	current_ring_index = ring_index;
@@ -170,7 +171,7 @@ void transfer_manager::start_frame_internal(uint32_t ring_index, std::unique_loc
 	jobs->clear();
 }
 void transfer_manager::end_frame() {
-	std::unique_lock<std::mutex> lock(manager_mutex);
+	std::unique_lock<decltype(manager_mutex)> lock(manager_mutex);
 	in_frame = false;
 	process_waiting_jobs();
 	staging_buffer.flush_mapped(dev.native_device());
@@ -260,7 +261,7 @@ void transfer_manager::process_ready_callbacks(std::vector<transfer_job>& jobs)
 std::vector<boost::variant<queued_handle<vk::UniqueCommandBuffer>, vk::CommandBuffer>>
 transfer_manager::retrieve_ready_ownership_transfers() {
 	std::vector<boost::variant<queued_handle<vk::UniqueCommandBuffer>, vk::CommandBuffer>> res;
-	std::unique_lock<std::mutex> lock(manager_mutex);
+	std::unique_lock<decltype(manager_mutex)> lock(manager_mutex);
 	if(dev.graphics_queue_index().first != dev.transfer_queue_index().first) {
 		using std::swap;
 		swap(ready_ownership_command_buffers, res);
@@ -39,7 +39,7 @@ unique_descriptor_pool::allocate_descriptor_set(const std::shared_ptr<const desc
 	vk::DescriptorSetAllocateInfo ai(native_pool_.get(), 1, &nlayout);
 	vk::DescriptorSet set;
 	{
-		std::lock_guard<std::mutex> lock(pool_mutex_);
+		std::lock_guard<decltype(pool_mutex_)> lock(pool_mutex_);
 		if(!available_resources_.sufficient_for(req)) {
 			throw mce::graphics_exception("Insufficient resources in pool for requested allocation.");
 		}
@@ -65,7 +65,7 @@ std::vector<descriptor_set> unique_descriptor_pool::allocate_descriptor_sets(
 	nlayouts.reserve(layouts.size());
 	std::transform(layouts.begin(), layouts.end(), std::back_inserter(nlayouts),
 				   [](const std::shared_ptr<const descriptor_set_layout>& l) { return l->native_layout(); });
-	std::unique_lock<std::mutex> lock(pool_mutex_);
+	std::unique_lock<decltype(pool_mutex_)> lock(pool_mutex_);
 	if(!available_resources_.sufficient_for(req)) {
 		throw mce::graphics_exception("Insufficient resources in pool for requested allocation.");
 	}
@@ -84,7 +84,7 @@ std::vector<descriptor_set> unique_descriptor_pool::allocate_descriptor_sets(
 void unique_descriptor_pool::free(vk::DescriptorSet set,
 								  const std::shared_ptr<const descriptor_set_layout>& layout) {
 	descriptor_set_resources alloc = *layout;
-	std::lock_guard<std::mutex> lock(pool_mutex_);
+	std::lock_guard<decltype(pool_mutex_)> lock(pool_mutex_);
 	(*dev_)->freeDescriptorSets(native_pool_.get(), set);
 	available_resources_ += alloc;
 }
@@ -96,7 +96,7 @@ growing_unique_descriptor_pool::growing_unique_descriptor_pool(device& dev,
 }
 
 uint32_t growing_unique_descriptor_pool::available_descriptors(vk::DescriptorType type) const {
-	std::lock_guard<std::mutex> lock(blocks_mutex_);
+	std::lock_guard<decltype(blocks_mutex_)> lock(blocks_mutex_);
 	return std::accumulate(blocks_.begin(), blocks_.end(), 0u,
 						   [type](uint32_t s, const std::unique_ptr<unique_descriptor_pool>& p) {
 							   return s + p->available_descriptors(type);
@@ -104,7 +104,7 @@ uint32_t growing_unique_descriptor_pool::available_descriptors(vk::DescriptorTyp
 }
 
 uint32_t growing_unique_descriptor_pool::available_sets() const {
-	std::lock_guard<std::mutex> lock(blocks_mutex_);
+	std::lock_guard<decltype(blocks_mutex_)> lock(blocks_mutex_);
 	return std::accumulate(blocks_.begin(), blocks_.end(), 0u,
 						   [](uint32_t s, const std::unique_ptr<unique_descriptor_pool>& p) {
 							   return s + p->available_sets();
@@ -114,7 +114,7 @@ uint32_t growing_unique_descriptor_pool::available_sets() const {
 descriptor_set growing_unique_descriptor_pool::allocate_descriptor_set(
 		const std::shared_ptr<const descriptor_set_layout>& layout, destruction_queue_manager* dqm) {
 	descriptor_set_resources req = *layout;
-	std::lock_guard<std::mutex> lock(blocks_mutex_);
+	std::lock_guard<decltype(blocks_mutex_)> lock(blocks_mutex_);
 	auto it = std::find_if(blocks_.begin(), blocks_.end(),
 						   [&req](const std::unique_ptr<unique_descriptor_pool>& blk) {
 							   return blk->available_resources().sufficient_for(req);
@@ -134,7 +134,7 @@ std::vector<descriptor_set> growing_unique_descriptor_pool::allocate_descriptor_
 	for(const auto& layout : layouts) {
 		req += *layout;
 	}
-	std::lock_guard<std::mutex> lock(blocks_mutex_);
+	std::lock_guard<decltype(blocks_mutex_)> lock(blocks_mutex_);
 	auto it = std::find_if(blocks_.begin(), blocks_.end(),
 						   [&req](const std::unique_ptr<unique_descriptor_pool>& blk) {
 							   return blk->available_resources().sufficient_for(req);
@@ -148,14 +148,14 @@ std::vector<descriptor_set> growing_unique_descriptor_pool::allocate_descriptor_
 }
 
 uint32_t growing_unique_descriptor_pool::descriptors_capacity(vk::DescriptorType type) const {
-	std::lock_guard<std::mutex> lock(blocks_mutex_);
+	std::lock_guard<decltype(blocks_mutex_)> lock(blocks_mutex_);
 	return std::accumulate(blocks_.begin(), blocks_.end(), 0u,
 						   [type](uint32_t s, const std::unique_ptr<unique_descriptor_pool>& p) {
 							   return s + p->max_descriptors(type);
 						   });
 }
 uint32_t growing_unique_descriptor_pool::sets_capacity() const {
-	std::lock_guard<std::mutex> lock(blocks_mutex_);
+	std::lock_guard<decltype(blocks_mutex_)> lock(blocks_mutex_);
 	return std::accumulate(
 			blocks_.begin(), blocks_.end(), 0u,
 			[](uint32_t s, const std::unique_ptr<unique_descriptor_pool>& p) { return s + p->max_sets(); });
@@ -163,7 +163,7 @@ uint32_t growing_unique_descriptor_pool::sets_capacity() const {
 
 descriptor_set_resources growing_unique_descriptor_pool::available_resources() const {
 	descriptor_set_resources rv;
-	std::lock_guard<std::mutex> lock(blocks_mutex_);
+	std::lock_guard<decltype(blocks_mutex_)> lock(blocks_mutex_);
 	for(const auto& blk : blocks_) {
 		rv += blk->available_resources();
 	}
@@ -171,7 +171,7 @@ descriptor_set_resources growing_unique_descriptor_pool::available_resources() c
 }
 descriptor_set_resources growing_unique_descriptor_pool::resource_capacity() const {
 	descriptor_set_resources rv;
-	std::lock_guard<std::mutex> lock(blocks_mutex_);
+	std::lock_guard<decltype(blocks_mutex_)> lock(blocks_mutex_);
 	for(const auto& blk : blocks_) {
 		rv += blk->max_resources();
 	}
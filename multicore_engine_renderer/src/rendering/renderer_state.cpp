@@ -20,6 +20,7 @@
 #include <mce/graphics/pipeline_layout.hpp>
 #include <mce/rendering/renderer_state.hpp>
 #include <mce/util/algorithm.hpp>
+#include <mce/util/perf_counters.hpp>
 #include <tbb/parallel_sort.h>
 
 namespace mce {
@@ -109,9 +110,14 @@ void renderer_state::render(const mce::core::frame_time&) {
 	}
 	task_reducer red(*this);
 	tbb::parallel_reduce(containers::make_pool_const_range(static_model_comps), red);
-	tbb::parallel_sort(*(red.buffer));
+	{
+		// Only measures the share of the sort that runs on the calling thread.
+		MCE_PERF_ZONE("rendering.render.sort");
+		tbb::parallel_sort(*(red.buffer));
+	}
 	using range = tbb::blocked_range<decltype(red.buffer->begin())>;
 	tbb::parallel_for(range(red.buffer->begin(), red.buffer->end()), [this, sys](const range& r) {
+		MCE_PERF_ZONE("rendering.render.record");
 		// auto& per_thread_data = sys->per_thread_data();
 		auto& per_frame_per_thread_data = sys->per_frame_per_thread_data();
 		util::grouped_foreach(
@@ -136,6 +142,7 @@ void renderer_state::render(const mce::core::frame_time&) {
 	});
 }
 void renderer_state::task_reducer::operator()(const static_model_comp_range_t& range) {
+	MCE_PERF_ZONE("rendering.render.reduce");
 	for(const static_model_component& c : range) {
 		if(c.ready()) {
 			assert(c.model());
@@ -31,8 +31,8 @@ renderer_system::renderer_system(core::engine& eng, graphics::graphics_system& g
 		  primary_cmd_pool(gs_.device(), gs_.device().graphics_queue_index().first, true, true) {
 
 	graphics::shader_loader shader_ldr(eng.asset_manager(), gs_.graphics_manager());
-	shader_ldr.load_shader(settings_.main_forward_vertex_shader_name);
-	shader_ldr.load_shader(settings_.main_forward_fragment_shader_name);
+	shader_ldr.load_shaders(
+			{settings_.main_forward_vertex_shader_name, settings_.main_forward_fragment_shader_name});
 
 	create_samplers();
 	create_descriptor_sets();
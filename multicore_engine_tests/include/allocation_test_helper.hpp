@@ -0,0 +1,56 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_tests/include/allocation_test_helper.hpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#ifndef ALLOCATION_TEST_HELPER_HPP_
+#define ALLOCATION_TEST_HELPER_HPP_
+
+#include <cstdint>
+#include <gtest.hpp>
+#include <mce/memory/allocation_tracking.hpp>
+#include <utility>
+
+namespace mce {
+namespace test {
+
+/// \brief Runs the given frame function for warm_up_frames frames and then checks that the following
+/// measured_frames frames make at most allocation_budget allocations per frame on all threads.
+/**
+ * Intended to be used as <code>ASSERT_TRUE(frames_within_allocation_budget(frame, 16, 64, 0));</code>. The
+ * measurement includes allocations of threads that run concurrently with the frames, such as background
+ * loading threads, which should therefore be idle. Tests using this should be skipped if
+ * mce::memory::allocation_tracking_enabled() is false, because no allocations are counted in that case.
+ */
+template <typename F>
+::testing::AssertionResult frames_within_allocation_budget(F&& frame, unsigned warm_up_frames,
+														   unsigned measured_frames,
+														   uint64_t allocation_budget) {
+	for(unsigned i = 0; i < warm_up_frames; ++i) {
+		frame();
+	}
+	auto start = memory::global_allocation_counters();
+	for(unsigned i = 0; i < measured_frames; ++i) {
+		frame();
+	}
+	auto counted = memory::global_allocation_counters() - start;
+	if(counted.allocations <= allocation_budget * measured_frames) return ::testing::AssertionSuccess();
+	return ::testing::AssertionFailure()
+		   << counted.allocations << " allocations (" << counted.allocated_bytes << " bytes) in "
+		   << measured_frames << " frames after warm-up exceed the budget of " << allocation_budget
+		   << " allocations per frame.";
+}
+
+/// \brief Runs the given frame function for warm_up_frames frames and then checks that the following
+/// measured_frames frames make no allocations on any thread.
+template <typename F>
+::testing::AssertionResult frames_without_allocations(F&& frame, unsigned warm_up_frames,
+													  unsigned measured_frames) {
+	return frames_within_allocation_budget(std::forward<F>(frame), warm_up_frames, measured_frames, 0);
+}
+
+} // namespace test
+} // namespace mce
+
+#endif /* ALLOCATION_TEST_HELPER_HPP_ */
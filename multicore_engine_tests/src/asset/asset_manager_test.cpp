@@ -0,0 +1,120 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_tests/src/asset/asset_manager_test.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <gtest.hpp>
+#include <mce/asset/asset_loader.hpp>
+#include <mce/asset/asset_manager.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mce {
+namespace asset {
+
+namespace {
+
+// Records the order in which loads are started and blocks the load of the asset "gate" until released.
+class recording_asset_loader : public asset_loader {
+	std::promise<void> gate_promise;
+	std::shared_future<void> gate;
+	std::mutex started_mutex;
+	std::vector<std::string> started_;
+
+public:
+	recording_asset_loader() : gate{gate_promise.get_future().share()} {}
+	void open_gate() {
+		gate_promise.set_value();
+	}
+	std::vector<std::string> started() {
+		std::lock_guard<std::mutex> lock(started_mutex);
+		return started_;
+	}
+	bool start_load_asset(const std::shared_ptr<asset>& loading_asset, asset_manager&, bool) override {
+		if(loading_asset->name() == "gate") gate.wait();
+		{
+			std::lock_guard<std::mutex> lock(started_mutex);
+			started_.push_back(loading_asset->name());
+		}
+		static const char content[] = "content";
+		finish_loading(loading_asset, file_content_ptr(file_content_ptr(), content), sizeof(content));
+		return true;
+	}
+	void start_pin_load_unit(const std::string&, asset_manager&) override {}
+	void start_pin_load_unit(const std::string&, asset_manager&, const simple_completion_handler&,
+							 const error_handler&) override {}
+	void start_unpin_load_unit(const std::string&, asset_manager&) override {}
+};
+
+bool wait_for_count(const std::atomic<int>& count, int expected) {
+	for(int i = 0; i < 500 && count != expected; ++i) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	return count == expected;
+}
+
+} // namespace
+
+TEST(asset_asset_manager_test, load_priority_order) {
+	asset_manager m(1);
+	auto loader = std::make_shared<recording_asset_loader>();
+	m.add_asset_loader(std::shared_ptr<asset_loader>(loader));
+	std::atomic<int> completed{0};
+	auto done = [&completed](const asset_ptr&) { ++completed; };
+	auto fail = [](std::exception_ptr) { ADD_FAILURE(); };
+	// The single worker is blocked by the gate while the other requests are queued.
+	m.load_asset_async("gate", done, fail, load_priority::immediate);
+	m.load_asset_async("b1", done, fail, load_priority::background);
+	m.load_asset_async("n1", done, fail, load_priority::normal);
+	m.load_asset_async("b2", done, fail, load_priority::background);
+	m.load_asset_async("h1", done, fail, load_priority::high);
+	// Promotes the waiting load of b2.
+	m.load_asset_async("b2", done, fail, load_priority::immediate);
+	loader->open_gate();
+	ASSERT_TRUE(wait_for_count(completed, 6));
+	ASSERT_EQ((std::vector<std::string>{"gate", "b2", "h1", "n1", "b1"}), loader->started());
+}
+
+TEST(asset_asset_manager_test, cancelled_requests) {
+	asset_manager m(1);
+	auto loader = std::make_shared<recording_asset_loader>();
+	m.add_asset_loader(std::shared_ptr<asset_loader>(loader));
+	auto gate = m.load_asset_future("gate", load_priority::immediate);
+	load_cancellation_token token;
+	std::atomic<int> cancelled{0};
+	m.load_asset_async("c1", [](const asset_ptr&) { ADD_FAILURE(); },
+					   [&cancelled](std::exception_ptr e) {
+						   try {
+							   std::rethrow_exception(e);
+						   } catch(const operation_cancelled_exception&) {
+							   ++cancelled;
+						   } catch(...) {
+						   }
+					   },
+					   load_priority::normal, token);
+	auto c1 = m.load_asset_future("c1", load_priority::normal, token);
+	auto c2_cancelled = m.load_asset_future("c2", load_priority::normal, token);
+	auto c2 = m.load_asset_future("c2");
+	token.cancel();
+	loader->open_gate();
+	ASSERT_TRUE(gate.get());
+	ASSERT_THROW(c1.get(), operation_cancelled_exception);
+	ASSERT_THROW(c2_cancelled.get(), operation_cancelled_exception);
+	ASSERT_TRUE(c2.get());
+	ASSERT_TRUE(wait_for_count(cancelled, 1));
+	ASSERT_EQ((std::vector<std::string>{"gate", "c2"}), loader->started());
+	ASSERT_THROW(m.load_asset_future("c3", load_priority::normal, token).get(), operation_cancelled_exception);
+	// The skipped load is not cached as failed.
+	ASSERT_TRUE(m.load_asset_sync("c1"));
+	ASSERT_EQ((std::vector<std::string>{"gate", "c2", "c1"}), loader->started());
+}
+
+} // namespace asset
+} // namespace mce
@@ -5,21 +5,27 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <boost/filesystem.hpp>
+#include <chrono>
+#include <cstdint>
 #include <cstring>
 #include <fstream>
 #include <future>
 #include <gtest.hpp>
 #include <iostream>
 #include <mce/asset/asset_manager.hpp>
+#include <mce/asset/async_native_file_reader.hpp>
 #include <mce/asset/file_asset_loader.hpp>
 #include <mce/asset/load_unit_asset_loader.hpp>
+#include <mce/asset/mapped_pack_file_reader.hpp>
 #include <mce/asset/native_file_reader.hpp>
 #include <mce/asset/pack_file_reader.hpp>
 #include <mce/asset_gen/load_unit_gen.hpp>
 #include <mce/asset_gen/pack_file_gen.hpp>
 #include <mce/util/finally.hpp>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <string>
 #include <thread>
@@ -108,6 +114,68 @@ struct assets_generators_and_loaders_test : public ::testing::Test {
 	~assets_generators_and_loaders_test() {}
 };
 
+namespace {
+
+// Forwards to an async_native_file_reader and records which files are read as a whole and which ranges.
+class counting_file_reader final : public file_reader {
+	async_native_file_reader reader;
+	std::mutex records_mutex;
+	std::vector<std::string> whole_files;
+	std::vector<std::pair<std::string, file_size>> range_sizes;
+
+public:
+	std::pair<file_content_ptr, file_size> read_file(const std::string& prefix,
+													 const std::string& file) override {
+		std::lock_guard<std::mutex> lock(records_mutex);
+		whole_files.push_back(file);
+		return reader.read_file(prefix, file);
+	}
+	std::pair<file_content_ptr, file_size> read_file_range(const std::string& prefix, const std::string& file,
+														   file_size offset, file_size size) override {
+		auto content = reader.read_file_range(prefix, file, offset, size);
+		std::lock_guard<std::mutex> lock(records_mutex);
+		range_sizes.emplace_back(file, content.second);
+		return content;
+	}
+	std::vector<std::string> whole_file_reads() {
+		std::lock_guard<std::mutex> lock(records_mutex);
+		return whole_files;
+	}
+	std::vector<std::pair<std::string, file_size>> range_reads() {
+		std::lock_guard<std::mutex> lock(records_mutex);
+		return range_sizes;
+	}
+};
+
+// Forwards to a native_file_reader but holds back reading the given file until the gate is opened.
+class gated_file_reader final : public file_reader {
+	native_file_reader reader;
+	std::string gated_file;
+	std::shared_future<void> gate;
+
+public:
+	gated_file_reader(std::string gated_file, std::shared_future<void> gate)
+			: gated_file{std::move(gated_file)}, gate{std::move(gate)} {}
+	std::pair<file_content_ptr, file_size> read_file(const std::string& prefix,
+													 const std::string& file) override {
+		if(file == gated_file) gate.wait();
+		return reader.read_file(prefix, file);
+	}
+};
+
+// Returns the number of bytes the process has read through system calls or 0 if that isn't available.
+uint64_t process_read_bytes() {
+	std::ifstream io("/proc/self/io");
+	std::string key;
+	uint64_t value = 0;
+	while(io >> key >> value) {
+		if(key == "rchar:") return value;
+	}
+	return 0;
+}
+
+} // namespace
+
 TEST_F(assets_generators_and_loaders_test, load_files_sync) {
 	asset_manager m;
 	auto loader = std::make_shared<file_asset_loader>(
@@ -169,6 +237,198 @@ TEST_F(assets_generators_and_loaders_test, load_files_async) {
 	ASSERT_TRUE(f4.get());
 }
 
+TEST_F(assets_generators_and_loaders_test, load_files_async_multiple) {
+	asset_manager m;
+	auto loader = std::make_shared<file_asset_loader>(
+			std::vector<path_prefix>({{std::make_unique<native_file_reader>(), "."}}));
+	m.add_asset_loader(loader);
+	std::promise<std::vector<asset_ptr>> p;
+	auto f = p.get_future();
+	m.load_assets_async({util::symbol(file_a->name), util::symbol(file_b->name), util::symbol(file_c->name),
+						 util::symbol(file_d->name)},
+						[&p](std::vector<asset_ptr> assets) { p.set_value(std::move(assets)); },
+						[&p](std::exception_ptr e) { p.set_exception(e); });
+	auto assets = f.get();
+	ASSERT_EQ(4u, assets.size());
+	ASSERT_TRUE(file_a->check(assets[0]->data(), assets[0]->size()));
+	ASSERT_TRUE(file_b->check(assets[1]->data(), assets[1]->size()));
+	ASSERT_TRUE(file_c->check(assets[2]->data(), assets[2]->size()));
+	ASSERT_TRUE(file_d->check(assets[3]->data(), assets[3]->size()));
+}
+
+TEST_F(assets_generators_and_loaders_test, load_files_async_multiple_error) {
+	asset_manager m;
+	auto loader = std::make_shared<file_asset_loader>(
+			std::vector<path_prefix>({{std::make_unique<native_file_reader>(), "."}}));
+	m.add_asset_loader(loader);
+	std::promise<std::vector<asset_ptr>> p;
+	auto f = p.get_future();
+	std::atomic<int> completions{0};
+	std::atomic<int> errors{0};
+	// The handlers are shared by all assets and destroyed once every asset has run and dropped its handlers,
+	// which releases the guard.
+	std::promise<void> handlers_released;
+	auto handlers_released_future = handlers_released.get_future();
+	std::shared_ptr<void> guard(nullptr, [&handlers_released](void*) { handlers_released.set_value(); });
+	m.load_assets_async({util::symbol(file_a->name), util::symbol("nonexistent_file_x"),
+						 util::symbol("nonexistent_file_y")},
+						[&p, &completions](std::vector<asset_ptr> assets) {
+							++completions;
+							p.set_value(std::move(assets));
+						},
+						[&p, &errors, guard](std::exception_ptr e) {
+							++errors;
+							p.set_exception(e);
+						});
+	guard.reset();
+	ASSERT_THROW(f.get(), path_not_found_exception);
+	handlers_released_future.get();
+	ASSERT_EQ(0, completions.load());
+	ASSERT_EQ(1, errors.load());
+	auto a = m.load_asset_sync(file_a->name);
+	ASSERT_TRUE(file_a->check(a->data(), a->size()));
+	ASSERT_THROW(m.load_asset_sync("nonexistent_file_x"), path_not_found_exception);
+	ASSERT_THROW(m.load_asset_sync("nonexistent_file_y"), path_not_found_exception);
+}
+
+TEST_F(assets_generators_and_loaders_test, load_files_async_native_reader) {
+	asset_manager m;
+	auto loader = std::make_shared<file_asset_loader>(
+			std::vector<path_prefix>({{std::make_unique<async_native_file_reader>(), "."}}));
+	m.add_asset_loader(loader);
+	auto f1 = m.load_asset_future(file_a->name);
+	auto f2 = m.load_asset_future(file_b->name);
+	auto a3 = m.load_asset_sync(file_c->name);
+	auto f4 = m.load_asset_future(file_d->name);
+	auto a1 = f1.get();
+	auto a2 = f2.get();
+	auto a4 = f4.get();
+	ASSERT_TRUE(file_a->check(a1->data(), a1->size()));
+	ASSERT_TRUE(file_b->check(a2->data(), a2->size()));
+	ASSERT_TRUE(file_c->check(a3->data(), a3->size()));
+	ASSERT_TRUE(file_d->check(a4->data(), a4->size()));
+	ASSERT_ANY_THROW(m.load_asset_future("nonexistent_file_x").get());
+}
+
+TEST_F(assets_generators_and_loaders_test, load_files_async_native_reader_blocking_handler) {
+	asset_manager m(4);
+	auto loader = std::make_shared<file_asset_loader>(
+			std::vector<path_prefix>({{std::make_unique<async_native_file_reader>(), "."}}));
+	m.add_asset_loader(loader);
+	auto b_loaded = std::make_shared<std::promise<void>>();
+	std::shared_future<void> b_loaded_future = b_loaded->get_future();
+	auto a_handled = std::make_shared<std::promise<bool>>();
+	auto a_handled_future = a_handled->get_future();
+	// The handler for a blocks until b is loaded, which requires the reader to complete b in the meantime.
+	m.load_asset_async(file_a->name,
+					   [b_loaded_future, a_handled](const asset_ptr&) {
+						   auto status = b_loaded_future.wait_for(std::chrono::seconds(10));
+						   a_handled->set_value(status == std::future_status::ready);
+					   },
+					   [a_handled](std::exception_ptr e) { a_handled->set_exception(e); });
+	m.load_asset_async(file_b->name, [b_loaded](const asset_ptr&) { b_loaded->set_value(); },
+					   [](std::exception_ptr) {});
+	ASSERT_TRUE(a_handled_future.get());
+}
+
+TEST_F(assets_generators_and_loaders_test, async_native_file_reader_queue_overflow) {
+	std::vector<std::promise<bool>> promises(64);
+	std::vector<std::future<bool>> futures;
+	for(auto& p : promises) {
+		futures.push_back(p.get_future());
+	}
+	{
+		// The small queue forces some of the reads to fall back to synchronous reads.
+		async_native_file_reader reader(2);
+		for(size_t i = 0; i < promises.size(); ++i) {
+			auto& file = i % 2 ? file_a : file_d;
+			auto& p = promises[i];
+			ASSERT_TRUE(reader.start_read_file(
+					".", file->name,
+					[&p, &file](const file_content_ptr& content, file_size size) {
+						p.set_value(file->check(content.get(), size));
+					},
+					[&p](std::exception_ptr e) { p.set_exception(e); }));
+		}
+		ASSERT_FALSE(reader.start_read_file(".", "nonexistent_file_x",
+											[](const file_content_ptr&, file_size) {},
+											[](std::exception_ptr) {}));
+	}
+	for(auto& f : futures) {
+		ASSERT_TRUE(f.get());
+	}
+}
+
+TEST_F(assets_generators_and_loaders_test, async_native_file_reader_read_file_range) {
+	async_native_file_reader reader;
+	auto read_bytes_before = process_read_bytes();
+	auto range = reader.read_file_range(".", file_a->name, 100, 1000);
+	auto read_bytes = process_read_bytes() - read_bytes_before;
+	// Reading the whole file would read more than the small range and the statistics file itself.
+	if(read_bytes_before) {
+		ASSERT_LT(read_bytes, file_a->data.size() / 2);
+	}
+	ASSERT_TRUE(range.first);
+	ASSERT_EQ(1000u, range.second);
+	ASSERT_TRUE(std::equal(file_a->data.begin() + 100, file_a->data.begin() + 1100, range.first.get()));
+	auto tail = reader.read_file_range(".", file_a->name, file_a->data.size() - 10, 1000);
+	ASSERT_TRUE(tail.first);
+	ASSERT_EQ(10u, tail.second);
+	ASSERT_TRUE(std::equal(file_a->data.end() - 10, file_a->data.end(), tail.first.get()));
+	ASSERT_FALSE(reader.read_file_range(".", "nonexistent_file_x", 0, 10).first);
+}
+
+TEST_F(assets_generators_and_loaders_test, cache_budget_lru_eviction) {
+	asset_manager m;
+	auto loader = std::make_shared<file_asset_loader>(
+			std::vector<path_prefix>({{std::make_unique<native_file_reader>(), "."}}));
+	m.add_asset_loader(loader);
+	auto wait_for_resident = [&m](uint64_t bytes) {
+		for(int i = 0; i < 500 && m.cache_statistics().resident_bytes != bytes; ++i) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+		return m.cache_statistics().resident_bytes == bytes;
+	};
+	uint64_t size_a = file_a->data.size();
+	uint64_t size_b = file_b->data.size();
+	uint64_t size_c = file_c->data.size();
+	uint64_t size_d = file_d->data.size();
+	m.cache_budget(size_a + size_c + size_d);
+	ASSERT_TRUE(m.load_asset_sync(file_a->name));
+	std::weak_ptr<const asset> a2 = m.load_asset_sync(file_b->name);
+	ASSERT_FALSE(a2.expired());
+	ASSERT_TRUE(m.load_asset_sync(file_c->name));
+	// Requesting a again makes b the least recently used asset.
+	ASSERT_TRUE(m.load_asset_sync(file_a->name));
+	auto a4 = m.load_asset_sync(file_d->name);
+	ASSERT_TRUE(wait_for_resident(size_a + size_c + size_d));
+	// The eviction pass frees the evicted asset instead of leaving it to a later reclamation.
+	for(int i = 0; i < 500 && !a2.expired(); ++i) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	ASSERT_TRUE(a2.expired());
+	auto stats = m.cache_statistics();
+	ASSERT_EQ(1u, stats.hits);
+	ASSERT_EQ(4u, stats.misses);
+	ASSERT_EQ(1u, stats.evictions);
+	ASSERT_EQ(size_b, stats.evicted_bytes);
+	ASSERT_TRUE(m.load_asset_sync(file_a->name));
+	ASSERT_EQ(2u, m.cache_statistics().hits);
+	// Referenced assets are kept even if they exceed the budget.
+	m.cache_budget(1);
+	ASSERT_TRUE(wait_for_resident(size_d));
+	ASSERT_TRUE(file_d->check(a4->data(), a4->size()));
+	a4.reset();
+	m.start_clean();
+	ASSERT_TRUE(wait_for_resident(0));
+	stats = m.cache_statistics();
+	ASSERT_EQ(4u, stats.evictions);
+	ASSERT_EQ(size_a + size_b + size_c + size_d, stats.evicted_bytes);
+	m.reset_cache_statistics();
+	ASSERT_EQ(0.0, m.cache_statistics().hit_rate());
+	ASSERT_EQ(0u, m.cache_statistics().evictions);
+}
+
 TEST_F(assets_generators_and_loaders_test, gen_and_load_load_unit_sync) {
 	mce::asset_gen::load_unit_gen gen;
 	gen.add_file(file_a->name, "file_a");
@@ -223,6 +483,72 @@ TEST_F(assets_generators_and_loaders_test, gen_and_load_load_unit_future) {
 	ASSERT_TRUE(file_c->check(a3->data(), a3->size()));
 	ASSERT_TRUE(file_d->check(a4->data(), a4->size()));
 }
+
+TEST_F(assets_generators_and_loaders_test, gen_and_load_load_unit_streaming) {
+	mce::asset_gen::load_unit_gen gen;
+	gen.add_file(file_a->name, "file_a");
+	gen.add_file(file_b->name, "file_b");
+	gen.add_file(file_c->name, "file_c");
+	gen.add_file(file_d->name, "file_d");
+	auto f = util::finally([]() {
+		fs::remove("test.lum");
+		fs::remove("test.lup");
+	});
+	gen.compile_load_unit("test.lum", "test.lup");
+	asset_manager m;
+	auto loader = std::make_shared<load_unit_asset_loader>(
+			std::vector<path_prefix>({{std::make_unique<native_file_reader>(), "."}}),
+			load_unit_asset_loader::payload_mode::streaming);
+	m.add_asset_loader(loader);
+	std::promise<void> pinned;
+	m.start_pin_load_unit("test", [&pinned]() { pinned.set_value(); },
+						  [&pinned](std::exception_ptr e) { pinned.set_exception(e); });
+	pinned.get_future().get();
+	auto a1 = m.load_asset_sync("file_a");
+	ASSERT_TRUE(file_a->check(a1->data(), a1->size()));
+	auto f2 = m.load_asset_future("file_b");
+	auto f3 = m.load_asset_future("file_c");
+	auto f4 = m.load_asset_future("file_d");
+	auto a2 = f2.get();
+	auto a3 = f3.get();
+	auto a4 = f4.get();
+	ASSERT_TRUE(file_b->check(a2->data(), a2->size()));
+	ASSERT_TRUE(file_c->check(a3->data(), a3->size()));
+	ASSERT_TRUE(file_d->check(a4->data(), a4->size()));
+	ASSERT_ANY_THROW(m.load_asset_sync("nonexistent_asset"));
+}
+
+TEST_F(assets_generators_and_loaders_test, gen_and_load_load_unit_streaming_reads_ranges) {
+	mce::asset_gen::load_unit_gen gen;
+	gen.add_file(file_a->name, "file_a");
+	gen.add_file(file_b->name, "file_b");
+	gen.add_file(file_c->name, "file_c");
+	gen.add_file(file_d->name, "file_d");
+	auto f = util::finally([]() {
+		fs::remove("test.lum");
+		fs::remove("test.lup");
+	});
+	gen.compile_load_unit("test.lum", "test.lup");
+	auto reader = std::make_shared<counting_file_reader>();
+	asset_manager m;
+	auto loader = std::make_shared<load_unit_asset_loader>(std::vector<path_prefix>({{reader, "."}}),
+														   load_unit_asset_loader::payload_mode::streaming);
+	m.add_asset_loader(loader);
+	std::promise<void> pinned;
+	m.start_pin_load_unit("test", [&pinned]() { pinned.set_value(); },
+						  [&pinned](std::exception_ptr e) { pinned.set_exception(e); });
+	pinned.get_future().get();
+	auto a1 = m.load_asset_sync("file_a");
+	auto a3 = m.load_asset_sync("file_c");
+	ASSERT_TRUE(file_a->check(a1->data(), a1->size()));
+	ASSERT_TRUE(file_c->check(a3->data(), a3->size()));
+	// Only the meta data are read as a whole, the pay-load only in the ranges of the requested assets.
+	ASSERT_EQ(std::vector<std::string>({"test.lum"}), reader->whole_file_reads());
+	std::vector<std::pair<std::string, file_size>> expected_ranges = {{"test.lup", file_a->data.size()},
+																	   {"test.lup", file_c->data.size()}};
+	ASSERT_EQ(expected_ranges, reader->range_reads());
+}
+
 TEST_F(assets_generators_and_loaders_test, gen_and_load_load_unit_async) {
 	mce::asset_gen::load_unit_gen gen;
 	gen.add_file(file_a->name, "file_a");
@@ -261,6 +587,79 @@ TEST_F(assets_generators_and_loaders_test, gen_and_load_load_unit_async) {
 	ASSERT_TRUE(f4.get());
 }
 
+TEST_F(assets_generators_and_loaders_test, gen_and_load_load_unit_precedence) {
+	mce::asset_gen::load_unit_gen gen1;
+	gen1.add_file(file_a->name, "shared");
+	mce::asset_gen::load_unit_gen gen2;
+	gen2.add_file(file_b->name, "shared");
+	gen2.add_file(file_c->name, "only_2");
+	auto f = util::finally([]() {
+		fs::remove("test1.lum");
+		fs::remove("test1.lup");
+		fs::remove("test2.lum");
+		fs::remove("test2.lup");
+	});
+	gen1.compile_load_unit("test1.lum", "test1.lup");
+	gen2.compile_load_unit("test2.lum", "test2.lup");
+	auto loader = std::make_shared<load_unit_asset_loader>(
+			std::vector<path_prefix>({{std::make_unique<native_file_reader>(), "."}}));
+	asset_manager m;
+	m.add_asset_loader(loader);
+	for(const char* name : {"test1", "test2"}) {
+		std::promise<void> pinned;
+		m.start_pin_load_unit(name, [&pinned]() { pinned.set_value(); },
+							  [&pinned](std::exception_ptr e) { pinned.set_exception(e); });
+		pinned.get_future().get();
+	}
+	auto a1 = m.load_asset_sync("shared");
+	ASSERT_TRUE(file_a->check(a1->data(), a1->size()));
+	auto a2 = m.load_asset_sync("only_2");
+	ASSERT_TRUE(file_c->check(a2->data(), a2->size()));
+	ASSERT_ANY_THROW(m.load_asset_sync("nonexistent_asset"));
+	// After unpinning the first load unit, the shared asset is provided by the second one.
+	m.start_unpin_load_unit("test1");
+	asset_manager m2;
+	m2.add_asset_loader(loader);
+	auto a3 = m2.load_asset_sync("shared");
+	ASSERT_TRUE(file_b->check(a3->data(), a3->size()));
+	m.start_unpin_load_unit("test2");
+	ASSERT_ANY_THROW(m2.load_asset_sync("only_2"));
+}
+
+TEST_F(assets_generators_and_loaders_test, gen_and_load_load_unit_precedence_out_of_order) {
+	mce::asset_gen::load_unit_gen gen1;
+	gen1.add_file(file_a->name, "shared");
+	mce::asset_gen::load_unit_gen gen2;
+	gen2.add_file(file_b->name, "shared");
+	auto f = util::finally([]() {
+		fs::remove("test1.lum");
+		fs::remove("test1.lup");
+		fs::remove("test2.lum");
+		fs::remove("test2.lup");
+	});
+	gen1.compile_load_unit("test1.lum", "test1.lup");
+	gen2.compile_load_unit("test2.lum", "test2.lup");
+	std::promise<void> gate;
+	auto loader = std::make_shared<load_unit_asset_loader>(std::vector<path_prefix>(
+			{{std::make_unique<gated_file_reader>("test1.lum", gate.get_future().share()), "."}}));
+	asset_manager m(2);
+	m.add_asset_loader(loader);
+	std::promise<void> pinned1;
+	std::promise<void> pinned2;
+	m.start_pin_load_unit("test1", [&pinned1]() { pinned1.set_value(); },
+						  [&pinned1](std::exception_ptr e) { pinned1.set_exception(e); });
+	m.start_pin_load_unit("test2", [&pinned2]() { pinned2.set_value(); },
+						  [&pinned2](std::exception_ptr e) { pinned2.set_exception(e); });
+	// The meta data of the second load unit are indexed first and replaced by the ones pinned before them.
+	auto pinned2_future = pinned2.get_future();
+	pinned2_future.wait();
+	gate.set_value();
+	pinned2_future.get();
+	pinned1.get_future().get();
+	auto a1 = m.load_asset_sync("shared");
+	ASSERT_TRUE(file_a->check(a1->data(), a1->size()));
+}
+
 TEST_F(assets_generators_and_loaders_test, gen_and_load_pack_file_sync) {
 	mce::asset_gen::pack_file_gen gen;
 	gen.add_file(file_a->name, "file_a");
@@ -283,6 +682,23 @@ TEST_F(assets_generators_and_loaders_test, gen_and_load_pack_file_sync) {
 	ASSERT_TRUE(file_d->check(a4->data(), a4->size()));
 }
 
+TEST_F(assets_generators_and_loaders_test, gen_and_read_pack_file_elements) {
+	mce::asset_gen::pack_file_gen gen;
+	gen.add_file(file_a->name, "file_a");
+	gen.add_file(file_c->name, "file_c");
+	auto f = util::finally([]() { fs::remove("test.pack"); });
+	gen.compile_pack_file("test.pack");
+	pack_file_reader reader;
+	auto c = reader.read_file("test.pack", "file_c");
+	ASSERT_TRUE(c.first);
+	ASSERT_TRUE(file_c->check(c.first.get(), c.second));
+	auto a = reader.read_file("test.pack", "file_a");
+	ASSERT_TRUE(a.first);
+	ASSERT_TRUE(file_a->check(a.first.get(), a.second));
+	ASSERT_FALSE(reader.read_file("test.pack", "file_b").first);
+	ASSERT_FALSE(reader.read_file("test.pack", "file_").first);
+}
+
 TEST_F(assets_generators_and_loaders_test, gen_and_load_pack_file_future) {
 	mce::asset_gen::pack_file_gen gen;
 	gen.add_file(file_a->name, "file_a");
@@ -364,6 +780,126 @@ TEST_F(assets_generators_and_loaders_test, gen_and_load_pack_file_sync_compresse
 	ASSERT_TRUE(file_d->check(a4->data(), a4->size()));
 }
 
+TEST_F(assets_generators_and_loaders_test, gen_and_load_pack_file_codecs) {
+	// Codecs that are not supported by this build fall back to zlib to keep the test meaningful.
+	auto codec_or_zlib = [](util::compression_codec codec) {
+		return util::codec_available(codec) ? codec : util::compression_codec::zlib;
+	};
+	mce::asset_gen::pack_file_gen gen;
+	gen.add_file_compressed(file_a->name, "file_a", codec_or_zlib(util::compression_codec::lz4));
+	gen.add_file_compressed(file_b->name, "file_b", codec_or_zlib(util::compression_codec::lz4), 9);
+	gen.add_file_compressed(file_c->name, "file_c", codec_or_zlib(util::compression_codec::zstd), 19);
+	gen.add_file_compressed(file_d->name, "file_d", util::compression_codec::none);
+	auto f = util::finally([]() { fs::remove("test.pack"); });
+	gen.compile_pack_file("test.pack");
+	pack_file_reader reader;
+	mapped_pack_file_reader mapped_reader;
+	file_reader* readers[] = {&reader, &mapped_reader};
+	const char* names[] = {"file_a", "file_b", "file_c", "file_d"};
+	test_file* files[] = {file_a.get(), file_b.get(), file_c.get(), file_d.get()};
+	for(auto r : readers) {
+		for(size_t i = 0; i < 4; ++i) {
+			auto content = r->read_file("test.pack", names[i]);
+			ASSERT_TRUE(content.first) << names[i];
+			ASSERT_EQ(files[i]->data.size(), content.second) << names[i];
+			ASSERT_TRUE(files[i]->check(content.first.get(), content.second)) << names[i];
+		}
+	}
+}
+
+TEST_F(assets_generators_and_loaders_test, gen_and_read_pack_file_ranges) {
+	mce::asset_gen::pack_file_gen gen;
+	gen.add_file_compressed(file_a->name, "file_a_single");
+	gen.add_file(file_a->name, "file_a_stored");
+	gen.set_block_size(0x1000);
+	gen.add_file_compressed(file_a->name, "file_a_blocked");
+	gen.add_file_compressed(file_c->name, "file_c");
+	auto f = util::finally([]() { fs::remove("test.pack"); });
+	gen.compile_pack_file("test.pack");
+	pack_file_reader reader;
+	mapped_pack_file_reader mapped_reader;
+	native_file_reader native_reader;
+	file_reader* readers[] = {&reader, &mapped_reader};
+	const char* names[] = {"file_a_single", "file_a_stored", "file_a_blocked"};
+	const auto& data = file_a->data;
+	// Ranges within a block, across block boundaries, up to the end, beyond the end and empty ranges.
+	std::pair<size_t, size_t> ranges[] = {{0, 10},			{0x1000, 0x1000}, {0xFFF, 2},
+										  {0x2345, 0x5432}, {0x7F000, 0x2000}, {0x40000, 0},
+										  {0x90000, 10},	{0, data.size()}};
+	auto check_range = [&](const std::pair<file_content_ptr, file_size>& content, size_t offset,
+						   size_t size) {
+		auto begin = std::min(offset, data.size());
+		auto end = std::min(offset + size, data.size());
+		EXPECT_TRUE(content.first);
+		EXPECT_EQ(end - begin, content.second);
+		return content.first && std::equal(data.begin() + begin, data.begin() + end, content.first.get(),
+										   content.first.get() + content.second);
+	};
+	for(auto r : readers) {
+		for(auto name : names) {
+			for(const auto& range : ranges) {
+				ASSERT_TRUE(check_range(r->read_file_range("test.pack", name, range.first, range.second),
+										range.first, range.second))
+						<< name << " " << range.first << " " << range.second;
+			}
+		}
+		ASSERT_FALSE(r->read_file_range("test.pack", "file_b", 0, 10).first);
+		auto c = r->read_file_range("test.pack", "file_c", 5, 10);
+		ASSERT_TRUE(c.first);
+		ASSERT_TRUE(std::equal(file_c->data.begin() + 5, file_c->data.begin() + 15, c.first.get(),
+							   c.first.get() + c.second));
+	}
+	for(const auto& range : ranges) {
+		ASSERT_TRUE(check_range(native_reader.read_file_range(".", file_a->name, range.first, range.second),
+								range.first, range.second));
+	}
+}
+
+TEST_F(assets_generators_and_loaders_test, gen_and_load_mapped_pack_file_sync) {
+	mce::asset_gen::pack_file_gen gen;
+	gen.add_file(file_a->name, "file_a");
+	gen.add_file_compressed(file_b->name, "file_b", 1);
+	gen.add_file(file_c->name, "file_c");
+	gen.add_file_compressed(file_d->name, "file_d", 9);
+	auto f = util::finally([]() { fs::remove("test.pack"); });
+	gen.compile_pack_file("test.pack");
+	asset_manager m;
+	auto loader = std::make_shared<file_asset_loader>(
+			std::vector<path_prefix>({{std::make_unique<mapped_pack_file_reader>(), "test.pack"}}));
+	m.add_asset_loader(loader);
+	auto a1 = m.load_asset_sync("file_a");
+	ASSERT_TRUE(file_a->check(a1->data(), a1->size()));
+	auto a2 = m.load_asset_sync("file_b");
+	ASSERT_TRUE(file_b->check(a2->data(), a2->size()));
+	auto a3 = m.load_asset_sync("file_c");
+	ASSERT_TRUE(file_c->check(a3->data(), a3->size()));
+	auto a4 = m.load_asset_sync("file_d");
+	ASSERT_TRUE(file_d->check(a4->data(), a4->size()));
+}
+
+TEST_F(assets_generators_and_loaders_test, mapped_pack_file_reader_zero_copy) {
+	mce::asset_gen::pack_file_gen gen;
+	gen.add_file(file_a->name, "file_a");
+	gen.add_file(file_c->name, "file_c");
+	auto f = util::finally([]() { fs::remove("test.pack"); });
+	gen.compile_pack_file("test.pack");
+	file_content_ptr c;
+	{
+		mapped_pack_file_reader reader(mapped_pack_file_reader::access_pattern::sequential);
+		auto a1 = reader.read_file("test.pack", "file_a");
+		auto a2 = reader.read_file("test.pack", "file_a");
+		ASSERT_TRUE(a1.first);
+		// Both reads refer to the same mapped memory.
+		ASSERT_EQ(a1.first.get(), a2.first.get());
+		ASSERT_FALSE(reader.read_file("test.pack", "file_b").first);
+		ASSERT_FALSE(reader.read_file("nonexistent.pack", "file_a").first);
+		c = reader.read_file("test.pack", "file_c").first;
+	}
+	// The content keeps the mapping alive after the reader is gone.
+	ASSERT_TRUE(c);
+	ASSERT_TRUE(file_c->check(c.get(), file_c->data.size()));
+}
+
 TEST_F(assets_generators_and_loaders_test, gen_and_load_pack_file_future_compressed) {
 	mce::asset_gen::pack_file_gen gen;
 	gen.add_file_compressed(file_a->name, "file_a");
@@ -41,7 +41,7 @@ TEST(assets_pack_file_description_parser_test, single_empty_section) {
 	auto root = parser.parse("[unit test]", first, last);
 	ASSERT_TRUE(first == last);
 	ast::pack_file_ast_root root_expected;
-	ast::pack_file_section sec1{"test", -2, {}};
+	ast::pack_file_section sec1{"test", {}, {}};
 	root_expected.emplace_back(sec1);
 	ASSERT_TRUE(root == root_expected);
 }
@@ -54,7 +54,7 @@ TEST(assets_pack_file_description_parser_test, single_comment_in_section) {
 	auto root = parser.parse("[unit test]", first, last);
 	ASSERT_TRUE(first == last);
 	ast::pack_file_ast_root root_expected;
-	ast::pack_file_section sec1{"test", -2, {}};
+	ast::pack_file_section sec1{"test", {}, {}};
 	root_expected.emplace_back(sec1);
 	ASSERT_TRUE(root == root_expected);
 }
@@ -66,7 +66,7 @@ TEST(assets_pack_file_description_parser_test, single_section_single_entry) {
 	auto root = parser.parse("[unit test]", first, last);
 	ASSERT_TRUE(first == last);
 	ast::pack_file_ast_root root_expected;
-	ast::pack_file_section sec1{"test", -2, {{"test1", "test2"}}};
+	ast::pack_file_section sec1{"test", {}, {{"test1", "test2"}}};
 	root_expected.emplace_back(sec1);
 	ASSERT_TRUE(root == root_expected);
 }
@@ -78,7 +78,7 @@ TEST(assets_pack_file_description_parser_test, single_section_multi_entry) {
 	auto root = parser.parse("[unit test]", first, last);
 	ASSERT_TRUE(first == last);
 	ast::pack_file_ast_root root_expected;
-	ast::pack_file_section sec1{"test", -2, {{"test1", "test2"}, {"test3", "test4"}, {"test5", "test6"}}};
+	ast::pack_file_section sec1{"test", {}, {{"test1", "test2"}, {"test3", "test4"}, {"test5", "test6"}}};
 	root_expected.emplace_back(sec1);
 	ASSERT_TRUE(root == root_expected);
 }
@@ -90,8 +90,8 @@ TEST(assets_pack_file_description_parser_test, multi_section_single_entry) {
 	auto root = parser.parse("[unit test]", first, last);
 	ASSERT_TRUE(first == last);
 	ast::pack_file_ast_root root_expected;
-	root_expected.emplace_back(ast::pack_file_section{"testA", -2, {{"test1", "test2"}}});
-	root_expected.emplace_back(ast::pack_file_section{"testB", -2, {{"test1", "test2"}}});
+	root_expected.emplace_back(ast::pack_file_section{"testA", {}, {{"test1", "test2"}}});
+	root_expected.emplace_back(ast::pack_file_section{"testB", {}, {{"test1", "test2"}}});
 	ASSERT_TRUE(root == root_expected);
 }
 TEST(assets_pack_file_description_parser_test, multi_section_multi_entry) {
@@ -104,12 +104,12 @@ TEST(assets_pack_file_description_parser_test, multi_section_multi_entry) {
 	ASSERT_TRUE(first == last);
 	ast::pack_file_ast_root root_expected;
 	root_expected.emplace_back(ast::pack_file_section{"testA",
-													  -2,
+													  {},
 													  {{"test1", ast::lookup_type::w, "test2"},
 													   {"test3", ast::lookup_type::d, "test4"},
 													   {"test5", ast::lookup_type::w, "test6"}}});
 	root_expected.emplace_back(ast::pack_file_section{"testB",
-													  -2,
+													  {},
 													  {{"test1", ast::lookup_type::w, "test2"},
 													   {"test3", ast::lookup_type::w, "test4"},
 													   {"test5", ast::lookup_type::d, "test6"}}});
@@ -126,12 +126,12 @@ TEST(assets_pack_file_description_parser_test, no_internal_path) {
 	ASSERT_TRUE(first == last);
 	ast::pack_file_ast_root root_expected;
 	root_expected.emplace_back(ast::pack_file_section{"testA",
-													  -2,
+													  {},
 													  {{"test1", ast::lookup_type::w, {}},
 													   {"test3", ast::lookup_type::d, {}},
 													   {"test5", ast::lookup_type::w, {}}}});
 	root_expected.emplace_back(ast::pack_file_section{"testB",
-													  -2,
+													  {},
 													  {{"test1", ast::lookup_type::w, {}},
 													   {"test3", ast::lookup_type::w, {}},
 													   {"test5", ast::lookup_type::d, {}}}});
@@ -147,10 +147,13 @@ TEST(assets_pack_file_description_parser_test, multi_section_multi_entry_zip) {
 	auto root = parser.parse("[unit test]", first, last);
 	ASSERT_TRUE(first == last);
 	ast::pack_file_ast_root root_expected;
+	root_expected.emplace_back(ast::pack_file_section{"testA",
+													  {util::compression_codec::zlib, -1},
+													  {{"test1", "test2"},
+													   {"test3", "test4"},
+													   {"test5", "test6"}}});
 	root_expected.emplace_back(ast::pack_file_section{
-			"testA", -1, {{"test1", "test2"}, {"test3", "test4"}, {"test5", "test6"}}});
-	root_expected.emplace_back(ast::pack_file_section{
-			"testB", -2, {{"test1", "test2"}, {"test3", "test4"}, {"test5", "test6"}}});
+			"testB", {}, {{"test1", "test2"}, {"test3", "test4"}, {"test5", "test6"}}});
 	ASSERT_TRUE(root == root_expected);
 }
 
@@ -163,10 +166,10 @@ TEST(assets_pack_file_description_parser_test, no_internal_path_zip) {
 	auto root = parser.parse("[unit test]", first, last);
 	ASSERT_TRUE(first == last);
 	ast::pack_file_ast_root root_expected;
-	root_expected.emplace_back(
-			ast::pack_file_section{"testA", -1, {{"test1", {}}, {"test3", {}}, {"test5", {}}}});
-	root_expected.emplace_back(
-			ast::pack_file_section{"testB", -1, {{"test1", {}}, {"test3", {}}, {"test5", {}}}});
+	root_expected.emplace_back(ast::pack_file_section{
+			"testA", {util::compression_codec::zlib, -1}, {{"test1", {}}, {"test3", {}}, {"test5", {}}}});
+	root_expected.emplace_back(ast::pack_file_section{
+			"testB", {util::compression_codec::zlib, -1}, {{"test1", {}}, {"test3", {}}, {"test5", {}}}});
 	ASSERT_TRUE(root == root_expected);
 }
 
@@ -179,10 +182,10 @@ TEST(assets_pack_file_description_parser_test, no_internal_path_zip_level_0_1) {
 	auto root = parser.parse("[unit test]", first, last);
 	ASSERT_TRUE(first == last);
 	ast::pack_file_ast_root root_expected;
-	root_expected.emplace_back(
-			ast::pack_file_section{"testA", 0, {{"test1", {}}, {"test3", {}}, {"test5", {}}}});
-	root_expected.emplace_back(
-			ast::pack_file_section{"testB", 1, {{"test1", {}}, {"test3", {}}, {"test5", {}}}});
+	root_expected.emplace_back(ast::pack_file_section{
+			"testA", {util::compression_codec::zlib, 0}, {{"test1", {}}, {"test3", {}}, {"test5", {}}}});
+	root_expected.emplace_back(ast::pack_file_section{
+			"testB", {util::compression_codec::zlib, 1}, {{"test1", {}}, {"test3", {}}, {"test5", {}}}});
 	ASSERT_TRUE(root == root_expected);
 }
 
@@ -195,10 +198,10 @@ TEST(assets_pack_file_description_parser_test, no_internal_path_zip_level_7_9) {
 	auto root = parser.parse("[unit test]", first, last);
 	ASSERT_TRUE(first == last);
 	ast::pack_file_ast_root root_expected;
-	root_expected.emplace_back(
-			ast::pack_file_section{"testA", 7, {{"test1", {}}, {"test3", {}}, {"test5", {}}}});
-	root_expected.emplace_back(
-			ast::pack_file_section{"testB", 9, {{"test1", {}}, {"test3", {}}, {"test5", {}}}});
+	root_expected.emplace_back(ast::pack_file_section{
+			"testA", {util::compression_codec::zlib, 7}, {{"test1", {}}, {"test3", {}}, {"test5", {}}}});
+	root_expected.emplace_back(ast::pack_file_section{
+			"testB", {util::compression_codec::zlib, 9}, {{"test1", {}}, {"test3", {}}, {"test5", {}}}});
 	ASSERT_TRUE(root == root_expected);
 }
 
@@ -214,9 +217,9 @@ TEST(assets_pack_file_description_parser_test, whitespace_skipping) {
 	ASSERT_TRUE(first == last);
 	ast::pack_file_ast_root root_expected;
 	root_expected.emplace_back(ast::pack_file_section{
-			"testA", -1, {{"test1", "test2"}, {"test3", "test4"}, {"test5", "test6"}}});
+			"testA", {}, {{"test1", "test2"}, {"test3", "test4"}, {"test5", "test6"}}});
 	root_expected.emplace_back(ast::pack_file_section{
-			"testB", -1, {{"test1", "test2"}, {"test3", "test4"}, {"test5", "test6"}}});
+			"testB", {}, {{"test1", "test2"}, {"test3", "test4"}, {"test5", "test6"}}});
 	ASSERT_TRUE(root == root_expected);
 }
 
@@ -266,6 +269,90 @@ TEST(assets_pack_file_description_parser_test, syntax_error_missing_zip_level) {
 	ASSERT_THROW(root = parser.parse("[unit test]", first, last), syntax_exception);
 }
 
+TEST(assets_pack_file_description_parser_test, section_codecs) {
+	pack_file_description_parser parser;
+	std::string testdata = "testA lz4{\"test1\";}testB zstd(19){\"test1\";}testC none{\"test1\";}"
+						   "testD zip(3){\"test1\";}";
+	const char* first = testdata.data();
+	const char* last = testdata.data() + testdata.size();
+	auto root = parser.parse("[unit test]", first, last);
+	ASSERT_TRUE(first == last);
+	ASSERT_EQ(4u, root.size());
+	ASSERT_EQ((ast::compression_spec{util::compression_codec::lz4, -1}), root[0].compression);
+	ASSERT_EQ((ast::compression_spec{util::compression_codec::zstd, 19}), root[1].compression);
+	ASSERT_EQ((ast::compression_spec{util::compression_codec::none, -2}), root[2].compression);
+	ASSERT_EQ((ast::compression_spec{util::compression_codec::zlib, 3}), root[3].compression);
+}
+
+TEST(assets_pack_file_description_parser_test, entry_compression_override) {
+	pack_file_description_parser parser;
+	std::string testdata = "testA zip{\"test1\"->\"test2\" lz4;\"test3\"d zstd(5);\"test5\" none;\"test7\";}";
+	const char* first = testdata.data();
+	const char* last = testdata.data() + testdata.size();
+	auto root = parser.parse("[unit test]", first, last);
+	ASSERT_TRUE(first == last);
+	ASSERT_EQ(1u, root.size());
+	const auto& section = root[0];
+	ASSERT_EQ(4u, section.entries.size());
+	ASSERT_EQ("test2", section.entries[0].internal_path);
+	ASSERT_EQ(ast::lookup_type::d, section.entries[1].lookup);
+	ASSERT_EQ((ast::compression_spec{util::compression_codec::lz4, -1}),
+			  section.entry_compression(section.entries[0], "test2"));
+	ASSERT_EQ((ast::compression_spec{util::compression_codec::zstd, 5}),
+			  section.entry_compression(section.entries[1], "test3"));
+	ASSERT_EQ((ast::compression_spec{util::compression_codec::none, -2}),
+			  section.entry_compression(section.entries[2], "test5"));
+	ASSERT_EQ((ast::compression_spec{util::compression_codec::zlib, -1}),
+			  section.entry_compression(section.entries[3], "test7"));
+}
+
+TEST(assets_pack_file_description_parser_test, compression_rules) {
+	pack_file_description_parser parser;
+	std::string testdata = "testA zip{\n"
+						   "compress \"textures/*.ktx\" lz4;\n"
+						   "compress \"*.bin\" zstd(19);\n"
+						   "\"a.ktx\"->\"textures/a.ktx\";\n"
+						   "\"b.ktx\"->\"textures/b.ktx\" none;\n"
+						   "\"levels/c.bin\";\n"
+						   "\"d.txt\";\n"
+						   "}";
+	const char* first = testdata.data();
+	const char* last = testdata.data() + testdata.size();
+	auto root = parser.parse("[unit test]", first, last);
+	ASSERT_TRUE(first == last);
+	ASSERT_EQ(1u, root.size());
+	const auto& section = root[0];
+	ASSERT_EQ(2u, section.compression_rules.size());
+	ASSERT_EQ("textures/*.ktx", section.compression_rules[0].pattern);
+	ASSERT_EQ(4u, section.entries.size());
+	ASSERT_EQ((ast::compression_spec{util::compression_codec::lz4, -1}),
+			  section.entry_compression(section.entries[0], "textures/a.ktx"));
+	ASSERT_EQ((ast::compression_spec{util::compression_codec::none, -2}),
+			  section.entry_compression(section.entries[1], "textures/b.ktx"));
+	ASSERT_EQ((ast::compression_spec{util::compression_codec::zstd, 19}),
+			  section.entry_compression(section.entries[2], "levels/c.bin"));
+	ASSERT_EQ((ast::compression_spec{util::compression_codec::zlib, -1}),
+			  section.entry_compression(section.entries[3], "d.txt"));
+}
+
+TEST(assets_pack_file_description_parser_test, syntax_error_compression_rule_after_entry) {
+	pack_file_description_parser parser;
+	std::string testdata = "testA{\"test1\";compress \"*\" lz4;}";
+	const char* first = testdata.data();
+	const char* last = testdata.data() + testdata.size();
+	ast::pack_file_ast_root root;
+	ASSERT_THROW(root = parser.parse("[unit test]", first, last), syntax_exception);
+}
+
+TEST(assets_pack_file_description_parser_test, syntax_error_unknown_codec) {
+	pack_file_description_parser parser;
+	std::string testdata = "testA{\"test1\" brotli;}";
+	const char* first = testdata.data();
+	const char* last = testdata.data() + testdata.size();
+	ast::pack_file_ast_root root;
+	ASSERT_THROW(root = parser.parse("[unit test]", first, last), syntax_exception);
+}
+
 } // namespace parser
 } // namespace asset_gen
 } // namespace mce
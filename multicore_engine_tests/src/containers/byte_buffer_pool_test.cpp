@@ -5,9 +5,13 @@
  */
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstring>
 #include <gtest.hpp>
 #include <mce/containers/byte_buffer_pool.hpp>
+#include <thread>
+#include <vector>
 
 namespace mce {
 namespace containers {
@@ -56,5 +60,102 @@ TEST(containers_byte_buffer_pool_test, pool_buffers_reuse) {
 	ASSERT_EQ(cap, p.capacity());
 }
 
+TEST(containers_byte_buffer_pool_test, concurrent_allocation) {
+	byte_buffer_pool p(0x1000);
+	const int thread_count = 16;
+	const size_t buffers_per_thread = 1024;
+	std::vector<std::thread> threads;
+	std::vector<int> results(thread_count, 0);
+	for(int t = 0; t < thread_count; ++t) {
+		threads.emplace_back([&p, &results, t]() {
+			std::vector<pooled_byte_buffer_ptr> buffs;
+			for(size_t i = 0; i < buffers_per_thread; ++i) {
+				auto b = p.allocate_buffer(64 + i % 64);
+				memset(b, t, b.size());
+				buffs.push_back(b);
+			}
+			results[t] = std::all_of(buffs.begin(), buffs.end(), [t](const pooled_byte_buffer_ptr& b) {
+				return std::all_of(b.begin(), b.end(), [t](char c) { return c == char(t); });
+			});
+		});
+	}
+	for(auto& t : threads) {
+		t.join();
+	}
+	ASSERT_TRUE(std::all_of(results.begin(), results.end(), [](int r) { return r; }));
+}
+
+TEST(containers_byte_buffer_pool_test, concurrent_allocation_default_size_capacity) {
+	byte_buffer_pool p;
+	auto cap = p.capacity();
+	// The chunks of all threads fit into the two initial pool buffers.
+	const int thread_count = 32;
+	std::vector<std::thread> threads;
+	std::vector<std::vector<pooled_byte_buffer_ptr>> buffs(thread_count);
+	for(int t = 0; t < thread_count; ++t) {
+		threads.emplace_back([&p, &buffs, t]() {
+			for(size_t i = 0; i < 16; ++i) {
+				buffs[t].push_back(p.allocate_buffer(256));
+				memset(buffs[t].back(), t, buffs[t].back().size());
+			}
+		});
+	}
+	for(auto& t : threads) {
+		t.join();
+	}
+	ASSERT_EQ(cap, p.capacity());
+	for(int t = 0; t < thread_count; ++t) {
+		for(const auto& b : buffs[t]) {
+			ASSERT_TRUE(std::all_of(b.begin(), b.end(), [t](char c) { return c == char(t); }));
+		}
+	}
+}
+
+TEST(containers_byte_buffer_pool_test, release_resources) {
+	byte_buffer_pool p;
+	auto b = p.allocate_buffer(1024);
+	memset(b, 42, b.size());
+	p.release_resources();
+	ASSERT_EQ(0u, p.capacity());
+	auto b2 = p.allocate_buffer(1024);
+	memset(b2, 23, b2.size());
+	ASSERT_NE(0u, p.capacity());
+	ASSERT_TRUE(std::all_of(b.begin(), b.end(), [](char c) { return c == 42; }));
+}
+
+TEST(containers_byte_buffer_pool_test, release_resources_concurrent_with_allocation) {
+	byte_buffer_pool p;
+	const int thread_count = 8;
+	std::atomic<int> finished_threads{0};
+	std::vector<std::thread> threads;
+	std::vector<int> results(thread_count, 0);
+	for(int t = 0; t < thread_count; ++t) {
+		threads.emplace_back([&p, &finished_threads, &results, t]() {
+			std::vector<pooled_byte_buffer_ptr> buffs;
+			for(int round = 0; round < 256; ++round) {
+				for(size_t i = 0; i < 64; ++i) {
+					auto b = p.allocate_buffer(64 + i % 64);
+					memset(b, t, b.size());
+					buffs.push_back(b);
+				}
+				buffs.erase(buffs.begin(), buffs.begin() + buffs.size() / 2);
+			}
+			results[t] = std::all_of(buffs.begin(), buffs.end(), [t](const pooled_byte_buffer_ptr& b) {
+				return std::all_of(b.begin(), b.end(), [t](char c) { return c == char(t); });
+			});
+			++finished_threads;
+		});
+	}
+	// The pool grows with every release, the number of releases is therefore bounded.
+	for(int i = 0; i < 16 && finished_threads < thread_count; ++i) {
+		p.release_resources();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	for(auto& t : threads) {
+		t.join();
+	}
+	ASSERT_TRUE(std::all_of(results.begin(), results.end(), [](int r) { return r; }));
+}
+
 } // namespace containers
 } // namespace mce
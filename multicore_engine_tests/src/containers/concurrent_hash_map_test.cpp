@@ -0,0 +1,220 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_tests/src/containers/concurrent_hash_map_test.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <atomic>
+#include <gtest.hpp>
+#include <mce/containers/concurrent_hash_map.hpp>
+#include <mce/util/epoch_reclamation.hpp>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace mce {
+namespace containers {
+
+TEST(containers_concurrent_hash_map_test, insert_find_erase) {
+	concurrent_hash_map<int, int> map;
+	ASSERT_TRUE(map.empty());
+	ASSERT_FALSE(map.find(1));
+	ASSERT_TRUE(map.insert(1, 10));
+	ASSERT_TRUE(map.insert(2, 20));
+	ASSERT_FALSE(map.insert(1, 11));
+	ASSERT_EQ(2u, map.size());
+	ASSERT_EQ(10, map.find(1).value());
+	ASSERT_EQ(20, map.find(2).value());
+	ASSERT_FALSE(map.contains(3));
+	ASSERT_FALSE(map.insert_or_assign(1, 12));
+	ASSERT_EQ(12, map.find(1).value());
+	ASSERT_TRUE(map.insert_or_assign(3, 30));
+	ASSERT_TRUE(map.erase(2));
+	ASSERT_FALSE(map.erase(2));
+	ASSERT_FALSE(map.contains(2));
+	ASSERT_EQ(2u, map.size());
+	int visited = 0;
+	ASSERT_TRUE(map.visit(3, [&visited](const int& value) { visited = value; }));
+	ASSERT_EQ(30, visited);
+}
+
+TEST(containers_concurrent_hash_map_test, erase_key_if) {
+	concurrent_hash_map<int, int> map;
+	ASSERT_TRUE(map.insert(1, 10));
+	ASSERT_TRUE(map.insert(2, 20));
+	ASSERT_FALSE(map.erase_if(1, [](const int& value) { return value != 10; }));
+	ASSERT_TRUE(map.contains(1));
+	ASSERT_TRUE(map.erase_if(1, [](const int& value) { return value == 10; }));
+	ASSERT_FALSE(map.contains(1));
+	ASSERT_FALSE(map.erase_if(3, [](const int&) { return true; }));
+	ASSERT_EQ(1u, map.size());
+}
+
+TEST(containers_concurrent_hash_map_test, many_keys_with_removals) {
+	concurrent_hash_map<int, int> map(4);
+	const int count = 10000;
+	for(int i = 0; i < count; ++i) {
+		ASSERT_TRUE(map.insert(i, i * 2));
+	}
+	ASSERT_EQ(size_t(count), map.size());
+	for(int i = 0; i < count; i += 2) {
+		ASSERT_TRUE(map.erase(i));
+	}
+	// Reinserting into the deleted slots must not create duplicates.
+	for(int i = 0; i < count; i += 4) {
+		ASSERT_TRUE(map.insert(i, i * 3));
+	}
+	for(int i = 0; i < count; ++i) {
+		auto value = map.find(i);
+		if(i % 4 == 0) {
+			ASSERT_EQ(i * 3, value.value());
+		} else if(i % 2 == 0) {
+			ASSERT_FALSE(value);
+		} else {
+			ASSERT_EQ(i * 2, value.value());
+		}
+	}
+	size_t visited = 0;
+	map.for_each([&visited](const int& key, const int& value) {
+		visited++;
+		ASSERT_EQ(key * (key % 4 == 0 ? 3 : 2), value);
+	});
+	ASSERT_EQ(map.size(), visited);
+	auto removed = map.erase_if([](const int& key, const int&) { return key % 4 == 3; });
+	ASSERT_EQ(size_t(count / 4), removed);
+	map.clear();
+	ASSERT_TRUE(map.empty());
+	ASSERT_FALSE(map.contains(1));
+}
+
+TEST(containers_concurrent_hash_map_test, for_each_sample) {
+	concurrent_hash_map<int, int> map(4);
+	const int count = 1000;
+	for(int i = 0; i < count; ++i) {
+		ASSERT_TRUE(map.insert(i, i * 2));
+	}
+	for(size_t position : {size_t(0), size_t(7), size_t(12345), ~size_t(0)}) {
+		std::set<int> sampled;
+		auto visited = map.for_each_sample(position, 16, [&sampled](const int& key, const int& value) {
+			ASSERT_EQ(key * 2, value);
+			sampled.insert(key);
+		});
+		ASSERT_EQ(16u, visited);
+		ASSERT_EQ(16u, sampled.size());
+	}
+	// Maps with fewer entries than requested are visited completely.
+	concurrent_hash_map<int, int> small_map(4);
+	ASSERT_TRUE(small_map.insert(1, 2));
+	ASSERT_TRUE(small_map.insert(2, 4));
+	ASSERT_EQ(2u, small_map.for_each_sample(42, 16, [](const int&, const int&) {}));
+}
+
+TEST(containers_concurrent_hash_map_test, heterogeneous_string_lookup) {
+	concurrent_hash_map<std::string, int> map;
+	ASSERT_TRUE(map.insert(std::string_view("models/test.model"), 1));
+	ASSERT_TRUE(map.insert("textures/test.dds", 2));
+	ASSERT_EQ(1, map.find(std::string("models/test.model")).value());
+	ASSERT_EQ(1, map.find(std::string_view("models/test.model")).value());
+	ASSERT_EQ(2, map.find("textures/test.dds").value());
+	ASSERT_FALSE(map.contains("textures/test"));
+	ASSERT_TRUE(map.erase(std::string_view("textures/test.dds")));
+	ASSERT_EQ(1u, map.size());
+}
+
+TEST(containers_concurrent_hash_map_test, find_or_insert_creates_once) {
+	concurrent_hash_map<std::string, std::shared_ptr<int>> map;
+	std::atomic<int> created{0};
+	std::vector<std::thread> threads;
+	std::vector<std::shared_ptr<int>> results(8);
+	for(size_t i = 0; i < results.size(); ++i) {
+		threads.emplace_back([&map, &created, &results, i]() {
+			results[i] = map.find_or_insert("shared", [&created]() {
+								created++;
+								return std::make_shared<int>(42);
+							}).first;
+		});
+	}
+	for(auto& t : threads) {
+		t.join();
+	}
+	ASSERT_EQ(1, created);
+	for(auto& result : results) {
+		ASSERT_EQ(results.front(), result);
+	}
+	auto existing = map.find_or_insert("shared", []() { return std::make_shared<int>(0); });
+	ASSERT_FALSE(existing.second);
+	ASSERT_EQ(42, *existing.first);
+}
+
+TEST(containers_concurrent_hash_map_test, removed_values_are_reclaimed) {
+	auto value = std::make_shared<int>(1);
+	{
+		concurrent_hash_map<int, std::shared_ptr<int>> map;
+		map.insert(1, value);
+		map.insert(2, value);
+		map.insert(3, value);
+		ASSERT_EQ(4, value.use_count());
+		map.erase(1);
+		map.insert_or_assign(2, std::make_shared<int>(2));
+		util::epoch_synchronize();
+		ASSERT_EQ(2, value.use_count());
+	}
+	ASSERT_EQ(1, value.use_count());
+}
+
+TEST(containers_concurrent_hash_map_test, concurrent_readers_and_writers) {
+	concurrent_hash_map<int, int> map;
+	const int writer_count = 4;
+	const int keys_per_writer = 5000;
+	std::atomic<bool> stop{false};
+	std::atomic<bool> invalid_value{false};
+	std::vector<std::thread> readers;
+	for(int r = 0; r < 4; ++r) {
+		readers.emplace_back([&]() {
+			while(!stop) {
+				for(int key = 0; key < writer_count * keys_per_writer; key += 7) {
+					auto value = map.find(key);
+					if(value && value.value() != key && value.value() != -key) invalid_value = true;
+				}
+			}
+		});
+	}
+	std::vector<std::thread> writers;
+	for(int w = 0; w < writer_count; ++w) {
+		writers.emplace_back([&map, w]() {
+			int begin = w * keys_per_writer;
+			int end = begin + keys_per_writer;
+			for(int key = begin; key < end; ++key) {
+				map.insert(key, key);
+			}
+			for(int key = begin; key < end; key += 2) {
+				map.insert_or_assign(key, -key);
+			}
+			for(int key = begin; key < end; key += 3) {
+				map.erase(key);
+			}
+		});
+	}
+	for(auto& t : writers) {
+		t.join();
+	}
+	stop = true;
+	for(auto& t : readers) {
+		t.join();
+	}
+	ASSERT_FALSE(invalid_value);
+	for(int key = 0; key < writer_count * keys_per_writer; ++key) {
+		auto value = map.find(key);
+		if((key % keys_per_writer) % 3 == 0) {
+			ASSERT_FALSE(value);
+		} else {
+			ASSERT_EQ(((key % keys_per_writer) % 2 == 0) ? -key : key, value.value());
+		}
+	}
+}
+
+} // namespace containers
+} // namespace mce
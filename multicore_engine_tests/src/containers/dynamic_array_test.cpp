@@ -4,8 +4,10 @@
  * Copyright 2017 by Stefan Bodenschatz
  */
 
+#include <algorithm>
 #include <gtest.hpp>
 #include <mce/containers/dynamic_array.hpp>
+#include <memory_resource>
 
 namespace mce {
 namespace containers {
@@ -223,6 +225,26 @@ TEST(containers_dynamic_array_test, construct_aggregate_init2) {
 	ASSERT_EQ(42, da[0].a);
 	ASSERT_EQ(123, da[0].b);
 }
+TEST(containers_dynamic_array_test, construct_with_allocator) {
+	char buffer[1024];
+	std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+	dynamic_array<int> da(std::allocator_arg, &resource, 10, index_param_tag<int>());
+	ASSERT_EQ(&resource, da.get_allocator().resource());
+	ASSERT_GE(reinterpret_cast<char*>(da.data()), buffer);
+	ASSERT_LT(reinterpret_cast<char*>(da.data()), buffer + sizeof(buffer));
+	for(int i = 0; i < 10; ++i) {
+		ASSERT_EQ(i, da[i]);
+	}
+	dynamic_array<int> copy(da);
+	ASSERT_EQ(std::pmr::get_default_resource(), copy.get_allocator().resource());
+	ASSERT_TRUE(std::equal(da.begin(), da.end(), copy.begin(), copy.end()));
+	dynamic_array<int> moved(std::move(da));
+	ASSERT_EQ(&resource, moved.get_allocator().resource());
+	ASSERT_EQ(0u, da.size());
+	copy = std::move(moved);
+	ASSERT_EQ(&resource, copy.get_allocator().resource());
+	ASSERT_EQ(9, copy[9]);
+}
 
 } // namespace containers
 } // namespace mce
@@ -11,6 +11,7 @@
 #include <iostream>
 #include <map>
 #include <mce/containers/generic_flat_map.hpp>
+#include <memory_resource>
 #include <string>
 #include <vector>
 
@@ -282,6 +283,21 @@ TEST_F(containers_generic_flat_multimap_stdvec_test, erase) {
 		return v1.first == v2.first && v1.second == v2.second;
 	}));
 }
+TEST(containers_generic_flat_map_pmr_test, uses_memory_resource) {
+	char buffer[0x1000];
+	std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+	pmr_flat_map<int, float> m(&resource);
+	for(int i = 0; i < 20; ++i) {
+		m.insert(20 - i, float(i));
+	}
+	ASSERT_EQ(20u, m.size());
+	ASSERT_EQ(0.0f, m.find(20)->second);
+	ASSERT_TRUE(std::is_sorted(m.begin(), m.end(), [](auto&& a, auto&& b) { return a.first < b.first; }));
+	pmr_flat_multimap<int, float> mm{std::pmr::polymorphic_allocator<std::byte>(&resource)};
+	mm.insert(1, 1.0f);
+	mm.insert(1, 2.0f);
+	ASSERT_EQ(2u, mm.count(1));
+}
 
 } /* namespace containers */
 } /* namespace mce */
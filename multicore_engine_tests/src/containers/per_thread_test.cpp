@@ -5,9 +5,13 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <gtest.hpp>
 #include <mce/containers/per_thread.hpp>
+#include <memory>
+#include <thread>
+#include <vector>
 
 namespace mce {
 namespace containers {
@@ -34,9 +38,10 @@ TEST(containers_per_thread_test, thread_index_consistency) {
 											generator_param([](size_t i) { return int(i * i); }));
 	bool res[num_threads];
 	int indices[num_threads];
+	std::atomic<int> finished{0};
 	std::vector<std::thread> threads;
 	for(int i = 0; i < num_threads; ++i) {
-		threads.emplace_back([i, &res, &pt, &indices]() {
+		threads.emplace_back([i, &res, &pt, &indices, &finished]() {
 			//using namespace std::chrono_literals; //TODO: Find out why this causes an ICE on MSVC (VS 16.3.6)
 			std::this_thread::sleep_for(std::chrono::milliseconds(1)); //TODO: Use UDL again
 			auto index = pt.slot_index();
@@ -45,10 +50,13 @@ TEST(containers_per_thread_test, thread_index_consistency) {
 				std::this_thread::yield();
 				if(index != pt.slot_index()) {
 					res[i] = false;
-					return;
+					break;
 				}
 				res[i] = true;
 			}
+			// Keep the slot until all threads are done, slots of exited threads are reused.
+			++finished;
+			while(finished < num_threads) std::this_thread::yield();
 		});
 	}
 	for(auto& t : threads) {
@@ -66,11 +74,15 @@ TEST(containers_per_thread_test, object_access) {
 	constexpr int num_threads = 128;
 	per_thread<int> pt(num_threads, -1);
 	std::vector<std::thread> threads;
+	std::atomic<int> assigned{0};
 	for(int i = 0; i < num_threads; ++i) {
-		threads.emplace_back([i, &pt]() {
+		threads.emplace_back([i, &pt, &assigned]() {
 			//using namespace std::chrono_literals; //TODO: Find out why this causes an ICE on MSVC (VS 16.3.6)
 			std::this_thread::sleep_for(std::chrono::milliseconds(1)); //TODO: Use UDL again
 			pt.get() = i;
+			// Keep the slot until all threads have one, slots of exited threads are reused.
+			++assigned;
+			while(assigned < num_threads) std::this_thread::yield();
 		});
 	}
 	for(auto& t : threads) {
@@ -89,9 +101,10 @@ TEST(containers_per_thread_index_test, thread_index_consistency) {
 	per_thread_index pt(num_threads);
 	bool res[num_threads];
 	int indices[num_threads];
+	std::atomic<int> finished{0};
 	std::vector<std::thread> threads;
 	for(int i = 0; i < num_threads; ++i) {
-		threads.emplace_back([i, &res, &pt, &indices]() {
+		threads.emplace_back([i, &res, &pt, &indices, &finished]() {
 			//using namespace std::chrono_literals; //TODO: Find out why this causes an ICE on MSVC (VS 16.3.6)
 			std::this_thread::sleep_for(std::chrono::milliseconds(1)); //TODO: Use UDL again
 			auto index = pt.slot_index();
@@ -100,10 +113,13 @@ TEST(containers_per_thread_index_test, thread_index_consistency) {
 				std::this_thread::yield();
 				if(index != pt.slot_index()) {
 					res[i] = false;
-					return;
+					break;
 				}
 				res[i] = true;
 			}
+			// Keep the slot until all threads are done, slots of exited threads are reused.
+			++finished;
+			while(finished < num_threads) std::this_thread::yield();
 		});
 	}
 	for(auto& t : threads) {
@@ -117,5 +133,91 @@ TEST(containers_per_thread_index_test, thread_index_consistency) {
 	ASSERT_EQ(ie, dup);
 }
 
+TEST(containers_per_thread_test, growable_construction_and_access) {
+	constexpr int num_threads = 128;
+	per_thread<per_thread_test_object_1> pt(growable_slots_tag{}, 4, index_param_tag<int>{}, 42,
+											generator_param([](size_t i) { return int(i * i); }));
+	ASSERT_EQ(4u, pt.total_slots());
+	std::vector<std::thread> threads;
+	for(int i = 0; i < num_threads; ++i) {
+		threads.emplace_back([&pt]() {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			auto& obj = pt.get();
+			ASSERT_EQ(&obj, &pt.get());
+			obj.val = -1;
+		});
+	}
+	for(auto& t : threads) {
+		t.join();
+	}
+	ASSERT_GE(pt.total_slots(), pt.used_slots());
+	ASSERT_LE(pt.used_slots(), size_t(num_threads));
+	for(size_t i = 0; i < pt.total_slots(); ++i) {
+		ASSERT_EQ(i, (pt.begin() + i)->index);
+		ASSERT_EQ(i * i, (pt.begin() + i)->sqr);
+		ASSERT_EQ(i < pt.used_slots() ? -1 : 42, (pt.begin() + i)->val);
+	}
+	ASSERT_EQ(pt.total_slots(), size_t(std::distance(pt.all().begin(), pt.all().end())));
+}
+
+TEST(containers_per_thread_test, slot_released_on_thread_exit) {
+	per_thread<int> pt(1, 0);
+	for(int i = 0; i < 16; ++i) {
+		std::thread([&pt]() { ++pt.get(); }).join();
+	}
+	ASSERT_EQ(1u, pt.used_slots());
+	ASSERT_EQ(16, *pt.begin());
+}
+
+TEST(containers_per_thread_index_test, slot_released_on_thread_exit_after_destruction) {
+	auto pt = std::make_unique<per_thread_index>(1);
+	std::atomic<bool> stop{false};
+	std::atomic<bool> started{false};
+	std::thread t([&]() {
+		pt->slot_index();
+		started = true;
+		while(!stop) std::this_thread::yield();
+	});
+	while(!started) std::this_thread::yield();
+	ASSERT_THROW(pt->slot_index(), mce::resource_depleted_exception);
+	pt.reset();
+	stop = true;
+	t.join();
+}
+
+TEST(containers_per_thread_index_test, cached_index_across_instances_and_clear) {
+	// More instances than the thread-local cache has entries to test eviction.
+	constexpr int num_instances = 64;
+	std::vector<std::unique_ptr<per_thread_index>> indices;
+	for(int i = 0; i < num_instances; ++i) {
+		indices.push_back(std::make_unique<per_thread_index>(2));
+	}
+	for(int round = 0; round < 3; ++round) {
+		for(auto& index : indices) {
+			ASSERT_EQ(0u, index->slot_index());
+			ASSERT_EQ(1u, index->used_slots());
+		}
+	}
+	for(auto& index : indices) {
+		index->clear();
+	}
+	std::atomic<bool> stop{false};
+	std::atomic<bool> started{false};
+	std::thread t([&]() {
+		for(auto& index : indices) index->slot_index();
+		started = true;
+		while(!stop) std::this_thread::yield();
+	});
+	while(!started) std::this_thread::yield();
+	for(int round = 0; round < 3; ++round) {
+		for(auto& index : indices) {
+			ASSERT_EQ(1u, index->slot_index());
+			ASSERT_EQ(2u, index->used_slots());
+		}
+	}
+	stop = true;
+	t.join();
+}
+
 } // namespace containers
 } // namespace mce
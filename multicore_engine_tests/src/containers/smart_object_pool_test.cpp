@@ -155,5 +155,21 @@ TEST_F(containers_smart_object_pool_test, iterator_prevent_skip_over_end) {
 	ASSERT_TRUE(val == 3);
 }
 
+TEST(containers_smart_object_pool_huge_page_test, emplace_iterate_and_destroy_many) {
+	smart_object_pool<long long, 0x10000u, memory::huge_page_block_allocation_policy> pool;
+	std::vector<smart_pool_ptr<long long>> elem_ptrs;
+	for(long long i = 0; i < 0x18000; ++i) {
+		elem_ptrs.emplace_back(pool.emplace(i));
+	}
+	ASSERT_EQ(pool.capacity(), 0x20000u);
+	long long sum = 0;
+	for(auto& val : pool) {
+		sum += val;
+	}
+	ASSERT_EQ(sum, (0x18000ll * (0x18000ll - 1)) / 2);
+	elem_ptrs.clear();
+	ASSERT_TRUE(pool.empty());
+}
+
 } /* namespace containers */
 } /* namespace mce */
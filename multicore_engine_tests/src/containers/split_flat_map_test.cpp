@@ -0,0 +1,108 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_tests/src/containers/split_flat_map_test.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <algorithm>
+#include <boost/container/small_vector.hpp>
+#include <cstdint>
+#include <gtest.hpp>
+#include <limits>
+#include <map>
+#include <mce/containers/split_flat_map.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace mce {
+namespace containers {
+
+namespace {
+
+template <typename T>
+using small_container = boost::container::small_vector<T, 16>;
+// Alias template to not depend on relaxed template template argument matching for std::vector.
+template <typename T>
+using vector = std::vector<T>;
+
+template <typename Key>
+void check_against_std_map(size_t size, Key min_key, Key max_key) {
+	std::mt19937 gen(size_t(12345) + size);
+	std::uniform_int_distribution<Key> dist(min_key, max_key);
+	split_flat_map<vector, Key, int> sfm;
+	std::map<Key, int> ref;
+	while(ref.size() < size) {
+		auto key = dist(gen);
+		int value = int(ref.size());
+		auto res = sfm.insert(key, value);
+		auto ref_res = ref.emplace(key, value);
+		ASSERT_EQ(ref_res.second, res.second);
+		ASSERT_EQ(key, res.first->first);
+	}
+	ASSERT_EQ(ref.size(), sfm.size());
+	ASSERT_TRUE(std::equal(sfm.begin(), sfm.end(), ref.begin(), ref.end(), [](const auto& a, const auto& b) {
+		return a.first == b.first && a.second == b.second;
+	}));
+	for(int i = 0; i < 1000; ++i) {
+		auto key = dist(gen);
+		auto it = sfm.find(key);
+		auto ref_it = ref.find(key);
+		if(ref_it == ref.end()) {
+			ASSERT_TRUE(it == sfm.end());
+		} else {
+			ASSERT_TRUE(it != sfm.end());
+			ASSERT_EQ(ref_it->second, it->second);
+		}
+		ASSERT_EQ(std::distance(ref.begin(), ref.lower_bound(key)), sfm.lower_bound(key) - sfm.begin());
+	}
+}
+
+} // namespace
+
+TEST(containers_split_flat_map_test, insert_find_erase) {
+	split_flat_map<small_container, uint32_t, std::string> sfm;
+	ASSERT_TRUE(sfm.insert(42u, "hello").second);
+	ASSERT_TRUE(sfm.insert(7u, "world").second);
+	ASSERT_FALSE(sfm.insert(42u, "again").second);
+	ASSERT_EQ("hello", sfm.find(42)->second);
+	ASSERT_EQ("world", sfm.at(7));
+	ASSERT_TRUE(sfm.find(8) == sfm.end());
+	ASSERT_FALSE(sfm.insert_or_assign(42u, "again").second);
+	ASSERT_EQ("again", sfm.find(42)->second);
+	ASSERT_EQ(1u, sfm.erase(7));
+	ASSERT_EQ(0u, sfm.erase(7));
+	ASSERT_EQ(1u, sfm.size());
+	ASSERT_EQ(42u, sfm.begin()->first);
+	ASSERT_THROW(sfm.at(7), std::out_of_range);
+	for(auto&& e : sfm) {
+		e.second = "modified";
+	}
+	const auto& csfm = sfm;
+	ASSERT_EQ("modified", csfm.begin()->second);
+}
+
+TEST(containers_split_flat_map_test, unsigned_keys_match_std_map) {
+	for(size_t size : {0, 1, 3, 4, 5, 8, 15, 16, 17, 31, 32, 33, 64, 100, 1000}) {
+		check_against_std_map<uint32_t>(size, 0, std::numeric_limits<uint32_t>::max());
+		check_against_std_map<uint32_t>(size, 0, uint32_t(size * 2 + 1));
+	}
+}
+
+TEST(containers_split_flat_map_test, signed_keys_match_std_map) {
+	for(size_t size : {0, 1, 3, 4, 5, 8, 15, 16, 17, 31, 32, 33, 64, 100, 1000}) {
+		check_against_std_map<int32_t>(size, std::numeric_limits<int32_t>::min(),
+									   std::numeric_limits<int32_t>::max());
+		check_against_std_map<int32_t>(size, -int32_t(size), int32_t(size));
+	}
+}
+
+TEST(containers_split_flat_map_test, non_simd_keys_match_std_map) {
+	for(size_t size : {0, 1, 5, 33, 100}) {
+		check_against_std_map<int64_t>(size, -int64_t(size), int64_t(size));
+		check_against_std_map<uint16_t>(size, 0, uint16_t(size * 2 + 1));
+	}
+}
+
+} // namespace containers
+} // namespace mce
@@ -149,6 +149,24 @@ TEST_F(containers_unordered_object_pool_test, reorganize) {
 	ASSERT_TRUE(count != 0u);
 	checkSet(expect);
 }
+TEST(containers_unordered_object_pool_huge_page_test, emplace_iterate_and_erase) {
+	unordered_object_pool<long long, 0x40000u, unordered_object_pool_lock_policies::safe_internals_policy,
+						  memory::huge_page_block_allocation_policy>
+			pool;
+	for(long long i = 0; i < 0x50000; ++i) {
+		pool.emplace(i);
+	}
+	long long sum = 0;
+	for(auto& val : pool) {
+		sum += val;
+	}
+	ASSERT_EQ(pool.size(), 0x50000u);
+	ASSERT_EQ(sum, (0x50000ll * (0x50000ll - 1)) / 2);
+	for(auto it = pool.begin(); it != pool.end();) {
+		it = pool.erase(it);
+	}
+	ASSERT_TRUE(pool.empty());
+}
 
 } /* namespace containers */
 } /* namespace mce */
@@ -0,0 +1,70 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_tests/src/core/engine_frame_allocation_test.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <allocation_test_helper.hpp>
+#include <atomic>
+#include <gtest.hpp>
+#include <mce/asset/dummy_asset.hpp>
+#include <mce/core/core_defs.hpp>
+#include <mce/core/engine.hpp>
+#include <mce/core/entity_game_state.hpp>
+#include <mce/core/game_state_machine.hpp>
+#include <mce/entity/entity.hpp>
+#include <mce/memory/allocation_tracking.hpp>
+#include <mce/simulation/actuator_state.hpp>
+#include <mce/simulation/actuator_system.hpp>
+#include <string>
+
+namespace mce {
+namespace core {
+
+namespace {
+
+constexpr int allocation_test_entity_count = 64;
+
+// Moves entities with actuator components, covering the system hooks, the component pool processing and
+// the entity transform updates without requiring a renderer.
+class allocation_test_game_state : public entity_game_state {
+public:
+	allocation_test_game_state(mce::core::engine* engine, mce::core::game_state_machine* state_machine,
+							   mce::core::game_state* parent_state)
+			: entity_game_state(engine, state_machine, parent_state) {
+		add_system_state<simulation::actuator_state>();
+		std::string entities = "Moving_Ent_Conf{actuator{movement_pattern=\"drift\";}}";
+		for(int i = 0; i < allocation_test_entity_count; ++i) {
+			entities += "Moving_Ent_Conf ent_" + std::to_string(i) + " (" + std::to_string(i) + ",0,0),();";
+		}
+		entity_manager().load_entities_from_template_lang_file(
+				asset::dummy_asset::create_dummy_asset("allocation_test.etf", entities));
+	}
+};
+
+} // namespace
+
+TEST(core_engine_frame_allocation_test, headless_frame_loop_with_entities_without_allocations) {
+	if(!memory::allocation_tracking_enabled()) GTEST_SKIP() << "The allocation functions are not replaced.";
+	engine eng;
+	std::atomic<unsigned> movements{0};
+	auto actuators = eng.add_system<simulation::actuator_system>();
+	actuators->set_movement_pattern("drift", [&movements](const frame_time& ft, entity::entity& ent) {
+		auto pos = ent.position();
+		pos.y += ft.delta_t;
+		ent.position(pos);
+		movements.fetch_add(1, std::memory_order_relaxed);
+	});
+	eng.game_state_machine().enter<allocation_test_game_state>();
+	core::clock clk;
+	auto frame = [&eng, &clk] {
+		auto ft = clk.frame_tick();
+		eng.process(ft);
+		eng.render(ft);
+	};
+	ASSERT_TRUE(test::frames_without_allocations(frame, 16, 256));
+	ASSERT_EQ(unsigned(allocation_test_entity_count * (16 + 256)), movements.load());
+}
+
+} // namespace core
+} // namespace mce
@@ -18,11 +18,11 @@ namespace destruction_queue_manager_test {
 class test_memory_manager : public device_memory_manager_interface {
 	std::vector<int> destroyed_map;
 	int deletion_index = 0;
-	mutable std::mutex mutex;
+	mutable lock_type mutex{"tests.mock_memory_manager"};
 
 public:
 	void free(const device_memory_allocation& allocation) override {
-		std::lock_guard<std::mutex> lock(mutex);
+		std::lock_guard<lock_type> lock(mutex);
 		EXPECT_GT(destroyed_map.size(), allocation.block_id);
 		destroyed_map[allocation.block_id] = deletion_index++;
 	}
@@ -30,21 +30,21 @@ public:
 	allocate(const vk::MemoryRequirements&, bool,
 			 vk::MemoryPropertyFlags = vk::MemoryPropertyFlagBits::eDeviceLocal) override {
 		device_memory_allocation a;
-		std::lock_guard<std::mutex> lock(mutex);
+		std::lock_guard<lock_type> lock(mutex);
 		a.block_id = int32_t(destroyed_map.size());
 		destroyed_map.push_back(-1);
 		return a;
 	}
 	const std::vector<int>& status() {
-		std::lock_guard<std::mutex> lock(mutex);
+		std::lock_guard<lock_type> lock(mutex);
 		return destroyed_map;
 	}
 	virtual device* associated_device() const override {
-		std::lock_guard<std::mutex> lock(mutex);
+		std::lock_guard<lock_type> lock(mutex);
 		return nullptr;
 	}
-	virtual std::unique_lock<std::mutex> obtain_lock(const device_memory_allocation&) const override {
-		return std::unique_lock<std::mutex>(mutex);
+	virtual std::unique_lock<lock_type> obtain_lock(const device_memory_allocation&) const override {
+		return std::unique_lock<lock_type>(mutex);
 	}
 };
 
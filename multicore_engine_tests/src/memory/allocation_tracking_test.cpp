@@ -0,0 +1,101 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_tests/src/memory/allocation_tracking_test.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <algorithm>
+#include <allocation_test_helper.hpp>
+#include <cstring>
+#include <gtest.hpp>
+#include <mce/memory/allocation_tracking.hpp>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mce {
+namespace memory {
+
+TEST(memory_allocation_tracking_test, counts_thread_allocations) {
+	if(!allocation_tracking_enabled()) GTEST_SKIP() << "The allocation functions are not replaced.";
+	allocation_counting_scope scope;
+	{
+		std::vector<uint64_t> values(100, 42);
+		ASSERT_EQ(4200u, std::accumulate(values.begin(), values.end(), uint64_t(0)));
+	}
+	auto counted = scope.counters();
+	ASSERT_EQ(1u, counted.allocations);
+	ASSERT_EQ(1u, counted.deallocations);
+	ASSERT_GE(counted.allocated_bytes, 100 * sizeof(uint64_t));
+}
+
+TEST(memory_allocation_tracking_test, counts_other_threads_globally) {
+	if(!allocation_tracking_enabled()) GTEST_SKIP() << "The allocation functions are not replaced.";
+	allocation_counting_scope scope;
+	auto start = global_allocation_counters();
+	std::vector<std::unique_ptr<int>> objects;
+	std::thread t([&objects] {
+		for(int i = 0; i < 10; ++i) {
+			objects.push_back(std::make_unique<int>(i));
+		}
+		objects.clear();
+	});
+	t.join();
+	auto counted = global_allocation_counters() - start;
+	ASSERT_GE(counted.allocations, 10u);
+	ASSERT_GE(counted.deallocations, 10u);
+	// The thread object may allocate its state on the creating thread, but not 10 times.
+	ASSERT_LT(scope.counters().allocations, 10u);
+}
+
+TEST(memory_allocation_tracking_test, zone_attribution) {
+	if(!allocation_tracking_enabled()) GTEST_SKIP() << "The allocation functions are not replaced.";
+	static allocation_zone outer_zone("allocation_tracking_test.outer");
+	static allocation_zone inner_zone("allocation_tracking_test.inner");
+	outer_zone.reset();
+	inner_zone.reset();
+	{
+		allocation_zone_scope outer(outer_zone);
+		std::vector<int> a(10, 1);
+		{
+			allocation_zone_scope inner(inner_zone);
+			std::vector<int> b(10, 2);
+			std::vector<int> c(10, 3);
+			ASSERT_EQ(50, std::accumulate(b.begin(), b.end(), 0) + std::accumulate(c.begin(), c.end(), 0));
+		}
+		ASSERT_EQ(10, std::accumulate(a.begin(), a.end(), 0));
+	}
+	auto outer_counters = outer_zone.counters();
+	auto inner_counters = inner_zone.counters();
+	ASSERT_EQ(1u, outer_counters.allocations);
+	ASSERT_EQ(1u, outer_counters.deallocations);
+	ASSERT_EQ(2u, inner_counters.allocations);
+	ASSERT_EQ(2u, inner_counters.deallocations);
+	auto zones = allocation_zone_counters();
+	ASSERT_TRUE(std::any_of(zones.begin(), zones.end(), [](const auto& z) {
+		return std::strcmp(z.first, "allocation_tracking_test.inner") == 0 && z.second.allocations == 2;
+	}));
+}
+
+TEST(memory_allocation_tracking_test, steady_state_frames) {
+	if(!allocation_tracking_enabled()) GTEST_SKIP() << "The allocation functions are not replaced.";
+	std::vector<int> buffer;
+	auto steady_frame = [&buffer] {
+		buffer.clear();
+		for(int i = 0; i < 1000; ++i) {
+			buffer.push_back(i);
+		}
+	};
+	ASSERT_TRUE(test::frames_without_allocations(steady_frame, 1, 10));
+	auto churning_frame = [] {
+		std::string s(100, 'x');
+		ASSERT_EQ('x', s.back());
+	};
+	ASSERT_FALSE(test::frames_without_allocations(churning_frame, 1, 10));
+	ASSERT_TRUE(test::frames_within_allocation_budget(churning_frame, 1, 10, 1));
+}
+
+} // namespace memory
+} // namespace mce
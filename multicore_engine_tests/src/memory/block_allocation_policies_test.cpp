@@ -0,0 +1,50 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_tests/src/memory/block_allocation_policies_test.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <cstring>
+#include <gtest.hpp>
+#include <mce/memory/aligned.hpp>
+#include <mce/memory/block_allocation_policies.hpp>
+
+namespace mce {
+namespace memory {
+
+TEST(memory_block_allocation_policies_test, default_policy_alignment) {
+	for(size_t alignment = 1; alignment <= 256; alignment *= 2) {
+		void* ptr = default_block_allocation_policy::allocate(100, alignment);
+		ASSERT_TRUE(is_aligned(ptr, alignment));
+		std::memset(ptr, 0xAB, 100);
+		default_block_allocation_policy::deallocate(ptr, 100, alignment);
+	}
+}
+
+TEST(memory_block_allocation_policies_test, huge_page_policy_small_block) {
+	void* ptr = huge_page_block_allocation_policy::allocate(0x1000, 64);
+	ASSERT_TRUE(is_aligned(ptr, 64));
+	std::memset(ptr, 0xAB, 0x1000);
+	huge_page_block_allocation_policy::deallocate(ptr, 0x1000, 64);
+}
+
+TEST(memory_block_allocation_policies_test, huge_page_policy_large_block) {
+	size_t size = huge_page_size * 3 + 0x1234;
+	void* ptr = huge_page_block_allocation_policy::allocate(size, 64);
+	ASSERT_TRUE(is_aligned(ptr, huge_page_size));
+	std::memset(ptr, 0xAB, size);
+	huge_page_block_allocation_policy::deallocate(ptr, size, 64);
+}
+
+TEST(memory_block_allocation_policies_test, make_policy_allocated) {
+	struct alignas(128) overaligned {
+		int value;
+		explicit overaligned(int value) : value{value} {}
+	};
+	auto ptr = make_policy_allocated<overaligned, default_block_allocation_policy>(42);
+	ASSERT_TRUE(is_aligned(ptr.get(), 128));
+	ASSERT_EQ(ptr->value, 42);
+}
+
+} // namespace memory
+} // namespace mce
@@ -0,0 +1,154 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_tests/src/memory/frame_arena_test.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <atomic>
+#include <cstring>
+#include <gtest.hpp>
+#include <mce/memory/aligned.hpp>
+#include <mce/memory/frame_arena.hpp>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+namespace mce {
+namespace memory {
+
+namespace {
+
+class counting_resource : public std::pmr::memory_resource {
+	std::pmr::memory_resource* upstream = std::pmr::new_delete_resource();
+
+protected:
+	void* do_allocate(size_t bytes, size_t alignment) override {
+		++allocations;
+		return upstream->allocate(bytes, alignment);
+	}
+	void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+		++deallocations;
+		upstream->deallocate(ptr, bytes, alignment);
+	}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+		return this == &other;
+	}
+
+public:
+	std::atomic<size_t> allocations{0};
+	std::atomic<size_t> deallocations{0};
+};
+
+} // namespace
+
+TEST(memory_frame_arena_test, linear_arena_alignment) {
+	linear_arena_resource arena(0x100);
+	for(size_t alignment = 1; alignment <= 256; alignment *= 2) {
+		void* ptr = arena.allocate(24, alignment);
+		ASSERT_TRUE(is_aligned(ptr, alignment));
+		std::memset(ptr, 0xAB, 24);
+	}
+	void* large = arena.allocate(0x1000, 64);
+	ASSERT_TRUE(is_aligned(large, 64));
+	std::memset(large, 0xCD, 0x1000);
+}
+
+TEST(memory_frame_arena_test, linear_arena_reset_coalesces_chunks) {
+	counting_resource upstream;
+	{
+		linear_arena_resource arena(0x100, &upstream);
+		for(int i = 0; i < 100; ++i) {
+			ASSERT_NE(nullptr, arena.allocate(0x40, 8));
+		}
+		ASSERT_GT(arena.chunk_count(), 1u);
+		ASSERT_GE(arena.allocated_bytes(), 100u * 0x40u);
+		auto capacity = arena.capacity();
+		arena.reset();
+		ASSERT_EQ(1u, arena.chunk_count());
+		ASSERT_EQ(capacity, arena.capacity());
+		ASSERT_EQ(0u, arena.allocated_bytes());
+		auto allocations = upstream.allocations.load();
+		for(int frame = 0; frame < 10; ++frame) {
+			for(int i = 0; i < 100; ++i) {
+				ASSERT_NE(nullptr, arena.allocate(0x40, 8));
+			}
+			arena.reset();
+		}
+		ASSERT_EQ(allocations, upstream.allocations.load());
+	}
+	ASSERT_EQ(upstream.allocations.load(), upstream.deallocations.load());
+}
+
+TEST(memory_frame_arena_test, pmr_vector_in_steady_state) {
+	counting_resource upstream;
+	frame_arena arena(2, 0x100, &upstream);
+	for(int frame = 0; frame < 4; ++frame) {
+		std::pmr::vector<int> v(arena.allocator<int>());
+		for(int i = 0; i < 1000; ++i) {
+			v.push_back(i);
+		}
+		arena.advance_frame();
+	}
+	auto allocations = upstream.allocations.load();
+	for(int frame = 0; frame < 10; ++frame) {
+		std::pmr::vector<int> v(arena.allocator<int>());
+		for(int i = 0; i < 1000; ++i) {
+			v.push_back(i);
+		}
+		ASSERT_EQ(999, v.back());
+		arena.advance_frame();
+	}
+	ASSERT_EQ(allocations, upstream.allocations.load());
+}
+
+TEST(memory_frame_arena_test, double_buffering) {
+	frame_arena arena(2, 0x100);
+	auto previous = static_cast<int*>(arena.resource()->allocate(sizeof(int), alignof(int)));
+	*previous = 42;
+	auto previous_resource = arena.resource();
+	arena.advance_frame();
+	ASSERT_EQ(1u, arena.current_frame());
+	ASSERT_NE(previous_resource, arena.resource());
+	auto current = static_cast<int*>(arena.resource()->allocate(sizeof(int), alignof(int)));
+	*current = 123;
+	ASSERT_EQ(42, *previous);
+	arena.advance_frame();
+	ASSERT_EQ(previous_resource, arena.resource());
+	ASSERT_EQ(0u, arena.allocated_bytes());
+	ASSERT_EQ(123, *current);
+}
+
+TEST(memory_frame_arena_test, per_thread_arenas) {
+	frame_arena arena(2, 0x100);
+	constexpr int thread_count = 8;
+	std::vector<std::thread> threads;
+	std::vector<std::pmr::memory_resource*> resources(thread_count);
+	std::atomic<int> finished{0};
+	for(int t = 0; t < thread_count; ++t) {
+		threads.emplace_back([&arena, &resources, &finished, t] {
+			resources[t] = arena.resource();
+			std::pmr::vector<int> v(arena.allocator<int>());
+			for(int i = 0; i < 1000; ++i) {
+				v.push_back(t);
+			}
+			for(int i = 0; i < 1000; ++i) {
+				ASSERT_EQ(t, v[i]);
+			}
+			// Keep the thread alive until all threads obtained their arena.
+			++finished;
+			while(finished.load() < thread_count) std::this_thread::yield();
+		});
+	}
+	for(auto& t : threads) {
+		t.join();
+	}
+	for(int i = 0; i < thread_count; ++i) {
+		for(int j = i + 1; j < thread_count; ++j) {
+			ASSERT_NE(resources[i], resources[j]);
+		}
+	}
+	ASSERT_GE(arena.allocated_bytes(), thread_count * 1000 * sizeof(int));
+}
+
+} // namespace memory
+} // namespace mce
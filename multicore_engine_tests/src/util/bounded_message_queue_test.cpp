@@ -0,0 +1,146 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_tests/src/util/bounded_message_queue_test.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <array>
+#include <boost/container/flat_set.hpp>
+#include <gtest.hpp>
+#include <mce/util/bounded_message_queue.hpp>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace mce {
+namespace util {
+
+namespace {
+
+const int thread_count = 32;
+const int elements_per_thread = 128;
+
+boost::container::flat_set<std::pair<int, int>> expected_elements() {
+	boost::container::flat_set<std::pair<int, int>> expected;
+	expected.reserve(thread_count * elements_per_thread);
+	for(int i = 0; i < thread_count; i++) {
+		for(int j = 0; j < elements_per_thread; ++j) {
+			expected.emplace(i, j);
+		}
+	}
+	return expected;
+}
+
+template <typename Queue>
+std::vector<std::thread> start_producers(Queue& queue) {
+	std::vector<std::thread> threads;
+	for(int i = 0; i < thread_count; i++) {
+		threads.emplace_back([&queue, i]() {
+			for(int j = 0; j < elements_per_thread; ++j) {
+				queue.push(std::make_pair(i, j));
+			}
+		});
+	}
+	return threads;
+}
+
+} // namespace
+
+TEST(util_bounded_message_queue_test, thread_safety_push_pop) {
+	bounded_message_queue<std::pair<int, int>> queue(256);
+	boost::container::flat_set<std::pair<int, int>> actual;
+	actual.reserve(thread_count * elements_per_thread);
+	auto threads = start_producers(queue);
+	for(int i = 0; i < thread_count * elements_per_thread; ++i) {
+		actual.emplace(queue.pop());
+	}
+	for(auto& thread : threads) {
+		thread.join();
+	}
+	ASSERT_TRUE(queue.empty());
+	ASSERT_TRUE(actual == expected_elements());
+}
+
+TEST(util_bounded_message_queue_test, thread_safety_push_try_pop) {
+	bounded_message_queue<std::pair<int, int>> queue(256);
+	boost::container::flat_set<std::pair<int, int>> actual;
+	actual.reserve(thread_count * elements_per_thread);
+	auto threads = start_producers(queue);
+	for(int i = 0; i < thread_count * elements_per_thread;) {
+		std::pair<int, int> elem;
+		if(queue.try_pop(elem)) {
+			actual.emplace(elem);
+			++i;
+		}
+	}
+	for(auto& thread : threads) {
+		thread.join();
+	}
+	ASSERT_TRUE(queue.empty());
+	ASSERT_TRUE(actual == expected_elements());
+}
+
+TEST(util_bounded_message_queue_test, thread_safety_push_pop_batch) {
+	bounded_message_queue<std::pair<int, int>> queue(256);
+	boost::container::flat_set<std::pair<int, int>> actual;
+	actual.reserve(thread_count * elements_per_thread);
+	auto threads = start_producers(queue);
+	std::array<std::pair<int, int>, 64> buffer;
+	for(int i = 0; i < thread_count * elements_per_thread;) {
+		auto count = queue.pop_batch(buffer.begin(), buffer.size());
+		actual.insert(buffer.begin(), buffer.begin() + count);
+		i += int(count);
+	}
+	for(auto& thread : threads) {
+		thread.join();
+	}
+	ASSERT_TRUE(queue.empty());
+	ASSERT_TRUE(actual == expected_elements());
+}
+
+TEST(util_bounded_message_queue_test, try_push_full) {
+	bounded_message_queue<int> queue(4);
+	ASSERT_EQ(queue.capacity(), 4u);
+	for(int i = 0; i < 4; ++i) {
+		ASSERT_TRUE(queue.try_push(i));
+	}
+	ASSERT_TRUE(queue.full());
+	ASSERT_FALSE(queue.try_push(4));
+	ASSERT_EQ(queue.size(), 4u);
+	int val = -1;
+	ASSERT_TRUE(queue.try_pop(val));
+	ASSERT_EQ(val, 0);
+	ASSERT_TRUE(queue.try_push(4));
+	std::array<int, 8> buffer;
+	ASSERT_EQ(queue.pop_batch(buffer.begin(), buffer.size()), 4u);
+	ASSERT_EQ(buffer[0], 1);
+	ASSERT_EQ(buffer[3], 4);
+	ASSERT_TRUE(queue.empty());
+	ASSERT_FALSE(queue.try_pop(val));
+}
+
+TEST(util_bounded_message_queue_test, destroys_remaining_elements) {
+	auto obj = std::make_shared<int>(42);
+	{
+		bounded_message_queue<std::shared_ptr<int>> queue(8);
+		queue.push(obj);
+		queue.push(obj);
+		ASSERT_EQ(obj.use_count(), 3);
+	}
+	ASSERT_EQ(obj.use_count(), 1);
+}
+
+TEST(util_bounded_message_queue_test, throwing_element_construction) {
+	bounded_message_queue<std::string> queue(2);
+	std::string long_string(1000, 'x');
+	ASSERT_TRUE(queue.try_push(long_string));
+	ASSERT_TRUE(queue.try_push("test"));
+	ASSERT_FALSE(queue.try_push(long_string));
+	ASSERT_EQ(queue.pop(), long_string);
+	ASSERT_EQ(queue.pop(), "test");
+}
+
+} // namespace util
+} // namespace mce
@@ -7,6 +7,8 @@
 #include <gtest.hpp>
 #include <mce/util/callback_pool.hpp>
 #include <mce/util/unused.hpp>
+#include <thread>
+#include <vector>
 
 namespace mce {
 namespace util {
@@ -181,5 +183,78 @@ TEST(util_callback_pool_test, const_correctnes) {
 	ASSERT_EQ(1, x);
 }
 
+TEST(util_callback_pool_test, concurrent_allocation) {
+	callback_pool p(0x1000);
+	const int thread_count = 16;
+	const int functions_per_thread = 1024;
+	std::vector<int> results(thread_count * functions_per_thread, 0);
+	std::vector<std::thread> threads;
+	for(int t = 0; t < thread_count; ++t) {
+		threads.emplace_back([&p, &results, t]() {
+			std::vector<callback_pool_function<void()>> functions;
+			for(int i = 0; i < functions_per_thread; ++i) {
+				auto index = t * functions_per_thread + i;
+				functions.push_back(
+						p.allocate_function<void()>([&results, index]() { results[index] = index; }));
+			}
+			for(auto& f : functions) {
+				f();
+			}
+		});
+	}
+	for(auto& t : threads) {
+		t.join();
+	}
+	for(size_t i = 0; i < results.size(); ++i) {
+		ASSERT_EQ(int(i), results[i]);
+	}
+}
+
+TEST(util_callback_pool_test, concurrent_allocation_default_size_capacity) {
+	callback_pool p;
+	auto cap = p.capacity();
+	// The chunks of all threads fit into the two initial buffers.
+	const int thread_count = 32;
+	const int functions_per_thread = 16;
+	std::vector<int> results(thread_count * functions_per_thread, 0);
+	std::vector<std::vector<callback_pool_function<void()>>> functions(thread_count);
+	std::vector<std::thread> threads;
+	for(int t = 0; t < thread_count; ++t) {
+		threads.emplace_back([&p, &results, &functions, t]() {
+			for(int i = 0; i < functions_per_thread; ++i) {
+				auto index = t * functions_per_thread + i;
+				functions[t].push_back(
+						p.allocate_function<void()>([&results, index]() { results[index] = index; }));
+			}
+		});
+	}
+	for(auto& t : threads) {
+		t.join();
+	}
+	ASSERT_EQ(cap, p.capacity());
+	for(auto& thread_functions : functions) {
+		for(auto& f : thread_functions) {
+			f();
+		}
+	}
+	for(size_t i = 0; i < results.size(); ++i) {
+		ASSERT_EQ(int(i), results[i]);
+	}
+}
+
+TEST(util_callback_pool_test, release_resources) {
+	callback_pool p;
+	int x = 0;
+	auto f = p.allocate_function<void()>([&]() { x = 42; });
+	p.release_resources();
+	ASSERT_EQ(0u, p.capacity());
+	auto g = p.allocate_function<void()>([&]() { x = 23; });
+	ASSERT_NE(0u, p.capacity());
+	f();
+	ASSERT_EQ(42, x);
+	g();
+	ASSERT_EQ(23, x);
+}
+
 } // namespace util
 } // namespace mce
@@ -82,5 +82,105 @@ TEST(util_compression, compression_decompression_level_9) {
 	ASSERT_TRUE(std::equal(input.begin(), input.end(), decompressed.begin(), decompressed.end()));
 }
 
+TEST(util_compression, decompression_into_buffer) {
+	std::vector<char> input(0x50000);
+	for(size_t i = 0; i < input.size(); ++i) {
+		input[i] = char(i * 7 % 251);
+	}
+	auto compressed = compress(input, 6);
+	std::vector<char> output(input.size());
+	decompress(compressed.data(), compressed.size(), output.data(), output.size());
+	ASSERT_TRUE(std::equal(input.begin(), input.end(), output.begin(), output.end()));
+}
+
+TEST(util_compression, decompression_into_buffer_size_mismatch) {
+	std::vector<char> input = {'H', 'e', 'l', 'l', 'o', ' ', 'W', 'o', 'r', 'l', 'd', '!'};
+	auto compressed = compress(input, 6);
+	std::vector<char> small_output(input.size() - 1);
+	ASSERT_THROW(decompress(compressed.data(), compressed.size(), small_output.data(), small_output.size()),
+				 compression_exception);
+	std::vector<char> large_output(input.size() + 1);
+	ASSERT_THROW(decompress(compressed.data(), compressed.size(), large_output.data(), large_output.size()),
+				 compression_exception);
+	std::vector<char> output(input.size());
+	ASSERT_THROW(decompress(compressed.data(), compressed.size() - 2, output.data(), output.size()),
+				 compression_exception);
+}
+
+TEST(util_compression, decompression_into_empty_buffer) {
+	auto compressed = compress(std::vector<char>(), 6);
+	char dummy = 0;
+	decompress(compressed.data(), compressed.size(), &dummy, 0);
+}
+
+namespace {
+
+const compression_codec all_codecs[] = {compression_codec::none, compression_codec::zlib,
+										compression_codec::lz4, compression_codec::zstd};
+
+} // namespace
+
+TEST(util_compression, codec_round_trip) {
+	std::vector<char> input(0x30000);
+	for(size_t i = 0; i < input.size(); ++i) {
+		input[i] = char(i * 13 % 239);
+	}
+	for(auto id : all_codecs) {
+		if(!codec_available(id)) continue;
+		const codec& c = get_codec(id);
+		ASSERT_EQ(id, c.id());
+		for(int level : {-1, 1, 100}) {
+			std::vector<char> compressed;
+			c.compress(input.data(), input.size(), level, compressed);
+			std::vector<char> output(input.size());
+			c.decompress(compressed.data(), compressed.size(), output.data(), output.size());
+			ASSERT_TRUE(std::equal(input.begin(), input.end(), output.begin(), output.end()))
+					<< codec_name(id) << " level " << level;
+		}
+	}
+}
+
+TEST(util_compression, codec_size_mismatch) {
+	std::vector<char> input = {'H', 'e', 'l', 'l', 'o', ' ', 'W', 'o', 'r', 'l', 'd', '!'};
+	for(auto id : all_codecs) {
+		if(!codec_available(id)) continue;
+		const codec& c = get_codec(id);
+		std::vector<char> compressed;
+		c.compress(input.data(), input.size(), -1, compressed);
+		std::vector<char> small_output(input.size() - 1);
+		ASSERT_THROW(c.decompress(compressed.data(), compressed.size(), small_output.data(),
+								  small_output.size()),
+					 compression_exception)
+				<< codec_name(id);
+		std::vector<char> large_output(input.size() + 1);
+		ASSERT_THROW(c.decompress(compressed.data(), compressed.size(), large_output.data(),
+								  large_output.size()),
+					 compression_exception)
+				<< codec_name(id);
+	}
+}
+
+TEST(util_compression, codec_empty_data) {
+	for(auto id : all_codecs) {
+		if(!codec_available(id)) continue;
+		const codec& c = get_codec(id);
+		std::vector<char> compressed;
+		c.compress(nullptr, 0, -1, compressed);
+		char dummy = 0;
+		c.decompress(compressed.data(), compressed.size(), &dummy, 0);
+	}
+}
+
+TEST(util_compression, codec_unavailable) {
+	ASSERT_TRUE(codec_available(compression_codec::none));
+	ASSERT_TRUE(codec_available(compression_codec::zlib));
+	for(auto id : all_codecs) {
+		if(codec_available(id)) continue;
+		ASSERT_THROW(get_codec(id), compression_exception) << codec_name(id);
+	}
+	ASSERT_FALSE(codec_available(static_cast<compression_codec>(200)));
+	ASSERT_THROW(get_codec(static_cast<compression_codec>(200)), compression_exception);
+}
+
 } // namespace util
 } // namespace mce
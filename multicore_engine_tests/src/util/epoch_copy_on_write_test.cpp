@@ -0,0 +1,78 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_tests/src/util/epoch_copy_on_write_test.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <atomic>
+#include <gtest.hpp>
+#include <mce/util/epoch_copy_on_write.hpp>
+#include <thread>
+#include <vector>
+
+namespace mce {
+namespace util {
+
+namespace {
+
+// Lets reader_count threads read the vector for the given number of iterations while a writer appends to it.
+template <typename Cow, typename Read>
+void read_heavy_scenario(Cow& cow, Read read, int reader_count, int reads) {
+	std::atomic<bool> error{false};
+	std::vector<std::thread> readers;
+	for(int i = 0; i < reader_count; ++i) {
+		readers.emplace_back([&]() {
+			for(int j = 0; j < reads; ++j) {
+				if(!read(cow)) error = true;
+			}
+		});
+	}
+	for(int i = 0; i < 64; ++i) {
+		cow.do_transaction([i](std::vector<int>& v) { v.push_back(i); });
+		std::this_thread::yield();
+	}
+	for(auto& r : readers) {
+		r.join();
+	}
+	EXPECT_FALSE(error);
+}
+
+bool consistent(const std::vector<int>& v) {
+	for(size_t i = 0; i < v.size(); ++i) {
+		if(v[i] != int(i)) return false;
+	}
+	return true;
+}
+
+} // namespace
+
+TEST(util_epoch_copy_on_write_test, transactions_are_visible) {
+	epoch_copy_on_write<std::vector<int>> cow;
+	auto before = cow.get();
+	cow.do_transaction([](std::vector<int>& v) { v.push_back(42); });
+	ASSERT_TRUE(before->empty());
+	auto after = cow.get();
+	ASSERT_EQ(1u, after->size());
+	ASSERT_EQ(42, (*after)[0]);
+}
+
+TEST(util_epoch_copy_on_write_test, throwing_transaction_keeps_version) {
+	epoch_copy_on_write<std::vector<int>> cow(std::vector<int>{1, 2, 3});
+	ASSERT_THROW(cow.do_transaction([](std::vector<int>& v) {
+		v.clear();
+		throw std::runtime_error("test");
+	}),
+				 std::runtime_error);
+	ASSERT_EQ(3u, cow.get()->size());
+}
+
+TEST(util_epoch_copy_on_write_test, concurrent_readers_and_writers) {
+	epoch_copy_on_write<std::vector<int>> cow;
+	read_heavy_scenario(cow, [](const auto& c) { return consistent(*c.get()); }, 8, 20000);
+	epoch_synchronize();
+	ASSERT_EQ(64u, cow.get()->size());
+	ASSERT_TRUE(consistent(*cow.get()));
+}
+
+} // namespace util
+} // namespace mce
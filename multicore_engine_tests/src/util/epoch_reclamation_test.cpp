@@ -0,0 +1,157 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_tests/src/util/epoch_reclamation_test.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <atomic>
+#include <gtest.hpp>
+#include <mce/util/epoch_reclamation.hpp>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace mce {
+namespace util {
+
+namespace {
+
+struct epoch_reclamation_test_object {
+	std::atomic<int>* destroyed;
+	explicit epoch_reclamation_test_object(std::atomic<int>* destroyed) : destroyed{destroyed} {}
+	~epoch_reclamation_test_object() {
+		++*destroyed;
+		destroyed = nullptr;
+	}
+};
+
+std::atomic<int> throwing_deleter_calls{0};
+
+void throwing_deleter(void* object) {
+	delete static_cast<epoch_reclamation_test_object*>(object);
+	++throwing_deleter_calls;
+	throw std::runtime_error("deleter failed");
+}
+
+} // namespace
+
+TEST(util_epoch_reclamation_test, retire_without_readers) {
+	std::atomic<int> destroyed{0};
+	epoch_retire(new epoch_reclamation_test_object(&destroyed));
+	epoch_synchronize();
+	ASSERT_EQ(1, destroyed);
+}
+
+TEST(util_epoch_reclamation_test, reader_delays_reclamation) {
+	std::atomic<int> destroyed{0};
+	std::atomic<bool> entered{false};
+	std::atomic<bool> leave{false};
+	std::thread reader([&]() {
+		epoch_guard guard;
+		entered = true;
+		while(!leave) std::this_thread::yield();
+	});
+	while(!entered) std::this_thread::yield();
+	for(int i = 0; i < 16; ++i) {
+		epoch_retire(new epoch_reclamation_test_object(&destroyed));
+	}
+	ASSERT_EQ(0, destroyed);
+	leave = true;
+	reader.join();
+	epoch_synchronize();
+	ASSERT_EQ(16, destroyed);
+}
+
+TEST(util_epoch_reclamation_test, nested_guards) {
+	std::atomic<int> destroyed{0};
+	std::atomic<bool> retired{false};
+	std::atomic<bool> checked{false};
+	std::thread reader([&]() {
+		epoch_guard outer;
+		{
+			epoch_guard inner;
+		}
+		while(!retired) std::this_thread::yield();
+		// The inner guard must not have ended the critical section of the outer one.
+		for(int i = 0; i < 16; ++i) {
+			epoch_retire(new epoch_reclamation_test_object(&destroyed));
+		}
+		checked = destroyed == 0;
+	});
+	retired = true;
+	reader.join();
+	ASSERT_TRUE(checked);
+	epoch_synchronize();
+	ASSERT_EQ(16, destroyed);
+}
+
+TEST(util_epoch_reclamation_test, retiring_thread_reclaims_without_synchronize) {
+	std::atomic<int> destroyed{0};
+	std::thread writer([&]() {
+		for(int i = 0; i < 256; ++i) {
+			epoch_retire(new epoch_reclamation_test_object(&destroyed));
+		}
+	});
+	writer.join();
+	ASSERT_LT(0, destroyed);
+	epoch_synchronize();
+	ASSERT_EQ(256, destroyed);
+}
+
+TEST(util_epoch_reclamation_test, synchronize_reclaims_objects_of_exited_threads) {
+	std::atomic<int> destroyed{0};
+	std::thread writer([&]() { epoch_retire(new epoch_reclamation_test_object(&destroyed)); });
+	writer.join();
+	epoch_synchronize();
+	ASSERT_EQ(1, destroyed);
+	ASSERT_EQ(0u, epoch_pending_reclamations());
+}
+
+TEST(util_epoch_reclamation_test, throwing_deleter_does_not_leak_other_objects) {
+	std::atomic<int> destroyed{0};
+	throwing_deleter_calls = 0;
+	epoch_retire(new epoch_reclamation_test_object(&destroyed));
+	epoch_retire(new epoch_reclamation_test_object(&destroyed), throwing_deleter);
+	epoch_retire(new epoch_reclamation_test_object(&destroyed));
+	ASSERT_NO_THROW(epoch_synchronize());
+	ASSERT_EQ(3, destroyed);
+	ASSERT_EQ(1, throwing_deleter_calls);
+	ASSERT_EQ(0u, epoch_pending_reclamations());
+}
+
+TEST(util_epoch_reclamation_test, concurrent_readers_and_writers) {
+	const int reader_count = 8;
+	const int writes = 4096;
+	std::atomic<epoch_reclamation_test_object*> current{nullptr};
+	std::atomic<int> destroyed{0};
+	std::atomic<bool> stop{false};
+	std::atomic<bool> error{false};
+	current = new epoch_reclamation_test_object(&destroyed);
+	std::vector<std::thread> readers;
+	for(int i = 0; i < reader_count; ++i) {
+		readers.emplace_back([&]() {
+			while(!stop) {
+				epoch_guard guard;
+				auto obj = current.load();
+				// A reclaimed object would have its counter pointer reset.
+				if(obj->destroyed != &destroyed) error = true;
+			}
+		});
+	}
+	for(int i = 0; i < writes; ++i) {
+		auto old = current.exchange(new epoch_reclamation_test_object(&destroyed));
+		epoch_retire(old);
+	}
+	stop = true;
+	for(auto& r : readers) {
+		r.join();
+	}
+	epoch_synchronize();
+	ASSERT_FALSE(error);
+	ASSERT_EQ(writes, destroyed);
+	delete current.load();
+	ASSERT_EQ(0u, epoch_pending_reclamations());
+}
+
+} // namespace util
+} // namespace mce
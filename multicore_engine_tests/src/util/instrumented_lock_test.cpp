@@ -0,0 +1,110 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_tests/src/util/instrumented_lock_test.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <gtest.hpp>
+#include <mce/util/instrumented_lock.hpp>
+#include <mce/util/statistics.hpp>
+#include <mutex>
+#include <shared_mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace mce {
+namespace util {
+
+namespace {
+
+lock_counters_snapshot counters_of(const char* name) {
+	auto all = all_lock_counters();
+	auto it = std::find_if(all.begin(), all.end(),
+						   [name](const auto& entry) { return std::strcmp(entry.first, name) == 0; });
+	return it != all.end() ? it->second : lock_counters_snapshot();
+}
+
+// The counters persist across tests with the same name, therefore the tests check the differences.
+lock_counters_snapshot operator-(const lock_counters_snapshot& a, const lock_counters_snapshot& b) {
+	return {a.acquisitions - b.acquisitions, a.contended_acquisitions - b.contended_acquisitions,
+			a.wait_time_ns - b.wait_time_ns, a.max_wait_time_ns, a.hold_time_ns - b.hold_time_ns};
+}
+
+} // namespace
+
+TEST(util_instrumented_lock_test, uncontended_acquisitions) {
+	auto before = counters_of("instrumented_lock_test.uncontended");
+	instrumented_lock<> lock("instrumented_lock_test.uncontended");
+	instrumented_lock<> same_name_lock("instrumented_lock_test.uncontended");
+	for(int i = 0; i < 10; ++i) {
+		std::lock_guard<instrumented_lock<>> guard(lock);
+	}
+	ASSERT_TRUE(same_name_lock.try_lock());
+	same_name_lock.unlock();
+	auto counters = counters_of("instrumented_lock_test.uncontended") - before;
+	if(lock_statistics_enabled) {
+		ASSERT_EQ(11u, counters.acquisitions);
+		ASSERT_EQ(0u, counters.contended_acquisitions);
+		ASSERT_EQ(0u, counters.wait_time_ns);
+	} else {
+		ASSERT_EQ(0u, counters.acquisitions);
+	}
+}
+
+TEST(util_instrumented_lock_test, contended_acquisition_records_wait_and_hold_time) {
+	auto before = counters_of("instrumented_lock_test.contended");
+	instrumented_lock<> lock("instrumented_lock_test.contended");
+	lock.lock();
+	std::thread waiter([&lock]() {
+		std::lock_guard<instrumented_lock<>> guard(lock);
+	});
+	// The waiter can't acquire the lock before it is released, whether it started waiting already or not.
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	lock.unlock();
+	waiter.join();
+	auto counters = counters_of("instrumented_lock_test.contended") - before;
+	if(lock_statistics_enabled) {
+		ASSERT_EQ(2u, counters.acquisitions);
+		ASSERT_GE(counters.hold_time_ns, 20000000u);
+		ASSERT_LE(counters.contended_acquisitions, 1u);
+	} else {
+		ASSERT_EQ(0u, counters.acquisitions);
+	}
+}
+
+TEST(util_instrumented_lock_test, shared_acquisitions) {
+	auto before = counters_of("instrumented_lock_test.shared");
+	instrumented_lock<std::shared_timed_mutex> lock("instrumented_lock_test.shared");
+	{
+		std::shared_lock<instrumented_lock<std::shared_timed_mutex>> first(lock);
+		std::shared_lock<instrumented_lock<std::shared_timed_mutex>> second(lock);
+		ASSERT_FALSE(lock.try_lock());
+	}
+	{ std::unique_lock<instrumented_lock<std::shared_timed_mutex>> exclusive(lock); }
+	auto counters = counters_of("instrumented_lock_test.shared") - before;
+	ASSERT_EQ(lock_statistics_enabled ? 3u : 0u, counters.acquisitions);
+}
+
+TEST(util_instrumented_lock_test, lock_statistic_output) {
+	instrumented_lock<> lock("instrumented_lock_test.statistic");
+	{ std::lock_guard<instrumented_lock<>> guard(lock); }
+	lock_statistic statistic;
+	std::stringstream stream;
+	stream << statistic.evaluate();
+	auto output = stream.str();
+	ASSERT_EQ(0u, output.find("lock;acquisitions;contended;wait_ns;max_wait_ns;hold_ns\n"));
+	if(lock_statistics_enabled) {
+		ASSERT_NE(std::string::npos, output.find("\ninstrumented_lock_test.statistic;1;0;0;0;"));
+		statistic.clear();
+		ASSERT_EQ(0u, counters_of("instrumented_lock_test.statistic").acquisitions);
+	} else {
+		ASSERT_EQ(std::string::npos, output.find("instrumented_lock_test.statistic"));
+	}
+}
+
+} // namespace util
+} // namespace mce
@@ -0,0 +1,132 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_tests/src/util/perf_counters_test.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <gtest.hpp>
+#include <mce/util/perf_counters.hpp>
+#include <mce/util/statistics.hpp>
+#include <sstream>
+#include <vector>
+
+namespace mce {
+namespace util {
+
+namespace {
+
+perf_counter_zone_values zone_values_of(const char* name) {
+	auto zones = perf_counter_zones();
+	auto it = std::find_if(zones.begin(), zones.end(),
+						   [name](const auto& zone) { return std::strcmp(zone.name, name) == 0; });
+	return it != zones.end() ? *it : perf_counter_zone_values{name, 0, {}};
+}
+
+// Keeps the compiler from removing the loop, so that the zones have instructions to count.
+volatile uint64_t perf_counters_test_sink = 0;
+
+void busy_work() {
+	uint64_t x = 1;
+	for(int i = 0; i < 100000; ++i) {
+		x = x * 6364136223846793005ull + 1442695040888963407ull;
+	}
+	perf_counters_test_sink = x;
+}
+
+} // namespace
+
+TEST(util_perf_counters_test, zone_records_samples) {
+	static perf_counter_zone zone("perf_counters_test.samples");
+	auto before = zone.samples();
+	for(int i = 0; i < 3; ++i) {
+		perf_counter_zone_scope scope(zone);
+		busy_work();
+	}
+	ASSERT_EQ(before + 3, zone.samples());
+	ASSERT_EQ(zone.samples(), zone_values_of("perf_counters_test.samples").samples);
+	if(perf_counters_available()) {
+		ASSERT_GT(zone.counters().cycles, 0u);
+		ASSERT_GT(zone.counters().instructions, 300000u);
+	} else {
+		ASSERT_EQ(0u, zone.counters().cycles);
+		ASSERT_EQ(0u, zone.counters().instructions);
+	}
+}
+
+TEST(util_perf_counters_test, thread_counters_are_monotonic) {
+	auto first = thread_perf_counters();
+	busy_work();
+	auto second = thread_perf_counters();
+	if(perf_counters_available()) {
+		ASSERT_GT(second.instructions, first.instructions);
+	} else {
+		ASSERT_EQ(0u, second.instructions);
+		ASSERT_EQ(0u, second.cycles);
+	}
+}
+
+TEST(util_perf_counters_test, reading_delta_scales_interval) {
+	// Separately scaled cumulative values would be 10000 at the start and 2000 at the end.
+	perf_counter_reading start{{1000, 2000, 30, 40}, 1000, 100};
+	perf_counter_reading end{{1100, 2400, 30, 41}, 2000, 1100};
+	auto delta = end - start;
+	ASSERT_EQ(100u, delta.cycles);
+	ASSERT_EQ(400u, delta.instructions);
+	ASSERT_EQ(0u, delta.llc_misses);
+	ASSERT_EQ(1u, delta.branch_misses);
+	perf_counter_reading multiplexed{{1300, 2800, 40, 41}, 3000, 1600};
+	delta = multiplexed - end;
+	ASSERT_EQ(400u, delta.cycles);
+	ASSERT_EQ(800u, delta.instructions);
+	ASSERT_EQ(20u, delta.llc_misses);
+	ASSERT_EQ(0u, delta.branch_misses);
+}
+
+TEST(util_perf_counters_test, failed_reading_gives_zero_delta) {
+	perf_counter_reading start{{1000, 2000, 30, 40}, 1000, 500};
+	auto delta = perf_counter_reading{} - start;
+	ASSERT_EQ(0u, delta.cycles);
+	ASSERT_EQ(0u, delta.instructions);
+	ASSERT_EQ(0u, delta.llc_misses);
+	ASSERT_EQ(0u, delta.branch_misses);
+	auto values_delta = perf_counter_values{} - start.raw;
+	ASSERT_EQ(0u, values_delta.cycles);
+	ASSERT_EQ(0u, values_delta.branch_misses);
+}
+
+TEST(util_perf_counters_test, zone_macro) {
+	auto before = zone_values_of("perf_counters_test.macro").samples;
+	for(int i = 0; i < 2; ++i) {
+		MCE_PERF_ZONE("perf_counters_test.macro");
+		busy_work();
+	}
+	auto samples = zone_values_of("perf_counters_test.macro").samples - before;
+	ASSERT_EQ(perf_counters_enabled ? 2u : 0u, samples);
+}
+
+TEST(util_perf_counters_test, reset_zones) {
+	static perf_counter_zone zone("perf_counters_test.reset");
+	{ perf_counter_zone_scope scope(zone); }
+	ASSERT_EQ(1u, zone.samples());
+	reset_perf_counter_zones();
+	ASSERT_EQ(0u, zone.samples());
+	ASSERT_EQ(0u, zone.counters().cycles);
+}
+
+TEST(util_perf_counters_test, perf_counter_statistic_output) {
+	static perf_counter_zone zone("perf_counters_test.statistic");
+	{ perf_counter_zone_scope scope(zone); }
+	perf_counter_statistic statistic;
+	std::stringstream stream;
+	stream << statistic.evaluate();
+	auto output = stream.str();
+	ASSERT_EQ(0u, output.find("zone;samples;cycles;instructions;llc_misses;branch_misses\n"));
+	ASSERT_NE(std::string::npos, output.find("\nperf_counters_test.statistic;1;"));
+	statistic.clear();
+	ASSERT_EQ(0u, zone.samples());
+}
+
+} // namespace util
+} // namespace mce
@@ -0,0 +1,94 @@
+/*
+ * Multi-Core Engine project
+ * File /multicore_engine_tests/src/util/symbol_test.cpp
+ * Copyright 2026 by Stefan Bodenschatz
+ */
+
+#include <gtest.hpp>
+#include <mce/util/symbol.hpp>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace mce {
+namespace util {
+
+TEST(util_symbol_test, equal_strings_have_equal_symbols) {
+	symbol a("symbol_test/a");
+	symbol b(std::string("symbol_test/b"));
+	symbol a2(std::string("symbol_test/") + "a");
+	ASSERT_EQ(a, a2);
+	ASSERT_EQ(a.id(), a2.id());
+	ASSERT_EQ(a.hash(), a2.hash());
+	ASSERT_NE(a, b);
+	ASSERT_EQ("symbol_test/a", a.str());
+	ASSERT_EQ("symbol_test/b", b.view());
+	ASSERT_EQ(&a.str(), &a2.str());
+	std::stringstream stream;
+	stream << b;
+	ASSERT_EQ("symbol_test/b", stream.str());
+}
+
+TEST(util_symbol_test, empty_symbol) {
+	symbol empty;
+	ASSERT_TRUE(empty.empty());
+	ASSERT_EQ(0u, empty.id());
+	ASSERT_EQ("", empty.str());
+	ASSERT_EQ(empty, symbol(""));
+	ASSERT_FALSE(symbol("symbol_test/not_empty").empty());
+}
+
+TEST(util_symbol_test, find_does_not_intern) {
+	ASSERT_FALSE(symbol::find("symbol_test/never_interned"));
+	symbol interned("symbol_test/interned");
+	auto found = symbol::find("symbol_test/interned");
+	ASSERT_TRUE(found);
+	ASSERT_EQ(interned, found.value());
+	ASSERT_FALSE(symbol::find("symbol_test/never_interned"));
+}
+
+TEST(util_symbol_test, many_symbols) {
+	std::vector<symbol> symbols;
+	std::unordered_set<symbol> set;
+	for(int i = 0; i < 10000; ++i) {
+		symbols.emplace_back("symbol_test/many/" + std::to_string(i));
+		set.insert(symbols.back());
+	}
+	ASSERT_EQ(symbols.size(), set.size());
+	for(int i = 0; i < 10000; ++i) {
+		ASSERT_EQ("symbol_test/many/" + std::to_string(i), symbols[size_t(i)].str());
+		ASSERT_EQ(symbols[size_t(i)], symbol("symbol_test/many/" + std::to_string(i)));
+	}
+}
+
+TEST(util_symbol_test, concurrent_interning) {
+	const int thread_count = 8;
+	const int symbol_count = 2000;
+	std::vector<std::vector<symbol>> results(thread_count);
+	std::vector<std::thread> threads;
+	for(int t = 0; t < thread_count; ++t) {
+		threads.emplace_back([&results, t]() {
+			for(int i = 0; i < symbol_count; ++i) {
+				// Each thread interns the strings in a different order.
+				int index = (i * 7 + t * 13) % symbol_count;
+				results[size_t(t)].emplace_back("symbol_test/concurrent/" + std::to_string(index));
+			}
+		});
+	}
+	for(auto& thread : threads) {
+		thread.join();
+	}
+	for(int t = 0; t < thread_count; ++t) {
+		for(int i = 0; i < symbol_count; ++i) {
+			int index = (i * 7 + t * 13) % symbol_count;
+			auto sym = results[size_t(t)][size_t(i)];
+			ASSERT_EQ("symbol_test/concurrent/" + std::to_string(index), sym.str());
+			ASSERT_EQ(symbol("symbol_test/concurrent/" + std::to_string(index)), sym);
+		}
+	}
+}
+
+} // namespace util
+} // namespace mce